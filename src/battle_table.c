@@ -0,0 +1,632 @@
+#include <stdint.h>
+
+#include <src/include/battle_table.h>
+
+/* Generated by tools/battle_table_gen.py, do not edit below this line */
+
+const BattleMove battle_move_gen_i[256] = {
+    [0x01] = {40, 0x00, 35, 0}, // Pound
+    [0x02] = {50, 0x00, 25, 0}, // Karate Chop
+    [0x03] = {45, 0x00, 10, 0}, // Doubleslap
+    [0x04] = {54, 0x00, 15, 0}, // Comet Punch
+    [0x05] = {80, 0x00, 20, 0}, // Mega Punch
+    [0x06] = {40, 0x00, 20, 0}, // Pay Day
+    [0x07] = {75, 0x14, 15, 0}, // Fire Punch
+    [0x08] = {75, 0x19, 15, 0}, // Ice Punch
+    [0x09] = {75, 0x17, 15, 0}, // Thunderpunch
+    [0x0A] = {40, 0x00, 35, 0}, // Scratch
+    [0x0B] = {55, 0x00, 30, 0}, // Vicegrip
+    [0x0D] = {40, 0x00, 10, 0}, // Razor Wind
+    [0x0F] = {50, 0x00, 30, 0}, // Cut
+    [0x10] = {40, 0x00, 35, 0}, // Gust
+    [0x11] = {35, 0x02, 35, 0}, // Wing Attack
+    [0x13] = {35, 0x02, 15, 0}, // Fly
+    [0x14] = {15, 0x00, 20, 0}, // Bind
+    [0x15] = {80, 0x00, 20, 0}, // Slam
+    [0x16] = {35, 0x16, 10, 0}, // Vine Whip
+    [0x17] = {65, 0x00, 20, 0}, // Stomp
+    [0x18] = {60, 0x01, 30, 0}, // Double Kick
+    [0x19] = {120, 0x00, 5, 0}, // Mega Kick
+    [0x1A] = {70, 0x01, 25, 0}, // Jump Kick
+    [0x1B] = {60, 0x01, 15, 0}, // Rolling Kick
+    [0x1D] = {70, 0x00, 15, 0}, // Headbutt
+    [0x1E] = {65, 0x00, 25, 0}, // Horn Attack
+    [0x1F] = {45, 0x00, 20, 0}, // Fury Attack
+    [0x21] = {35, 0x00, 35, 0}, // Tackle
+    [0x22] = {85, 0x00, 15, 0}, // Body Slam
+    [0x23] = {15, 0x00, 20, 0}, // Wrap
+    [0x24] = {90, 0x00, 20, 0}, // Take Down
+    [0x25] = {90, 0x00, 20, 0}, // Thrash
+    [0x26] = {100, 0x00, 15, 0}, // Double-Edge
+    [0x28] = {15, 0x03, 35, 0}, // Poison Sting
+    [0x29] = {50, 0x07, 20, 0}, // Twineedle
+    [0x2A] = {42, 0x07, 20, 0}, // Pin Missile
+    [0x2C] = {60, 0x00, 25, 0}, // Bite
+    [0x31] = {20, 0x00, 20, BATTLE_MOVE_FIXED}, // Sonicboom
+    [0x33] = {40, 0x03, 30, 0}, // Acid
+    [0x34] = {40, 0x14, 25, 0}, // Ember
+    [0x35] = {95, 0x14, 15, 0}, // Flamethrower
+    [0x37] = {40, 0x15, 25, 0}, // Water Gun
+    [0x38] = {120, 0x15, 5, 0}, // Hydro Pump
+    [0x39] = {95, 0x15, 15, 0}, // Surf
+    [0x3A] = {95, 0x19, 10, 0}, // Ice Beam
+    [0x3B] = {120, 0x19, 5, 0}, // Blizzard
+    [0x3C] = {65, 0x18, 20, 0}, // Psybeam
+    [0x3D] = {65, 0x15, 20, 0}, // Bubblebeam
+    [0x3E] = {65, 0x19, 20, 0}, // Aurora Beam
+    [0x3F] = {150, 0x00, 5, 0}, // Hyper Beam
+    [0x40] = {35, 0x02, 35, 0}, // Peck
+    [0x41] = {80, 0x02, 20, 0}, // Drill Peck
+    [0x42] = {80, 0x01, 25, 0}, // Submission
+    [0x43] = {50, 0x01, 20, 0}, // Low Kick
+    [0x45] = {0, 0x01, 20, BATTLE_MOVE_LEVEL}, // Seismic Toss
+    [0x46] = {80, 0x00, 15, 0}, // Strength
+    [0x47] = {20, 0x16, 20, 0}, // Absorb
+    [0x48] = {40, 0x16, 10, 0}, // Mega Drain
+    [0x4B] = {55, 0x16, 25, 0}, // Razor Leaf
+    [0x4C] = {60, 0x16, 10, 0}, // Solar Beam
+    [0x50] = {70, 0x16, 20, 0}, // Petal Dance
+    [0x52] = {40, 0x1A, 10, BATTLE_MOVE_FIXED}, // Dragon Rage
+    [0x53] = {15, 0x14, 15, 0}, // Fire Spin
+    [0x54] = {40, 0x17, 30, 0}, // Thundershock
+    [0x55] = {95, 0x17, 15, 0}, // Thunderbolt
+    [0x57] = {120, 0x17, 10, 0}, // Thunder
+    [0x58] = {50, 0x05, 15, 0}, // Rock Throw
+    [0x59] = {100, 0x04, 10, 0}, // Earthquake
+    [0x5B] = {50, 0x04, 10, 0}, // Dig
+    [0x5D] = {50, 0x18, 25, 0}, // Confusion
+    [0x5E] = {90, 0x18, 10, 0}, // Psychic
+    [0x62] = {40, 0x00, 30, 0}, // Quick Attack
+    [0x63] = {20, 0x00, 20, 0}, // Rage
+    [0x65] = {0, 0x08, 15, BATTLE_MOVE_LEVEL}, // Night Shade
+    [0x79] = {100, 0x00, 10, 0}, // Egg Bomb
+    [0x7A] = {20, 0x08, 30, 0}, // Lick
+    [0x7B] = {20, 0x03, 20, 0}, // Smog
+    [0x7C] = {65, 0x03, 20, 0}, // Sludge
+    [0x7D] = {65, 0x04, 20, 0}, // Bone Club
+    [0x7E] = {120, 0x14, 5, 0}, // Fire Blast
+    [0x7F] = {80, 0x15, 15, 0}, // Waterfall
+    [0x80] = {35, 0x15, 10, 0}, // Clamp
+    [0x81] = {60, 0x00, 20, 0}, // Swift
+    [0x82] = {50, 0x00, 15, 0}, // Skull Bash
+    [0x83] = {60, 0x00, 15, 0}, // Spike Cannon
+    [0x84] = {10, 0x00, 35, 0}, // Constrict
+    [0x88] = {85, 0x01, 20, 0}, // Hi Jump Kick
+    [0x8C] = {45, 0x00, 20, 0}, // Barrage
+    [0x8D] = {20, 0x07, 15, 0}, // Leech Life
+    [0x8F] = {70, 0x02, 5, 0}, // Sky Attack
+    [0x91] = {20, 0x15, 30, 0}, // Bubble
+    [0x92] = {70, 0x00, 10, 0}, // Dizzy Punch
+    [0x95] = {0, 0x18, 15, BATTLE_MOVE_LEVEL}, // Psywave
+    [0x98] = {90, 0x15, 10, 0}, // Crabhammer
+    [0x9A] = {54, 0x00, 15, 0}, // Fury Swipes
+    [0x9B] = {100, 0x04, 10, 0}, // Boomerang
+    [0x9D] = {75, 0x05, 10, 0}, // Rock Slide
+    [0x9E] = {80, 0x00, 15, 0}, // Hyper Fang
+    [0xA1] = {80, 0x00, 10, 0}, // Tri Attack
+    [0xA2] = {0, 0x00, 10, BATTLE_MOVE_HALF_HP}, // Super Fang
+    [0xA3] = {70, 0x00, 20, 0}, // Slash
+    [0xA5] = {50, 0x00, 10, 0}, // Struggle
+};
+
+const BattleMove battle_move_gen_ii[256] = {
+    [0x01] = {40, 0x00, 35, 0}, // Pound
+    [0x02] = {50, 0x01, 25, 0}, // Karate Chop
+    [0x03] = {45, 0x00, 10, 0}, // Doubleslap
+    [0x04] = {54, 0x00, 15, 0}, // Comet Punch
+    [0x05] = {80, 0x00, 20, 0}, // Mega Punch
+    [0x06] = {40, 0x00, 20, 0}, // Pay Day
+    [0x07] = {75, 0x14, 15, 0}, // Fire Punch
+    [0x08] = {75, 0x19, 15, 0}, // Ice Punch
+    [0x09] = {75, 0x17, 15, 0}, // Thunderpunch
+    [0x0A] = {40, 0x00, 35, 0}, // Scratch
+    [0x0B] = {55, 0x00, 30, 0}, // Vicegrip
+    [0x0D] = {40, 0x00, 10, 0}, // Razor Wind
+    [0x0F] = {50, 0x00, 30, 0}, // Cut
+    [0x10] = {40, 0x02, 35, 0}, // Gust
+    [0x11] = {60, 0x02, 35, 0}, // Wing Attack
+    [0x13] = {35, 0x02, 15, 0}, // Fly
+    [0x14] = {15, 0x00, 20, 0}, // Bind
+    [0x15] = {80, 0x00, 20, 0}, // Slam
+    [0x16] = {35, 0x16, 10, 0}, // Vine Whip
+    [0x17] = {65, 0x00, 20, 0}, // Stomp
+    [0x18] = {60, 0x01, 30, 0}, // Double Kick
+    [0x19] = {120, 0x00, 5, 0}, // Mega Kick
+    [0x1A] = {70, 0x01, 25, 0}, // Jump Kick
+    [0x1B] = {60, 0x01, 15, 0}, // Rolling Kick
+    [0x1D] = {70, 0x00, 15, 0}, // Headbutt
+    [0x1E] = {65, 0x00, 25, 0}, // Horn Attack
+    [0x1F] = {45, 0x00, 20, 0}, // Fury Attack
+    [0x21] = {35, 0x00, 35, 0}, // Tackle
+    [0x22] = {85, 0x00, 15, 0}, // Body Slam
+    [0x23] = {15, 0x00, 20, 0}, // Wrap
+    [0x24] = {90, 0x00, 20, 0}, // Take Down
+    [0x25] = {90, 0x00, 20, 0}, // Thrash
+    [0x26] = {120, 0x00, 15, 0}, // Double-Edge
+    [0x28] = {15, 0x03, 35, 0}, // Poison Sting
+    [0x29] = {50, 0x07, 20, 0}, // Twineedle
+    [0x2A] = {42, 0x07, 20, 0}, // Pin Missile
+    [0x2C] = {60, 0x1B, 25, 0}, // Bite
+    [0x31] = {20, 0x00, 20, BATTLE_MOVE_FIXED}, // Sonicboom
+    [0x33] = {40, 0x03, 30, 0}, // Acid
+    [0x34] = {40, 0x14, 25, 0}, // Ember
+    [0x35] = {95, 0x14, 15, 0}, // Flamethrower
+    [0x37] = {40, 0x15, 25, 0}, // Water Gun
+    [0x38] = {120, 0x15, 5, 0}, // Hydro Pump
+    [0x39] = {95, 0x15, 15, 0}, // Surf
+    [0x3A] = {95, 0x19, 10, 0}, // Ice Beam
+    [0x3B] = {120, 0x19, 5, 0}, // Blizzard
+    [0x3C] = {65, 0x18, 20, 0}, // Psybeam
+    [0x3D] = {65, 0x15, 20, 0}, // Bubblebeam
+    [0x3E] = {65, 0x19, 20, 0}, // Aurora Beam
+    [0x3F] = {150, 0x00, 5, 0}, // Hyper Beam
+    [0x40] = {35, 0x02, 35, 0}, // Peck
+    [0x41] = {80, 0x02, 20, 0}, // Drill Peck
+    [0x42] = {80, 0x01, 25, 0}, // Submission
+    [0x43] = {50, 0x01, 20, 0}, // Low Kick
+    [0x45] = {0, 0x01, 20, BATTLE_MOVE_LEVEL}, // Seismic Toss
+    [0x46] = {80, 0x00, 15, 0}, // Strength
+    [0x47] = {20, 0x16, 20, 0}, // Absorb
+    [0x48] = {40, 0x16, 10, 0}, // Mega Drain
+    [0x4B] = {55, 0x16, 25, 0}, // Razor Leaf
+    [0x4C] = {60, 0x16, 10, 0}, // Solar Beam
+    [0x50] = {70, 0x16, 20, 0}, // Petal Dance
+    [0x52] = {40, 0x1A, 10, BATTLE_MOVE_FIXED}, // Dragon Rage
+    [0x53] = {15, 0x14, 15, 0}, // Fire Spin
+    [0x54] = {40, 0x17, 30, 0}, // Thundershock
+    [0x55] = {95, 0x17, 15, 0}, // Thunderbolt
+    [0x57] = {120, 0x17, 10, 0}, // Thunder
+    [0x58] = {50, 0x05, 15, 0}, // Rock Throw
+    [0x59] = {100, 0x04, 10, 0}, // Earthquake
+    [0x5B] = {30, 0x04, 10, 0}, // Dig
+    [0x5D] = {50, 0x18, 25, 0}, // Confusion
+    [0x5E] = {90, 0x18, 10, 0}, // Psychic
+    [0x62] = {40, 0x00, 30, 0}, // Quick Attack
+    [0x63] = {20, 0x00, 20, 0}, // Rage
+    [0x65] = {0, 0x08, 15, BATTLE_MOVE_LEVEL}, // Night Shade
+    [0x79] = {100, 0x00, 10, 0}, // Egg Bomb
+    [0x7A] = {20, 0x08, 30, 0}, // Lick
+    [0x7B] = {20, 0x03, 20, 0}, // Smog
+    [0x7C] = {65, 0x03, 20, 0}, // Sludge
+    [0x7D] = {65, 0x04, 20, 0}, // Bone Club
+    [0x7E] = {120, 0x14, 5, 0}, // Fire Blast
+    [0x7F] = {80, 0x15, 15, 0}, // Waterfall
+    [0x80] = {35, 0x15, 10, 0}, // Clamp
+    [0x81] = {60, 0x00, 20, 0}, // Swift
+    [0x82] = {50, 0x00, 15, 0}, // Skull Bash
+    [0x83] = {60, 0x00, 15, 0}, // Spike Cannon
+    [0x84] = {10, 0x00, 35, 0}, // Constrict
+    [0x88] = {85, 0x01, 20, 0}, // Hi Jump Kick
+    [0x8C] = {45, 0x00, 20, 0}, // Barrage
+    [0x8D] = {20, 0x07, 15, 0}, // Leech Life
+    [0x8F] = {70, 0x02, 5, 0}, // Sky Attack
+    [0x91] = {20, 0x15, 30, 0}, // Bubble
+    [0x92] = {70, 0x00, 10, 0}, // Dizzy Punch
+    [0x95] = {0, 0x18, 15, BATTLE_MOVE_LEVEL}, // Psywave
+    [0x98] = {90, 0x15, 10, 0}, // Crabhammer
+    [0x9A] = {54, 0x00, 15, 0}, // Fury Swipes
+    [0x9B] = {100, 0x04, 10, 0}, // Boomerang
+    [0x9D] = {75, 0x05, 10, 0}, // Rock Slide
+    [0x9E] = {80, 0x00, 15, 0}, // Hyper Fang
+    [0xA1] = {80, 0x00, 10, 0}, // Tri Attack
+    [0xA2] = {0, 0x00, 10, BATTLE_MOVE_HALF_HP}, // Super Fang
+    [0xA3] = {70, 0x00, 20, 0}, // Slash
+    [0xA5] = {50, 0x00, 10, 0}, // Struggle
+    [0xA7] = {60, 0x01, 10, 0}, // Triple Kick
+    [0xA8] = {40, 0x1B, 10, 0}, // Thief
+    [0xAC] = {60, 0x14, 25, 0}, // Flame Wheel
+    [0xAF] = {40, 0x00, 15, 0}, // Flail
+    [0xB1] = {100, 0x02, 5, 0}, // Aeroblast
+    [0xB3] = {40, 0x01, 15, 0}, // Reversal
+    [0xB5] = {40, 0x19, 25, 0}, // Powder Snow
+    [0xB7] = {40, 0x01, 30, 0}, // Mach Punch
+    [0xB9] = {60, 0x1B, 20, 0}, // Feint Attack
+    [0xBC] = {90, 0x03, 10, 0}, // Sludge Bomb
+    [0xBD] = {20, 0x04, 10, 0}, // Mud-Slap
+    [0xBE] = {65, 0x15, 10, 0}, // Octazooka
+    [0xC0] = {100, 0x17, 5, 0}, // Zap Cannon
+    [0xC4] = {55, 0x19, 15, 0}, // Icy Wind
+    [0xC6] = {75, 0x04, 10, 0}, // Bone Rush
+    [0xC8] = {90, 0x1A, 15, 0}, // Outrage
+    [0xCA] = {60, 0x16, 5, 0}, // Giga Drain
+    [0xCD] = {30, 0x05, 20, 0}, // Rollout
+    [0xCE] = {40, 0x00, 40, 0}, // False Swipe
+    [0xD1] = {65, 0x17, 20, 0}, // Spark
+    [0xD2] = {10, 0x07, 20, 0}, // Fury Cutter
+    [0xD3] = {70, 0x09, 25, 0}, // Steel Wing
+    [0xD8] = {70, 0x00, 20, 0}, // Return
+    [0xD9] = {50, 0x00, 15, 0}, // Present
+    [0xDA] = {70, 0x00, 20, 0}, // Frustration
+    [0xDD] = {100, 0x14, 5, 0}, // Sacred Fire
+    [0xDE] = {70, 0x04, 30, 0}, // Magnitude
+    [0xDF] = {100, 0x01, 5, 0}, // Dynamic Punch
+    [0xE0] = {120, 0x07, 10, 0}, // Megahorn
+    [0xE1] = {60, 0x1A, 20, 0}, // Dragon Breath
+    [0xE4] = {40, 0x1B, 20, 0}, // Pursuit
+    [0xE5] = {20, 0x00, 40, 0}, // Rapid Spin
+    [0xE7] = {100, 0x09, 15, 0}, // Iron Tail
+    [0xE8] = {50, 0x09, 35, 0}, // Metal Claw
+    [0xE9] = {70, 0x01, 10, 0}, // Vital Throw
+    [0xED] = {70, 0x00, 15, 0}, // Hidden Power
+    [0xEE] = {100, 0x01, 5, 0}, // Cross Chop
+    [0xEF] = {40, 0x1A, 20, 0}, // Twister
+    [0xF2] = {80, 0x1B, 15, 0}, // Crunch
+    [0xF5] = {80, 0x00, 5, 0}, // Extreme Speed
+    [0xF6] = {60, 0x05, 5, 0}, // Ancient Power
+    [0xF7] = {80, 0x08, 15, 0}, // Shadow Ball
+    [0xF9] = {20, 0x01, 15, 0}, // Rock Smash
+    [0xFA] = {15, 0x15, 15, 0}, // Whirlpool
+    [0xFB] = {10, 0x1B, 10, 0}, // Beat Up
+};
+
+const uint8_t battle_type_eff_gen_i[BATTLE_TYPE_CNT][BATTLE_TYPE_CNT] = {
+    /* Normal */
+    {2, 2, 2, 2, 2, 1, 2, 2, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Fighting */
+    {4, 2, 1, 1, 2, 4, 2, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 4, 2, 2},
+    /* Flying */
+    {2, 4, 2, 2, 2, 1, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 1, 2, 2, 2, 2},
+    /* Poison */
+    {2, 2, 2, 1, 1, 1, 2, 4, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 2},
+    /* Ground */
+    {2, 2, 0, 4, 2, 4, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 1, 4, 2, 2, 2, 2},
+    /* Rock */
+    {2, 1, 4, 2, 1, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 4, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Bug */
+    {2, 1, 1, 4, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 4, 2, 4, 2, 2, 2},
+    /* Ghost */
+    {0, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Fire */
+    {2, 2, 2, 2, 2, 1, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 4, 2, 2, 4, 1, 2},
+    /* Water */
+    {2, 2, 2, 2, 4, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 1, 1, 2, 2, 2, 1, 2},
+    /* Grass */
+    {2, 2, 1, 1, 4, 4, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 4, 1, 2, 2, 2, 1, 2},
+    /* Electric */
+    {2, 2, 4, 2, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 1, 1, 2, 2, 1, 2},
+    /* Psychic */
+    {2, 4, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2},
+    /* Ice */
+    {2, 2, 4, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 4, 2, 2, 1, 4, 2},
+    /* Dragon */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+};
+
+const uint8_t battle_type_eff_gen_ii[BATTLE_TYPE_CNT][BATTLE_TYPE_CNT] = {
+    /* Normal */
+    {2, 2, 2, 2, 2, 1, 2, 2, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Fighting */
+    {4, 2, 1, 1, 2, 4, 2, 1, 0, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 4, 2, 4},
+    /* Flying */
+    {2, 4, 2, 2, 2, 1, 2, 4, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 1, 2, 2, 2, 2},
+    /* Poison */
+    {2, 2, 2, 1, 1, 1, 2, 2, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 2},
+    /* Ground */
+    {2, 2, 0, 4, 2, 4, 2, 1, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 1, 4, 2, 2, 2, 2},
+    /* Rock */
+    {2, 1, 4, 2, 1, 2, 2, 4, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 4, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Bug */
+    {2, 1, 1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 4, 2, 4, 2, 2, 4},
+    /* Ghost */
+    {0, 2, 2, 2, 2, 2, 2, 2, 4, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 1},
+    /* Steel */
+    {2, 2, 2, 2, 2, 4, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 2, 1, 2, 4, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Unused */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    /* Fire */
+    {2, 2, 2, 2, 2, 1, 2, 4, 2, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 4, 2, 2, 4, 1, 2},
+    /* Water */
+    {2, 2, 2, 2, 4, 4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 1, 1, 2, 2, 2, 1, 2},
+    /* Grass */
+    {2, 2, 1, 1, 4, 4, 2, 1, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 4, 1, 2, 2, 2, 1, 2},
+    /* Electric */
+    {2, 2, 4, 2, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 1, 1, 2, 2, 1, 2},
+    /* Psychic */
+    {2, 4, 2, 4, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 2, 0},
+    /* Ice */
+    {2, 2, 4, 2, 4, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 4, 2, 2, 1, 4, 2},
+    /* Dragon */
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2},
+    /* Dark */
+    {2, 1, 2, 2, 2, 2, 2, 2, 4, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 1},
+};
+
+const uint8_t battle_species_type_gen_ii[BATTLE_SPECIES_CNT][2] = {
+    {0x16, 0x03}, // Bulbasaur
+    {0x16, 0x03}, // Ivysaur
+    {0x16, 0x03}, // Venusaur
+    {0x14, 0x14}, // Charmander
+    {0x14, 0x14}, // Charmeleon
+    {0x14, 0x02}, // Charizard
+    {0x15, 0x15}, // Squirtle
+    {0x15, 0x15}, // Wartortle
+    {0x15, 0x15}, // Blastoise
+    {0x07, 0x07}, // Caterpie
+    {0x07, 0x07}, // Metapod
+    {0x07, 0x02}, // Butterfree
+    {0x07, 0x03}, // Weedle
+    {0x07, 0x03}, // Kakuna
+    {0x07, 0x03}, // Beedrill
+    {0x00, 0x02}, // Pidgey
+    {0x00, 0x02}, // Pidgeotto
+    {0x00, 0x02}, // Pidgeot
+    {0x00, 0x00}, // Rattata
+    {0x00, 0x00}, // Raticate
+    {0x00, 0x02}, // Spearow
+    {0x00, 0x02}, // Fearow
+    {0x03, 0x03}, // Ekans
+    {0x03, 0x03}, // Arbok
+    {0x17, 0x17}, // Pikachu
+    {0x17, 0x17}, // Raichu
+    {0x04, 0x04}, // Sandshrew
+    {0x04, 0x04}, // Sandslash
+    {0x03, 0x03}, // Nidoran\200
+    {0x03, 0x03}, // Nidorina
+    {0x03, 0x04}, // Nidoqueen
+    {0x03, 0x03}, // Nidoran\201
+    {0x03, 0x03}, // Nidorino
+    {0x03, 0x04}, // Nidoking
+    {0x00, 0x00}, // Clefairy
+    {0x00, 0x00}, // Clefable
+    {0x14, 0x14}, // Vulpix
+    {0x14, 0x14}, // Ninetales
+    {0x00, 0x00}, // Jigglypuff
+    {0x00, 0x00}, // Wigglytuff
+    {0x03, 0x02}, // Zubat
+    {0x03, 0x02}, // Golbat
+    {0x16, 0x03}, // Oddish
+    {0x16, 0x03}, // Gloom
+    {0x16, 0x03}, // Vileplume
+    {0x07, 0x16}, // Paras
+    {0x07, 0x16}, // Parasect
+    {0x07, 0x03}, // Venonat
+    {0x07, 0x03}, // Venomoth
+    {0x04, 0x04}, // Diglett
+    {0x04, 0x04}, // Dugtrio
+    {0x00, 0x00}, // Meowth
+    {0x00, 0x00}, // Persian
+    {0x15, 0x15}, // Psyduck
+    {0x15, 0x15}, // Golduck
+    {0x01, 0x01}, // Mankey
+    {0x01, 0x01}, // Primeape
+    {0x14, 0x14}, // Growlithe
+    {0x14, 0x14}, // Arcanine
+    {0x15, 0x15}, // Poliwag
+    {0x15, 0x15}, // Poliwhirl
+    {0x15, 0x01}, // Poliwrath
+    {0x18, 0x18}, // Abra
+    {0x18, 0x18}, // Kadabra
+    {0x18, 0x18}, // Alakazam
+    {0x01, 0x01}, // Machop
+    {0x01, 0x01}, // Machoke
+    {0x01, 0x01}, // Machamp
+    {0x16, 0x03}, // Bellsprout
+    {0x16, 0x03}, // Weepinbell
+    {0x16, 0x03}, // Victreebel
+    {0x15, 0x03}, // Tentacool
+    {0x15, 0x03}, // Tentacruel
+    {0x05, 0x04}, // Geodude
+    {0x05, 0x04}, // Graveler
+    {0x05, 0x04}, // Golem
+    {0x14, 0x14}, // Ponyta
+    {0x14, 0x14}, // Rapidash
+    {0x15, 0x18}, // Slowpoke
+    {0x15, 0x18}, // Slowbro
+    {0x17, 0x09}, // Magnemite
+    {0x17, 0x09}, // Magneton
+    {0x00, 0x02}, // Farfetch'd
+    {0x00, 0x02}, // Doduo
+    {0x00, 0x02}, // Dodrio
+    {0x15, 0x15}, // Seel
+    {0x15, 0x19}, // Dewgong
+    {0x03, 0x03}, // Grimer
+    {0x03, 0x03}, // Muk
+    {0x15, 0x15}, // Shellder
+    {0x15, 0x19}, // Cloyster
+    {0x08, 0x03}, // Gastly
+    {0x08, 0x03}, // Haunter
+    {0x08, 0x03}, // Gengar
+    {0x05, 0x04}, // Onix
+    {0x18, 0x18}, // Drowzee
+    {0x18, 0x18}, // Hypno
+    {0x15, 0x15}, // Krabby
+    {0x15, 0x15}, // Kingler
+    {0x17, 0x17}, // Voltorb
+    {0x17, 0x17}, // Electrode
+    {0x16, 0x18}, // Exeggcute
+    {0x16, 0x18}, // Exeggutor
+    {0x04, 0x04}, // Cubone
+    {0x04, 0x04}, // Marowak
+    {0x01, 0x01}, // Hitmonlee
+    {0x01, 0x01}, // Hitmonchan
+    {0x00, 0x00}, // Lickitung
+    {0x03, 0x03}, // Koffing
+    {0x03, 0x03}, // Weezing
+    {0x04, 0x05}, // Rhyhorn
+    {0x04, 0x05}, // Rhydon
+    {0x00, 0x00}, // Chansey
+    {0x16, 0x16}, // Tangela
+    {0x00, 0x00}, // Kangaskhan
+    {0x15, 0x15}, // Horsea
+    {0x15, 0x15}, // Seadra
+    {0x15, 0x15}, // Goldeen
+    {0x15, 0x15}, // Seaking
+    {0x15, 0x15}, // Staryu
+    {0x15, 0x18}, // Starmie
+    {0x18, 0x18}, // Mr.Mime
+    {0x07, 0x02}, // Scyther
+    {0x19, 0x18}, // Jynx
+    {0x17, 0x17}, // Electabuzz
+    {0x14, 0x14}, // Magmar
+    {0x07, 0x07}, // Pinsir
+    {0x00, 0x00}, // Tauros
+    {0x15, 0x15}, // Magikarp
+    {0x15, 0x02}, // Gyarados
+    {0x15, 0x19}, // Lapras
+    {0x00, 0x00}, // Ditto
+    {0x00, 0x00}, // Eevee
+    {0x15, 0x15}, // Vaporeon
+    {0x17, 0x17}, // Jolteon
+    {0x14, 0x14}, // Flareon
+    {0x00, 0x00}, // Porygon
+    {0x05, 0x15}, // Omanyte
+    {0x05, 0x15}, // Omastar
+    {0x05, 0x15}, // Kabuto
+    {0x05, 0x15}, // Kabutops
+    {0x05, 0x02}, // Aerodactyl
+    {0x00, 0x00}, // Snorlax
+    {0x19, 0x02}, // Articuno
+    {0x17, 0x02}, // Zapdos
+    {0x14, 0x02}, // Moltres
+    {0x1A, 0x1A}, // Dratini
+    {0x1A, 0x1A}, // Dragonair
+    {0x1A, 0x02}, // Dragonite
+    {0x18, 0x18}, // Mewtwo
+    {0x18, 0x18}, // Mew
+    {0x16, 0x16}, // Chikorita
+    {0x16, 0x16}, // Bayleef
+    {0x16, 0x16}, // Meganium
+    {0x14, 0x14}, // Cyndaquil
+    {0x14, 0x14}, // Quilava
+    {0x14, 0x14}, // Typhlosion
+    {0x15, 0x15}, // Totodile
+    {0x15, 0x15}, // Croconaw
+    {0x15, 0x15}, // Feraligatr
+    {0x00, 0x00}, // Sentret
+    {0x00, 0x00}, // Furret
+    {0x00, 0x02}, // Hoothoot
+    {0x00, 0x02}, // Noctowl
+    {0x07, 0x02}, // Ledyba
+    {0x07, 0x02}, // Ledian
+    {0x07, 0x03}, // Spinarak
+    {0x07, 0x03}, // Ariados
+    {0x03, 0x02}, // Crobat
+    {0x15, 0x17}, // Chinchou
+    {0x15, 0x17}, // Lanturn
+    {0x17, 0x17}, // Pichu
+    {0x00, 0x00}, // Cleffa
+    {0x00, 0x00}, // Igglybuff
+    {0x00, 0x00}, // Togepi
+    {0x00, 0x02}, // Togetic
+    {0x18, 0x02}, // Natu
+    {0x18, 0x02}, // Xatu
+    {0x17, 0x17}, // Mareep
+    {0x17, 0x17}, // Flaaffy
+    {0x17, 0x17}, // Ampharos
+    {0x16, 0x16}, // Bellossom
+    {0x15, 0x15}, // Marill
+    {0x15, 0x15}, // Azumarill
+    {0x05, 0x05}, // Sudowoodo
+    {0x15, 0x15}, // Politoed
+    {0x16, 0x02}, // Hoppip
+    {0x16, 0x02}, // Skiploom
+    {0x16, 0x02}, // Jumpluff
+    {0x00, 0x00}, // Aipom
+    {0x16, 0x16}, // Sunkern
+    {0x16, 0x16}, // Sunflora
+    {0x07, 0x02}, // Yanma
+    {0x15, 0x04}, // Wooper
+    {0x15, 0x04}, // Quagsire
+    {0x18, 0x18}, // Espeon
+    {0x1B, 0x1B}, // Umbreon
+    {0x1B, 0x02}, // Murkrow
+    {0x15, 0x18}, // Slowking
+    {0x08, 0x08}, // Misdreavus
+    {0x18, 0x18}, // Unown
+    {0x18, 0x18}, // Wobbuffet
+    {0x00, 0x18}, // Girafarig
+    {0x07, 0x07}, // Pineco
+    {0x07, 0x09}, // Forretress
+    {0x00, 0x00}, // Dunsparce
+    {0x04, 0x02}, // Gligar
+    {0x09, 0x04}, // Steelix
+    {0x00, 0x00}, // Snubbull
+    {0x00, 0x00}, // Granbull
+    {0x15, 0x03}, // Qwilfish
+    {0x07, 0x09}, // Scizor
+    {0x07, 0x05}, // Shuckle
+    {0x07, 0x01}, // Heracross
+    {0x1B, 0x19}, // Sneasel
+    {0x00, 0x00}, // Teddiursa
+    {0x00, 0x00}, // Ursaring
+    {0x14, 0x14}, // Slugma
+    {0x14, 0x05}, // Magcargo
+    {0x19, 0x04}, // Swinub
+    {0x19, 0x04}, // Piloswine
+    {0x15, 0x05}, // Corsola
+    {0x15, 0x15}, // Remoraid
+    {0x15, 0x15}, // Octillery
+    {0x19, 0x02}, // Delibird
+    {0x15, 0x02}, // Mantine
+    {0x09, 0x02}, // Skarmory
+    {0x1B, 0x14}, // Houndour
+    {0x1B, 0x14}, // Houndoom
+    {0x15, 0x1A}, // Kingdra
+    {0x04, 0x04}, // Phanpy
+    {0x04, 0x04}, // Donphan
+    {0x00, 0x00}, // Porygon2
+    {0x00, 0x00}, // Stantler
+    {0x00, 0x00}, // Smeargle
+    {0x01, 0x01}, // Tyrogue
+    {0x01, 0x01}, // Hitmontop
+    {0x19, 0x18}, // Smoochum
+    {0x17, 0x17}, // Elekid
+    {0x14, 0x14}, // Magby
+    {0x00, 0x00}, // Miltank
+    {0x00, 0x00}, // Blissey
+    {0x17, 0x17}, // Raikou
+    {0x14, 0x14}, // Entei
+    {0x15, 0x15}, // Suicune
+    {0x05, 0x04}, // Larvitar
+    {0x05, 0x04}, // Pupitar
+    {0x05, 0x1B}, // Tyranitar
+    {0x18, 0x02}, // Lugia
+    {0x14, 0x02}, // Ho-Oh
+    {0x18, 0x16}, // Celebi
+};
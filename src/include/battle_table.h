@@ -0,0 +1,65 @@
+#ifndef BATTLE_TABLE_H
+#define BATTLE_TABLE_H
+
+#pragma once
+
+#include <stdint.h>
+
+#include <src/include/pokemon_data.h>
+
+/* Flash resident data for estimating damage in a colosseum battle. The
+ * tables are generated by tools/battle_table_gen.py, which must be re-run any
+ * time move_list or type_list change.
+ */
+
+/* Type indices go up to Dark, 0x1B */
+#define BATTLE_TYPE_CNT 0x1C
+#define BATTLE_TYPE_STEEL 0x09
+#define BATTLE_TYPE_DARK 0x1B
+/* Fire and every type after it use the special stats, the rest physical */
+#define BATTLE_TYPE_SPECIAL 0x14
+
+/* Number of species Gen II has */
+#define BATTLE_SPECIES_CNT 251
+
+/* Damage is the user's level, e.g. Seismic Toss */
+#define BATTLE_MOVE_LEVEL 0x01
+/* Damage is power, e.g. Dragon Rage */
+#define BATTLE_MOVE_FIXED 0x02
+/* Damage is half of the target's HP, e.g. Super Fang */
+#define BATTLE_MOVE_HALF_HP 0x04
+
+struct __attribute__((__packed__)) battle_move {
+    /* Power per turn, with the average number of hits of a multi hit move
+     * folded in and a charging move halved. 0 for a move that the battle
+     * model does not count any damage for.
+     */
+    uint8_t power;
+    uint8_t type;
+    /* Without any PP Ups */
+    uint8_t pp;
+    uint8_t flags;
+};
+typedef struct battle_move BattleMove;
+
+extern const BattleMove battle_move_gen_i[256];
+extern const BattleMove battle_move_gen_ii[256];
+/* Indexed by [attacker][defender], in halves: 0, 1, 2 for neutral, or 4 */
+extern const uint8_t battle_type_eff_gen_i[BATTLE_TYPE_CNT][BATTLE_TYPE_CNT];
+extern const uint8_t battle_type_eff_gen_ii[BATTLE_TYPE_CNT][BATTLE_TYPE_CNT];
+/* Types of each species, by 0 indexed pokedex number. Gen II party members
+ * do not carry their types like Gen I ones do.
+ */
+extern const uint8_t battle_species_type_gen_ii[BATTLE_SPECIES_CNT][2];
+
+static inline const BattleMove* battle_move_get(uint8_t gen, uint8_t move) {
+    return (gen == GEN_I) ? &battle_move_gen_i[move] : &battle_move_gen_ii[move];
+}
+
+/* Effectiveness of atk against def, in halves. An unknown type is neutral. */
+static inline uint8_t battle_type_eff_get(uint8_t gen, uint8_t atk, uint8_t def) {
+    if(atk >= BATTLE_TYPE_CNT || def >= BATTLE_TYPE_CNT) return 2;
+    return (gen == GEN_I) ? battle_type_eff_gen_i[atk][def] : battle_type_eff_gen_ii[atk][def];
+}
+
+#endif /* BATTLE_TABLE_H */
@@ -3,6 +3,6 @@
 
 #pragma once
 
-extern const NamedList item_list[];
+extern const NamedList item_list;
 
 #endif // ITEM_NL_H
@@ -3,6 +3,6 @@
 
 #pragma once
 
-extern const NamedList move_list[];
+extern const NamedList move_list;
 
 #endif // MOVE_NL_H
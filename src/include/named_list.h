@@ -6,17 +6,36 @@
 #include <stddef.h>
 #include <stdint.h>
 
-struct __attribute__((__packed__)) named_list {
+/* Number of generations a list can be filtered by, one per bit of gen */
+#define NAMEDLIST_GEN_CNT 2
+
+struct __attribute__((__packed__)) named_list_item {
     const char* name;
     const uint8_t index;
     const uint8_t gen; // Bitfield of compatible generations
 };
 
-typedef struct named_list NamedList;
+typedef struct named_list_item NamedListItem;
 
-/* Get number of elements in a list
- * This is not very efficient as-is since it has to walk the whole list.
+/* A list of items, and lookup tables for it. The tables are generated from
+ * the items by tools/named_list_gen.py, which must be re-run any time the
+ * items of a list change.
  */
+struct named_list {
+    const NamedListItem* items;
+    size_t cnt;
+    /* List position of the first item with each index, 0 if none match */
+    const uint8_t* index_pos;
+    /* List positions of the items compatible with each generation, in list
+     * order. Generation bit n is in element n.
+     */
+    const uint8_t* gen_pos[NAMEDLIST_GEN_CNT];
+    size_t gen_cnt[NAMEDLIST_GEN_CNT];
+};
+
+typedef struct named_list NamedList;
+
+/* Get number of elements in a list */
 size_t namedlist_cnt(const NamedList* list);
 
 /* Returns the generation mask of the requested item in the list */
@@ -40,7 +59,15 @@ uint32_t namedlist_index_get(const NamedList* list, uint32_t pos);
 /* Get a pointer to the item's name from an item's index */
 const char* namedlist_name_get_index(const NamedList* list, uint32_t index);
 
-/* Get a pointer to the item's name from a position */
+/* Get a pointer to the item's name from a position. Returns NULL for the
+ * position one past the last item.
+ */
 const char* namedlist_name_get_pos(const NamedList* list, uint32_t pos);
 
+/* Number of items compatible with gen, and the list position of the nth of
+ * them. gen is a single generation, e.g. GEN_I.
+ */
+size_t namedlist_gen_cnt(const NamedList* list, uint8_t gen);
+uint32_t namedlist_gen_pos_get(const NamedList* list, uint8_t gen, size_t n);
+
 #endif //NAMED_LIST_H
@@ -7,6 +7,17 @@
 #include <src/include/pokemon_app.h>
 #include <src/include/pokemon_data.h>
 
+#define SERIAL_NO_DATA_BYTE 0xFE
+#define SERIAL_PATCH_LIST_PART_TERMINATOR 0xFF
+#define SERIAL_MAIL_PREAMBLE_BYTE 0x20
+#define SERIAL_MAIL_REPLACEMENT_BYTE 0x21
+
+/* Max number of entries in a patch list. The largest party is Gen II, at
+ * 6x 48 byte party members, 288 bytes, every one of which could need a patch.
+ * Then there are two part terminators on top of that.
+ */
+#define PLIST_MAX_SZ (LEN_PARTY_MAX + 2)
+
 struct patch_list;
 
 struct patch_list* plist_alloc(void);
@@ -17,6 +28,16 @@ void plist_free(struct patch_list* plist);
 
 uint8_t plist_index_get(struct patch_list* plist, int offset);
 
-void plist_create(struct patch_list** pplist, PokemonData* pdata);
+/* Fully resync the patch list with every byte of the party in pdata */
+void plist_create(struct patch_list* plist, PokemonData* pdata);
+
+/* Only recheck the party bytes that pdata has marked as dirty since the last
+ * update, regenerating the list if needed. Returns true if the set of
+ * patched bytes changed. Must not be called from an ISR.
+ *
+ * The live party data is never modified, the 0xFE -> 0xFF substitution is
+ * the responsibility of whatever is transmitting the party.
+ */
+bool plist_update(struct patch_list* plist, PokemonData* pdata);
 
 #endif /* TRADE_PATCH_LIST_H */
@@ -14,6 +14,7 @@
 #include <gblink.h>
 
 #include <src/include/pokemon_data.h>
+#include <src/include/pokemon_box.h>
 
 #define TAG "Pokemon"
 
@@ -28,13 +29,12 @@ struct pokemon_fap {
     VariableItemList* variable_item_list;
     DialogEx* dialog_ex;
 
-    /* Struct for holding trade data */
-    /* NOTE: There may be some runtime memory savings by adding more intelligence
-     * to views/trade and slimming down this struct to only contain the single
-     * pokemon data rather than the full 6 member party data.
-     */
+    /* Struct for holding trade data, the full 6 member party */
     PokemonData* pdata;
 
+    /* Pokemon saved to the SD card, NULL if the box couldn't be opened */
+    struct pokemon_box* box;
+
     /* gblink interface */
     void *gblink_handle;
 };
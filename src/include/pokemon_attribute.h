@@ -29,26 +29,26 @@ typedef enum {
  *   male only pokemon need to be specifically checked for.
  */
 
-const char* pokemon_gender_is_static(PokemonData* pdata, uint8_t ratio);
+const char* pokemon_gender_is_static(PokemonData* pdata, uint8_t slot, uint8_t ratio);
 
 /* This will return a pointer to a string of the pokemon's current gender */
-const char* pokemon_gender_get(PokemonData* pdata);
+const char* pokemon_gender_get(PokemonData* pdata, uint8_t slot);
 
-void pokemon_gender_set(PokemonData* pdata, Gender gender);
+void pokemon_gender_set(PokemonData* pdata, uint8_t slot, Gender gender);
 
-const char* pokerus_get_status_str(PokemonData* pdata);
+const char* pokerus_get_status_str(PokemonData* pdata, uint8_t slot);
 
-void pokerus_set_strain(PokemonData* pdata, uint8_t strain);
+void pokerus_set_strain(PokemonData* pdata, uint8_t slot, uint8_t strain);
 
-void pokerus_set_days(PokemonData *pdata, uint8_t days);
+void pokerus_set_days(PokemonData* pdata, uint8_t slot, uint8_t days);
 
-bool pokemon_is_shiny(PokemonData* pdata);
+bool pokemon_is_shiny(PokemonData* pdata, uint8_t slot);
 
-void pokemon_set_shiny(PokemonData *pdata, bool shiny);
+void pokemon_set_shiny(PokemonData* pdata, uint8_t slot, bool shiny);
 
 /* Returns ascii char, or 0 if unown is not the current pokemon */
-char unown_form_get(PokemonData* pdata);
+char unown_form_get(PokemonData* pdata, uint8_t slot);
 
-void unown_form_set(PokemonData* pdata, char letter);
+void unown_form_set(PokemonData* pdata, uint8_t slot, char letter);
 
 #endif // POKEMON_ATTRIBUTE_H
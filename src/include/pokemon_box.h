@@ -0,0 +1,98 @@
+#ifndef POKEMON_BOX_H
+#define POKEMON_BOX_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_data.h>
+
+/* A box of Pokemon saved to the SD card.
+ *
+ * The box file is a struct pokemon_box_hdr followed by an append-only log of
+ * struct pokemon_box_rec. Saving a Pokemon appends one record. Deleting one
+ * appends a record that cancels the earlier one. A record is never changed
+ * once written, so saving during a trade costs a single write.
+ *
+ * When the box is opened, the log is read once from start to end to build an
+ * index in RAM of the Pokemon still in the box. Records that fail their CRC,
+ * such as one cut short by the Flipper losing power, are skipped.
+ *
+ * Deleted and damaged records take up space until the box is compacted, which
+ * copies only the Pokemon still in the box to a new log and replaces the old
+ * one with it. This happens when the box is opened or something is deleted,
+ * once enough of the log is dead. All values are little endian.
+ */
+
+#define POKEMON_BOX_PATH APP_DATA_PATH("box.pkbx")
+#define POKEMON_BOX_MAGIC "PKBX"
+#define POKEMON_BOX_VERSION 1
+
+/* Compact once at least this many records are dead, and more of the log is
+ * dead than alive.
+ */
+#define POKEMON_BOX_COMPACT_MIN 32
+
+struct pokemon_box_hdr {
+    char magic[4];
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t rec_sz;
+} __attribute__((packed));
+
+/* The gen of a record that deletes the earlier record with the same id */
+#define POKEMON_BOX_GEN_DELETE 0
+
+struct pokemon_box_rec {
+    /* Given to each Pokemon when it is saved, never reused */
+    uint32_t id;
+    /* RTC timestamp of when the record was written */
+    uint32_t timestamp;
+    /* The fields of a PokemonRaw, see pokemon_data.h */
+    uint8_t gen;
+    uint8_t species;
+    uint8_t member[LEN_PARTY_MEMBER_MAX];
+    uint8_t ot_name[LEN_NAME_BUF];
+    uint8_t nickname[LEN_NAME_BUF];
+    /* CRC-32 of everything above */
+    uint32_t crc;
+} __attribute__((packed));
+
+/* What the index holds for each Pokemon in the box, in the order saved */
+struct pokemon_box_entry {
+    uint32_t id;
+    /* Position of its record in the log */
+    uint32_t rec;
+    uint8_t gen;
+    uint8_t species;
+};
+
+struct pokemon_box;
+
+/* Open the box at path, creating it if it doesn't exist, and build the index.
+ * Returns NULL if the file can't be opened or isn't a box, in which case it is
+ * left untouched.
+ */
+struct pokemon_box* pokemon_box_open(Storage* storage, const char* path);
+
+void pokemon_box_close(struct pokemon_box* box);
+
+/* Number of Pokemon in the box */
+size_t pokemon_box_count(struct pokemon_box* box);
+
+/* Copy out the index entry for the idx'th Pokemon, oldest first */
+bool pokemon_box_entry_get(struct pokemon_box* box, size_t idx, struct pokemon_box_entry* entry);
+
+/* Append raw to the box, returns its id, or 0 if it could not be written */
+uint32_t pokemon_box_save(struct pokemon_box* box, const PokemonRaw* raw);
+
+bool pokemon_box_load(struct pokemon_box* box, size_t idx, PokemonRaw* raw);
+
+bool pokemon_box_delete(struct pokemon_box* box, size_t idx);
+
+/* Rewrite the log with only the Pokemon still in the box */
+bool pokemon_box_compact(struct pokemon_box* box);
+
+#endif /* POKEMON_BOX_H */
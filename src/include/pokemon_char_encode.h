@@ -2,12 +2,6 @@
 #define POKEMON_CHAR_ENCODE_H
 /* NOTE: These map to the Gen 1 character set! */
 /* NOTE: These map to English */
-/* TODO: It may make more sense to put this in a const array as a LUT,
- * e.g. t['F'], t['l'], t['i'], t['p'], t['e'], t['r'], t['\0']
- * As this could be an easier translation for each letter to build a string
- * to set names and things on the fly in the flipper. Need to explore that.
- * once I get to that point.
- */
 #define TERM_ 0x50
 #define SPACE_ 0x7f
 #define A_ 0x80
@@ -99,13 +93,45 @@
 #define _8_ 0xfe
 #define _9_ 0xff
 
+/* Glyphs with no ASCII equivalent are given these char values so that they
+ * survive a decode and encode. These don't render properly on the Flipper,
+ * they are only meant to round trip names received from a Game Boy.
+ */
+#define CHAR_FEMALE '\200'
+#define CHAR_MALE '\201'
+#define CHAR_PK '\202'
+#define CHAR_MN '\203'
+#define CHAR_e_ACCENT '\204'
+#define CHAR_d_TICK '\205'
+#define CHAR_l_TICK '\206'
+#define CHAR_s_TICK '\207'
+#define CHAR_t_TICK '\210'
+#define CHAR_v_TICK '\211'
+#define CHAR_r_TICK '\212'
+#define CHAR_m_TICK '\213'
+#define CHAR_R_ARR '\214'
+#define CHAR_D_ARR '\215'
+
 #include <stdint.h>
 #include <stddef.h>
 
+/* Characters with no encoding become TERM_, encoded bytes with no character
+ * become '\0'.
+ */
 char pokemon_char_to_encoded(int byte);
 int pokemon_encoded_to_char(char byte);
 
 void pokemon_str_to_encoded_array(uint8_t* dest, char* src, size_t n);
 void pokemon_encoded_array_to_str(char* dest, uint8_t* src, size_t n);
 
+/* Encode at most len characters of the NUL terminated src in to the n byte
+ * name buffer dest, the rest of dest is filled with TERM_.
+ */
+void pokemon_name_encode(uint8_t* dest, size_t n, const char* src, size_t len);
+
+/* Decode the name buffer src in to the n byte dest, stopping at the first
+ * TERM_ or after n - 1 characters. dest is always NUL terminated.
+ */
+void pokemon_name_decode(char* dest, size_t n, const uint8_t* src);
+
 #endif // POKEMON_CHAR_ENCODE_H
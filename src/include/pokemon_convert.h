@@ -0,0 +1,39 @@
+#ifndef POKEMON_CONVERT_H
+#define POKEMON_CONVERT_H
+
+#pragma once
+
+#include <stdint.h>
+
+#include <src/include/pokemon_data.h>
+
+/* Moves a Pokemon between Gen I and Gen II the way the Time Capsule does.
+ *
+ * Going up to Gen II, the species index is mapped to its pokedex number, the
+ * catch rate becomes the held item, with the same handful of exceptions the
+ * games make, and friendship starts at the base value. Going down to Gen I,
+ * the held item becomes the catch rate, and the types come from the species.
+ * Friendship, Pokerus, and caught data have nowhere to go and are lost. In
+ * both directions the stats are worked out again for the new generation, so
+ * Gen I SPC becomes Gen II SPC_ATK and SPC_DEF, and back.
+ *
+ * A Pokemon that Gen I has no room for is rejected: an egg, a species after
+ * Mew, or anything with a move or type that only exists in Gen II.
+ */
+
+typedef enum {
+    CONVERT_OK = 0,
+    /* gen is not GEN_I or GEN_II */
+    CONVERT_ERR_GEN,
+    /* Not a species of the source gen, or not one the target gen has */
+    CONVERT_ERR_SPECIES,
+    CONVERT_ERR_MOVE,
+    CONVERT_ERR_TYPE,
+} ConvertErr;
+
+/* Convert src to gen in to dst, which may be src. A Pokemon already of gen is
+ * copied as is. On error, dst is left alone.
+ */
+ConvertErr pokemon_convert(const PokemonRaw* src, uint8_t gen, PokemonRaw* dst);
+
+#endif /* POKEMON_CONVERT_H */
@@ -9,7 +9,6 @@
 #include <toolbox/stream/stream.h>
 #include <toolbox/stream/file_stream.h>
 
-#include <math.h>
 #include <stdint.h>
 
 #include <src/include/named_list.h>
@@ -28,11 +27,18 @@
 #define LEN_NUM_BUF 6
 #define LEN_LEVEL 4 // Max 3 digits
 #define LEN_OT_ID 6 // Max 5 digits
+#define LEN_PARTY_MAX 288 // 6x Gen II party members, 48 bytes each
+#define LEN_PARTY_MEMBER_MAX 48 // Gen II, Gen I is 44
+#define PARTY_CNT_MAX 6
+#define LEN_MAIL_MSG 33 // Max 32 chars
+#define LEN_MAIL_META 14 // Author name, nationality, ID, species, mail item
+#define LEN_MAIL_BLOCK (PARTY_CNT_MAX * (LEN_MAIL_MSG + LEN_MAIL_META))
 
 typedef struct pokemon_party_data_gen_i PokemonPartyGenI;
 typedef struct trade_block_gen_i TradeBlockGenI;
 typedef struct pokemon_party_data_gen_ii PokemonPartyGenII;
 typedef struct trade_block_gen_ii TradeBlockGenII;
+typedef struct mail_block_gen_ii MailBlockGenII;
 
 /* Based on the flipperzero-game-engine sprite structure */
 struct fxbm_sprite {
@@ -41,6 +47,37 @@ struct fxbm_sprite {
     uint8_t data[];
 };
 
+struct stat_field;
+struct sprite_cache;
+
+/* One party member and its names, exactly as they are laid out in the trade
+ * block of gen, for moving a whole Pokemon in or out of a PokemonData as is.
+ * Bytes of member past the size of gen's party member are 0.
+ */
+struct pokemon_raw {
+    uint8_t gen;
+    /* The party_members entry, only differs from the index in member for an
+     * egg in Gen II.
+     */
+    uint8_t species;
+    uint8_t member[LEN_PARTY_MEMBER_MAX];
+    uint8_t ot_name[LEN_NAME_BUF];
+    uint8_t nickname[LEN_NAME_BUF];
+};
+typedef struct pokemon_raw PokemonRaw;
+
+/* One party member's stats, EVs, and IVs as plain numbers, each array indexed
+ * from STAT to STAT_END. Fields that a generation does not have read as 0.
+ */
+struct stat_block {
+    uint16_t stat[STAT_END];
+    uint16_t ev[STAT_END];
+    uint8_t iv[STAT_END];
+    uint8_t level;
+    uint8_t num;
+};
+typedef struct stat_block StatBlock;
+
 struct pokemon_data {
     const NamedList* move_list;
     const NamedList* stat_list;
@@ -54,9 +91,18 @@ struct pokemon_data {
     /* Shortcut pointer to the actual party data in the trade block */
     void* party;
     size_t party_sz;
+    /* Gen II only, the mail of each party slot. NULL in Gen I */
+    MailBlockGenII* mail;
+    /* Bitmap of party bytes modified since they were last consumed by the
+     * trade patch list, one bit per byte.
+     */
+    uint8_t party_dirty[LEN_PARTY_MAX / 8];
+
+    /* Current EV/IV stat selection for each party slot */
+    EvIv stat_sel[PARTY_CNT_MAX];
 
-    /* Current EV/IV stat selection */
-    EvIv stat_sel;
+    /* Party slot currently selected for editing */
+    uint8_t party_sel;
 
     /* Current generation */
     uint8_t gen;
@@ -65,9 +111,12 @@ struct pokemon_data {
     uint8_t dex_max;
 
     /* These are private to pokemon_data */
+    const struct stat_field* stat_fields;
+    /* Recalculations waiting to be run, for each party slot */
+    uint8_t recalc_pending[PARTY_CNT_MAX];
     Storage* storage;
-    struct fxbm_sprite* bitmap;
-    uint8_t bitmap_num;
+    /* Allocated the first time a sprite is drawn */
+    struct sprite_cache* sprites;
     FuriString* asset_path;
 };
 typedef struct pokemon_data PokemonData;
@@ -75,18 +124,64 @@ typedef struct pokemon_data PokemonData;
 PokemonData* pokemon_data_alloc(uint8_t gen);
 void pokemon_data_free(PokemonData* pdata);
 
-uint8_t* pokemon_icon_get(PokemonData* pdata, int num);
-
-void pokemon_stat_memcpy(PokemonData* dst, PokemonData* src, uint8_t which);
-uint16_t pokemon_stat_get(PokemonData* pdata, DataStat stat, DataStatSub num);
-void pokemon_stat_set(PokemonData* pdata, DataStat stat, DataStatSub which, uint16_t val);
+/* Returns the sprite for pokedex number num, 1 indexed. If it can't be read
+ * from the SD card, a placeholder sprite is returned instead. The sprite
+ * remains valid until the next call.
+ */
+const struct fxbm_sprite* pokemon_icon_get(PokemonData* pdata, int num);
+/* Never waits on the SD card, returns the placeholder sprite if num isn't
+ * loaded yet. Loading of num and its neighbors in the direction of dir, -1 or
+ * 1, is started in the background. The callback set with
+ * pokemon_icon_callback_set() is run from another thread once num is ready.
+ */
+const struct fxbm_sprite* pokemon_icon_peek(PokemonData* pdata, int num, int dir);
+void pokemon_icon_callback_set(PokemonData* pdata, void (*callback)(void*), void* context);
+
+uint8_t pokemon_party_cnt_get(PokemonData* pdata);
+uint8_t pokemon_party_add(PokemonData* pdata);
+void pokemon_party_remove(PokemonData* pdata, uint8_t slot);
+void pokemon_party_dirty_mark(PokemonData* pdata, size_t offs, size_t len);
+void pokemon_stat_memcpy(PokemonData* dst, uint8_t dst_slot, PokemonData* src, uint8_t src_slot);
+/* Copy slot out as is. This is safe to call from an ISR, so does not run any
+ * pending recalculation, see pokemon_recalculate_pending().
+ */
+void pokemon_raw_get(PokemonData* pdata, uint8_t slot, PokemonRaw* raw);
+/* Overwrite slot with raw as is, nothing is recalculated. raw has no mail, so
+ * any mail slot had is blanked. Returns false, and leaves slot alone, if raw is
+ * not from the same generation as pdata.
+ */
+bool pokemon_raw_set(PokemonData* pdata, uint8_t slot, const PokemonRaw* raw);
+uint16_t pokemon_stat_get(PokemonData* pdata, uint8_t slot, DataStat stat, DataStatSub num);
+void pokemon_stat_set(
+    PokemonData* pdata,
+    uint8_t slot,
+    DataStat stat,
+    DataStatSub which,
+    uint16_t val);
+/* Read or write a whole StatBlock in one go. Setting a block writes the stats,
+ * EVs, and IVs only, and does not recalculate anything.
+ */
+void pokemon_stat_block_get(PokemonData* pdata, uint8_t slot, StatBlock* block);
+void pokemon_stat_block_set(PokemonData* pdata, uint8_t slot, const StatBlock* block);
 uint16_t pokemon_stat_ev_get(PokemonData* pdata, DataStat stat);
 void pokemon_stat_ev_set(PokemonData* pdata, DataStat stat, uint16_t val);
 void pokemon_stat_iv_set(PokemonData* pdata, int val);
-void pokemon_exp_set(PokemonData* pdata, uint32_t exp);
-void pokemon_exp_calc(PokemonData* pdata);
-void pokemon_stat_calc(PokemonData* pdata, DataStat stat);
-void pokemon_default_nickname_set(char* dest, PokemonData* pdata, size_t n);
-void pokemon_name_set(PokemonData* pdata, DataStat stat, char* name);
-void pokemon_name_get(PokemonData* pdata, DataStat stat, char* dest, size_t len);
+void pokemon_exp_set(PokemonData* pdata, uint8_t slot, uint32_t exp);
+uint32_t pokemon_exp_get(PokemonData* pdata, uint8_t slot);
+void pokemon_exp_calc(PokemonData* pdata, uint8_t slot);
+/* The level that slot's exp works out to, which may not match its level for
+ * a Pokemon that came from somewhere else.
+ */
+uint8_t pokemon_exp_level_get(PokemonData* pdata, uint8_t slot);
+/* One stat, as the games work it out from its base stat, IV, EV, and level */
+uint16_t pokemon_stat_calc(DataStat stat, uint8_t base, uint8_t iv, uint16_t ev, uint8_t level);
+void pokemon_stats_calc(PokemonData* pdata, uint8_t slot);
+/* Must be called before using the trade block directly rather than through
+ * the accessors. Not safe to call from an ISR.
+ */
+void pokemon_recalculate_pending(PokemonData* pdata);
+void pokemon_default_nickname_set(char* dest, PokemonData* pdata, uint8_t slot, size_t n);
+/* slot is ignored for STAT_TRAINER_NAME */
+void pokemon_name_set(PokemonData* pdata, uint8_t slot, DataStat stat, char* name);
+void pokemon_name_get(PokemonData* pdata, uint8_t slot, DataStat stat, char* dest, size_t len);
 #endif /* POKEMON_DATA_H */
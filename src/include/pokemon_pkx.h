@@ -0,0 +1,61 @@
+#ifndef POKEMON_PKX_H
+#define POKEMON_PKX_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_data.h>
+
+/* Single Pokemon files in the .pk1 and .pk2 formats used by PKHeX and other
+ * community tools.
+ *
+ * A file is a party list holding one Pokemon: a count of 1, the species, a
+ * 0xFF terminator, then the party struct, OT name, and nickname exactly as
+ * they are in the trade block. That makes a file the same bytes as the fields
+ * of a PokemonRaw, in a different order. Only the international format, with
+ * 11 byte names, is supported. Japanese files have 6 byte names and are
+ * rejected by their size.
+ */
+
+#define PKX_DIR APP_DATA_PATH("pkx")
+
+#define PKX_HDR_SZ 3
+#define PK1_MEMBER_SZ 44
+#define PK2_MEMBER_SZ LEN_PARTY_MEMBER_MAX
+#define PK1_FILE_SZ (PKX_HDR_SZ + PK1_MEMBER_SZ + (2 * LEN_NAME_BUF))
+#define PK2_FILE_SZ (PKX_HDR_SZ + PK2_MEMBER_SZ + (2 * LEN_NAME_BUF))
+#define PKX_FILE_SZ_MAX PK2_FILE_SZ
+
+/* Size of a file for gen, or 0 if gen has no file format */
+size_t pokemon_pkx_size(uint8_t gen);
+
+/* File extension for gen, including the '.', or NULL */
+const char* pokemon_pkx_ext(uint8_t gen);
+
+/* Write raw to buf as a file of its gen. Returns the number of bytes written,
+ * or 0 if buf is too small.
+ */
+size_t pokemon_pkx_encode(const PokemonRaw* raw, uint8_t* buf, size_t len);
+
+/* Read a file of either gen, telling them apart by len. Returns false if buf
+ * is not a well formed file, in which case raw is left alone.
+ */
+bool pokemon_pkx_decode(const uint8_t* buf, size_t len, PokemonRaw* raw);
+
+/* Replace the party with the .pk1 and .pk2 files in dir, the first
+ * PARTY_CNT_MAX of them in name order, converted to pdata's gen. Files that
+ * aren't well formed, or can't be converted, are skipped. The party is left
+ * alone if there are none. Returns the number imported.
+ */
+uint8_t pokemon_pkx_party_import(PokemonData* pdata, Storage* storage, const char* dir);
+
+/* Write every party member to dir, creating it if needed, as files named after
+ * their slot and nickname. Returns the number written.
+ */
+uint8_t pokemon_pkx_party_export(PokemonData* pdata, Storage* storage, const char* dir);
+
+#endif /* POKEMON_PKX_H */
@@ -5,13 +5,22 @@
 
 #include <src/include/stats.h>
 
+/* The slightly fast and slightly slow rates exist in the games' data, but no
+ * Pokemon in Gen I or Gen II uses them.
+ */
 typedef enum {
     GROWTH_MEDIUM_FAST = 0,
+    GROWTH_SLIGHTLY_FAST = 1,
+    GROWTH_SLIGHTLY_SLOW = 2,
     GROWTH_MEDIUM_SLOW = 3,
     GROWTH_FAST = 4,
     GROWTH_SLOW = 5,
+    GROWTH_COUNT,
 } Growth;
 
+#define LEVEL_MIN 1
+#define LEVEL_MAX 100
+
 typedef struct pokemon_data_table PokemonTable;
 
 int table_pokemon_pos_get(const PokemonTable* table, uint8_t index);
@@ -19,5 +28,11 @@ uint8_t
     table_stat_base_get(const PokemonTable* table, uint8_t num, DataStat stat, DataStatSub which);
 const char* table_stat_name_get(const PokemonTable* table, int num);
 const PokemonTable* table_pointer_get();
+/* Total experience at the start of level, level is clamped to LEVEL_MIN and
+ * LEVEL_MAX.
+ */
+uint32_t table_exp_get(Growth growth, uint8_t level);
+/* The highest level that exp is enough for */
+uint8_t table_level_get(Growth growth, uint32_t exp);
 
 #endif // POKEMON_TABLE_H
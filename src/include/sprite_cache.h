@@ -0,0 +1,68 @@
+#ifndef SPRITE_CACHE_H
+#define SPRITE_CACHE_H
+
+#pragma once
+
+#include <stdint.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_data.h>
+
+/* A small cache of recently drawn Pokemon sprites in front of the sprite pack
+ * on the SD card. The pack is opened once when the cache is allocated and
+ * kept open until it is freed.
+ *
+ * All of the sprite memory is allocated up front with the cache, there is no
+ * allocation when looking up a sprite. When the cache is full, the least
+ * recently used sprite is replaced.
+ *
+ * Sprites can also be loaded ahead of time by a prefetch thread, started the
+ * first time a prefetch is requested. A view can then only draw what is
+ * already loaded, and never wait on the SD card.
+ */
+
+/* Enough to hold everything a prefetch loads, plus the sprite being drawn */
+#define SPRITE_CACHE_SLOTS 8
+
+/* How many sprites to prefetch ahead of and behind the requested one */
+#define SPRITE_PREFETCH_AHEAD 4
+#define SPRITE_PREFETCH_BEHIND 2
+
+typedef void (*SpriteCacheCallback)(void* context);
+
+struct sprite_cache;
+
+struct sprite_cache* sprite_cache_alloc(Storage* storage, const char* path);
+
+void sprite_cache_free(struct sprite_cache* cache);
+
+/* Returns sprite num, 1 indexed by pokedex number, or NULL if it could not
+ * be read. The sprite remains valid until the next get or peek.
+ */
+const struct fxbm_sprite* sprite_cache_get(struct sprite_cache* cache, int num);
+
+/* Like sprite_cache_get(), but returns NULL rather than reading from the SD
+ * card if num isn't already loaded.
+ */
+const struct fxbm_sprite* sprite_cache_peek(struct sprite_cache* cache, int num);
+
+/* Have the prefetch thread load num, then the sprites after it in the
+ * direction of dir, then some before it. Numbers wrap within min and max.
+ * Only the latest request is worked on, any earlier one is abandoned.
+ */
+void sprite_cache_prefetch(struct sprite_cache* cache, int num, int dir, int min, int max);
+
+/* callback is run from the prefetch thread once the sprite from the latest
+ * prefetch request is loaded, with none of the cache's locks held. Once this
+ * returns, the previous callback is not running and will not be run again, so
+ * this must not be called from within the callback.
+ */
+void sprite_cache_callback_set(
+    struct sprite_cache* cache,
+    SpriteCacheCallback callback,
+    void* context);
+
+/* Lookup counters since the cache was allocated */
+void sprite_cache_stats_get(struct sprite_cache* cache, uint32_t* hits, uint32_t* misses);
+
+#endif /* SPRITE_CACHE_H */
@@ -0,0 +1,58 @@
+#ifndef SPRITE_PACK_H
+#define SPRITE_PACK_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* The compressed sprite pack, generated from sprites/ by tools/sprite_pack.py.
+ *
+ * A pack is a struct sprite_pack_hdr, followed by count + 1 uint32_t file
+ * offsets, followed by the sprite data. Sprite n, 1 indexed by pokedex number,
+ * is the bytes from offset n - 1 up to offset n. All values are little
+ * endian.
+ *
+ * Every sprite is XBM data, width x height at 1 bpp, stored one of two ways:
+ *
+ * - Raw, if its length is exactly the size of the XBM data.
+ *
+ * - Coded, if it is shorter. Each byte of the XBM has the byte one row above
+ *   it XORed in, which leaves mostly 0 bytes. This is stored as a bitmask with
+ *   one bit per byte, LSB first, set for every byte that isn't 0, followed by
+ *   just the bytes that aren't 0.
+ *
+ * Either way a sprite decodes in a single pass straight in to the buffer that
+ * is drawn from, with no extra memory.
+ */
+
+#define SPRITE_PACK_MAGIC "PKSP"
+#define SPRITE_PACK_VERSION 1
+
+struct sprite_pack_hdr {
+    char magic[4];
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t count;
+    uint16_t width;
+    uint16_t height;
+} __attribute__((packed));
+
+/* Size of one decoded sprite, which is also the largest a stored one can be */
+static inline size_t sprite_pack_data_size(uint16_t width, uint16_t height) {
+    return ((width + 7) / 8) * height;
+}
+
+/* Decode len bytes of a stored sprite from src in to dest, which must hold
+ * sprite_pack_data_size() bytes. Returns false if src is not a valid sprite of
+ * that size, in which case dest is left with garbage.
+ */
+bool sprite_pack_decode(
+    uint8_t* dest,
+    const uint8_t* src,
+    size_t len,
+    uint16_t width,
+    uint16_t height);
+
+#endif /* SPRITE_PACK_H */
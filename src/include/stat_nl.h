@@ -3,7 +3,7 @@
 
 #pragma once
 
-extern const NamedList stat_list[];
+extern const NamedList stat_list;
 
 typedef enum {
     RANDIV_ZEROEV,
@@ -83,6 +83,7 @@ typedef enum {
     STAT_EXP,
     STAT_HELD_ITEM,
     STAT_POKERUS,
+    STAT_DATA_END, // Sentry value
 } DataStat;
 
 typedef enum {
@@ -3,6 +3,6 @@
 
 #pragma once
 
-extern const NamedList type_list[];
+extern const NamedList type_list;
 
 #endif // TYPE_NL_H
@@ -0,0 +1,82 @@
+#ifndef WIRE_IMAGE_H
+#define WIRE_IMAGE_H
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <src/include/pokemon_data.h>
+#include <src/include/patch_list.h>
+
+/* The wire image is the full outgoing stream of the fixed length portions of
+ * a trade centre exchange, built before the link is started. This way the link
+ * ISR only needs to index in to it and advance a cursor for each byte.
+ *
+ * The layout is:
+ * RANDOM: 10x random numbers followed by 9x SERIAL_PREAMBLE_BYTE. All of
+ *   these are echoed back to the Game Boy.
+ * DATA: The full trade_block, 415 bytes for Gen I, 441 bytes for Gen II.
+ * PATCH: The last of the 6x SERIAL_PREAMBLE_BYTE and 7x BLANK bytes, echoed,
+ *   followed by the patch list. 196 bytes total.
+ * MAIL: Gen II only, 389 bytes. 6x SERIAL_MAIL_PREAMBLE_BYTE, echoed, then
+ *   the MailBlockGenII, then the mail patch list. 0xFE in a message is sent
+ *   as SERIAL_MAIL_REPLACEMENT_BYTE, and is not told apart from it when
+ *   received, the same as the games do. 0xFE in the metadata is sent as 0xFF,
+ *   and the patch list has its 1 indexed offset in to the metadata. There is
+ *   only the one part, ended by a part terminator, then 0x00 to the end.
+ *
+ * The portions between these, e.g. the preambles before RANDOM and PATCH, are
+ * of variable length and are still handled by the trade state machine.
+ */
+#define WIRE_RANDOM_SZ 19
+#define WIRE_TRADE_BLOCK_MAX_SZ 441
+#define WIRE_PATCH_SZ 196
+#define WIRE_PATCH_ECHO_SZ 8
+#define WIRE_MAIL_SZ 389
+#define WIRE_MAIL_PREAMBLE_SZ 6
+#define WIRE_MAIL_PATCH_SZ (WIRE_MAIL_SZ - WIRE_MAIL_PREAMBLE_SZ - LEN_MAIL_BLOCK)
+#define WIRE_IMAGE_MAX_SZ \
+    (WIRE_RANDOM_SZ + WIRE_TRADE_BLOCK_MAX_SZ + WIRE_PATCH_SZ + WIRE_MAIL_SZ)
+
+struct wire_image {
+    /* Current position in the image, advanced by each transmitted byte */
+    size_t pos;
+    /* Total length of the image for the current generation */
+    size_t len;
+    /* Start of each section, RANDOM is always at 0 */
+    size_t data_offs;
+    size_t patch_offs;
+    size_t mail_offs;
+    /* Byte to transmit at each position */
+    uint8_t tx[WIRE_IMAGE_MAX_SZ];
+    /* 0xFF at each position that echoes the incoming byte, 0x00 otherwise.
+     * tx is always 0x00 at an echo position.
+     */
+    uint8_t echo[WIRE_IMAGE_MAX_SZ];
+};
+
+struct wire_image* wire_image_alloc(void);
+
+void wire_image_free(struct wire_image* image);
+
+/* Build the full image from the current trade_block and patch list. This
+ * also rewinds the image cursor. Must not be called from an ISR.
+ */
+void wire_image_build(struct wire_image* image, PokemonData* pdata, struct patch_list* plist);
+
+static inline void wire_image_rewind(struct wire_image* image) {
+    image->pos = 0;
+}
+
+/* Returns the byte to transmit in response to `in` and advances the cursor.
+ * The caller is responsible for not advancing past image->len.
+ */
+static inline uint8_t wire_image_next(struct wire_image* image, uint8_t in) {
+    uint8_t send = image->tx[image->pos] | (in & image->echo[image->pos]);
+
+    image->pos++;
+    return send;
+}
+
+#endif /* WIRE_IMAGE_H */
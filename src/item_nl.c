@@ -1,7 +1,7 @@
 #include <src/include/named_list.h>
 #include <src/include/pokemon_data.h>
 
-const NamedList item_list[] = {
+static const NamedListItem item_list_items[] = {
     {"No Item", 0x00, GEN_II},
     {"Amulet Coin", 0x5B, GEN_II},
     {"Antidote", 0x09, GEN_II},
@@ -229,3 +229,50 @@ const NamedList item_list[] = {
     {"Ylw Apricorn", 0x5C, GEN_II},
     {},
 };
+
+/* Generated by tools/named_list_gen.py, do not edit below this line */
+
+static const uint8_t item_list_index_pos[256] = {
+    0, 88, 215, 19, 53, 119, 0, 8, 102, 2, 20, 70, 3, 112, 48, 91,
+    68, 155, 123, 37, 134, 89, 42, 162, 217, 0, 67, 125, 71, 23, 84, 22,
+    131, 219, 74, 95, 110, 120, 47, 136, 93, 56, 156, 92, 29, 0, 45, 146,
+    76, 220, 0, 221, 223, 222, 28, 72, 0, 40, 111, 51, 141, 157, 124, 38,
+    90, 33, 133, 139, 150, 106, 27, 143, 100, 128, 127, 50, 147, 140, 126, 21,
+    69, 118, 73, 11, 96, 132, 163, 9, 142, 15, 159, 1, 224, 54, 26, 107,
+    214, 218, 12, 14, 0, 117, 13, 144, 116, 153, 145, 108, 87, 97, 115, 10,
+    39, 148, 129, 55, 16, 98, 161, 44, 160, 34, 35, 58, 135, 57, 83, 24,
+    86, 32, 80, 151, 152, 4, 114, 0, 0, 0, 25, 6, 138, 0, 0, 94,
+    30, 0, 75, 0, 0, 0, 105, 31, 7, 0, 0, 0, 137, 59, 43, 77,
+    85, 41, 0, 78, 46, 101, 81, 109, 52, 154, 121, 0, 216, 5, 49, 149,
+    0, 113, 130, 0, 18, 158, 79, 122, 82, 36, 103, 17, 104, 99, 0, 164,
+    165, 166, 167, 0, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179,
+    180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 0, 192, 193, 194,
+    195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210,
+    211, 212, 213, 60, 61, 62, 63, 64, 65, 66, 0, 0, 0, 0, 0, 0,
+};
+
+static const uint8_t item_list_gen_ii_pos[225] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+    96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224,
+};
+
+const NamedList item_list = {
+    .items = item_list_items,
+    .cnt = 225,
+    .index_pos = item_list_index_pos,
+    .gen_pos = {NULL, item_list_gen_ii_pos},
+    .gen_cnt = {0, 225},
+};
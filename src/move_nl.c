@@ -1,7 +1,7 @@
 #include <src/include/named_list.h>
 #include <src/include/pokemon_data.h>
 
-const NamedList move_list[] = {
+static const NamedListItem move_list_items[] = {
     {"No Move", 0x00, (GEN_I | GEN_II)},
     {"Absorb", 0x47, (GEN_I | GEN_II)},
     {"Acid", 0x33, (GEN_I | GEN_II)},
@@ -256,3 +256,65 @@ const NamedList move_list[] = {
     {"Zap Cannon", 0xC0, GEN_II},
     {},
 };
+
+/* Generated by tools/named_list_gen.py, do not edit below this line */
+
+static const uint8_t move_list_index_pos[256] = {
+    0, 146, 103, 48, 27, 120, 138, 65, 99, 232, 177, 241, 84, 160, 222, 39,
+    85, 248, 247, 72, 16, 187, 242, 207, 47, 119, 102, 170, 174, 88, 92, 76,
+    93, 224, 19, 250, 226, 229, 46, 225, 145, 239, 142, 107, 17, 82, 166, 183,
+    216, 198, 44, 2, 57, 69, 129, 245, 94, 217, 98, 18, 150, 24, 9, 95,
+    139, 53, 212, 112, 34, 179, 208, 1, 117, 106, 83, 159, 197, 144, 211, 189,
+    141, 209, 51, 66, 233, 231, 234, 230, 169, 55, 67, 43, 235, 29, 151, 97,
+    116, 5, 155, 156, 227, 134, 124, 178, 49, 161, 86, 126, 194, 28, 249, 40,
+    11, 109, 87, 162, 73, 15, 122, 128, 180, 56, 108, 193, 191, 20, 64, 244,
+    26, 221, 185, 201, 30, 6, 104, 196, 91, 81, 52, 143, 10, 105, 111, 186,
+    236, 23, 45, 205, 71, 153, 204, 3, 35, 60, 78, 22, 163, 167, 96, 182,
+    31, 237, 215, 188, 213, 210, 184, 238, 228, 200, 125, 133, 70, 195, 38, 68,
+    32, 4, 33, 165, 203, 147, 149, 113, 176, 63, 219, 14, 192, 132, 135, 202,
+    251, 74, 41, 140, 100, 42, 21, 110, 136, 175, 80, 59, 25, 171, 62, 218,
+    123, 199, 77, 206, 115, 8, 190, 89, 164, 148, 75, 173, 137, 172, 114, 54,
+    118, 50, 12, 58, 154, 158, 220, 101, 121, 243, 131, 223, 130, 90, 36, 240,
+    157, 214, 37, 127, 152, 61, 7, 181, 79, 168, 246, 13, 0, 0, 0, 0,
+};
+
+static const uint8_t move_list_gen_i_pos[166] = {
+    0, 1, 2, 3, 5, 6, 9, 10, 11, 15, 16, 17, 18, 19, 20, 22,
+    23, 24, 26, 27, 28, 29, 30, 31, 34, 35, 39, 40, 43, 44, 45, 46,
+    47, 48, 49, 51, 52, 53, 55, 56, 57, 60, 64, 65, 66, 67, 69, 71,
+    72, 73, 76, 78, 81, 82, 83, 84, 85, 86, 87, 88, 91, 92, 93, 94,
+    95, 96, 97, 98, 99, 102, 103, 104, 105, 106, 107, 108, 109, 111, 112, 116,
+    117, 119, 120, 122, 124, 126, 128, 129, 134, 138, 139, 141, 142, 143, 144, 145,
+    146, 150, 151, 153, 155, 156, 159, 160, 161, 162, 163, 166, 167, 169, 170, 174,
+    177, 178, 179, 180, 182, 183, 185, 186, 187, 188, 189, 191, 193, 194, 196, 197,
+    198, 201, 204, 205, 207, 208, 209, 210, 211, 212, 213, 215, 216, 217, 221, 222,
+    224, 225, 226, 227, 229, 230, 231, 232, 233, 234, 235, 236, 237, 239, 241, 242,
+    244, 245, 247, 248, 249, 250,
+};
+
+static const uint8_t move_list_gen_ii_pos[252] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+    96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251,
+};
+
+const NamedList move_list = {
+    .items = move_list_items,
+    .cnt = 252,
+    .index_pos = move_list_index_pos,
+    .gen_pos = {move_list_gen_i_pos, move_list_gen_ii_pos},
+    .gen_cnt = {166, 252},
+};
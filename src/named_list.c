@@ -1,22 +1,18 @@
+#include <furi.h>
+
 #include <stddef.h>
 #include <stdint.h>
 
 #include <src/include/named_list.h>
 
-/* Get number of elements in a list
- * This is not very efficient as-is since it has to walk the whole list.
- */
+/* Get number of elements in a list */
 size_t namedlist_cnt(const NamedList* list) {
-    size_t i;
-
-    for(i = 0;; i++) {
-        if(list[i].name == NULL) return i;
-    }
+    return list->cnt;
 }
 
 /* Returns the generation mask of the requested item in the list */
 uint32_t namedlist_gen_get_pos(const NamedList* list, uint32_t pos) {
-    return list[pos].gen;
+    return list->items[pos].gen;
 }
 
 /* Returns the generation mask of the item in the list that matches the
@@ -24,7 +20,7 @@ uint32_t namedlist_gen_get_pos(const NamedList* list, uint32_t pos) {
  * of the provided index not matching any of the list elements.
  */
 uint32_t namedlist_gen_get_index(const NamedList* list, uint32_t index) {
-    return list[namedlist_pos_get(list, index)].gen;
+    return list->items[namedlist_pos_get(list, index)].gen;
 }
 
 /* Returns the list position based on the provided index. If index is not
@@ -32,30 +28,42 @@ uint32_t namedlist_gen_get_index(const NamedList* list, uint32_t index) {
  * indicator. e.g. No Move.
  */
 uint32_t namedlist_pos_get(const NamedList* list, uint32_t index) {
-    int i;
+    /* Indices are a single byte, anything else can't match */
+    if(index > UINT8_MAX) return 0;
 
-    for(i = 0;; i++) {
-        if(list[i].name == NULL) break;
-        if(index == list[i].index) return i;
-    }
-
-    /* This will return the first entry in case index is not matched.
-     * Could be surprising at runtime.
-     */
-    return 0;
+    return list->index_pos[index];
 }
 
 /* Get the item's index value from the position specified */
 uint32_t namedlist_index_get(const NamedList* list, uint32_t pos) {
-    return list[pos].index;
+    return list->items[pos].index;
 }
 
 /* Get a pointer to the item's name from an item's index */
 const char* namedlist_name_get_index(const NamedList* list, uint32_t index) {
-    return list[namedlist_pos_get(list, index)].name;
+    return list->items[namedlist_pos_get(list, index)].name;
 }
 
 /* Get a pointer to the item's name from a position */
 const char* namedlist_name_get_pos(const NamedList* list, uint32_t pos) {
-    return list[pos].name;
+    return list->items[pos].name;
+}
+
+/* The gen_pos element for a single generation bit */
+static size_t namedlist_gen_elem(uint8_t gen) {
+    size_t i = __builtin_ctz(gen);
+
+    furi_check(gen && !(gen & (gen - 1)) && i < NAMEDLIST_GEN_CNT);
+    return i;
+}
+
+size_t namedlist_gen_cnt(const NamedList* list, uint8_t gen) {
+    return list->gen_cnt[namedlist_gen_elem(gen)];
+}
+
+uint32_t namedlist_gen_pos_get(const NamedList* list, uint8_t gen, size_t n) {
+    size_t i = namedlist_gen_elem(gen);
+
+    furi_check(n < list->gen_cnt[i]);
+    return list->gen_pos[i][n];
 }
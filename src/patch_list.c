@@ -1,88 +1,147 @@
 #include <src/include/pokemon_app.h>
+#include <src/include/patch_list.h>
 
+/* The patch list is a flat array that is allocated once and then reused for
+ * every rebuild. The worst case is every byte of the largest party (Gen II)
+ * needing a patch, plus the two part terminators. See PLIST_MAX_SZ.
+ *
+ * Alongside the list itself, a bitmap of every party byte that is currently
+ * 0xFE is kept. This is updated only at the offsets that PokemonData has
+ * marked as dirty, and the list is then regenerated from the bitmap.
+ */
 struct patch_list {
-    uint8_t index;
-    struct patch_list* next;
+    size_t len;
+    uint8_t fe_map[LEN_PARTY_MAX / 8];
+    uint8_t index[PLIST_MAX_SZ];
 };
 
 struct patch_list* plist_alloc(void) {
     struct patch_list* plist = NULL;
 
     plist = malloc(sizeof(struct patch_list));
-    plist->index = 0;
-    plist->next = NULL;
+    memset(plist, '\0', sizeof(struct patch_list));
     return plist;
 }
 
 void plist_append(struct patch_list* plist, uint8_t index) {
     furi_assert(plist);
+    furi_check(plist->len < PLIST_MAX_SZ);
 
-    for(;;) {
-        if(plist->next == NULL) break;
-        plist = plist->next;
-    }
-    plist->index = index;
-    plist->next = plist_alloc();
+    plist->index[plist->len] = index;
+    plist->len++;
 }
 
 void plist_free(struct patch_list* plist) {
-    struct patch_list* plist_next = NULL;
-
-    while(plist != NULL) {
-        plist_next = plist->next;
-        free(plist);
-        plist = plist_next;
-    }
+    free(plist);
 }
 
 /* Returns the index value at offset member of the list. If offset is beyond
  * the length of the allocated list, it will just return 0.
+ *
+ * This is called from the link ISR for every byte of the patch list that
+ * gets transmitted, so it needs to stay a simple bounds check and load.
  */
 uint8_t plist_index_get(struct patch_list* plist, int offset) {
     furi_assert(plist);
-    int i;
 
-    for(i = 0; i < offset; i++) {
-        if(plist->next == NULL) break;
-        plist = plist->next;
+    if(offset < 0 || (size_t)offset >= plist->len) return 0;
+
+    return plist->index[offset];
+}
+
+/* Regenerate the list from the bitmap of 0xFE bytes.
+ *
+ * The first half of the patch list covers offsets 0x00 - 0xfb, which
+ * is expressed as 0x01 - 0xfc. An 0xFF byte is added to signify the
+ * end of the first part. The second half of the patch list covers
+ * offsets 0xfc - 0x107 (more in gen ii). Which is expressed as
+ * 0x01 - 0xc. A 0xFF byte is added to signify the end of the second part.
+ */
+static void plist_generate(struct patch_list* plist, size_t party_sz) {
+    size_t i;
+    size_t j;
+    size_t offs;
+    bool pt_2 = false;
+
+    plist->len = 0;
+
+    for(i = 0; i < (party_sz + 7) / 8; i++) {
+        /* Most of the map is expected to be empty */
+        if(plist->fe_map[i] == 0) continue;
+
+        for(j = 0; j < 8; j++) {
+            if(!(plist->fe_map[i] & (1 << j))) continue;
+            offs = (i * 8) + j;
+
+            if(offs >= 0xFC && !pt_2) {
+                plist_append(plist, 0xFF);
+                pt_2 = true;
+            }
+
+            FURI_LOG_D(
+                TAG,
+                "[plist] patching byte 0x%02X, adding 0x%02X to plist",
+                offs,
+                (offs % 0xfc) + 1);
+            plist_append(plist, (offs % 0xfc) + 1);
+        }
     }
 
-    return plist->index;
+    if(!pt_2) plist_append(plist, 0xFF);
+    plist_append(plist, 0xFF);
 }
 
-void plist_create(struct patch_list** pplist, PokemonData* pdata) {
+bool plist_update(struct patch_list* plist, PokemonData* pdata) {
+    furi_assert(plist);
     furi_assert(pdata);
-    uint8_t* trade_party_flat = pdata->party;
+    uint8_t* party_flat = pdata->party;
+    bool changed = false;
+    bool is_fe;
+    uint8_t bit;
     size_t i;
+    size_t j;
+    size_t offs;
 
-    /* If plist is non-NULL that means its already been created. Tear it down
-     * first.
-     */
-    if(*pplist != NULL) {
-        plist_free(*pplist);
-        *pplist = NULL;
-    }
+    /* The wire image is built from the trade block right after this */
+    pokemon_recalculate_pending(pdata);
 
-    *pplist = plist_alloc();
-    /* The first half of the patch list covers offsets 0x00 - 0xfb, which
-     * is expressed as 0x01 - 0xfc. An 0xFF byte is added to signify the
-     * end of the first part. The second half of the patch list covers
-     * offsets 0xfc - 0x107 (more in gen ii). Which is expressed as
-     * 0x01 - 0xc. A 0xFF byte is added to signify the end of the second part.
-     */
-    for(i = 0; i < pdata->party_sz; i++) {
-        if(i == 0xFC) {
-            FURI_LOG_D(TAG, "[plist] part 1 end");
-            plist_append(*pplist, 0xFF);
-        }
+    for(i = 0; i < (pdata->party_sz + 7) / 8; i++) {
+        if(pdata->party_dirty[i] == 0) continue;
 
-        if(trade_party_flat[i] == 0xFE) {
-            FURI_LOG_D(
-                TAG, "[plist] patching byte 0x%02X, adding 0x%02X to plist", i, (i % 0xfc) + 1);
-            plist_append(*pplist, (i % 0xfc) + 1);
-            trade_party_flat[i] = 0xFF;
+        for(j = 0; j < 8; j++) {
+            offs = (i * 8) + j;
+            bit = (1 << j);
+            if(!(pdata->party_dirty[i] & bit) || offs >= pdata->party_sz) continue;
+
+            is_fe = (party_flat[offs] == SERIAL_NO_DATA_BYTE);
+            if(is_fe != !!(plist->fe_map[i] & bit)) {
+                plist->fe_map[i] ^= bit;
+                changed = true;
+            }
         }
+
+        pdata->party_dirty[i] = 0;
     }
-    FURI_LOG_D(TAG, "[plist] part 2 end");
-    plist_append(*pplist, 0xFF);
+
+    /* An empty list has not been generated yet, it always has at least the
+     * two part terminators.
+     */
+    if(changed || plist->len == 0) {
+        plist_generate(plist, pdata->party_sz);
+        FURI_LOG_D(TAG, "[plist] regenerated, %d entries", plist->len);
+    }
+
+    return changed;
+}
+
+void plist_create(struct patch_list* plist, PokemonData* pdata) {
+    furi_assert(plist);
+    furi_assert(pdata);
+
+    /* Force every party byte to be rechecked */
+    memset(plist->fe_map, 0x00, sizeof(plist->fe_map));
+    plist->len = 0;
+    pokemon_party_dirty_mark(pdata, 0, pdata->party_sz);
+
+    plist_update(plist, pdata);
 }
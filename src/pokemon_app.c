@@ -69,6 +69,10 @@ PokemonFap* pokemon_alloc() {
     pokemon_fap->gblink_handle = gblink_alloc();
     gblink_pinconf_load(pokemon_fap->gblink_handle);
 
+    // Box, the index is built once here
+    pokemon_fap->box =
+        pokemon_box_open((Storage*)furi_record_open(RECORD_STORAGE), POKEMON_BOX_PATH);
+
     return pokemon_fap;
 }
 
@@ -78,6 +82,10 @@ void free_app(PokemonFap* pokemon_fap) {
     // gblink
     gblink_free(pokemon_fap->gblink_handle);
 
+    // Box
+    if(pokemon_fap->box) pokemon_box_close(pokemon_fap->box);
+    furi_record_close(RECORD_STORAGE);
+
     // Submenu
     view_dispatcher_remove_view(pokemon_fap->view_dispatcher, AppViewSubmenu);
     submenu_free(pokemon_fap->submenu);
@@ -13,14 +13,14 @@ static const char* gender_str[] = {
 /* This returns a string pointer if the gender is static, NULL if it is not and
  * the gender needs to be calculated.
  */
-const char* pokemon_gender_is_static(PokemonData* pdata, uint8_t ratio) {
+const char* pokemon_gender_is_static(PokemonData* pdata, uint8_t slot, uint8_t ratio) {
     switch(ratio) {
     case 0xFF:
         return gender_str[0];
     case 0xFE:
         return gender_str[1];
     case 0x00:
-        if(pokemon_stat_get(pdata, STAT_NUM, NONE) != 0xEB) { // Tyrogue can be either gender
+        if(pokemon_stat_get(pdata, slot, STAT_NUM, NONE) != 0xEB) { // Tyrogue can be either gender
             return gender_str[2];
         }
         break;
@@ -31,36 +31,36 @@ const char* pokemon_gender_is_static(PokemonData* pdata, uint8_t ratio) {
     return NULL;
 }
 
-const char* pokemon_gender_get(PokemonData* pdata) {
+const char* pokemon_gender_get(PokemonData* pdata, uint8_t slot) {
     uint8_t ratio = table_stat_base_get(
         pdata->pokemon_table,
-        pokemon_stat_get(pdata, STAT_NUM, NONE),
+        pokemon_stat_get(pdata, slot, STAT_NUM, NONE),
         STAT_BASE_GENDER_RATIO,
         NONE);
     uint8_t atk_iv;
     const char* rc;
 
-    rc = pokemon_gender_is_static(pdata, ratio);
+    rc = pokemon_gender_is_static(pdata, slot, ratio);
     if(rc) return rc;
 
     /* Falling through here means now we need to calculate the gender from
      * its ratio and ATK_IV.
      */
-    atk_iv = pokemon_stat_get(pdata, STAT_ATK_IV, NONE);
+    atk_iv = pokemon_stat_get(pdata, slot, STAT_ATK_IV, NONE);
     if(atk_iv * 17 <= ratio)
         return gender_str[1];
     else
         return gender_str[2];
 }
 
-void pokemon_gender_set(PokemonData* pdata, Gender gender) {
+void pokemon_gender_set(PokemonData* pdata, uint8_t slot, Gender gender) {
 
     uint8_t ratio = table_stat_base_get(
         pdata->pokemon_table,
-        pokemon_stat_get(pdata, STAT_NUM, NONE),
+        pokemon_stat_get(pdata, slot, STAT_NUM, NONE),
         STAT_BASE_GENDER_RATIO,
         NONE);
-    uint8_t atk_iv = pokemon_stat_get(pdata, STAT_ATK_IV, NONE);
+    uint8_t atk_iv = pokemon_stat_get(pdata, slot, STAT_ATK_IV, NONE);
 
     /* If we need to make the pokemon a male, increase atk IV until it exceeds
      * the gender ratio.
@@ -85,7 +85,7 @@ void pokemon_gender_set(PokemonData* pdata, Gender gender) {
         while((atk_iv * 17) > ratio) atk_iv--;
     }
 
-    pokemon_stat_set(pdata, STAT_ATK_IV, NONE, atk_iv);
+    pokemon_stat_set(pdata, slot, STAT_ATK_IV, NONE, atk_iv);
 }
 
 static const char* pokerus_states[] = {
@@ -95,10 +95,10 @@ static const char* pokerus_states[] = {
     "",
 };
 
-const char* pokerus_get_status_str(PokemonData* pdata) {
+const char* pokerus_get_status_str(PokemonData* pdata, uint8_t slot) {
     uint8_t pokerus;
 
-    pokerus = pokemon_stat_get(pdata, STAT_POKERUS, NONE);
+    pokerus = pokemon_stat_get(pdata, slot, STAT_POKERUS, NONE);
 
     if(pokerus == 0x00)
         return pokerus_states[0];
@@ -109,30 +109,30 @@ const char* pokerus_get_status_str(PokemonData* pdata) {
     return pokerus_states[2];
 }
 
-void pokerus_set_strain(PokemonData* pdata, uint8_t strain) {
+void pokerus_set_strain(PokemonData* pdata, uint8_t slot, uint8_t strain) {
     uint8_t pokerus;
 
     /* Need to read/modify/write the existing stat */
-    pokerus = pokemon_stat_get(pdata, STAT_POKERUS, NONE);
+    pokerus = pokemon_stat_get(pdata, slot, STAT_POKERUS, NONE);
     pokerus &= 0x0f;
     pokerus |= (strain << 4);
 
     if((pokerus & 0xf0) == 0x00)
         pokerus = 0;
 
-    pokemon_stat_set(pdata, STAT_POKERUS, NONE, pokerus);
+    pokemon_stat_set(pdata, slot, STAT_POKERUS, NONE, pokerus);
 }
 
-void pokerus_set_days(PokemonData *pdata, uint8_t days) {
+void pokerus_set_days(PokemonData* pdata, uint8_t slot, uint8_t days) {
     uint8_t pokerus;
 
     days &= 0x0f;
 
     /* Need to read/modify/write the existing stat */
-    pokerus = pokemon_stat_get(pdata, STAT_POKERUS, NONE);
+    pokerus = pokemon_stat_get(pdata, slot, STAT_POKERUS, NONE);
     pokerus &= 0xf0;
     pokerus |= days;
-    pokemon_stat_set(pdata, STAT_POKERUS, NONE, pokerus);
+    pokemon_stat_set(pdata, slot, STAT_POKERUS, NONE, pokerus);
 }
 
 /* This just assumes gen ii for now */
@@ -140,11 +140,11 @@ void pokerus_set_days(PokemonData *pdata, uint8_t days) {
  * Spd, Def, and Spc must all be 10
  * Atk must be 2, 3, 6, 7, 10, 11, 14, or 15
  */
-bool pokemon_is_shiny(PokemonData* pdata) {
-    uint8_t atk_iv = pokemon_stat_get(pdata, STAT_ATK_IV, NONE);
-    uint8_t def_iv = pokemon_stat_get(pdata, STAT_DEF_IV, NONE);
-    uint8_t spd_iv = pokemon_stat_get(pdata, STAT_SPD_IV, NONE);
-    uint8_t spc_iv = pokemon_stat_get(pdata, STAT_SPC_IV, NONE);
+bool pokemon_is_shiny(PokemonData* pdata, uint8_t slot) {
+    uint8_t atk_iv = pokemon_stat_get(pdata, slot, STAT_ATK_IV, NONE);
+    uint8_t def_iv = pokemon_stat_get(pdata, slot, STAT_DEF_IV, NONE);
+    uint8_t spd_iv = pokemon_stat_get(pdata, slot, STAT_SPD_IV, NONE);
+    uint8_t spc_iv = pokemon_stat_get(pdata, slot, STAT_SPC_IV, NONE);
     bool rc = 1;
 
     if(spd_iv != 10) rc = 0;
@@ -168,29 +168,34 @@ bool pokemon_is_shiny(PokemonData* pdata) {
     return rc;
 }
 
-void pokemon_set_shiny(PokemonData* pdata, bool shiny) {
+void pokemon_set_shiny(PokemonData* pdata, uint8_t slot, bool shiny) {
 
     if(!shiny) {
         do {
             /* First, reset the IV to the selected stat */
-            pokemon_stat_set(pdata, STAT_SEL, NONE, pokemon_stat_get(pdata, STAT_SEL, NONE));
+            pokemon_stat_set(
+                pdata, slot, STAT_SEL, NONE, pokemon_stat_get(pdata, slot, STAT_SEL, NONE));
 
 	    /* XXX: This may not be right? */
             /* Next, ensure the current IVs wouldn't make the pokemon shiny */
-        } while(pokemon_is_shiny(pdata));
+        } while(pokemon_is_shiny(pdata, slot));
     } else {
         /* Set Def, Spd, Spc to 10 */
-        pokemon_stat_set(pdata, STAT_DEF_IV, NONE, 10);
-        pokemon_stat_set(pdata, STAT_SPD_IV, NONE, 10);
-        pokemon_stat_set(pdata, STAT_SPC_IV, NONE, 10);
+        pokemon_stat_set(pdata, slot, STAT_DEF_IV, NONE, 10);
+        pokemon_stat_set(pdata, slot, STAT_SPD_IV, NONE, 10);
+        pokemon_stat_set(pdata, slot, STAT_SPC_IV, NONE, 10);
 
         /* Increase ATK IV until we hit a shiny number. Note that, this only
          * affects IVs that are randomly generated, max IV will already be set
          * at 15 which will make it shiny.
          */
-        while(!pokemon_is_shiny(pdata)) {
+        while(!pokemon_is_shiny(pdata, slot)) {
             pokemon_stat_set(
-                pdata, STAT_ATK_IV, NONE, pokemon_stat_get(pdata, STAT_ATK_IV, NONE) + 1);
+                pdata,
+                slot,
+                STAT_ATK_IV,
+                NONE,
+                pokemon_stat_get(pdata, slot, STAT_ATK_IV, NONE) + 1);
         }
     }
 }
@@ -205,9 +210,9 @@ void pokemon_set_shiny(PokemonData* pdata, bool shiny) {
  *
  * https://bulbapedia.bulbagarden.net/wiki/Individual_values#Unown's_letter
  */
-static uint8_t unown_ivs_get(PokemonData* pdata) {
+static uint8_t unown_ivs_get(PokemonData* pdata, uint8_t slot) {
     furi_assert(pdata);
-    uint16_t ivs = pokemon_stat_get(pdata, STAT_IV, NONE);
+    uint16_t ivs = pokemon_stat_get(pdata, slot, STAT_IV, NONE);
     uint8_t ivs_mid;
 
     ivs_mid =
@@ -217,9 +222,9 @@ static uint8_t unown_ivs_get(PokemonData* pdata) {
     return ivs_mid;
 }
 
-static void unown_ivs_set(PokemonData* pdata, uint8_t ivs_mid) {
+static void unown_ivs_set(PokemonData* pdata, uint8_t slot, uint8_t ivs_mid) {
     furi_assert(pdata);
-    uint16_t ivs = pokemon_stat_get(pdata, STAT_IV, NONE);
+    uint16_t ivs = pokemon_stat_get(pdata, slot, STAT_IV, NONE);
 
     /* Clear the middle bits of each nibble */
     ivs &= ~(0x6666);
@@ -228,11 +233,11 @@ static void unown_ivs_set(PokemonData* pdata, uint8_t ivs_mid) {
     ivs |=
         (((ivs_mid & 0xC0) << 7) | ((ivs_mid & 0x30) << 5) | ((ivs_mid & 0x0C) << 3) |
          ((ivs_mid & 0x03) << 1));
-    pokemon_stat_set(pdata, STAT_IV, NONE, ivs);
+    pokemon_stat_set(pdata, slot, STAT_IV, NONE, ivs);
 }
 
-char unown_form_get(PokemonData* pdata) {
-    uint8_t form = unown_ivs_get(pdata);
+char unown_form_get(PokemonData* pdata, uint8_t slot) {
+    uint8_t form = unown_ivs_get(pdata, slot);
 
     /* The forumula is specifically the center two bits of each IV slapped
      * together and floor(/10)
@@ -244,8 +249,8 @@ char unown_form_get(PokemonData* pdata) {
 }
 
 /* Try and get to the desired form by adding/subtracting the current IVs */
-void unown_form_set(PokemonData* pdata, char letter) {
-    uint8_t ivs = unown_ivs_get(pdata);
+void unown_form_set(PokemonData* pdata, uint8_t slot, char letter) {
+    uint8_t ivs = unown_ivs_get(pdata, slot);
     uint8_t form;
 
     letter = toupper(letter);
@@ -261,5 +266,5 @@ void unown_form_set(PokemonData* pdata, char letter) {
     }
 
     /* form is now the target letter, set IVs back up */
-    unown_ivs_set(pdata, ivs);
+    unown_ivs_set(pdata, slot, ivs);
 }
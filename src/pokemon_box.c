@@ -0,0 +1,450 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_box.h>
+
+/* Starting size of the index, it doubles each time it fills */
+#define BOX_INDEX_MIN 16
+
+/* Records read at once while scanning or compacting */
+#define BOX_CHUNK_RECS 8
+
+/* File offset of a record in the log */
+#define BOX_REC_OFFSET(rec) \
+    (sizeof(struct pokemon_box_hdr) + ((rec) * sizeof(struct pokemon_box_rec)))
+
+/* Locking: lock protects everything, every public function takes it */
+struct pokemon_box {
+    Storage* storage;
+    File* file;
+    FuriString* path;
+    FuriMutex* lock;
+
+    /* Pokemon in the box, sorted by id, which is also the order in the log */
+    struct pokemon_box_entry* index;
+    size_t count;
+    size_t index_sz;
+
+    /* Records in the log, and how many of those aren't in the index */
+    uint32_t recs;
+    uint32_t dead;
+    uint32_t next_id;
+};
+
+/* CRC-32 with the same polynomial as zlib, a nibble at a time to keep the
+ * table small.
+ */
+static uint32_t pokemon_box_crc(const void* data, size_t len) {
+    static const uint32_t table[16] = {
+        0x00000000,
+        0x1DB71064,
+        0x3B6E20C8,
+        0x26D930AC,
+        0x76DC4190,
+        0x6B6B51F4,
+        0x4DB26158,
+        0x5005713C,
+        0xEDB88320,
+        0xF00F9344,
+        0xD6D6A3E8,
+        0xCB61B38C,
+        0x9B64C2B0,
+        0x86D3D2D4,
+        0xA00AE278,
+        0xBDBDF21C,
+    };
+    const uint8_t* byte = data;
+    uint32_t crc = 0xFFFFFFFF;
+
+    for(; len > 0; len--, byte++) {
+        crc ^= *byte;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+
+    return ~crc;
+}
+
+static inline bool pokemon_box_rec_ok(const struct pokemon_box_rec* rec) {
+    return rec->crc == pokemon_box_crc(rec, offsetof(struct pokemon_box_rec, crc));
+}
+
+/* Index of the entry with id, or count if there isn't one */
+static size_t pokemon_box_find(struct pokemon_box* box, uint32_t id) {
+    size_t lo = 0;
+    size_t hi = box->count;
+    size_t mid;
+
+    while(lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if(box->index[mid].id == id) return mid;
+        if(box->index[mid].id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return box->count;
+}
+
+static void pokemon_box_index_add(struct pokemon_box* box, const struct pokemon_box_rec* rec) {
+    struct pokemon_box_entry* entry;
+
+    if(box->count == box->index_sz) {
+        box->index_sz = box->index_sz ? box->index_sz * 2 : BOX_INDEX_MIN;
+        box->index = realloc(box->index, box->index_sz * sizeof(struct pokemon_box_entry));
+    }
+
+    entry = &box->index[box->count++];
+    entry->id = rec->id;
+    entry->rec = box->recs;
+    entry->gen = rec->gen;
+    entry->species = rec->species;
+}
+
+static void pokemon_box_index_remove(struct pokemon_box* box, size_t idx) {
+    box->count--;
+    memmove(
+        &box->index[idx],
+        &box->index[idx + 1],
+        (box->count - idx) * sizeof(struct pokemon_box_entry));
+}
+
+/* Apply one record from the log to the index, and count it */
+static void pokemon_box_apply(struct pokemon_box* box, const struct pokemon_box_rec* rec) {
+    size_t idx;
+
+    if(!pokemon_box_rec_ok(rec)) {
+        FURI_LOG_W(TAG, "[box] bad record %lu", box->recs);
+        box->dead++;
+        box->recs++;
+        return;
+    }
+
+    if(rec->gen == POKEMON_BOX_GEN_DELETE) {
+        /* Both the delete and the record it deletes are now dead */
+        box->dead++;
+        idx = pokemon_box_find(box, rec->id);
+        if(idx < box->count) {
+            pokemon_box_index_remove(box, idx);
+            box->dead++;
+        }
+    } else if((rec->gen != GEN_I && rec->gen != GEN_II) || rec->id < box->next_id) {
+        /* ids only go up, anything else didn't come from here */
+        box->dead++;
+    } else {
+        pokemon_box_index_add(box, rec);
+    }
+
+    if(rec->id >= box->next_id) box->next_id = rec->id + 1;
+    box->recs++;
+}
+
+/* Read the whole log in to the index. Anything past the last whole record is
+ * from a write that never finished, and is cut off so that the next record
+ * lands in the right place.
+ */
+static bool pokemon_box_scan(struct pokemon_box* box) {
+    struct pokemon_box_rec* chunk = malloc(BOX_CHUNK_RECS * sizeof(struct pokemon_box_rec));
+    uint64_t size = storage_file_size(box->file);
+    uint32_t recs = (size - sizeof(struct pokemon_box_hdr)) / sizeof(struct pokemon_box_rec);
+    size_t len;
+    size_t i;
+    bool ok = true;
+
+    while(box->recs < recs) {
+        len = recs - box->recs;
+        if(len > BOX_CHUNK_RECS) len = BOX_CHUNK_RECS;
+        len *= sizeof(struct pokemon_box_rec);
+        if(storage_file_read(box->file, chunk, len) != len) {
+            ok = false;
+            break;
+        }
+
+        for(i = 0; i < len / sizeof(struct pokemon_box_rec); i++)
+            pokemon_box_apply(box, &chunk[i]);
+    }
+
+    free(chunk);
+
+    if(ok && size != BOX_REC_OFFSET(recs)) {
+        FURI_LOG_W(TAG, "[box] dropping partial record at %lu", recs);
+        ok = storage_file_seek(box->file, BOX_REC_OFFSET(recs), true) &&
+             storage_file_truncate(box->file);
+    }
+
+    return ok;
+}
+
+static bool pokemon_box_compact_needed(struct pokemon_box* box) {
+    return box->dead >= POKEMON_BOX_COMPACT_MIN && box->dead > box->count;
+}
+
+/* Path of the new log while compacting */
+static FuriString* pokemon_box_tmp_path(struct pokemon_box* box) {
+    return furi_string_alloc_printf("%s.tmp", furi_string_get_cstr(box->path));
+}
+
+/* Copy every live record to a new log, then swap it in. lock must be held. If
+ * anything fails before the swap, the old log is kept as is.
+ */
+static bool pokemon_box_compact_locked(struct pokemon_box* box) {
+    FuriString* tmp_path = pokemon_box_tmp_path(box);
+    File* tmp = storage_file_alloc(box->storage);
+    struct pokemon_box_rec* chunk = malloc(BOX_CHUNK_RECS * sizeof(struct pokemon_box_rec));
+    struct pokemon_box_hdr hdr = {0};
+    size_t i, n;
+    bool ok;
+
+    memcpy(hdr.magic, POKEMON_BOX_MAGIC, sizeof(hdr.magic));
+    hdr.version = POKEMON_BOX_VERSION;
+    hdr.rec_sz = sizeof(struct pokemon_box_rec);
+
+    ok = storage_file_open(
+             tmp, furi_string_get_cstr(tmp_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+         storage_file_write(tmp, &hdr, sizeof(hdr)) == sizeof(hdr);
+
+    /* Live records are batched in chunk, the log is in the same order */
+    for(i = 0, n = 0; ok && i < box->count; i++) {
+        ok = storage_file_seek(box->file, BOX_REC_OFFSET(box->index[i].rec), true) &&
+             storage_file_read(box->file, &chunk[n], sizeof(struct pokemon_box_rec)) ==
+                 sizeof(struct pokemon_box_rec);
+        if(!ok) break;
+        n++;
+        if(n == BOX_CHUNK_RECS || i == box->count - 1) {
+            ok = storage_file_write(tmp, chunk, n * sizeof(struct pokemon_box_rec)) ==
+                 n * sizeof(struct pokemon_box_rec);
+            n = 0;
+        }
+    }
+
+    if(ok) ok = storage_file_sync(tmp);
+    storage_file_close(tmp);
+    storage_file_free(tmp);
+    free(chunk);
+
+    if(ok) {
+        /* An interrupted swap is finished the next time the box is opened */
+        storage_file_close(box->file);
+        storage_common_remove(box->storage, furi_string_get_cstr(box->path));
+        ok = storage_common_rename(
+                 box->storage,
+                 furi_string_get_cstr(tmp_path),
+                 furi_string_get_cstr(box->path)) == FSE_OK &&
+             storage_file_open(
+                 box->file, furi_string_get_cstr(box->path), FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+        if(ok) {
+            FURI_LOG_I(TAG, "[box] compacted %lu records to %u", box->recs, box->count);
+            for(i = 0; i < box->count; i++)
+                box->index[i].rec = i;
+            box->recs = box->count;
+            box->dead = 0;
+        } else {
+            /* Nothing can be written without knowing what is in the file */
+            FURI_LOG_E(TAG, "[box] lost the log while compacting");
+            box->count = 0;
+            box->recs = 0;
+        }
+    } else {
+        FURI_LOG_E(TAG, "[box] unable to compact");
+        storage_common_remove(box->storage, furi_string_get_cstr(tmp_path));
+    }
+
+    furi_string_free(tmp_path);
+
+    return ok;
+}
+
+struct pokemon_box* pokemon_box_open(Storage* storage, const char* path) {
+    furi_assert(storage);
+    furi_assert(path);
+    struct pokemon_box* box = NULL;
+    struct pokemon_box_hdr hdr = {0};
+    FuriString* tmp_path;
+    bool ok;
+
+    box = malloc(sizeof(struct pokemon_box));
+    memset(box, '\0', sizeof(struct pokemon_box));
+    box->storage = storage;
+    box->path = furi_string_alloc_set(path);
+    box->lock = furi_mutex_alloc(FuriMutexTypeNormal);
+    box->file = storage_file_alloc(storage);
+    box->next_id = 1;
+
+    /* Finish a compaction that was interrupted after removing the old log */
+    tmp_path = pokemon_box_tmp_path(box);
+    if(!storage_file_exists(storage, path) &&
+       storage_file_exists(storage, furi_string_get_cstr(tmp_path))) {
+        FURI_LOG_W(TAG, "[box] recovering compacted log");
+        storage_common_rename(storage, furi_string_get_cstr(tmp_path), path);
+    }
+    furi_string_free(tmp_path);
+
+    ok = storage_file_open(box->file, path, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS);
+
+    if(ok && storage_file_size(box->file) < sizeof(hdr)) {
+        memcpy(hdr.magic, POKEMON_BOX_MAGIC, sizeof(hdr.magic));
+        hdr.version = POKEMON_BOX_VERSION;
+        hdr.rec_sz = sizeof(struct pokemon_box_rec);
+        ok = storage_file_seek(box->file, 0, true) && storage_file_truncate(box->file) &&
+             storage_file_write(box->file, &hdr, sizeof(hdr)) == sizeof(hdr);
+    } else if(ok) {
+        ok = storage_file_read(box->file, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+             !memcmp(hdr.magic, POKEMON_BOX_MAGIC, sizeof(hdr.magic)) &&
+             hdr.version == POKEMON_BOX_VERSION &&
+             hdr.rec_sz == sizeof(struct pokemon_box_rec) && pokemon_box_scan(box);
+    }
+
+    if(!ok) {
+        FURI_LOG_E(TAG, "[box] unable to open \'%s\'", path);
+        pokemon_box_close(box);
+        return NULL;
+    }
+
+    FURI_LOG_D(TAG, "[box] %u Pokemon, %lu dead records", box->count, box->dead);
+
+    if(pokemon_box_compact_needed(box) && !pokemon_box_compact_locked(box) &&
+       !storage_file_is_open(box->file)) {
+        pokemon_box_close(box);
+        return NULL;
+    }
+
+    return box;
+}
+
+void pokemon_box_close(struct pokemon_box* box) {
+    furi_assert(box);
+
+    storage_file_close(box->file);
+    storage_file_free(box->file);
+    furi_string_free(box->path);
+    furi_mutex_free(box->lock);
+    free(box->index);
+    free(box);
+}
+
+size_t pokemon_box_count(struct pokemon_box* box) {
+    furi_assert(box);
+    size_t count;
+
+    furi_check(furi_mutex_acquire(box->lock, FuriWaitForever) == FuriStatusOk);
+    count = box->count;
+    furi_check(furi_mutex_release(box->lock) == FuriStatusOk);
+
+    return count;
+}
+
+bool pokemon_box_entry_get(struct pokemon_box* box, size_t idx, struct pokemon_box_entry* entry) {
+    furi_assert(box);
+    furi_assert(entry);
+    bool ok;
+
+    furi_check(furi_mutex_acquire(box->lock, FuriWaitForever) == FuriStatusOk);
+    ok = (idx < box->count);
+    if(ok) *entry = box->index[idx];
+    furi_check(furi_mutex_release(box->lock) == FuriStatusOk);
+
+    return ok;
+}
+
+/* Write rec to the end of the log and apply it to the index. lock must be
+ * held. The log is synced so that once this returns, rec survives the Flipper
+ * losing power.
+ */
+static bool pokemon_box_append(struct pokemon_box* box, struct pokemon_box_rec* rec) {
+    rec->timestamp = furi_hal_rtc_get_timestamp();
+    rec->crc = pokemon_box_crc(rec, offsetof(struct pokemon_box_rec, crc));
+
+    /* Seeking to where the record belongs, rather than the end of the file,
+     * writes over anything left by an earlier failed append.
+     */
+    if(!storage_file_seek(box->file, BOX_REC_OFFSET(box->recs), true) ||
+       storage_file_write(box->file, rec, sizeof(struct pokemon_box_rec)) !=
+           sizeof(struct pokemon_box_rec) ||
+       !storage_file_sync(box->file)) {
+        FURI_LOG_E(TAG, "[box] unable to write record %lu", box->recs);
+        return false;
+    }
+
+    pokemon_box_apply(box, rec);
+
+    return true;
+}
+
+uint32_t pokemon_box_save(struct pokemon_box* box, const PokemonRaw* raw) {
+    furi_assert(box);
+    furi_assert(raw);
+    furi_check(raw->gen == GEN_I || raw->gen == GEN_II);
+    struct pokemon_box_rec rec = {0};
+    uint32_t id = 0;
+
+    rec.gen = raw->gen;
+    rec.species = raw->species;
+    memcpy(rec.member, raw->member, sizeof(rec.member));
+    memcpy(rec.ot_name, raw->ot_name, sizeof(rec.ot_name));
+    memcpy(rec.nickname, raw->nickname, sizeof(rec.nickname));
+
+    furi_check(furi_mutex_acquire(box->lock, FuriWaitForever) == FuriStatusOk);
+    rec.id = box->next_id;
+    if(pokemon_box_append(box, &rec)) id = rec.id;
+    furi_check(furi_mutex_release(box->lock) == FuriStatusOk);
+
+    if(id) FURI_LOG_D(TAG, "[box] saved %lu", id);
+
+    return id;
+}
+
+bool pokemon_box_load(struct pokemon_box* box, size_t idx, PokemonRaw* raw) {
+    furi_assert(box);
+    furi_assert(raw);
+    struct pokemon_box_rec rec;
+    bool ok;
+
+    furi_check(furi_mutex_acquire(box->lock, FuriWaitForever) == FuriStatusOk);
+    ok = idx < box->count &&
+         storage_file_seek(box->file, BOX_REC_OFFSET(box->index[idx].rec), true) &&
+         storage_file_read(box->file, &rec, sizeof(rec)) == sizeof(rec) &&
+         pokemon_box_rec_ok(&rec) && rec.id == box->index[idx].id;
+    furi_check(furi_mutex_release(box->lock) == FuriStatusOk);
+
+    if(!ok) return false;
+
+    raw->gen = rec.gen;
+    raw->species = rec.species;
+    memcpy(raw->member, rec.member, sizeof(raw->member));
+    memcpy(raw->ot_name, rec.ot_name, sizeof(raw->ot_name));
+    memcpy(raw->nickname, rec.nickname, sizeof(raw->nickname));
+
+    return true;
+}
+
+bool pokemon_box_delete(struct pokemon_box* box, size_t idx) {
+    furi_assert(box);
+    struct pokemon_box_rec rec = {0};
+    bool ok;
+
+    furi_check(furi_mutex_acquire(box->lock, FuriWaitForever) == FuriStatusOk);
+    ok = idx < box->count;
+    if(ok) {
+        rec.id = box->index[idx].id;
+        rec.gen = POKEMON_BOX_GEN_DELETE;
+        ok = pokemon_box_append(box, &rec);
+    }
+    if(ok && pokemon_box_compact_needed(box)) pokemon_box_compact_locked(box);
+    furi_check(furi_mutex_release(box->lock) == FuriStatusOk);
+
+    return ok;
+}
+
+bool pokemon_box_compact(struct pokemon_box* box) {
+    furi_assert(box);
+    bool ok;
+
+    furi_check(furi_mutex_acquire(box->lock, FuriWaitForever) == FuriStatusOk);
+    ok = pokemon_box_compact_locked(box);
+    furi_check(furi_mutex_release(box->lock) == FuriStatusOk);
+
+    return ok;
+}
@@ -3,305 +3,133 @@
 
 #include <src/include/pokemon_char_encode.h>
 
-char pokemon_char_to_encoded(int byte) {
-    switch(byte) {
-    case 'A':
-        return A_;
-    case 'B':
-        return B_;
-    case 'C':
-        return C_;
-    case 'D':
-        return D_;
-    case 'E':
-        return E_;
-    case 'F':
-        return F_;
-    case 'G':
-        return G_;
-    case 'H':
-        return H_;
-    case 'I':
-        return I_;
-    case 'J':
-        return J_;
-    case 'K':
-        return K_;
-    case 'L':
-        return L_;
-    case 'M':
-        return M_;
-    case 'N':
-        return N_;
-    case 'O':
-        return O_;
-    case 'P':
-        return P_;
-    case 'Q':
-        return Q_;
-    case 'R':
-        return R_;
-    case 'S':
-        return S_;
-    case 'T':
-        return T_;
-    case 'U':
-        return U_;
-    case 'V':
-        return V_;
-    case 'W':
-        return W_;
-    case 'X':
-        return X_;
-    case 'Y':
-        return Y_;
-    case 'Z':
-        return Z_;
-    case 'a':
-        return a_;
-    case 'b':
-        return b_;
-    case 'c':
-        return c_;
-    case 'd':
-        return d_;
-    case 'e':
-        return e_;
-    case 'f':
-        return f_;
-    case 'g':
-        return g_;
-    case 'h':
-        return h_;
-    case 'i':
-        return i_;
-    case 'j':
-        return j_;
-    case 'k':
-        return k_;
-    case 'l':
-        return l_;
-    case 'm':
-        return m_;
-    case 'n':
-        return n_;
-    case 'o':
-        return o_;
-    case 'p':
-        return p_;
-    case 'q':
-        return q_;
-    case 'r':
-        return r_;
-    case 's':
-        return s_;
-    case 't':
-        return t_;
-    case 'u':
-        return u_;
-    case 'v':
-        return v_;
-    case 'w':
-        return w_;
-    case 'x':
-        return x_;
-    case 'y':
-        return y_;
-    case 'z':
-        return z_;
-    case '-':
-        return HYPHEN_;
-    case '0':
-        return _0_;
-    case '1':
-        return _1_;
-    case '2':
-        return _2_;
-    case '3':
-        return _3_;
-    case '4':
-        return _4_;
-    case '5':
-        return _5_;
-    case '6':
-        return _6_;
-    case '7':
-        return _7_;
-    case '8':
-        return _8_;
-    case '9':
-        return _9_;
+/* Every character that has an encoding, and its encoded byte. Both lookup
+ * tables are built from this one list so that they always agree with each
+ * other. HYPHEN_ and DASH_ are the same glyph.
+ *
+ * The ♂/♀ symbols, and the other glyphs without an ASCII equivalent, don't
+ * render properly on the flipper. They are mapped to the CHAR_* values so
+ * that names containing them can still be passed through unchanged.
+ */
+#define POKEMON_CHARSET(X)      \
+    X('A', A_)                  \
+    X('B', B_)                  \
+    X('C', C_)                  \
+    X('D', D_)                  \
+    X('E', E_)                  \
+    X('F', F_)                  \
+    X('G', G_)                  \
+    X('H', H_)                  \
+    X('I', I_)                  \
+    X('J', J_)                  \
+    X('K', K_)                  \
+    X('L', L_)                  \
+    X('M', M_)                  \
+    X('N', N_)                  \
+    X('O', O_)                  \
+    X('P', P_)                  \
+    X('Q', Q_)                  \
+    X('R', R_)                  \
+    X('S', S_)                  \
+    X('T', T_)                  \
+    X('U', U_)                  \
+    X('V', V_)                  \
+    X('W', W_)                  \
+    X('X', X_)                  \
+    X('Y', Y_)                  \
+    X('Z', Z_)                  \
+    X('a', a_)                  \
+    X('b', b_)                  \
+    X('c', c_)                  \
+    X('d', d_)                  \
+    X('e', e_)                  \
+    X('f', f_)                  \
+    X('g', g_)                  \
+    X('h', h_)                  \
+    X('i', i_)                  \
+    X('j', j_)                  \
+    X('k', k_)                  \
+    X('l', l_)                  \
+    X('m', m_)                  \
+    X('n', n_)                  \
+    X('o', o_)                  \
+    X('p', p_)                  \
+    X('q', q_)                  \
+    X('r', r_)                  \
+    X('s', s_)                  \
+    X('t', t_)                  \
+    X('u', u_)                  \
+    X('v', v_)                  \
+    X('w', w_)                  \
+    X('x', x_)                  \
+    X('y', y_)                  \
+    X('z', z_)                  \
+    X('0', _0_)                 \
+    X('1', _1_)                 \
+    X('2', _2_)                 \
+    X('3', _3_)                 \
+    X('4', _4_)                 \
+    X('5', _5_)                 \
+    X('6', _6_)                 \
+    X('7', _7_)                 \
+    X('8', _8_)                 \
+    X('9', _9_)                 \
+    X('-', HYPHEN_)             \
+    X(' ', SPACE_)              \
+    X('(', O_PAREN_)            \
+    X(')', C_PAREN_)            \
+    X(':', COLON_)              \
+    X(';', SEMI_)               \
+    X('[', O_BRACKET_)          \
+    X(']', C_BRACKET_)          \
+    X('\'', S_QUOTE_)           \
+    X('?', QUESTION_)           \
+    X('!', EXCLAIM_)            \
+    X('.', PERIOD_)             \
+    X(CHAR_FEMALE, FEMALE_)     \
+    X(CHAR_MALE, MALE_)         \
+    X(CHAR_PK, PK_)             \
+    X(CHAR_MN, MN_)             \
+    X(CHAR_e_ACCENT, e_ACCENT_) \
+    X(CHAR_d_TICK, d_TICK_)     \
+    X(CHAR_l_TICK, l_TICK_)     \
+    X(CHAR_s_TICK, s_TICK_)     \
+    X(CHAR_t_TICK, t_TICK_)     \
+    X(CHAR_v_TICK, v_TICK_)     \
+    X(CHAR_r_TICK, r_TICK_)     \
+    X(CHAR_m_TICK, m_TICK_)     \
+    X(CHAR_R_ARR, R_ARR_)       \
+    X(CHAR_D_ARR, D_ARR_)
 
-        /* This was previously implemented with unicode escape codes, however, that
-     * seemed to cause compilation issues. Which is strange because others reported
-     * compilation issues with the actual unicode characters. I'm not sure a good
-     * universal way to resolve this.
-     *
-     * Additionally, the ♂/♀ symbols don't render properly on the flipper. Would
-     * need to create a custom image/icon somehow, otherwise its nonobvious that
-     * the traded pokemon would have this symbol in their name.
-     */
+#define CHAR_TO_ENCODED(c, e) [(uint8_t)(c)] = (e),
+#define ENCODED_TO_CHAR(c, e) [(e)] = (c),
 
-    case '\201':
-        return MALE_;
-    case '\200':
-        return FEMALE_;
-    default:
-        return TERM_;
-    }
+/* Characters with no encoding are left as 0, which is not a byte any
+ * character encodes to, and become TERM_ when looked up.
+ */
+static const uint8_t char_to_encoded[256] = {POKEMON_CHARSET(CHAR_TO_ENCODED)};
+
+/* Encoded bytes with no character are left as '\0' */
+static const char encoded_to_char[256] = {POKEMON_CHARSET(ENCODED_TO_CHAR)};
+
+static inline uint8_t pokemon_char_encode(char c) {
+    uint8_t encoded = char_to_encoded[(uint8_t)c];
+
+    return encoded ? encoded : TERM_;
 }
 
-int pokemon_encoded_to_char(char byte) {
-    switch(byte) {
-    case A_:
-        return 'A';
-    case B_:
-        return 'B';
-    case C_:
-        return 'C';
-    case D_:
-        return 'D';
-    case E_:
-        return 'E';
-    case F_:
-        return 'F';
-    case G_:
-        return 'G';
-    case H_:
-        return 'H';
-    case I_:
-        return 'I';
-    case J_:
-        return 'J';
-    case K_:
-        return 'K';
-    case L_:
-        return 'L';
-    case M_:
-        return 'M';
-    case N_:
-        return 'N';
-    case O_:
-        return 'O';
-    case P_:
-        return 'P';
-    case Q_:
-        return 'Q';
-    case R_:
-        return 'R';
-    case S_:
-        return 'S';
-    case T_:
-        return 'T';
-    case U_:
-        return 'U';
-    case V_:
-        return 'V';
-    case W_:
-        return 'W';
-    case X_:
-        return 'X';
-    case Y_:
-        return 'Y';
-    case Z_:
-        return 'Z';
-    case a_:
-        return 'a';
-    case b_:
-        return 'b';
-    case c_:
-        return 'c';
-    case d_:
-        return 'd';
-    case e_:
-        return 'e';
-    case f_:
-        return 'f';
-    case g_:
-        return 'g';
-    case h_:
-        return 'h';
-    case i_:
-        return 'i';
-    case j_:
-        return 'j';
-    case k_:
-        return 'k';
-    case l_:
-        return 'l';
-    case m_:
-        return 'm';
-    case n_:
-        return 'n';
-    case o_:
-        return 'o';
-    case p_:
-        return 'p';
-    case q_:
-        return 'q';
-    case r_:
-        return 'r';
-    case s_:
-        return 's';
-    case t_:
-        return 't';
-    case u_:
-        return 'u';
-    case v_:
-        return 'v';
-    case w_:
-        return 'w';
-    case x_:
-        return 'x';
-    case y_:
-        return 'y';
-    case z_:
-        return 'z';
-    case HYPHEN_:
-        return '-';
-    case _0_:
-        return '0';
-    case _1_:
-        return '1';
-    case _2_:
-        return '2';
-    case _3_:
-        return '3';
-    case _4_:
-        return '4';
-    case _5_:
-        return '5';
-    case _6_:
-        return '6';
-    case _7_:
-        return '7';
-    case _8_:
-        return '8';
-    case _9_:
-        return '9';
+char pokemon_char_to_encoded(int byte) {
+    return pokemon_char_encode((char)byte);
+}
 
-    /* This was previously implemented with unicode escape codes, however, that
-     * seemed to cause compilation issues. Which is strange because others reported
-     * compilation issues with the actual unicode characters. I'm not sure a good
-     * universal way to resolve this.
-     *
-     * Additionally, the ♂/♀ symbols don't render properly on the flipper. Would
-     * need to create a custom image/icon somehow, otherwise its nonobvious that
-     * the traded pokemon would have this symbol in their name.
-     */
-    case MALE_:
-        return '\201';
-    case FEMALE_:
-        return '\200';
-    default:
-        return '\0';
-    }
+int pokemon_encoded_to_char(char byte) {
+    return encoded_to_char[(uint8_t)byte];
 }
 
 /* encode n bytes, any currently noninputtable characters are set with TERM_ */
 void pokemon_str_to_encoded_array(uint8_t* dest, char* src, size_t n) {
     for(; n > 0; n--) {
-        *dest = pokemon_char_to_encoded(*src);
+        *dest = pokemon_char_encode(*src);
         dest++;
         src++;
     }
@@ -310,8 +138,31 @@ void pokemon_str_to_encoded_array(uint8_t* dest, char* src, size_t n) {
 /* decode n bytes, any currently noninputtable characters are set with '\0' */
 void pokemon_encoded_array_to_str(char* dest, uint8_t* src, size_t n) {
     for(; n > 0; n--) {
-        *dest = pokemon_encoded_to_char(*src);
+        *dest = encoded_to_char[*src];
         dest++;
         src++;
     }
 }
+
+void pokemon_name_encode(uint8_t* dest, size_t n, const char* src, size_t len) {
+    size_t i;
+
+    if(len > n) len = n;
+
+    for(i = 0; i < len && src[i] != '\0'; i++)
+        dest[i] = pokemon_char_encode(src[i]);
+
+    for(; i < n; i++)
+        dest[i] = TERM_;
+}
+
+void pokemon_name_decode(char* dest, size_t n, const uint8_t* src) {
+    size_t i;
+
+    if(n == 0) return;
+
+    for(i = 0; i < n - 1 && src[i] != TERM_; i++)
+        dest[i] = encoded_to_char[src[i]];
+
+    dest[i] = '\0';
+}
@@ -0,0 +1,260 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "pokemon_data_i.h"
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_convert.h>
+#include <src/include/pokemon_table.h>
+#include <src/include/named_list.h>
+#include <src/include/move_nl.h>
+#include <src/include/type_nl.h>
+
+/* Number of Pokemon Gen I knows about, they are the first in the table */
+#define CONVERT_GEN_I_DEX_CNT 151
+
+/* The party_members entry of a Gen II egg */
+#define CONVERT_SPECIES_EGG 0xFD
+
+/* Friendship of a Pokemon that comes through the Time Capsule */
+#define CONVERT_FRIENDSHIP_BASE 70
+
+/* Everything from the moves through the move PP is laid out the same in both
+ * generations and is copied in one go: moves, OT ID, exp, EVs, IVs, and PP.
+ */
+#define CONVERT_SHARED_SZ \
+    (offsetof(PokemonPartyGenI, level_again) - offsetof(PokemonPartyGenI, move))
+
+_Static_assert(
+    CONVERT_SHARED_SZ ==
+        offsetof(PokemonPartyGenII, friendship) - offsetof(PokemonPartyGenII, move),
+    "Gen I and Gen II moves through PP must line up");
+
+/* Where each field is in a party member of one generation. An offset of 0 is
+ * a field this generation doesn't have, the species index is the only field
+ * actually at 0 and is always handled on its own.
+ */
+struct convert_layout {
+    uint8_t level;
+    /* A second copy of level */
+    uint8_t level_again;
+    uint8_t hp;
+    uint8_t status;
+    /* Catch rate in Gen I, held item in Gen II */
+    uint8_t item;
+    uint8_t type;
+    uint8_t friendship;
+    uint8_t shared;
+    uint8_t iv;
+    uint8_t ev[STAT_END];
+    uint8_t stat[STAT_END];
+};
+
+#define CONVERT_EVS(type)                          \
+    {[STAT_ATK] = offsetof(type, atk_ev),          \
+     [STAT_DEF] = offsetof(type, def_ev),          \
+     [STAT_SPD] = offsetof(type, spd_ev),          \
+     [STAT_SPC] = offsetof(type, spc_ev),          \
+     [STAT_SPC_ATK] = offsetof(type, spc_ev),      \
+     [STAT_SPC_DEF] = offsetof(type, spc_ev),      \
+     [STAT_HP] = offsetof(type, hp_ev)}
+
+static const struct convert_layout convert_layout_gen_i = {
+    /* The party level is the one that counts, level is what the box uses */
+    .level = offsetof(PokemonPartyGenI, level_again),
+    .level_again = offsetof(PokemonPartyGenI, level),
+    .hp = offsetof(PokemonPartyGenI, hp),
+    .status = offsetof(PokemonPartyGenI, status_condition),
+    .item = offsetof(PokemonPartyGenI, catch_held),
+    .type = offsetof(PokemonPartyGenI, type),
+    .shared = offsetof(PokemonPartyGenI, move),
+    .iv = offsetof(PokemonPartyGenI, iv),
+    .ev = CONVERT_EVS(PokemonPartyGenI),
+    .stat =
+        {[STAT_ATK] = offsetof(PokemonPartyGenI, atk),
+         [STAT_DEF] = offsetof(PokemonPartyGenI, def),
+         [STAT_SPD] = offsetof(PokemonPartyGenI, spd),
+         [STAT_SPC] = offsetof(PokemonPartyGenI, spc),
+         [STAT_HP] = offsetof(PokemonPartyGenI, max_hp)},
+};
+
+static const struct convert_layout convert_layout_gen_ii = {
+    .level = offsetof(PokemonPartyGenII, level),
+    .hp = offsetof(PokemonPartyGenII, hp),
+    .status = offsetof(PokemonPartyGenII, status_condition),
+    .item = offsetof(PokemonPartyGenII, held_item),
+    .friendship = offsetof(PokemonPartyGenII, friendship),
+    .shared = offsetof(PokemonPartyGenII, move),
+    .iv = offsetof(PokemonPartyGenII, iv),
+    .ev = CONVERT_EVS(PokemonPartyGenII),
+    .stat =
+        {[STAT_ATK] = offsetof(PokemonPartyGenII, atk),
+         [STAT_DEF] = offsetof(PokemonPartyGenII, def),
+         [STAT_SPD] = offsetof(PokemonPartyGenII, spd),
+         [STAT_SPC_ATK] = offsetof(PokemonPartyGenII, spc_atk),
+         [STAT_SPC_DEF] = offsetof(PokemonPartyGenII, spc_def),
+         [STAT_HP] = offsetof(PokemonPartyGenII, max_hp)},
+};
+
+/* Catch rates that Gen II doesn't keep as the held item, and the item it
+ * gives instead. The rest are kept as they are. Going back down, the held
+ * item is always kept as the catch rate.
+ */
+static const uint8_t convert_catch_items[][2] = {
+    {0x19, 0x92}, // Leftovers
+    {0x2D, 0x53}, // Bitter Berry
+    {0x32, 0xAE}, // Gold Berry
+    {0x5A, 0xAD}, // Berry
+    {0x64, 0xAD},
+    {0x78, 0xAD},
+    {0x87, 0xAD},
+    {0xBE, 0xAD},
+    {0xC3, 0xAD},
+    {0xDC, 0xAD},
+    {0xFA, 0xAD},
+    {0xFF, 0xAD},
+};
+
+static inline uint16_t convert_u16_get(const uint8_t* ptr) {
+    return (ptr[0] << 8) | ptr[1];
+}
+
+static inline void convert_u16_set(uint8_t* ptr, uint16_t val) {
+    ptr[0] = val >> 8;
+    ptr[1] = val;
+}
+
+static uint8_t convert_catch_item(uint8_t catch_rate) {
+    size_t i;
+
+    for(i = 0; i < COUNT_OF(convert_catch_items); i++) {
+        if(convert_catch_items[i][0] == catch_rate) return convert_catch_items[i][1];
+    }
+
+    return catch_rate;
+}
+
+/* The IV nibble that goes in to stat, iv is the IV word in GB byte order */
+static uint8_t convert_iv_get(const uint8_t* iv, DataStat stat) {
+    switch(stat) {
+    case STAT_ATK:
+        return iv[0] >> 4;
+    case STAT_DEF:
+        return iv[0] & 0x0F;
+    case STAT_SPD:
+        return iv[1] >> 4;
+    case STAT_HP:
+        return ((iv[0] & 0x10) >> 1) | ((iv[0] & 0x01) << 2) | ((iv[1] & 0x10) >> 3) |
+               (iv[1] & 0x01);
+    default:
+        return iv[1] & 0x0F;
+    }
+}
+
+/* True if index is in list and gen has it */
+static bool convert_list_has(const NamedList* list, uint8_t index, uint8_t gen) {
+    uint32_t pos = namedlist_pos_get(list, index);
+
+    return namedlist_index_get(list, pos) == index && (namedlist_gen_get_pos(list, pos) & gen);
+}
+
+/* Work out every stat the layout has for num, 0 indexed, from the level, EVs,
+ * and IVs already in member. HP is kept, but not above the new max.
+ */
+static void convert_stats_calc(
+    const PokemonTable* table,
+    const struct convert_layout* layout,
+    uint8_t* member,
+    uint8_t num) {
+    uint8_t level = member[layout->level];
+    DataStat i;
+
+    for(i = STAT; i < STAT_END; i++) {
+        if(!layout->stat[i]) continue;
+        convert_u16_set(
+            &member[layout->stat[i]],
+            pokemon_stat_calc(
+                i,
+                table_stat_base_get(table, num, i, NONE),
+                convert_iv_get(&member[layout->iv], i),
+                convert_u16_get(&member[layout->ev[i]]),
+                level));
+    }
+
+    if(convert_u16_get(&member[layout->hp]) > convert_u16_get(&member[layout->stat[STAT_HP]]))
+        memcpy(&member[layout->hp], &member[layout->stat[STAT_HP]], sizeof(uint16_t));
+}
+
+ConvertErr pokemon_convert(const PokemonRaw* src, uint8_t gen, PokemonRaw* dst) {
+    furi_assert(src);
+    furi_assert(dst);
+    const PokemonTable* table = table_pointer_get();
+    const struct convert_layout* from;
+    const struct convert_layout* to;
+    PokemonRaw out;
+    uint8_t num;
+    int i;
+
+    if((gen != GEN_I && gen != GEN_II) || (src->gen != GEN_I && src->gen != GEN_II))
+        return CONVERT_ERR_GEN;
+
+    if(src->gen == gen) {
+        *dst = *src;
+        return CONVERT_OK;
+    }
+
+    /* Find the pokedex number, 0 indexed, and check Gen I has room for it */
+    if(src->gen == GEN_I) {
+        from = &convert_layout_gen_i;
+        to = &convert_layout_gen_ii;
+        num = table_pokemon_pos_get(table, src->member[0]);
+        if(!src->member[0] || table_stat_base_get(table, num, STAT_BASE_INDEX, NONE) !=
+                                  src->member[0])
+            return CONVERT_ERR_SPECIES;
+    } else {
+        from = &convert_layout_gen_ii;
+        to = &convert_layout_gen_i;
+        if(src->species == CONVERT_SPECIES_EGG || src->member[0] == 0 ||
+           src->member[0] > CONVERT_GEN_I_DEX_CNT)
+            return CONVERT_ERR_SPECIES;
+        num = src->member[0] - 1;
+
+        for(i = MOVE_0; i <= MOVE_3; i++) {
+            if(!convert_list_has(&move_list, src->member[from->shared + i], GEN_I))
+                return CONVERT_ERR_MOVE;
+        }
+        for(i = TYPE_0; i <= TYPE_1; i++) {
+            if(!convert_list_has(
+                   &type_list, table_stat_base_get(table, num, STAT_BASE_TYPE, i), GEN_I))
+                return CONVERT_ERR_TYPE;
+        }
+    }
+
+    memset(&out, '\0', sizeof(out));
+    out.gen = gen;
+    memcpy(out.ot_name, src->ot_name, sizeof(out.ot_name));
+    memcpy(out.nickname, src->nickname, sizeof(out.nickname));
+
+    memcpy(&out.member[to->shared], &src->member[from->shared], CONVERT_SHARED_SZ);
+    memcpy(&out.member[to->hp], &src->member[from->hp], sizeof(uint16_t));
+    out.member[to->status] = src->member[from->status];
+    out.member[to->level] = src->member[from->level];
+    if(to->level_again) out.member[to->level_again] = src->member[from->level];
+
+    if(gen == GEN_II) {
+        out.member[0] = num + 1;
+        out.member[to->item] = convert_catch_item(src->member[from->item]);
+        out.member[to->friendship] = CONVERT_FRIENDSHIP_BASE;
+    } else {
+        out.member[0] = table_stat_base_get(table, num, STAT_BASE_INDEX, NONE);
+        out.member[to->item] = src->member[from->item];
+        for(i = TYPE_0; i <= TYPE_1; i++)
+            out.member[to->type + i] = table_stat_base_get(table, num, STAT_BASE_TYPE, i);
+    }
+    out.species = out.member[0];
+
+    convert_stats_calc(table, to, out.member, num);
+
+    *dst = out;
+    return CONVERT_OK;
+}
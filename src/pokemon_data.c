@@ -8,6 +8,7 @@
 #include <src/include/pokemon_char_encode.h>
 
 #include <src/include/pokemon_table.h>
+#include <src/include/sprite_cache.h>
 
 #include <src/include/named_list.h>
 #include <src/include/item_nl.h>
@@ -27,7 +28,8 @@
 #define RECALC_TYPES 0x40
 #define RECALC_ALL 0xFF
 
-#define FXBM_SPRITE_SIZE 404 // Each 56x56 sprite
+static void pokemon_stat_ev_calc(PokemonData* pdata, uint8_t slot, EvIv val);
+static void pokemon_stat_iv_calc(PokemonData* pdata, uint8_t slot, EvIv val);
 
 /* Text lookups to make debug output cleaner and easier to parse as a human */
 static char* stat_text_get(DataStat stat) {
@@ -105,20 +107,129 @@ static char* stat_text_get(DataStat stat) {
     }
 }
 
+/* Party member field layouts, see struct stat_field.
+ *
+ * The IVs in GB byte order, are always:
+ * atk, def, spd, spc
+ * Read as a 16 bit value in Flipper byte order, that puts them at the shifts
+ * below. In order to line up all of the dynamic stat accessors used as part
+ * of the stat calculation, the SPC IV and EV are overloaded to also be the
+ * SPC_ATK and SPC_DEF IV and EV. Only SPC exists, so when, for example, gen i
+ * calculates its SPC value, or gen ii calculates is SPC_DEF value, it will
+ * always grab the same value.
+ */
+#define FIELD_ENTRIES_COMMON(type)                                                \
+    [STAT_ATK] = FIELD_ENTRY(type, atk, FIELD_U16),                               \
+    [STAT_DEF] = FIELD_ENTRY(type, def, FIELD_U16),                               \
+    [STAT_SPD] = FIELD_ENTRY(type, spd, FIELD_U16),                               \
+    [STAT_HP] = FIELD_ENTRY_MIRROR(type, hp, max_hp, FIELD_U16),                  \
+    [STAT_MOVE] = FIELD_ENTRY(type, move, FIELD_ARRAY),                           \
+    [STAT_ATK_EV] = FIELD_ENTRY(type, atk_ev, FIELD_U16),                         \
+    [STAT_DEF_EV] = FIELD_ENTRY(type, def_ev, FIELD_U16),                         \
+    [STAT_SPD_EV] = FIELD_ENTRY(type, spd_ev, FIELD_U16),                         \
+    [STAT_SPC_EV] = FIELD_ENTRY(type, spc_ev, FIELD_U16),                         \
+    [STAT_SPC_ATK_EV] = FIELD_ENTRY(type, spc_ev, FIELD_U16),                     \
+    [STAT_SPC_DEF_EV] = FIELD_ENTRY(type, spc_ev, FIELD_U16),                     \
+    [STAT_HP_EV] = FIELD_ENTRY(type, hp_ev, FIELD_U16),                           \
+    [STAT_IV] = FIELD_ENTRY(type, iv, FIELD_U16),                                 \
+    [STAT_ATK_IV] = FIELD_ENTRY_IV(type, 4),                                      \
+    [STAT_DEF_IV] = FIELD_ENTRY_IV(type, 0),                                      \
+    [STAT_SPD_IV] = FIELD_ENTRY_IV(type, 12),                                     \
+    [STAT_SPC_IV] = FIELD_ENTRY_IV(type, 8),                                      \
+    [STAT_SPC_ATK_IV] = FIELD_ENTRY_IV(type, 8),                                  \
+    [STAT_SPC_DEF_IV] = FIELD_ENTRY_IV(type, 8),                                  \
+    [STAT_HP_IV] = FIELD_ENTRY(type, iv, FIELD_HP_IV),                            \
+    [STAT_CONDITION] = FIELD_ENTRY(type, status_condition, FIELD_U8),             \
+    [STAT_OT_ID] = FIELD_ENTRY(type, ot_id, FIELD_U16),                           \
+    [STAT_EXP] = FIELD_ENTRY(type, exp, FIELD_ARRAY)
+
+static const struct stat_field stat_fields_gen_i[STAT_DATA_END] = {
+    FIELD_ENTRIES_COMMON(PokemonPartyGenI),
+    [STAT_SPC] = FIELD_ENTRY(PokemonPartyGenI, spc, FIELD_U16),
+    [STAT_SPC_ATK] = FIELD_ENTRY_ABSENT,
+    [STAT_SPC_DEF] = FIELD_ENTRY_ABSENT,
+    [STAT_TYPE] = FIELD_ENTRY(PokemonPartyGenI, type, FIELD_ARRAY),
+    [STAT_LEVEL] = FIELD_ENTRY_MIRROR(PokemonPartyGenI, level, level_again, FIELD_U8),
+    /* In Gen I, index is not relative at all to dex num */
+    [STAT_INDEX] = FIELD_ENTRY(PokemonPartyGenI, index, FIELD_U8),
+    [STAT_NUM] = FIELD_ENTRY(PokemonPartyGenI, index, FIELD_U8 | FIELD_DEX),
+    [STAT_HELD_ITEM] = FIELD_ENTRY_ABSENT,
+    [STAT_POKERUS] = FIELD_ENTRY_ABSENT,
+};
+
+static const struct stat_field stat_fields_gen_ii[STAT_DATA_END] = {
+    FIELD_ENTRIES_COMMON(PokemonPartyGenII),
+    [STAT_SPC] = FIELD_ENTRY_ABSENT,
+    [STAT_SPC_ATK] = FIELD_ENTRY(PokemonPartyGenII, spc_atk, FIELD_U16),
+    [STAT_SPC_DEF] = FIELD_ENTRY(PokemonPartyGenII, spc_def, FIELD_U16),
+    /* Gen II doesn't have type assignment */
+    [STAT_TYPE] = FIELD_ENTRY_ABSENT,
+    [STAT_LEVEL] = FIELD_ENTRY(PokemonPartyGenII, level, FIELD_U8),
+    /* In Gen II, index is the same as the dex num, off by one */
+    [STAT_INDEX] = FIELD_ENTRY_BIAS(PokemonPartyGenII, index, -1, FIELD_U8),
+    [STAT_NUM] = FIELD_ENTRY_BIAS(PokemonPartyGenII, index, -1, FIELD_U8),
+    [STAT_HELD_ITEM] = FIELD_ENTRY(PokemonPartyGenII, held_item, FIELD_U8),
+    [STAT_POKERUS] = FIELD_ENTRY(PokemonPartyGenII, pokerus, FIELD_U8),
+};
+
+/* Values that need recalculating when a stat is set */
+static const uint8_t stat_recalc[STAT_DATA_END] = {
+    [STAT_LEVEL] = (RECALC_STATS | RECALC_EXP | RECALC_EVS),
+    /* Always recalculate everything if we selected a different pokemon */
+    [STAT_INDEX] = RECALC_ALL,
+    [STAT_NUM] = RECALC_ALL,
+    [STAT_SEL] = (RECALC_EVS | RECALC_IVS | RECALC_STATS),
+};
+
+/* The recalculation that produces each stat. Reading or writing one of these
+ * while that recalculation is pending resolves it first.
+ */
+static const uint8_t stat_recalc_out[STAT_DATA_END] = {
+    [STAT_ATK] = RECALC_STATS,
+    [STAT_DEF] = RECALC_STATS,
+    [STAT_SPD] = RECALC_STATS,
+    [STAT_SPC] = RECALC_STATS,
+    [STAT_SPC_ATK] = RECALC_STATS,
+    [STAT_SPC_DEF] = RECALC_STATS,
+    [STAT_HP] = RECALC_STATS,
+    [STAT_TYPE] = RECALC_TYPES,
+    [STAT_MOVE] = RECALC_MOVES,
+    [STAT_ATK_EV] = RECALC_EVS,
+    [STAT_DEF_EV] = RECALC_EVS,
+    [STAT_SPD_EV] = RECALC_EVS,
+    [STAT_SPC_EV] = RECALC_EVS,
+    [STAT_SPC_ATK_EV] = RECALC_EVS,
+    [STAT_SPC_DEF_EV] = RECALC_EVS,
+    [STAT_HP_EV] = RECALC_EVS,
+    [STAT_IV] = RECALC_IVS,
+    [STAT_ATK_IV] = RECALC_IVS,
+    [STAT_DEF_IV] = RECALC_IVS,
+    [STAT_SPD_IV] = RECALC_IVS,
+    [STAT_SPC_IV] = RECALC_IVS,
+    [STAT_SPC_ATK_IV] = RECALC_IVS,
+    [STAT_SPC_DEF_IV] = RECALC_IVS,
+    [STAT_HP_IV] = RECALC_IVS,
+    [STAT_NICKNAME] = RECALC_NICKNAME,
+    [STAT_EXP] = RECALC_EXP,
+};
+
 /* Allocates a chunk of memory for the trade data block and sets up some
- * default values.
+ * default values. The party starts with a single Pokemon in the first slot.
  */
 PokemonData* pokemon_data_alloc(uint8_t gen) {
     PokemonData* pdata;
 
     pdata = malloc(sizeof(PokemonData));
+    memset(pdata, '\0', sizeof(PokemonData));
     pdata->gen = gen;
+    /* Everything is dirty until the first time the patch list consumes it */
+    memset(pdata->party_dirty, 0xFF, sizeof(pdata->party_dirty));
 
     /* Set up lists */
-    pdata->move_list = move_list;
-    pdata->type_list = type_list;
-    pdata->stat_list = stat_list;
-    pdata->item_list = item_list;
+    pdata->move_list = &move_list;
+    pdata->type_list = &type_list;
+    pdata->stat_list = &stat_list;
+    pdata->item_list = &item_list;
     pdata->pokemon_table = table_pointer_get();
 
     pdata->storage = furi_record_open(RECORD_STORAGE);
@@ -129,7 +240,7 @@ PokemonData* pokemon_data_alloc(uint8_t gen) {
     case GEN_I:
         /* Allocate trade block and set its size for the trade view to use */
         pdata->trade_block_sz = sizeof(TradeBlockGenI);
-        pdata->party_sz = sizeof(PokemonPartyGenI) * 6;
+        pdata->party_sz = sizeof(PokemonPartyGenI) * PARTY_CNT_MAX;
         pdata->trade_block = malloc(pdata->trade_block_sz);
 
         /* The party_members element needs to be 0xff for unused */
@@ -139,9 +250,7 @@ PokemonData* pokemon_data_alloc(uint8_t gen) {
             sizeof(((TradeBlockGenI*)pdata->trade_block)->party_members));
 
         pdata->party = ((TradeBlockGenI*)pdata->trade_block)->party;
-
-        /* Set party count to 1 */
-        ((TradeBlockGenI*)pdata->trade_block)->party_cnt = 1;
+        pdata->stat_fields = stat_fields_gen_i;
 
         /* Set the max pokedex number, 0 indexed */
         pdata->dex_max = 150;
@@ -149,7 +258,7 @@ PokemonData* pokemon_data_alloc(uint8_t gen) {
     case GEN_II:
         /* Allocate trade block and set its size for the trade view to use */
         pdata->trade_block_sz = sizeof(TradeBlockGenII);
-        pdata->party_sz = sizeof(PokemonPartyGenII) * 6;
+        pdata->party_sz = sizeof(PokemonPartyGenII) * PARTY_CNT_MAX;
         pdata->trade_block = malloc(pdata->trade_block_sz);
 
         /* The party_members element needs to be 0xff for unused */
@@ -159,9 +268,10 @@ PokemonData* pokemon_data_alloc(uint8_t gen) {
             sizeof(((TradeBlockGenII*)pdata->trade_block)->party_members));
 
         pdata->party = ((TradeBlockGenII*)pdata->trade_block)->party;
+        pdata->stat_fields = stat_fields_gen_ii;
 
-        /* Set party count to 1 */
-        ((TradeBlockGenII*)pdata->trade_block)->party_cnt = 1;
+        pdata->mail = malloc(sizeof(MailBlockGenII));
+        memset(pdata->mail, '\0', sizeof(MailBlockGenII));
 
         /* Set the max pokedex number, 0 indexed */
         pdata->dex_max = 250;
@@ -171,12 +281,86 @@ PokemonData* pokemon_data_alloc(uint8_t gen) {
         break;
     }
 
-    /* Trainer/OT name, not to exceed 7 characters! */
-    pokemon_name_set(pdata, STAT_TRAINER_NAME, "Flipper");
-    pokemon_name_set(pdata, STAT_OT_NAME, "Flipper");
+    /* Trainer name, not to exceed 7 characters! */
+    pokemon_name_set(pdata, 0, STAT_TRAINER_NAME, "Flipper");
+
+    pokemon_party_add(pdata);
+    pokemon_recalculate_pending(pdata);
+
+    return pdata;
+}
+
+void pokemon_data_free(PokemonData* pdata) {
+    furi_record_close(RECORD_STORAGE);
+    free(pdata->trade_block);
+    free(pdata->mail);
+    if(pdata->sprites) sprite_cache_free(pdata->sprites);
+    furi_string_free(pdata->asset_path);
+    free(pdata);
+}
+
+/* Pointers to the party count and the party_members species list. These are
+ * at the same offsets in both generations, but go through the gen specific
+ * structs anyway to not rely on that.
+ */
+static uint8_t* pokemon_party_cnt_ptr(PokemonData* pdata) {
+    if(pdata->gen == GEN_I) return &((TradeBlockGenI*)pdata->trade_block)->party_cnt;
+    return &((TradeBlockGenII*)pdata->trade_block)->party_cnt;
+}
+
+static uint8_t* pokemon_party_members_ptr(PokemonData* pdata) {
+    if(pdata->gen == GEN_I) return ((TradeBlockGenI*)pdata->trade_block)->party_members;
+    return ((TradeBlockGenII*)pdata->trade_block)->party_members;
+}
+
+/* Pointer to the party struct for slot, and the nickname or OT name for slot */
+static void* pokemon_party_member_ptr(PokemonData* pdata, uint8_t slot) {
+    furi_check(slot < PARTY_CNT_MAX);
+    return (uint8_t*)pdata->party + (slot * (pdata->party_sz / PARTY_CNT_MAX));
+}
+
+static Name* pokemon_party_name_ptr(PokemonData* pdata, uint8_t slot, DataStat stat) {
+    furi_check(slot < PARTY_CNT_MAX);
+    if(pdata->gen == GEN_I) {
+        if(stat == STAT_NICKNAME) return &((TradeBlockGenI*)pdata->trade_block)->nickname[slot];
+        return &((TradeBlockGenI*)pdata->trade_block)->ot_name[slot];
+    }
+    if(stat == STAT_NICKNAME) return &((TradeBlockGenII*)pdata->trade_block)->nickname[slot];
+    return &((TradeBlockGenII*)pdata->trade_block)->ot_name[slot];
+}
+
+uint8_t pokemon_party_cnt_get(PokemonData* pdata) {
+    furi_assert(pdata);
+    return *pokemon_party_cnt_ptr(pdata);
+}
+
+/* Blank out the mail of slot, so a mail item shows an empty letter */
+static void pokemon_party_mail_clear(PokemonData* pdata, uint8_t slot) {
+    if(!pdata->mail) return;
+
+    memset(pdata->mail->message[slot], TERM_, LEN_MAIL_MSG);
+    memset(&pdata->mail->meta[slot], '\0', sizeof(pdata->mail->meta[slot]));
+    memset(pdata->mail->meta[slot].author, TERM_, sizeof(pdata->mail->meta[slot].author));
+}
+
+/* Set up the next free party slot with the same defaults as a fresh
+ * PokemonData and return its slot number.
+ */
+uint8_t pokemon_party_add(PokemonData* pdata) {
+    furi_assert(pdata);
+    uint8_t* party_cnt = pokemon_party_cnt_ptr(pdata);
+    uint8_t slot = *party_cnt;
+
+    furi_check(slot < PARTY_CNT_MAX);
+    (*party_cnt)++;
+
+    pokemon_party_mail_clear(pdata, slot);
+
+    /* OT name, not to exceed 7 characters! */
+    pokemon_name_set(pdata, slot, STAT_OT_NAME, "Flipper");
 
     /* OT trainer ID# */
-    pokemon_stat_set(pdata, STAT_OT_ID, NONE, 42069);
+    pokemon_stat_set(pdata, slot, STAT_OT_ID, NONE, 42069);
 
     /* Notes:
      * Move pp isn't explicitly set up, should be fine
@@ -186,18 +370,96 @@ PokemonData* pokemon_data_alloc(uint8_t gen) {
 
     /* Set up initial pokemon and level */
     /* This causes all other stats to be recalculated */
-    pokemon_stat_set(pdata, STAT_NUM, NONE, 0); // First Pokemon
-    pokemon_stat_set(pdata, STAT_LEVEL, NONE, 2); // Minimum level of 2
+    pokemon_stat_set(pdata, slot, STAT_NUM, NONE, 0); // First Pokemon
+    pokemon_stat_set(pdata, slot, STAT_LEVEL, NONE, 2); // Minimum level of 2
 
-    return pdata;
+    FURI_LOG_D(TAG, "[data] added party slot %d", slot);
+
+    return slot;
 }
 
-void pokemon_data_free(PokemonData* pdata) {
-    furi_record_close(RECORD_STORAGE);
-    free(pdata->trade_block);
-    if(pdata->bitmap && pdata->bitmap_num != 0) free(pdata->bitmap);
-    furi_string_free(pdata->asset_path);
-    free(pdata);
+/* Remove slot from the party, every slot after it moves up by one. The last
+ * Pokemon can never be removed.
+ */
+void pokemon_party_remove(PokemonData* pdata, uint8_t slot) {
+    furi_assert(pdata);
+    uint8_t* party_cnt = pokemon_party_cnt_ptr(pdata);
+    uint8_t* party_members = pokemon_party_members_ptr(pdata);
+    size_t member_sz = pdata->party_sz / PARTY_CNT_MAX;
+    uint8_t last;
+
+    furi_check(*party_cnt > 1 && slot < *party_cnt);
+    last = *party_cnt - 1;
+
+    memmove(
+        pokemon_party_member_ptr(pdata, slot),
+        pokemon_party_member_ptr(pdata, slot + 1),
+        (last - slot) * member_sz);
+    memmove(
+        pokemon_party_name_ptr(pdata, slot, STAT_NICKNAME),
+        pokemon_party_name_ptr(pdata, slot + 1, STAT_NICKNAME),
+        (last - slot) * sizeof(Name));
+    memmove(
+        pokemon_party_name_ptr(pdata, slot, STAT_OT_NAME),
+        pokemon_party_name_ptr(pdata, slot + 1, STAT_OT_NAME),
+        (last - slot) * sizeof(Name));
+    memmove(&party_members[slot], &party_members[slot + 1], last - slot);
+    memmove(&pdata->stat_sel[slot], &pdata->stat_sel[slot + 1], (last - slot) * sizeof(EvIv));
+    memmove(&pdata->recalc_pending[slot], &pdata->recalc_pending[slot + 1], last - slot);
+    if(pdata->mail) {
+        memmove(
+            pdata->mail->message[slot],
+            pdata->mail->message[slot + 1],
+            (last - slot) * LEN_MAIL_MSG);
+        memmove(
+            &pdata->mail->meta[slot],
+            &pdata->mail->meta[slot + 1],
+            (last - slot) * sizeof(pdata->mail->meta[0]));
+    }
+
+    /* Clear out the now unused last slot */
+    memset(pokemon_party_member_ptr(pdata, last), '\0', member_sz);
+    memset(pokemon_party_name_ptr(pdata, last, STAT_NICKNAME), TERM_, sizeof(Name));
+    memset(pokemon_party_name_ptr(pdata, last, STAT_OT_NAME), TERM_, sizeof(Name));
+    party_members[last] = 0xFF;
+    pdata->stat_sel[last] = 0;
+    pdata->recalc_pending[last] = RECALC_NONE;
+    pokemon_party_mail_clear(pdata, last);
+
+    *party_cnt = last;
+
+    /* Keep the same Pokemon selected, or the new last one if it was removed */
+    if(pdata->party_sel > slot) pdata->party_sel--;
+    if(pdata->party_sel >= last) pdata->party_sel = last - 1;
+
+    pokemon_party_dirty_mark(pdata, slot * member_sz, (last + 1 - slot) * member_sz);
+    FURI_LOG_D(TAG, "[data] removed party slot %d", slot);
+}
+
+/* Mark len bytes of the party, starting at offs, as modified. Safe to call
+ * from an ISR.
+ */
+void pokemon_party_dirty_mark(PokemonData* pdata, size_t offs, size_t len) {
+    furi_assert(pdata);
+    furi_check((offs + len) <= pdata->party_sz);
+
+    for(; len > 0; len--, offs++) {
+        pdata->party_dirty[offs / 8] |= (1 << (offs % 8));
+    }
+}
+
+/* Compare a party member against a copy taken before it was modified and
+ * mark only the bytes that actually changed.
+ */
+static void
+    pokemon_party_dirty_diff(PokemonData* pdata, uint8_t slot, uint8_t* before, size_t len) {
+    uint8_t* party_flat = pokemon_party_member_ptr(pdata, slot);
+    size_t offs = slot * len;
+    size_t i;
+
+    for(i = 0; i < len; i++) {
+        if(party_flat[i] != before[i]) pokemon_party_dirty_mark(pdata, offs + i, 1);
+    }
 }
 
 /* Recalculate values and stats based on their dependencies.
@@ -213,24 +475,25 @@ void pokemon_data_free(PokemonData* pdata) {
  * nickname:	depends on:	index
  * atk/def/etc:	depends on:	level, iv, ev, index
  */
-void pokemon_recalculate(PokemonData* pdata, uint8_t recalc) {
+void pokemon_recalculate(PokemonData* pdata, uint8_t slot, uint8_t recalc) {
     furi_assert(pdata);
     int i;
 
     if(recalc == RECALC_NONE) return;
 
     /* Ordered in order of priority for calculating other stats */
-    if(recalc & RECALC_NICKNAME) pokemon_default_nickname_set(NULL, pdata, 0);
+    if(recalc & RECALC_NICKNAME) pokemon_default_nickname_set(NULL, pdata, slot, 0);
 
     if(recalc & RECALC_MOVES) {
         for(i = MOVE_0; i <= MOVE_3; i++) {
             pokemon_stat_set(
                 pdata,
+                slot,
                 STAT_MOVE,
                 i,
                 table_stat_base_get(
                     pdata->pokemon_table,
-                    pokemon_stat_get(pdata, STAT_NUM, NONE),
+                    pokemon_stat_get(pdata, slot, STAT_NUM, NONE),
                     STAT_BASE_MOVE,
                     i));
         }
@@ -240,50 +503,74 @@ void pokemon_recalculate(PokemonData* pdata, uint8_t recalc) {
         for(i = TYPE_0; i <= TYPE_1; i++) {
             pokemon_stat_set(
                 pdata,
+                slot,
                 STAT_TYPE,
                 i,
                 table_stat_base_get(
                     pdata->pokemon_table,
-                    pokemon_stat_get(pdata, STAT_NUM, NONE),
+                    pokemon_stat_get(pdata, slot, STAT_NUM, NONE),
                     STAT_BASE_TYPE,
                     i));
         }
     }
 
-    if(recalc & RECALC_EXP) pokemon_exp_calc(pdata);
+    if(recalc & RECALC_EXP) pokemon_exp_calc(pdata, slot);
 
-    if(recalc & RECALC_EVS) pokemon_stat_ev_calc(pdata, pdata->stat_sel);
+    if(recalc & RECALC_EVS) pokemon_stat_ev_calc(pdata, slot, pdata->stat_sel[slot]);
 
     /* This just rerolls the IVs, nothing really to calculate */
-    if(recalc & RECALC_IVS) pokemon_stat_iv_calc(pdata, pdata->stat_sel);
+    if(recalc & RECALC_IVS) pokemon_stat_iv_calc(pdata, slot, pdata->stat_sel[slot]);
 
-    /* Note: This will still end up calculating spc_def on gen i pokemon.
-     * However, the way the accessors are set up the calculated value will
-     * never be written anywhere. This is just wasted CPU time.
-     */
-    if(recalc & RECALC_STATS) {
-        for(i = STAT; i < STAT_END; i++) {
-            pokemon_stat_calc(pdata, i);
-        }
+    if(recalc & RECALC_STATS) pokemon_stats_calc(pdata, slot);
+}
+
+/* Run any recalculation pending on slot that would change stat */
+static void pokemon_recalculate_for(PokemonData* pdata, uint8_t slot, DataStat stat) {
+    uint8_t recalc = pdata->recalc_pending[slot];
+
+    if(!(recalc & stat_recalc_out[stat])) return;
+
+    /* Clear it first, recalculating reads and writes the same stats */
+    pdata->recalc_pending[slot] = RECALC_NONE;
+    pokemon_recalculate(pdata, slot, recalc);
+}
+
+/* Setting a stat only marks what depends on it as pending. Everything pending
+ * is resolved in one go, either when a dependent value is read or written, or
+ * by this before the trade block is used as a whole.
+ */
+void pokemon_recalculate_pending(PokemonData* pdata) {
+    furi_assert(pdata);
+    uint8_t recalc;
+    uint8_t slot;
+
+    for(slot = 0; slot < PARTY_CNT_MAX; slot++) {
+        recalc = pdata->recalc_pending[slot];
+        if(recalc == RECALC_NONE) continue;
+
+        pdata->recalc_pending[slot] = RECALC_NONE;
+        pokemon_recalculate(pdata, slot, recalc);
     }
 }
 
 /* This needs to convert to encoded characters */
-void pokemon_name_set(PokemonData* pdata, DataStat stat, char* name) {
+void pokemon_name_set(PokemonData* pdata, uint8_t slot, DataStat stat, char* name) {
     furi_assert(pdata);
     size_t len;
     uint8_t gen = pdata->gen;
     uint8_t* ptr = NULL;
 
+    if(stat == STAT_NICKNAME) pokemon_recalculate_for(pdata, slot, stat);
+
     switch(stat) {
     case STAT_NICKNAME:
-        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->nickname[0].str;
-        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->nickname[0].str;
+        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->nickname[slot].str;
+        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->nickname[slot].str;
         len = 10;
         break;
     case STAT_OT_NAME:
-        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->ot_name[0].str;
-        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->ot_name[0].str;
+        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->ot_name[slot].str;
+        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->ot_name[slot].str;
         len = 7;
         break;
     case STAT_TRAINER_NAME:
@@ -296,38 +583,39 @@ void pokemon_name_set(PokemonData* pdata, DataStat stat, char* name) {
         break;
     }
 
-    /* Clear the buffer with TERM character */
-    memset(ptr, TERM_, LEN_NAME_BUF);
-
-    /* Set the encoded name in the buffer */
-    pokemon_str_to_encoded_array(ptr, name, len);
-    FURI_LOG_D(TAG, "[data] %s name set to %s", stat_text_get(stat), name);
+    /* Set the encoded name in the buffer, the rest is filled with TERM_ */
+    pokemon_name_encode(ptr, LEN_NAME_BUF, name, len);
+    FURI_LOG_D(TAG, "[data] %s:%d name set to %s", stat_text_get(stat), slot, name);
 }
 
-void pokemon_name_get(PokemonData* pdata, DataStat stat, char* dest, size_t len) {
+void pokemon_name_get(PokemonData* pdata, uint8_t slot, DataStat stat, char* dest, size_t len) {
     furi_assert(pdata);
     uint8_t* ptr = NULL;
     uint8_t gen = pdata->gen;
 
+    if(stat == STAT_NICKNAME) pokemon_recalculate_for(pdata, slot, stat);
+
     switch(stat) {
     case STAT_NICKNAME:
-        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->nickname[0].str;
-        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->nickname[0].str;
+        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->nickname[slot].str;
+        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->nickname[slot].str;
         break;
     case STAT_OT_NAME:
-        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->ot_name[0].str;
-        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->ot_name[0].str;
+        if(gen == GEN_I) ptr = ((TradeBlockGenI*)pdata->trade_block)->ot_name[slot].str;
+        if(gen == GEN_II) ptr = ((TradeBlockGenII*)pdata->trade_block)->ot_name[slot].str;
         break;
     default:
         furi_crash("name_get invalid");
         break;
     }
 
-    pokemon_encoded_array_to_str(dest, ptr, len);
+    /* Names are at most LEN_NAME_BUF - 1 characters plus TERM_ */
+    if(len > LEN_NAME_BUF) len = LEN_NAME_BUF;
+    pokemon_name_decode(dest, len, ptr);
 }
 
 /* If dest is not NULL, a copy of the default name is written to it as well */
-void pokemon_default_nickname_set(char* dest, PokemonData* pdata, size_t n) {
+void pokemon_default_nickname_set(char* dest, PokemonData* pdata, uint8_t slot, size_t n) {
     furi_assert(pdata);
     unsigned int i;
     char buf[LEN_NAME_BUF];
@@ -335,7 +623,7 @@ void pokemon_default_nickname_set(char* dest, PokemonData* pdata, size_t n) {
     /* First, get the default name */
     strncpy(
         buf,
-        table_stat_name_get(pdata->pokemon_table, pokemon_stat_get(pdata, STAT_NUM, NONE)),
+        table_stat_name_get(pdata->pokemon_table, pokemon_stat_get(pdata, slot, STAT_NUM, NONE)),
         sizeof(buf));
 
     /* Next, walk through and toupper() each character */
@@ -343,7 +631,7 @@ void pokemon_default_nickname_set(char* dest, PokemonData* pdata, size_t n) {
         buf[i] = toupper(buf[i]);
     }
 
-    pokemon_name_set(pdata, STAT_NICKNAME, buf);
+    pokemon_name_set(pdata, slot, STAT_NICKNAME, buf);
     FURI_LOG_D(TAG, "[data] Set default nickname");
 
     if(dest != NULL) {
@@ -351,411 +639,239 @@ void pokemon_default_nickname_set(char* dest, PokemonData* pdata, size_t n) {
     }
 }
 
-/* Each sprite 56x56 is 404 bytes long */
-uint8_t* pokemon_icon_get(PokemonData* pdata, int num) {
-    furi_assert(pdata);
-    File* file;
+/* The sprite cache is only set up the first time a sprite is needed. The
+ * compressed pack is used if there is one, otherwise the legacy pack that may
+ * be left over on the SD card from an older version.
+ */
+static struct sprite_cache* pokemon_sprites_get(PokemonData* pdata) {
     FuriString* path;
-    uint32_t size;
-    bool is_error = true;
-
-    if(pdata->bitmap_num != num) {
-        if(pdata->bitmap) {
-            free(pdata->bitmap);
-            pdata->bitmap = NULL;
-        }
 
-        file = storage_file_alloc(pdata->storage);
+    if(!pdata->sprites) {
         path = furi_string_alloc_set(pdata->asset_path);
-        furi_string_cat_printf(path, "all_sprites.fxbm");
-
-        if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
-            storage_file_seek(file, (num - 1) * FXBM_SPRITE_SIZE, true);
-            if(storage_file_read(file, &size, sizeof(size)) == sizeof(size)) {
-                pdata->bitmap = malloc(size);
-                if(storage_file_read(file, pdata->bitmap, size) ==
-                   FXBM_SPRITE_SIZE - sizeof(size)) {
-                    FURI_LOG_D(TAG, "Opened file \'%s\'", furi_string_get_cstr(path));
-                    is_error = false;
-                } else {
-                    free(pdata->bitmap);
-                }
-            }
+        furi_string_cat_printf(path, "all_sprites.pksp");
+        if(!storage_file_exists(pdata->storage, furi_string_get_cstr(path))) {
+            furi_string_set(path, pdata->asset_path);
+            furi_string_cat_printf(path, "all_sprites.fxbm");
         }
+        pdata->sprites = sprite_cache_alloc(pdata->storage, furi_string_get_cstr(path));
+        furi_string_free(path);
+    }
 
-        if(is_error) {
-            FURI_LOG_E(
-                TAG, "Failed to open \'%s\' or access sprite data", furi_string_get_cstr(path));
-            pdata->bitmap = (struct fxbm_sprite*)((uint8_t*)(__000_fxbm) + sizeof(size));
-            num = 0;
-        }
+    return pdata->sprites;
+}
 
-        storage_file_free(file);
-        furi_string_free(path);
+/* The built in placeholder sprite also has the 4 byte length at the start */
+static inline const struct fxbm_sprite* pokemon_icon_placeholder(void) {
+    return (const struct fxbm_sprite*)((uint8_t*)(__000_fxbm) + sizeof(uint32_t));
+}
 
-        pdata->bitmap_num = num;
-    }
+const struct fxbm_sprite* pokemon_icon_get(PokemonData* pdata, int num) {
+    furi_assert(pdata);
+    const struct fxbm_sprite* sprite;
 
-    return (uint8_t*)pdata->bitmap;
+    sprite = sprite_cache_get(pokemon_sprites_get(pdata), num);
+    if(!sprite) sprite = pokemon_icon_placeholder();
+
+    return sprite;
 }
 
-uint16_t pokemon_stat_get(PokemonData* pdata, DataStat stat, DataStatSub which) {
+const struct fxbm_sprite* pokemon_icon_peek(PokemonData* pdata, int num, int dir) {
     furi_assert(pdata);
-    void* party = pdata->party;
-    int gen = pdata->gen;
-    uint16_t val = 0;
+    struct sprite_cache* sprites = pokemon_sprites_get(pdata);
+    const struct fxbm_sprite* sprite;
+
+    sprite_cache_prefetch(sprites, num, dir, 1, pdata->dex_max + 1);
+    sprite = sprite_cache_peek(sprites, num);
+    if(!sprite) sprite = pokemon_icon_placeholder();
+
+    return sprite;
+}
+
+void pokemon_icon_callback_set(PokemonData* pdata, void (*callback)(void*), void* context) {
+    furi_assert(pdata);
+
+    sprite_cache_callback_set(pokemon_sprites_get(pdata), callback, context);
+}
+
+/* HP IV is calculated as the LSB of each other IV, assembled in the same bit
+ * order down to a single nibble. iv is as stored, in GB byte order.
+ */
+static uint8_t pokemon_hp_iv_get(uint16_t iv) {
     uint8_t hp_iv = 0;
 
-    switch(stat) {
-    case STAT_ATK:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->atk;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->atk;
-        break;
-    case STAT_DEF:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->def;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->def;
-        break;
-    case STAT_SPD:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->spd;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->spd;
-        break;
-    case STAT_SPC:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->spc;
-        break;
-    case STAT_SPC_ATK:
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->spc_atk;
-        break;
-    case STAT_SPC_DEF:
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->spc_def;
-        break;
-    case STAT_HP:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->hp;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->hp;
-        break;
-    case STAT_ATK_EV:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->atk_ev;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->atk_ev;
-        break;
-    case STAT_DEF_EV:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->def_ev;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->def_ev;
-        break;
-    case STAT_SPD_EV:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->spd_ev;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->spd_ev;
-        break;
-    case STAT_SPC_EV:
-    case STAT_SPC_ATK_EV:
-    case STAT_SPC_DEF_EV:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->spc_ev;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->spc_ev;
-        break;
-    case STAT_HP_EV:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->hp_ev;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->hp_ev;
-        break;
-    case STAT_IV:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->iv;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->iv;
-        break;
-    /* The IVs in GB byte order, are always:
-     * atk, def, spd, spc
-     * Like every other 16 bit quantity that the Flipper acts on, we need to
-     * bytw swap them normally. However, the below accessors for individual
-     * IV nibbles directly pull from the data structures which will always
-     * be in GB endianness.
-     */
-    case STAT_SPD_IV:
-        if(gen == GEN_I) return (((PokemonPartyGenI*)party)->iv >> 12) & 0x0F;
-        if(gen == GEN_II) return (((PokemonPartyGenII*)party)->iv >> 12) & 0x0F;
-        break;
-    /* In order to line up all of the dynamic stat accessors used as part of the
-     * stat calculation loop, we need to overload the SPC IV accessor to allow
-     * accessing SPC, SPC_ATK, and SPC_DEF. Note that only SPC exists, the ATK
-     * and DEF are the overloaded values. This is so when, for example, gen i
-     * calculates its SPC value, or gen ii calculates is SPC_DEF value, it will
-     * always grab the same IV nibble.
-     */
-    case STAT_SPC_IV:
-    case STAT_SPC_ATK_IV:
-    case STAT_SPC_DEF_IV:
-        if(gen == GEN_I) return (((PokemonPartyGenI*)party)->iv >> 8) & 0x0F;
-        if(gen == GEN_II) return (((PokemonPartyGenII*)party)->iv >> 8) & 0x0F;
-        break;
-    case STAT_ATK_IV:
-        if(gen == GEN_I) return (((PokemonPartyGenI*)party)->iv >> 4) & 0x0F;
-        if(gen == GEN_II) return (((PokemonPartyGenII*)party)->iv >> 4) & 0x0F;
-        break;
-    case STAT_DEF_IV:
-        if(gen == GEN_I) return ((PokemonPartyGenI*)party)->iv & 0x0F;
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->iv & 0x0F;
-        break;
-    case STAT_HP_IV:
-        /* NOTE:
-	 * HP IV is calculated as the LSB of each other IV, assembled in the
-	 * same bit order down to a single nibble.
-	 */
-        if(gen == GEN_I) val = (((PokemonPartyGenI*)party)->iv);
-        if(gen == GEN_II) val = (((PokemonPartyGenII*)party)->iv);
-        /* NOTE:
-	 * As noted above, we store the IV in the trade struct in the byte order
-	 * of the gameboy which is swapped from the Flipper's byte order.
-	 */
-        hp_iv |= ((val & 0x0010) >> 1); // ATK IV, MSbit of the hp_iv nibble
-        hp_iv |= ((val & 0x0001) << 2); // DEF IV, right of ATK IV in hp_iv nibble
-        hp_iv |= ((val & 0x1000) >> 11); // SPD IV, right of DEF IV in hp_iv nibble
-        hp_iv |= ((val & 0x0100) >> 8); // SPC IV, right of SPD IV in hp_iv nibble
-        return hp_iv;
-        break;
-    case STAT_LEVEL:
-        if(gen == GEN_I) return ((PokemonPartyGenI*)party)->level;
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->level;
-        break;
-    case STAT_INDEX:
-        if(gen == GEN_I) return ((PokemonPartyGenI*)party)->index;
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->index - 1;
-        break;
-    /* In Gen I, index is not relative at all to dex num.
-     * In Gen II, index is the same as the dex num.
-     */
-    case STAT_NUM:
-        if(gen == GEN_I) {
-            val = ((PokemonPartyGenI*)party)->index;
-            return table_pokemon_pos_get(pdata->pokemon_table, val);
-        }
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->index - 1;
-        break;
-    case STAT_MOVE:
-        if(gen == GEN_I) return ((PokemonPartyGenI*)party)->move[which];
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->move[which];
-        break;
-    case STAT_TYPE:
-        if(gen == GEN_I) return ((PokemonPartyGenI*)party)->type[which];
-        break;
-    case STAT_OT_ID:
-        if(gen == GEN_I) val = ((PokemonPartyGenI*)party)->ot_id;
-        if(gen == GEN_II) val = ((PokemonPartyGenII*)party)->ot_id;
-        break;
-    case STAT_POKERUS:
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->pokerus;
-        break;
-    case STAT_SEL:
-        if(gen == GEN_I) return pdata->stat_sel;
-        if(gen == GEN_II) return pdata->stat_sel;
-        break;
-    case STAT_CONDITION:
-        if(gen == GEN_I) return ((PokemonPartyGenI*)party)->status_condition = val;
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->status_condition = val;
-        break;
-    case STAT_HELD_ITEM:
-        if(gen == GEN_II) return ((PokemonPartyGenII*)party)->held_item;
-        break;
-    default:
-        furi_crash("STAT_GET: invalid stat");
-        break;
+    hp_iv |= ((iv & 0x0010) >> 1); // ATK IV, MSbit of the hp_iv nibble
+    hp_iv |= ((iv & 0x0001) << 2); // DEF IV, right of ATK IV in hp_iv nibble
+    hp_iv |= ((iv & 0x1000) >> 11); // SPD IV, right of DEF IV in hp_iv nibble
+    hp_iv |= ((iv & 0x0100) >> 8); // SPC IV, right of SPD IV in hp_iv nibble
+
+    return hp_iv;
+}
+
+static const struct stat_field* pokemon_stat_field_get(PokemonData* pdata, DataStat stat) {
+    furi_check(stat < STAT_DATA_END);
+
+    return &pdata->stat_fields[stat];
+}
+
+static uint16_t pokemon_field_get(
+    PokemonData* pdata,
+    const uint8_t* member,
+    const struct stat_field* field,
+    DataStatSub which) {
+    const uint8_t* ptr = member + field->offs;
+    uint16_t val;
+
+    if(field->flags & FIELD_ABSENT) return 0;
+
+    if(field->flags & FIELD_U16)
+        val = (ptr[0] << 8) | ptr[1];
+    else if(field->flags & FIELD_NIBBLE)
+        val = ((ptr[0] | (ptr[1] << 8)) >> field->shift) & 0x0F;
+    else if(field->flags & FIELD_HP_IV)
+        val = pokemon_hp_iv_get(ptr[0] | (ptr[1] << 8));
+    else if(field->flags & FIELD_ARRAY)
+        val = ptr[which];
+    else
+        val = ptr[0];
+
+    if(field->flags & FIELD_DEX) return table_pokemon_pos_get(pdata->pokemon_table, val);
+
+    return val + field->bias;
+}
+
+static void pokemon_field_write(uint8_t* ptr, const struct stat_field* field, uint16_t val) {
+    uint16_t iv;
+
+    if(field->flags & FIELD_U16) {
+        ptr[0] = val >> 8;
+        ptr[1] = val;
+    } else if(field->flags & FIELD_NIBBLE) {
+        iv = ptr[0] | (ptr[1] << 8);
+        iv &= ~(0x0F << field->shift);
+        iv |= ((val & 0x0F) << field->shift);
+        ptr[0] = iv;
+        ptr[1] = iv >> 8;
+    } else {
+        ptr[0] = val;
+    }
+}
+
+static void pokemon_field_set(
+    PokemonData* pdata,
+    uint8_t* member,
+    const struct stat_field* field,
+    DataStatSub which,
+    uint16_t val) {
+    if(field->flags & FIELD_ABSENT) return;
+    if(field->flags & FIELD_HP_IV) furi_crash("STAT_SET: read only stat");
+
+    if(field->flags & FIELD_DEX)
+        val = table_stat_base_get(pdata->pokemon_table, val, STAT_BASE_INDEX, NONE);
+    val -= field->bias;
+
+    if(field->flags & FIELD_ARRAY) {
+        member[field->offs + which] = val;
+        return;
     }
 
-    return __builtin_bswap16(val);
+    pokemon_field_write(member + field->offs, field, val);
+    if(field->mirror) pokemon_field_write(member + field->mirror, field, val);
 }
 
-void pokemon_stat_set(PokemonData* pdata, DataStat stat, DataStatSub which, uint16_t val) {
+uint16_t pokemon_stat_get(PokemonData* pdata, uint8_t slot, DataStat stat, DataStatSub which) {
     furi_assert(pdata);
-    void* party = pdata->party;
-    int gen = pdata->gen;
-    uint8_t recalc = 0;
-    uint16_t val_swap = __builtin_bswap16(val);
+    uint8_t* member = pokemon_party_member_ptr(pdata, slot);
+    const struct stat_field* field = pokemon_stat_field_get(pdata, stat);
 
-    switch(stat) {
-    case STAT_ATK:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->atk = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->atk = val_swap;
-        break;
-    case STAT_DEF:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->def = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->def = val_swap;
-        break;
-    case STAT_SPD:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->spd = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->spd = val_swap;
-        break;
-    case STAT_SPC:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->spc = val_swap;
-        break;
-    case STAT_SPC_ATK:
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->spc_atk = val_swap;
-        break;
-    case STAT_SPC_DEF:
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->spc_def = val_swap;
-        break;
-    case STAT_HP:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->hp = val_swap;
-            ((PokemonPartyGenI*)party)->max_hp = val_swap;
-        }
-        if(gen == GEN_II) {
-            ((PokemonPartyGenII*)party)->hp = val_swap;
-            ((PokemonPartyGenII*)party)->max_hp = val_swap;
-        }
-        break;
-    case STAT_ATK_EV:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->atk_ev = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->atk_ev = val_swap;
-        break;
-    case STAT_DEF_EV:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->def_ev = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->def_ev = val_swap;
-        break;
-    case STAT_SPD_EV:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->spd_ev = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->spd_ev = val_swap;
-        break;
-    /* The SPC ATK/DEF EVs are not real values, we just pretend they are */
-    case STAT_SPC_EV:
-    case STAT_SPC_ATK_EV:
-    case STAT_SPC_DEF_EV:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->spc_ev = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->spc_ev = val_swap;
-        break;
-    case STAT_HP_EV:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->hp_ev = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->hp_ev = val_swap;
-        break;
-    case STAT_IV:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->iv = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->iv = val_swap;
-        break;
-    /* The IVs in GB byte order, are always:
-     * atk, def, spd, spc
-     * Like every other 16 bit quantity that the Flipper acts on, we need to
-     * bytw swap them normally. However, the below accessors for individual
-     * IV nibbles directly manipulate the data structures which will always
-     * be in GB endianness.
-     */
-    case STAT_SPD_IV:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->iv &= ~(0x0F << 12);
-            ((PokemonPartyGenI*)party)->iv |= ((val & 0x0F) << 12);
-        }
-        if(gen == GEN_II) {
-            ((PokemonPartyGenII*)party)->iv &= ~(0x0F << 12);
-            ((PokemonPartyGenII*)party)->iv |= ((val & 0x0F) << 12);
-        }
-        break;
-    /* In order to line up all of the dynamic stat accessors used as part of the
-     * stat calculation loop, we need to overload the SPC IV accessor to allow
-     * accessing SPC, SPC_ATK, and SPC_DEF. Note that only SPC exists, the ATK
-     * and DEF are the overloaded values. This is so when, for example, gen i
-     * calculates its SPC value, or gen ii calculates is SPC_DEF value, it will
-     * always grab the same IV nibble.
-     */
-    case STAT_SPC_IV:
-    case STAT_SPC_ATK_IV:
-    case STAT_SPC_DEF_IV:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->iv &= ~(0x0F << 8);
-            ((PokemonPartyGenI*)party)->iv |= ((val & 0x0F) << 8);
-        }
-        if(gen == GEN_II) {
-            ((PokemonPartyGenII*)party)->iv &= ~(0x0F << 8);
-            ((PokemonPartyGenII*)party)->iv |= ((val & 0x0F) << 8);
-        }
-        break;
-    case STAT_ATK_IV:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->iv &= ~(0x0F << 4);
-            ((PokemonPartyGenI*)party)->iv |= ((val & 0x0F) << 4);
-        }
-        if(gen == GEN_II) {
-            ((PokemonPartyGenII*)party)->iv &= ~(0x0F << 4);
-            ((PokemonPartyGenII*)party)->iv |= ((val & 0x0F) << 4);
-        }
-        break;
-    case STAT_DEF_IV:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->iv &= ~(0x0F);
-            ((PokemonPartyGenI*)party)->iv |= (val & 0x0F);
-        }
-        if(gen == GEN_II) {
-            ((PokemonPartyGenII*)party)->iv &= ~(0x0F);
-            ((PokemonPartyGenII*)party)->iv |= (val & 0x0F);
-        }
-        break;
-    case STAT_MOVE:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->move[which] = val;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->move[which] = val;
-        break;
-    case STAT_TYPE:
-        /* Gen II doesn't have type assignment */
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->type[which] = val;
-        break;
-    case STAT_LEVEL:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->level = val;
-            ((PokemonPartyGenI*)party)->level_again = val;
-        }
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->level = val;
-        recalc = (RECALC_STATS | RECALC_EXP | RECALC_EVS);
-        break;
-    /* In Gen I, index is not relative at all to dex num.
-     * In Gen II, index is the same as the dex num.
-     */
-    case STAT_INDEX:
-        if(gen == GEN_I) {
-            ((PokemonPartyGenI*)party)->index = val;
-            ((TradeBlockGenI*)pdata->trade_block)->party_members[0] = val;
-        }
-        if(gen == GEN_II) {
-            ((PokemonPartyGenII*)party)->index = val + 1;
-            ((TradeBlockGenII*)pdata->trade_block)->party_members[0] = val + 1;
-        }
-        recalc = RECALC_ALL; // Always recalculate everything if we selected a different pokemon
-        break;
-    case STAT_NUM:
-        if(gen == GEN_I)
-            pokemon_stat_set(
-                pdata,
-                STAT_INDEX,
-                NONE,
-                table_stat_base_get(pdata->pokemon_table, val, STAT_BASE_INDEX, NONE));
-        if(gen == GEN_II) pokemon_stat_set(pdata, STAT_INDEX, NONE, val);
-        break;
-    case STAT_OT_ID:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->ot_id = val_swap;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->ot_id = val_swap;
-        break;
-    case STAT_POKERUS:
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->pokerus = val;
-        break;
-    case STAT_SEL:
-        pdata->stat_sel = val;
-        recalc = (RECALC_EVS | RECALC_IVS | RECALC_STATS);
-        break;
-    case STAT_EXP:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->exp[which] = val;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->exp[which] = val;
-        break;
-    case STAT_CONDITION:
-        if(gen == GEN_I) ((PokemonPartyGenI*)party)->status_condition = val;
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->status_condition = val;
-        break;
-    case STAT_HELD_ITEM:
-        if(gen == GEN_II) ((PokemonPartyGenII*)party)->held_item = val;
-        break;
-    default:
-        furi_crash("STAT_SET: invalid stat");
-        break;
+    if(stat == STAT_SEL) return pdata->stat_sel[slot];
+
+    if(!field->flags) furi_crash("STAT_GET: invalid stat");
+    pokemon_recalculate_for(pdata, slot, stat);
+
+    return pokemon_field_get(pdata, member, field, which);
+}
+
+void pokemon_stat_set(
+    PokemonData* pdata,
+    uint8_t slot,
+    DataStat stat,
+    DataStatSub which,
+    uint16_t val) {
+    furi_assert(pdata);
+    uint8_t* member = pokemon_party_member_ptr(pdata, slot);
+    const struct stat_field* field = pokemon_stat_field_get(pdata, stat);
+    uint8_t before[sizeof(PokemonPartyGenII)];
+    size_t party_member_sz = pdata->party_sz / PARTY_CNT_MAX;
+
+    /* Anything pending that would overwrite this value has to happen first */
+    pokemon_recalculate_for(pdata, slot, stat);
+
+    /* Keep a copy to figure out what changed for the trade patch list */
+    memcpy(before, member, party_member_sz);
+
+    if(stat == STAT_SEL) {
+        pdata->stat_sel[slot] = val;
+    } else {
+        if(!field->flags) furi_crash("STAT_SET: invalid stat");
+        pokemon_field_set(pdata, member, field, which, val);
     }
-    FURI_LOG_D(TAG, "[data] stat %s:%d set to 0x%X", stat_text_get(stat), which, val);
-    pokemon_recalculate(pdata, recalc);
+
+    /* The species list has to match the party member's species index */
+    if(stat == STAT_INDEX || stat == STAT_NUM)
+        pokemon_party_members_ptr(pdata)[slot] = member[field->offs];
+
+    FURI_LOG_D(
+        TAG, "[data] slot %d stat %s:%d set to 0x%X", slot, stat_text_get(stat), which, val);
+    pokemon_party_dirty_diff(pdata, slot, before, party_member_sz);
+    pdata->recalc_pending[slot] |= stat_recalc[stat];
+}
+
+void pokemon_stat_block_get(PokemonData* pdata, uint8_t slot, StatBlock* block) {
+    furi_assert(pdata);
+    furi_assert(block);
+    const uint8_t* member = pokemon_party_member_ptr(pdata, slot);
+    const struct stat_field* fields = pdata->stat_fields;
+    DataStat i;
+
+    for(i = STAT; i < STAT_END; i++) {
+        block->stat[i] = pokemon_field_get(pdata, member, &fields[i], NONE);
+        block->ev[i] = pokemon_field_get(pdata, member, &fields[i + STAT_EV_OFFS], NONE);
+        block->iv[i] = pokemon_field_get(pdata, member, &fields[i + STAT_IV_OFFS], NONE);
+    }
+    block->level = pokemon_field_get(pdata, member, &fields[STAT_LEVEL], NONE);
+    block->num = pokemon_field_get(pdata, member, &fields[STAT_NUM], NONE);
+}
+
+void pokemon_stat_block_set(PokemonData* pdata, uint8_t slot, const StatBlock* block) {
+    furi_assert(pdata);
+    furi_assert(block);
+    uint8_t* member = pokemon_party_member_ptr(pdata, slot);
+    const struct stat_field* fields = pdata->stat_fields;
+    uint8_t before[sizeof(PokemonPartyGenII)];
+    size_t party_member_sz = pdata->party_sz / PARTY_CNT_MAX;
+    DataStat i;
+
+    memcpy(before, member, party_member_sz);
+
+    for(i = STAT; i < STAT_END; i++) {
+        pokemon_field_set(pdata, member, &fields[i], NONE, block->stat[i]);
+        /* SPC_ATK and SPC_DEF EV/IV are just SPC, and HP IV is derived */
+        if(i == STAT_SPC_ATK || i == STAT_SPC_DEF) continue;
+        pokemon_field_set(pdata, member, &fields[i + STAT_EV_OFFS], NONE, block->ev[i]);
+        if(i == STAT_HP) continue;
+        pokemon_field_set(pdata, member, &fields[i + STAT_IV_OFFS], NONE, block->iv[i]);
+    }
+
+    pokemon_party_dirty_diff(pdata, slot, before, party_member_sz);
 }
 
-static void pokemon_stat_ev_calc(PokemonData* pdata, EvIv val) {
+static void pokemon_stat_ev_calc(PokemonData* pdata, uint8_t slot, EvIv val) {
     furi_assert(pdata);
     int level;
     uint16_t ev;
     DataStat i;
 
-    level = pokemon_stat_get(pdata, STAT_LEVEL, NONE);
+    level = pokemon_stat_get(pdata, slot, STAT_LEVEL, NONE);
 
     /* Generate STATEXP */
     switch(val) {
@@ -773,11 +889,11 @@ static void pokemon_stat_ev_calc(PokemonData* pdata, EvIv val) {
     }
 
     for(i = STAT_EV; i < STAT_EV_END; i++) {
-        pokemon_stat_set(pdata, i, NONE, ev);
+        pokemon_stat_set(pdata, slot, i, NONE, ev);
     }
 }
 
-static void pokemon_stat_iv_calc(PokemonData* pdata, EvIv val) {
+static void pokemon_stat_iv_calc(PokemonData* pdata, uint8_t slot, EvIv val) {
     furi_assert(pdata);
     uint16_t iv;
 
@@ -793,7 +909,7 @@ static void pokemon_stat_iv_calc(PokemonData* pdata, EvIv val) {
         break;
     }
 
-    pokemon_stat_set(pdata, STAT_IV, NONE, iv);
+    pokemon_stat_set(pdata, slot, STAT_IV, NONE, iv);
 }
 
 #define UINT32_TO_EXP(input, output_array)                     \
@@ -803,7 +919,7 @@ static void pokemon_stat_iv_calc(PokemonData* pdata, EvIv val) {
         (output_array)[0] = (uint8_t)(((input) >> 16) & 0xFF); \
     } while(0)
 
-void pokemon_exp_set(PokemonData* pdata, uint32_t exp) {
+void pokemon_exp_set(PokemonData* pdata, uint8_t slot, uint32_t exp) {
     furi_assert(pdata);
     uint8_t exp_tmp[3];
     int i;
@@ -811,104 +927,174 @@ void pokemon_exp_set(PokemonData* pdata, uint32_t exp) {
     UINT32_TO_EXP(exp, exp_tmp);
 
     for(i = EXP_0; i <= EXP_2; i++) {
-        pokemon_stat_set(pdata, STAT_EXP, i, exp_tmp[i]);
+        pokemon_stat_set(pdata, slot, STAT_EXP, i, exp_tmp[i]);
     }
 
-    FURI_LOG_D(TAG, "[data] Set pkmn exp %d", (int)exp);
+    FURI_LOG_D(TAG, "[data] Set pkmn %d exp %d", slot, (int)exp);
 }
 
-void pokemon_exp_calc(PokemonData* pdata) {
+uint32_t pokemon_exp_get(PokemonData* pdata, uint8_t slot) {
     furi_assert(pdata);
-    int level;
-    uint32_t exp;
-    uint8_t growth = table_stat_base_get(
-        pdata->pokemon_table, pokemon_stat_get(pdata, STAT_NUM, NONE), STAT_BASE_GROWTH, NONE);
-
-    level = (int)pokemon_stat_get(pdata, STAT_LEVEL, NONE);
-    /* Calculate exp */
-    switch(growth) {
-    case GROWTH_FAST:
-        // https://bulbapedia.bulbagarden.net/wiki/Experience#Fast
-        exp = (4 * level * level * level) / 5;
-        break;
-    case GROWTH_MEDIUM_FAST:
-        // https://bulbapedia.bulbagarden.net/wiki/Experience#Medium_Fast
-        exp = (level * level * level);
-        break;
-    case GROWTH_MEDIUM_SLOW:
-        // https://bulbapedia.bulbagarden.net/wiki/Experience#Medium_Slow
-        exp = (((level * level * level) * 6 / 5) - (15 * level * level) + (100 * level) - 140);
-        break;
-    case GROWTH_SLOW:
-        // https://bulbapedia.bulbagarden.net/wiki/Experience#Slow
-        exp = (5 * level * level * level) / 4;
-        break;
-    default:
-        furi_crash("incorrect growth val");
-        break;
+
+    return ((uint32_t)pokemon_stat_get(pdata, slot, STAT_EXP, EXP_0) << 16) |
+           ((uint32_t)pokemon_stat_get(pdata, slot, STAT_EXP, EXP_1) << 8) |
+           pokemon_stat_get(pdata, slot, STAT_EXP, EXP_2);
+}
+
+static inline Growth pokemon_growth_get(PokemonData* pdata, uint8_t slot) {
+    return table_stat_base_get(
+        pdata->pokemon_table,
+        pokemon_stat_get(pdata, slot, STAT_NUM, NONE),
+        STAT_BASE_GROWTH,
+        NONE);
+}
+
+void pokemon_exp_calc(PokemonData* pdata, uint8_t slot) {
+    furi_assert(pdata);
+    uint8_t level = pokemon_stat_get(pdata, slot, STAT_LEVEL, NONE);
+
+    pokemon_exp_set(pdata, slot, table_exp_get(pokemon_growth_get(pdata, slot), level));
+}
+
+uint8_t pokemon_exp_level_get(PokemonData* pdata, uint8_t slot) {
+    furi_assert(pdata);
+
+    return table_level_get(pokemon_growth_get(pdata, slot), pokemon_exp_get(pdata, slot));
+}
+
+/* floor(sqrt(ev) / 4), the stat experience term of the stat formula. This
+ * is a bit by bit integer square root, 8 iterations covers all of ev. The
+ * Flipper's FPU is single precision only, so sqrt() on a double would end up
+ * in software.
+ */
+static inline uint8_t pokemon_stat_ev_term(uint16_t ev) {
+    uint32_t rem = ev;
+    uint32_t root = 0;
+    uint32_t bit = 1 << 14;
+
+    while(bit) {
+        if(rem >= root + bit) {
+            rem -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
     }
 
-    pokemon_exp_set(pdata, exp);
+    return root >> 2;
 }
 
-/* Calculates stat from current level */
-void pokemon_stat_calc(PokemonData* pdata, DataStat stat) {
+/* Gen I and II calculation:
+ * https://bulbapedia.bulbagarden.net/wiki/Stat#Generations_I_and_II
+ * floor((((2 * (base + iv)) + floor(sqrt(ev) / 4)) * level) / 100)
+ * Every term is a non-negative integer, so this is done entirely in integer
+ * math and is bit exact with the above.
+ */
+uint16_t pokemon_stat_calc(DataStat stat, uint8_t base, uint8_t iv, uint16_t ev, uint8_t level) {
+    uint16_t val = (((2 * (base + iv)) + pokemon_stat_ev_term(ev)) * level) / 100;
+
+    return val + ((stat == STAT_HP) ? (level + 10) : 5);
+}
+
+/* Calculates all stats from current level, base stats, IVs and EVs */
+void pokemon_stats_calc(PokemonData* pdata, uint8_t slot) {
     furi_assert(pdata);
-    uint8_t iv;
-    uint16_t ev;
-    uint8_t base;
-    uint8_t level;
-    uint16_t calc;
-
-    level = pokemon_stat_get(pdata, STAT_LEVEL, NONE);
-    base = table_stat_base_get(
-        pdata->pokemon_table, pokemon_stat_get(pdata, STAT_NUM, NONE), stat, NONE);
-    ev = pokemon_stat_get(pdata, stat + STAT_EV_OFFS, NONE);
-    iv = pokemon_stat_get(pdata, stat + STAT_IV_OFFS, NONE);
-
-    /* Gen I and II calculation */
-    // https://bulbapedia.bulbagarden.net/wiki/Stat#Generations_I_and_II
-    calc = floor((((2 * (base + iv)) + floor(sqrt(ev) / 4)) * level) / 100);
-
-    if(stat == STAT_HP)
-        calc += (level + 10);
-    else
-        calc += 5;
+    StatBlock block;
+    DataStat i;
+
+    pokemon_stat_block_get(pdata, slot, &block);
 
-    pokemon_stat_set(pdata, stat, NONE, calc);
+    for(i = STAT; i < STAT_END; i++) {
+        block.stat[i] = pokemon_stat_calc(
+            i,
+            table_stat_base_get(pdata->pokemon_table, block.num, i, NONE),
+            block.iv[i],
+            block.ev[i],
+            block.level);
+    }
+
+    pokemon_stat_block_set(pdata, slot, &block);
 }
 
-/* Copy the traded-in Pokemon's main data to our struct */
-void pokemon_stat_memcpy(PokemonData* dst, PokemonData* src, uint8_t which) {
+/* Copy the traded-in Pokemon's main data from src_slot of src in to dst_slot
+ * of dst.
+ */
+void pokemon_stat_memcpy(PokemonData* dst, uint8_t dst_slot, PokemonData* src, uint8_t src_slot) {
+    furi_check(dst_slot < PARTY_CNT_MAX && src_slot < PARTY_CNT_MAX);
+
+    /* Anything still pending for the source moves along with it, this can
+     * be called from an ISR so it is not resolved here.
+     */
+    dst->recalc_pending[dst_slot] = src->recalc_pending[src_slot];
+
     if(dst->gen == GEN_I) {
-        ((TradeBlockGenI*)dst->trade_block)->party_members[0] =
-            ((TradeBlockGenI*)src->trade_block)->party_members[which];
+        ((TradeBlockGenI*)dst->trade_block)->party_members[dst_slot] =
+            ((TradeBlockGenI*)src->trade_block)->party_members[src_slot];
         memcpy(
-            &(((TradeBlockGenI*)dst->trade_block)->party[0]),
-            &(((TradeBlockGenI*)src->trade_block)->party[which]),
+            &(((TradeBlockGenI*)dst->trade_block)->party[dst_slot]),
+            &(((TradeBlockGenI*)src->trade_block)->party[src_slot]),
             sizeof(PokemonPartyGenI));
         memcpy(
-            &(((TradeBlockGenI*)dst->trade_block)->nickname[0]),
-            &(((TradeBlockGenI*)src->trade_block)->nickname[which]),
+            &(((TradeBlockGenI*)dst->trade_block)->nickname[dst_slot]),
+            &(((TradeBlockGenI*)src->trade_block)->nickname[src_slot]),
             sizeof(struct name));
         memcpy(
-            &(((TradeBlockGenI*)dst->trade_block)->ot_name[0]),
-            &(((TradeBlockGenI*)src->trade_block)->ot_name[which]),
+            &(((TradeBlockGenI*)dst->trade_block)->ot_name[dst_slot]),
+            &(((TradeBlockGenI*)src->trade_block)->ot_name[src_slot]),
             sizeof(struct name));
+        pokemon_party_dirty_mark(
+            dst, dst_slot * sizeof(PokemonPartyGenI), sizeof(PokemonPartyGenI));
     } else if(dst->gen == GEN_II) {
-        ((TradeBlockGenII*)dst->trade_block)->party_members[0] =
-            ((TradeBlockGenII*)src->trade_block)->party_members[which];
+        ((TradeBlockGenII*)dst->trade_block)->party_members[dst_slot] =
+            ((TradeBlockGenII*)src->trade_block)->party_members[src_slot];
         memcpy(
-            &(((TradeBlockGenII*)dst->trade_block)->party[0]),
-            &(((TradeBlockGenII*)src->trade_block)->party[which]),
+            &(((TradeBlockGenII*)dst->trade_block)->party[dst_slot]),
+            &(((TradeBlockGenII*)src->trade_block)->party[src_slot]),
             sizeof(PokemonPartyGenII));
         memcpy(
-            &(((TradeBlockGenII*)dst->trade_block)->nickname[0]),
-            &(((TradeBlockGenII*)src->trade_block)->nickname[which]),
+            &(((TradeBlockGenII*)dst->trade_block)->nickname[dst_slot]),
+            &(((TradeBlockGenII*)src->trade_block)->nickname[src_slot]),
             sizeof(struct name));
         memcpy(
-            &(((TradeBlockGenII*)dst->trade_block)->ot_name[0]),
-            &(((TradeBlockGenII*)src->trade_block)->ot_name[which]),
+            &(((TradeBlockGenII*)dst->trade_block)->ot_name[dst_slot]),
+            &(((TradeBlockGenII*)src->trade_block)->ot_name[src_slot]),
             sizeof(struct name));
+        /* Mail goes wherever the Pokemon holding it goes */
+        memcpy(dst->mail->message[dst_slot], src->mail->message[src_slot], LEN_MAIL_MSG);
+        dst->mail->meta[dst_slot] = src->mail->meta[src_slot];
+        pokemon_party_dirty_mark(
+            dst, dst_slot * sizeof(PokemonPartyGenII), sizeof(PokemonPartyGenII));
     }
 }
+
+void pokemon_raw_get(PokemonData* pdata, uint8_t slot, PokemonRaw* raw) {
+    furi_assert(pdata);
+    furi_assert(raw);
+    size_t member_sz = pdata->party_sz / PARTY_CNT_MAX;
+
+    memset(raw, '\0', sizeof(PokemonRaw));
+    raw->gen = pdata->gen;
+    raw->species = pokemon_party_members_ptr(pdata)[slot];
+    memcpy(raw->member, pokemon_party_member_ptr(pdata, slot), member_sz);
+    memcpy(raw->ot_name, pokemon_party_name_ptr(pdata, slot, STAT_OT_NAME), sizeof(Name));
+    memcpy(raw->nickname, pokemon_party_name_ptr(pdata, slot, STAT_NICKNAME), sizeof(Name));
+}
+
+bool pokemon_raw_set(PokemonData* pdata, uint8_t slot, const PokemonRaw* raw) {
+    furi_assert(pdata);
+    furi_assert(raw);
+    size_t member_sz = pdata->party_sz / PARTY_CNT_MAX;
+
+    if(raw->gen != pdata->gen) return false;
+
+    pokemon_party_members_ptr(pdata)[slot] = raw->species;
+    memcpy(pokemon_party_member_ptr(pdata, slot), raw->member, member_sz);
+    memcpy(pokemon_party_name_ptr(pdata, slot, STAT_OT_NAME), raw->ot_name, sizeof(Name));
+    memcpy(pokemon_party_name_ptr(pdata, slot, STAT_NICKNAME), raw->nickname, sizeof(Name));
+    pdata->recalc_pending[slot] = RECALC_NONE;
+    pokemon_party_mail_clear(pdata, slot);
+    pokemon_party_dirty_mark(pdata, slot * member_sz, member_sz);
+
+    return true;
+}
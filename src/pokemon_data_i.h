@@ -1,14 +1,13 @@
 #ifndef __POKEMON_DATA_I_H__
 #define __POKEMON_DATA_I_H__
 
+#include <stddef.h>
+
 #include <src/include/pokemon_data.h>
 
 //#include <src/pokemon_app.h>
 //#include <src/include/pokemon_char_encode.h>
 
-static void pokemon_stat_ev_calc(PokemonData* pdata, EvIv val);
-static void pokemon_stat_iv_calc(PokemonData* pdata, EvIv val);
-
 /* The struct is laid out exactly as the data trasfer that gets sent for trade
  * information. It has to be packed in order to not have padding in the Flipper.
  * Packing is always potentially filled with pitfalls, however this has worked
@@ -62,14 +61,14 @@ typedef struct name Name;
 struct __attribute__((__packed__)) trade_block_gen_i {
     Name trainer_name;
     uint8_t party_cnt;
-    /* Only the first pokemon is ever used even though there are 7 bytes here.
-     * If the remaining 6 bytes are _not_ 0xff, then the trade window renders
-     * garbage for the Flipper's party.
+    /* One species index per party member, followed by a 0xff terminator.
+     * Every byte after the last party member must be 0xff, otherwise the
+     * trade window renders garbage for the Flipper's party.
      */
     uint8_t party_members[7];
-    /* Only the first pokemon is set up, even though there are 6 total party members */
+    /* Only the first party_cnt members are set up */
     PokemonPartyGenI party[6];
-    /* Only the first pokemon has an OT name and nickname even though there are 6 members */
+    /* Only the first party_cnt members have an OT name and nickname */
     /* OT name should not exceed 7 chars! */
     Name ot_name[6];
     Name nickname[6];
@@ -126,18 +125,82 @@ struct __attribute__((__packed__)) pokemon_party_data_gen_ii {
 struct __attribute__((__packed__)) trade_block_gen_ii {
     Name trainer_name;
     uint8_t party_cnt;
-    /* Only the first pokemon is ever used even though there are 7 bytes here.
-     * If the remaining 6 bytes are _not_ 0xff, then the trade window renders
-     * garbage for the Flipper's party.
+    /* One species index per party member, followed by a 0xff terminator.
+     * Every byte after the last party member must be 0xff, otherwise the
+     * trade window renders garbage for the Flipper's party.
      */
     uint8_t party_members[7];
     uint16_t trainer_id;
-    /* Only the first pokemon is set up, even though there are 6 total party members */
+    /* Only the first party_cnt members are set up */
     PokemonPartyGenII party[6];
-    /* Only the first pokemon has an OT name and nickname even though there are 6 members */
+    /* Only the first party_cnt members have an OT name and nickname */
     /* OT name should not exceed 7 chars! */
     Name ot_name[6];
     Name nickname[6];
 };
 
+/* The mail of every party slot, in the order the Game Boy sends it during a
+ * Gen II trade: every slot's message, then every slot's metadata. A slot's
+ * mail is only looked at if its held item is a mail item.
+ */
+struct __attribute__((__packed__)) mail_meta_gen_ii {
+    /* OT name should not exceed 7 chars! */
+    uint8_t author[LEN_OT_NAME];
+    uint8_t nationality[2];
+    uint16_t author_id;
+    uint8_t species;
+    uint8_t item;
+};
+
+struct __attribute__((__packed__)) mail_block_gen_ii {
+    uint8_t message[PARTY_CNT_MAX][LEN_MAIL_MSG];
+    struct mail_meta_gen_ii meta[PARTY_CNT_MAX];
+};
+
+_Static_assert(sizeof(struct mail_meta_gen_ii) == LEN_MAIL_META, "Bad Gen II mail metadata");
+_Static_assert(sizeof(MailBlockGenII) == LEN_MAIL_BLOCK, "Bad Gen II mail block");
+
+/* Describes where a DataStat lives in a party member of a given generation,
+ * so that pokemon_stat_get/set are table lookups rather than a switch per
+ * generation. Each generation has an array of these indexed by DataStat,
+ * built with offsetof() from the structs above.
+ *
+ * An entry with no flags at all is not a party member field. An entry with
+ * FIELD_ABSENT exists, but not in this generation's layout; it reads as 0 and
+ * writes are ignored.
+ */
+#define FIELD_U8 (1 << 0)
+/* 16 bits, in GB byte order */
+#define FIELD_U16 (1 << 1)
+/* 4 bit IV nibble at shift, of a 16 bit IV word read in Flipper byte order */
+#define FIELD_NIBBLE (1 << 2)
+/* The HP IV, made from the LSB of each of the other IV nibbles. Read only */
+#define FIELD_HP_IV (1 << 3)
+/* An array of bytes, indexed by the DataStatSub */
+#define FIELD_ARRAY (1 << 4)
+/* A species index that maps to a pokedex number through the pokemon table */
+#define FIELD_DEX (1 << 5)
+#define FIELD_ABSENT (1 << 6)
+
+struct stat_field {
+    uint8_t offs;
+    uint8_t flags;
+    uint8_t shift;
+    /* Offset of a second copy of the field that is written along with it,
+     * e.g. max_hp. 0 for none.
+     */
+    uint8_t mirror;
+    /* Added to the stored value when read, subtracted when written */
+    int8_t bias;
+};
+
+#define FIELD_ENTRY(type, member, flags_) {.offs = offsetof(type, member), .flags = (flags_)}
+#define FIELD_ENTRY_IV(type, shift_) \
+    {.offs = offsetof(type, iv), .flags = FIELD_NIBBLE, .shift = (shift_)}
+#define FIELD_ENTRY_MIRROR(type, member, mirror_, flags_) \
+    {.offs = offsetof(type, member), .flags = (flags_), .mirror = offsetof(type, mirror_)}
+#define FIELD_ENTRY_BIAS(type, member, bias_, flags_) \
+    {.offs = offsetof(type, member), .flags = (flags_), .bias = (bias_)}
+#define FIELD_ENTRY_ABSENT {.flags = FIELD_ABSENT}
+
 #endif // __POKEMON_DATA_I_H__
@@ -0,0 +1,76 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <src/include/pokemon_char_encode.h>
+#include <src/include/pokemon_pkx.h>
+
+/* Species of an egg in a Gen II party list, see pokemon_data_i.h */
+#define PKX_SPECIES_EGG 0xFD
+
+size_t pokemon_pkx_size(uint8_t gen) {
+    if(gen == GEN_I) return PK1_FILE_SZ;
+    if(gen == GEN_II) return PK2_FILE_SZ;
+    return 0;
+}
+
+const char* pokemon_pkx_ext(uint8_t gen) {
+    if(gen == GEN_I) return ".pk1";
+    if(gen == GEN_II) return ".pk2";
+    return NULL;
+}
+
+size_t pokemon_pkx_encode(const PokemonRaw* raw, uint8_t* buf, size_t len) {
+    size_t size = pokemon_pkx_size(raw->gen);
+    size_t member_sz = size - PKX_HDR_SZ - (2 * LEN_NAME_BUF);
+
+    if(!size || len < size) return 0;
+
+    buf[0] = 1;
+    buf[1] = raw->species;
+    buf[2] = 0xFF;
+    memcpy(&buf[PKX_HDR_SZ], raw->member, member_sz);
+    memcpy(&buf[PKX_HDR_SZ + member_sz], raw->ot_name, LEN_NAME_BUF);
+    memcpy(&buf[PKX_HDR_SZ + member_sz + LEN_NAME_BUF], raw->nickname, LEN_NAME_BUF);
+
+    return size;
+}
+
+/* A name the game can show has to end somewhere */
+static bool pokemon_pkx_name_ok(const uint8_t* name) {
+    return memchr(name, TERM_, LEN_NAME_BUF) != NULL;
+}
+
+bool pokemon_pkx_decode(const uint8_t* buf, size_t len, PokemonRaw* raw) {
+    const uint8_t* member = &buf[PKX_HDR_SZ];
+    const uint8_t* ot_name;
+    const uint8_t* nickname;
+    size_t member_sz;
+    uint8_t gen;
+
+    if(len == PK1_FILE_SZ)
+        gen = GEN_I;
+    else if(len == PK2_FILE_SZ)
+        gen = GEN_II;
+    else
+        return false;
+
+    member_sz = len - PKX_HDR_SZ - (2 * LEN_NAME_BUF);
+    ot_name = member + member_sz;
+    nickname = ot_name + LEN_NAME_BUF;
+
+    if(buf[0] != 1 || buf[2] != 0xFF) return false;
+    if(buf[1] == 0 || buf[1] == 0xFF) return false;
+    /* The list and the party struct have to agree on what this is */
+    if(buf[1] != member[0] && !(gen == GEN_II && buf[1] == PKX_SPECIES_EGG)) return false;
+    if(!pokemon_pkx_name_ok(ot_name) || !pokemon_pkx_name_ok(nickname)) return false;
+
+    memset(raw, '\0', sizeof(PokemonRaw));
+    raw->gen = gen;
+    raw->species = buf[1];
+    memcpy(raw->member, member, member_sz);
+    memcpy(raw->ot_name, ot_name, LEN_NAME_BUF);
+    memcpy(raw->nickname, nickname, LEN_NAME_BUF);
+
+    return true;
+}
@@ -0,0 +1,156 @@
+#include <furi.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_convert.h>
+#include <src/include/pokemon_pkx.h>
+
+/* Only used to order files, longer names are still imported */
+#define PKX_NAME_LEN 64
+
+struct pkx_pick {
+    char name[PKX_NAME_LEN];
+    PokemonRaw raw;
+};
+
+static bool pkx_ext_match(const char* name, const char* ext) {
+    size_t name_len = strlen(name);
+    size_t ext_len = strlen(ext);
+
+    return name_len > ext_len && !strcasecmp(&name[name_len - ext_len], ext);
+}
+
+/* Read and decode a whole file of either gen, converted to gen */
+static bool pkx_file_read(File* file, const char* path, uint8_t gen, PokemonRaw* raw) {
+    uint8_t buf[PKX_FILE_SZ_MAX + 1];
+    size_t len = 0;
+    bool ok = false;
+    ConvertErr err = CONVERT_OK;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        len = storage_file_read(file, buf, sizeof(buf));
+        ok = pokemon_pkx_decode(buf, len, raw);
+    }
+    storage_file_close(file);
+
+    if(ok) {
+        err = pokemon_convert(raw, gen, raw);
+        ok = err == CONVERT_OK;
+    }
+
+    if(!ok) FURI_LOG_W(TAG, "[pkx] skipping %s, %d", path, err);
+    return ok;
+}
+
+/* picks is kept sorted by name and holds at most the first PARTY_CNT_MAX
+ * names seen. Returns the new number of picks.
+ */
+static uint8_t
+    pkx_pick_insert(struct pkx_pick* picks, uint8_t cnt, const char* name, const PokemonRaw* raw) {
+    uint8_t i;
+
+    if(cnt == PARTY_CNT_MAX) {
+        if(strcmp(name, picks[cnt - 1].name) >= 0) return cnt;
+        /* Push the last one out */
+        i = cnt - 1;
+    } else {
+        i = cnt++;
+    }
+
+    for(; i > 0 && strcmp(name, picks[i - 1].name) < 0; i--) picks[i] = picks[i - 1];
+    snprintf(picks[i].name, sizeof(picks[i].name), "%s", name);
+    picks[i].raw = *raw;
+
+    return cnt;
+}
+
+uint8_t pokemon_pkx_party_import(PokemonData* pdata, Storage* storage, const char* dir) {
+    furi_assert(pdata);
+    File* dir_file = storage_file_alloc(storage);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    struct pkx_pick* picks = malloc(sizeof(struct pkx_pick) * PARTY_CNT_MAX);
+    PokemonRaw raw;
+    FileInfo info;
+    char name[256];
+    uint8_t cnt = 0;
+    uint8_t i;
+
+    if(storage_dir_open(dir_file, dir)) {
+        while(storage_dir_read(dir_file, &info, name, sizeof(name))) {
+            if(file_info_is_dir(&info)) continue;
+            if(!pkx_ext_match(name, pokemon_pkx_ext(GEN_I)) &&
+               !pkx_ext_match(name, pokemon_pkx_ext(GEN_II)))
+                continue;
+
+            furi_string_printf(path, "%s/%s", dir, name);
+            if(pkx_file_read(file, furi_string_get_cstr(path), pdata->gen, &raw))
+                cnt = pkx_pick_insert(picks, cnt, name, &raw);
+        }
+    }
+    storage_dir_close(dir_file);
+
+    if(cnt) {
+        while(pokemon_party_cnt_get(pdata) > 1)
+            pokemon_party_remove(pdata, pokemon_party_cnt_get(pdata) - 1);
+
+        for(i = 0; i < cnt; i++) {
+            if(i) pokemon_party_add(pdata);
+            pokemon_raw_set(pdata, i, &picks[i].raw);
+        }
+        pdata->party_sel = 0;
+    }
+
+    FURI_LOG_I(TAG, "[pkx] imported %d from %s", cnt, dir);
+
+    free(picks);
+    furi_string_free(path);
+    storage_file_free(file);
+    storage_file_free(dir_file);
+
+    return cnt;
+}
+
+uint8_t pokemon_pkx_party_export(PokemonData* pdata, Storage* storage, const char* dir) {
+    furi_assert(pdata);
+    uint8_t party_cnt = pokemon_party_cnt_get(pdata);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    uint8_t buf[PKX_FILE_SZ_MAX];
+    char name[LEN_NAME_BUF];
+    PokemonRaw raw;
+    size_t len;
+    uint8_t cnt = 0;
+    uint8_t slot;
+    char* c;
+
+    storage_simply_mkdir(storage, dir);
+    pokemon_recalculate_pending(pdata);
+
+    for(slot = 0; slot < party_cnt; slot++) {
+        pokemon_raw_get(pdata, slot, &raw);
+        len = pokemon_pkx_encode(&raw, buf, sizeof(buf));
+
+        /* Keep the file name to something every filesystem takes */
+        pokemon_name_get(pdata, slot, STAT_NICKNAME, name, sizeof(name));
+        for(c = name; *c; c++) {
+            if(!((*c >= 'A' && *c <= 'Z') || (*c >= 'a' && *c <= 'z') || (*c >= '0' && *c <= '9')))
+                *c = '_';
+        }
+        furi_string_printf(path, "%s/%d_%s%s", dir, slot + 1, name, pokemon_pkx_ext(raw.gen));
+
+        if(storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+           storage_file_write(file, buf, len) == len)
+            cnt++;
+        else
+            FURI_LOG_E(TAG, "[pkx] failed to write %s", furi_string_get_cstr(path));
+        storage_file_close(file);
+    }
+
+    FURI_LOG_I(TAG, "[pkx] exported %d to %s", cnt, dir);
+
+    furi_string_free(path);
+    storage_file_free(file);
+
+    return cnt;
+}
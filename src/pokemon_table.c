@@ -30,18 +30,20 @@ struct __attribute__((__packed__)) pokemon_data_table {
     const GenderRatio gender_ratio;
 };
 
-int table_pokemon_pos_get(const PokemonTable* table, uint8_t index) {
-    int i;
+/* Position in pokemon_table of the first entry with each Gen I species index.
+ * Generated from pokemon_table at the end of this file by
+ * tools/pokemon_index_gen.py, which must be re-run if its order or indices
+ * change.
+ *
+ * Going the other way, from pokedex number to index, is already a single
+ * load of the table entry's .index.
+ */
+static const uint8_t pokemon_index_pos[256];
 
-    for(i = 0;; i++) {
-        if(table[i].index == index) return i;
-        if(table[i].name == NULL) break;
-    }
+int table_pokemon_pos_get(const PokemonTable* table, uint8_t index) {
+    UNUSED(table);
 
-    /* This will return the first entry in case index is not matched.
-     * Could be surprising at runtime.
-     */
-    return 0;
+    return pokemon_index_pos[index];
 }
 
 const char* table_stat_name_get(const PokemonTable* table, int num) {
@@ -56,7 +58,7 @@ uint8_t
     case STAT_BASE_INDEX:
         return table[num].index;
     case STAT_BASE_ATK:
-        return table[num].base_hp;
+        return table[num].base_atk;
     case STAT_BASE_DEF:
         return table[num].base_def;
     case STAT_BASE_SPD:
@@ -3359,3 +3361,93 @@ static const PokemonTable pokemon_table[] = {
 const PokemonTable* table_pointer_get() {
     return pokemon_table;
 }
+
+/* Total experience at the start of each level for each growth rate, using
+ * the games' own formula of a/b * n^3 + c * n^2 + d * n + e with the same
+ * integer rounding. Some rates go negative at level 1, where the games wrap
+ * around, those are clamped to 0 instead.
+ *
+ * Every entry is a constant expression, so the tables are built by the
+ * compiler and live in flash.
+ */
+#define GROWTH_EXP_RAW(n, a, b, c, d, e) \
+    (((n) * (n) * (n) * (a) / (b)) + ((c) * (n) * (n)) + ((d) * (n)) + (e))
+#define GROWTH_EXP(n, a, b, c, d, e) \
+    (GROWTH_EXP_RAW(n, a, b, c, d, e) < 0 ? 0 : GROWTH_EXP_RAW(n, a, b, c, d, e))
+
+#define EXP_MEDIUM_FAST(n) GROWTH_EXP(n, 1, 1, 0, 0, 0)
+#define EXP_SLIGHTLY_FAST(n) GROWTH_EXP(n, 3, 4, 10, 0, -30)
+#define EXP_SLIGHTLY_SLOW(n) GROWTH_EXP(n, 3, 4, 20, 0, -70)
+#define EXP_MEDIUM_SLOW(n) GROWTH_EXP(n, 6, 5, -15, 100, -140)
+#define EXP_FAST(n) GROWTH_EXP(n, 4, 5, 0, 0, 0)
+#define EXP_SLOW(n) GROWTH_EXP(n, 5, 4, 0, 0, 0)
+
+#define EXP_LEVELS_10(f, t)                                                             \
+    f((t) + 1), f((t) + 2), f((t) + 3), f((t) + 4), f((t) + 5), f((t) + 6), f((t) + 7), \
+        f((t) + 8), f((t) + 9), f((t) + 10)
+#define EXP_LEVELS(f)                                                                      \
+    EXP_LEVELS_10(f, 0), EXP_LEVELS_10(f, 10), EXP_LEVELS_10(f, 20), EXP_LEVELS_10(f, 30), \
+        EXP_LEVELS_10(f, 40), EXP_LEVELS_10(f, 50), EXP_LEVELS_10(f, 60),                  \
+        EXP_LEVELS_10(f, 70), EXP_LEVELS_10(f, 80), EXP_LEVELS_10(f, 90)
+
+static const uint32_t growth_exp[GROWTH_COUNT][LEVEL_MAX] = {
+    [GROWTH_MEDIUM_FAST] = {EXP_LEVELS(EXP_MEDIUM_FAST)},
+    [GROWTH_SLIGHTLY_FAST] = {EXP_LEVELS(EXP_SLIGHTLY_FAST)},
+    [GROWTH_SLIGHTLY_SLOW] = {EXP_LEVELS(EXP_SLIGHTLY_SLOW)},
+    [GROWTH_MEDIUM_SLOW] = {EXP_LEVELS(EXP_MEDIUM_SLOW)},
+    [GROWTH_FAST] = {EXP_LEVELS(EXP_FAST)},
+    [GROWTH_SLOW] = {EXP_LEVELS(EXP_SLOW)},
+};
+
+uint32_t table_exp_get(Growth growth, uint8_t level) {
+    furi_check(growth < GROWTH_COUNT);
+
+    if(level < LEVEL_MIN) level = LEVEL_MIN;
+    if(level > LEVEL_MAX) level = LEVEL_MAX;
+
+    return growth_exp[growth][level - 1];
+}
+
+uint8_t table_level_get(Growth growth, uint32_t exp) {
+    furi_check(growth < GROWTH_COUNT);
+    const uint32_t* table = growth_exp[growth];
+    uint8_t lo = LEVEL_MIN;
+    uint8_t hi = LEVEL_MAX;
+    uint8_t mid;
+
+    /* Every table starts at 0 for LEVEL_MIN, so lo is always a match */
+    while(lo < hi) {
+        mid = (lo + hi + 1) / 2;
+        if(table[mid - 1] <= exp)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return lo;
+}
+
+/* Generated by tools/pokemon_index_gen.py, do not edit below this line */
+
+/* Any index that does not match an entry gives the first entry, which could
+ * be surprising at runtime. Note that all Gen II only Pokemon have an index
+ * of 0, so index 0 is the first of those.
+ */
+static const uint8_t pokemon_index_pos[256] = {
+    /* 0x00 */ 151, 111, 114, 31, 34, 20, 99, 33, 79, 1, 102, 107, 101, 87, 93, 28,
+    /* 0x10 */ 30, 103, 110, 130, 58, 150, 129, 89, 71, 91, 122, 119, 8, 126, 113, 0,
+    /* 0x20 */ 0, 57, 94, 21, 15, 78, 63, 74, 112, 66, 121, 105, 106, 23, 46, 53,
+    /* 0x30 */ 95, 75, 0, 125, 0, 124, 81, 108, 0, 55, 85, 49, 127, 0, 0, 0,
+    /* 0x40 */ 82, 47, 148, 0, 0, 0, 83, 59, 123, 145, 143, 144, 131, 51, 97, 0,
+    /* 0x50 */ 0, 0, 36, 37, 24, 25, 0, 0, 146, 147, 139, 140, 115, 116, 0, 0,
+    /* 0x60 */ 26, 27, 137, 138, 38, 39, 132, 135, 134, 133, 65, 40, 22, 45, 60, 61,
+    /* 0x70 */ 12, 13, 14, 0, 84, 56, 50, 48, 86, 0, 0, 9, 10, 11, 67, 0,
+    /* 0x80 */ 54, 96, 41, 149, 142, 128, 0, 0, 88, 0, 98, 90, 0, 100, 35, 109,
+    /* 0x90 */ 52, 104, 0, 92, 62, 64, 16, 17, 120, 0, 2, 72, 0, 117, 118, 0,
+    /* 0xA0 */ 0, 0, 0, 76, 77, 18, 19, 32, 29, 73, 136, 141, 0, 80, 0, 0,
+    /* 0xB0 */ 3, 6, 4, 7, 5, 0, 0, 0, 0, 42, 43, 44, 68, 69, 70, 0,
+    /* 0xC0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0xD0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0xE0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0xF0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
@@ -1,6 +1,8 @@
 ADD_SCENE(pokemon,	main_menu,		MainMenu)
 ADD_SCENE(pokemon,	gen,			GenITrade)
 ADD_SCENE(pokemon,	gen,			GenIITrade)
+ADD_SCENE(pokemon,	select_party,		Party)
+ADD_SCENE(pokemon,	select_box,		Box)
 ADD_SCENE(pokemon,	select_pokemon,		Select)
 ADD_SCENE(pokemon,	select_name,		Nickname)
 ADD_SCENE(pokemon,	select_number,		Level)
@@ -17,6 +19,7 @@ ADD_SCENE(pokemon,	select_pokerus,		Pokerus)
 ADD_SCENE(pokemon,	select_name,		UnownForm)
 ADD_SCENE(pokemon,	select_number,		OTID)
 ADD_SCENE(pokemon,	select_name,		OTName)
+ADD_SCENE(pokemon,	select_trade_mode,	TradeMode)
 ADD_SCENE(pokemon,	trade,			Trade)
 ADD_SCENE(pokemon,	select_pins,		Pins)
 ADD_SCENE(pokemon,	exit_confirm,		ExitConfirm)
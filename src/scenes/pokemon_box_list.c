@@ -0,0 +1,102 @@
+#include <gui/modules/submenu.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_box.h>
+#include <src/include/pokemon_convert.h>
+#include <src/include/pokemon_data.h>
+
+#include <src/scenes/include/pokemon_scene.h>
+
+/* Only the newest are listed, to keep the submenu to a sane size */
+#define BOX_LIST_MAX 50
+
+/* Name of the species of a box entry, which holds the party_members byte of
+ * its gen.
+ */
+static const char*
+    select_box_species_name(PokemonData* pdata, const struct pokemon_box_entry* entry) {
+    int pos;
+
+    if(entry->gen == GEN_I)
+        pos = table_pokemon_pos_get(pdata->pokemon_table, entry->species);
+    else if(entry->species == 0xFD)
+        return "Egg";
+    else
+        pos = entry->species - 1;
+
+    return table_stat_name_get(pdata->pokemon_table, pos);
+}
+
+/* Copy the Pokemon in to the selected party slot. It stays in the box as well,
+ * so it can be restored again after being traded away.
+ */
+static void select_box_selected_callback(void* context, uint32_t index) {
+    PokemonFap* pokemon_fap = (PokemonFap*)context;
+    PokemonData* pdata = pokemon_fap->pdata;
+    PokemonRaw raw;
+    ConvertErr err = CONVERT_OK;
+
+    if(!pokemon_box_load(pokemon_fap->box, index, &raw)) {
+        submenu_set_header(pokemon_fap->submenu, "Unable to read");
+        return;
+    }
+
+    err = pokemon_convert(&raw, pdata->gen, &raw);
+    if(err != CONVERT_OK) {
+        FURI_LOG_W(TAG, "[box] %lu can't go in Gen %d, %d", index, pdata->gen, err);
+        submenu_set_header(
+            pokemon_fap->submenu,
+            (pdata->gen == GEN_I) ? "Can't go in Gen I" : "Can't go in Gen II");
+        return;
+    }
+
+    pokemon_raw_set(pdata, pdata->party_sel, &raw);
+
+    view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, PokemonSceneBack);
+}
+
+void pokemon_scene_select_box_on_enter(void* context) {
+    PokemonFap* pokemon_fap = (PokemonFap*)context;
+    PokemonData* pdata = pokemon_fap->pdata;
+    size_t count = pokemon_box_count(pokemon_fap->box);
+    struct pokemon_box_entry entry;
+    char buf[32];
+    size_t i;
+
+    submenu_reset(pokemon_fap->submenu);
+    snprintf(buf, sizeof(buf), "Box, to slot %d", pdata->party_sel + 1);
+    submenu_set_header(pokemon_fap->submenu, buf);
+
+    /* Newest first */
+    for(i = count; i > 0 && count - i < BOX_LIST_MAX; i--) {
+        if(!pokemon_box_entry_get(pokemon_fap->box, i - 1, &entry)) break;
+        snprintf(
+            buf,
+            sizeof(buf),
+            "%lu: %s (%s)",
+            entry.id,
+            select_box_species_name(pdata, &entry),
+            (entry.gen == GEN_I) ? "I" : "II");
+        submenu_add_item(
+            pokemon_fap->submenu, buf, i - 1, select_box_selected_callback, pokemon_fap);
+    }
+
+    view_dispatcher_switch_to_view(pokemon_fap->view_dispatcher, AppViewSubmenu);
+}
+
+bool pokemon_scene_select_box_on_event(void* context, SceneManagerEvent event) {
+    furi_assert(context);
+    PokemonFap* pokemon_fap = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom && event.event & PokemonSceneBack) {
+        scene_manager_previous_scene(pokemon_fap->scene_manager);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void pokemon_scene_select_box_on_exit(void* context) {
+    UNUSED(context);
+}
@@ -63,10 +63,14 @@ void pokemon_scene_gen_on_enter(void* context) {
         // Trade View
         /* Allocates its own view and adds it to the main view_dispatcher */
         pokemon_fap->trade = trade_alloc(
-            pdata, pokemon_fap->gblink_handle, pokemon_fap->view_dispatcher, AppViewTrade);
+            pdata,
+            pokemon_fap->gblink_handle,
+            pokemon_fap->box,
+            pokemon_fap->view_dispatcher,
+            AppViewTrade);
     }
 
-    pkmn_num = pokemon_stat_get(pdata, STAT_NUM, NONE);
+    pkmn_num = pokemon_stat_get(pdata, pdata->party_sel, STAT_NUM, NONE);
 
     /* Clear the scene state of the Move scene since that is used to set the
      * highlighted menu item.
@@ -79,6 +83,15 @@ void pokemon_scene_gen_on_enter(void* context) {
 
     submenu_reset(pokemon_fap->submenu);
 
+    snprintf(
+        buf,
+        sizeof(buf),
+        "Party Slot:     %d/%d",
+        pdata->party_sel + 1,
+        pokemon_party_cnt_get(pdata));
+    submenu_add_item(
+        pokemon_fap->submenu, buf, PokemonSceneParty, scene_change_from_main_cb, pokemon_fap);
+
     snprintf(
         buf,
         sizeof(buf),
@@ -87,7 +100,7 @@ void pokemon_scene_gen_on_enter(void* context) {
     submenu_add_item(
         pokemon_fap->submenu, buf, PokemonSceneSelect, scene_change_from_main_cb, pokemon_fap);
 
-    pokemon_name_get(pdata, STAT_NICKNAME, name_buf, sizeof(name_buf));
+    pokemon_name_get(pdata, pdata->party_sel, STAT_NICKNAME, name_buf, sizeof(name_buf));
     snprintf(buf, sizeof(buf), "Nickname:  %s", name_buf);
     submenu_add_item(
         pokemon_fap->submenu, buf, PokemonSceneNickname, scene_change_from_main_cb, pokemon_fap);
@@ -96,7 +109,7 @@ void pokemon_scene_gen_on_enter(void* context) {
         buf,
         sizeof(buf),
         "Level:           %d",
-        pokemon_stat_get(pdata, STAT_LEVEL, NONE));
+        pokemon_stat_get(pdata, pdata->party_sel, STAT_LEVEL, NONE));
     submenu_add_item(
         pokemon_fap->submenu, buf, PokemonSceneLevel, scene_change_from_main_cb, pokemon_fap);
 
@@ -107,7 +120,7 @@ void pokemon_scene_gen_on_enter(void* context) {
             "Held Item:   %s",
             namedlist_name_get_index(
                 pdata->item_list,
-                pokemon_stat_get(pdata, STAT_HELD_ITEM, NONE)));
+                pokemon_stat_get(pdata, pdata->party_sel, STAT_HELD_ITEM, NONE)));
         submenu_add_item(
             pokemon_fap->submenu, buf, PokemonSceneItem, scene_change_from_main_cb, pokemon_fap);
     }
@@ -131,7 +144,7 @@ void pokemon_scene_gen_on_enter(void* context) {
     submenu_add_item(
         pokemon_fap->submenu,
         namedlist_name_get_index(
-            pdata->stat_list, pokemon_stat_get(pdata, STAT_SEL, NONE)),
+            pdata->stat_list, pokemon_stat_get(pdata, pdata->party_sel, STAT_SEL, NONE)),
         PokemonSceneStats,
         scene_change_from_main_cb,
         pokemon_fap);
@@ -141,20 +154,28 @@ void pokemon_scene_gen_on_enter(void* context) {
             buf,
             sizeof(buf),
             "Shiny:             %s",
-            pokemon_is_shiny(pdata) ? "Yes" : "No");
+            pokemon_is_shiny(pdata, pdata->party_sel) ? "Yes" : "No");
         submenu_add_item(
             pokemon_fap->submenu, buf, PokemonSceneShiny, scene_change_from_main_cb, pokemon_fap);
 
-        snprintf(buf, sizeof(buf), "Gender:         %s", pokemon_gender_get(pdata));
+        snprintf(
+            buf,
+            sizeof(buf),
+            "Gender:         %s",
+            pokemon_gender_get(pdata, pdata->party_sel));
         submenu_add_item(
             pokemon_fap->submenu, buf, PokemonSceneGender, scene_change_from_main_cb, pokemon_fap);
 
-        snprintf(buf, sizeof(buf), "Pokerus:       %s", pokerus_get_status_str(pdata));
+        snprintf(
+            buf,
+            sizeof(buf),
+            "Pokerus:       %s",
+            pokerus_get_status_str(pdata, pdata->party_sel));
         submenu_add_item(
             pokemon_fap->submenu, buf, PokemonScenePokerus, scene_change_from_main_cb, pokemon_fap);
 
-        if(pokemon_stat_get(pdata, STAT_NUM, NONE) == 0xC8) { // Unown
-            snprintf(buf, sizeof(buf), "Unown Form: %c", unown_form_get(pdata));
+        if(pokemon_stat_get(pdata, pdata->party_sel, STAT_NUM, NONE) == 0xC8) { // Unown
+            snprintf(buf, sizeof(buf), "Unown Form: %c", unown_form_get(pdata, pdata->party_sel));
             submenu_add_item(
                 pokemon_fap->submenu,
                 buf,
@@ -168,15 +189,23 @@ void pokemon_scene_gen_on_enter(void* context) {
         buf,
         sizeof(buf),
         "OT ID#:          %05d",
-        pokemon_stat_get(pdata, STAT_OT_ID, NONE));
+        pokemon_stat_get(pdata, pdata->party_sel, STAT_OT_ID, NONE));
     submenu_add_item(
         pokemon_fap->submenu, buf, PokemonSceneOTID, scene_change_from_main_cb, pokemon_fap);
 
-    pokemon_name_get(pdata, STAT_OT_NAME, name_buf, sizeof(name_buf));
+    pokemon_name_get(pdata, pdata->party_sel, STAT_OT_NAME, name_buf, sizeof(name_buf));
     snprintf(buf, sizeof(buf), "OT Name:      %s", name_buf);
     submenu_add_item(
         pokemon_fap->submenu, buf, PokemonSceneOTName, scene_change_from_main_cb, pokemon_fap);
 
+    snprintf(
+        buf,
+        sizeof(buf),
+        "Trade Mode:  %s",
+        trade_queue_mode_name_get(trade_queue_mode_get(pokemon_fap->trade)));
+    submenu_add_item(
+        pokemon_fap->submenu, buf, PokemonSceneTradeMode, scene_change_from_main_cb, pokemon_fap);
+
     submenu_add_item(
         pokemon_fap->submenu, "Trade PKMN", PokemonSceneTrade, scene_change_from_main_cb, pokemon_fap);
 
@@ -230,12 +259,12 @@ bool pokemon_scene_gen_on_event(void* context, SceneManagerEvent event) {
             scene_manager_set_scene_state(pokemon_fap->scene_manager, PokemonSceneLevel, event.event);
             break;
         case PokemonSceneGender:
-            pokemon_num = pokemon_stat_get(pdata, STAT_NUM, NONE);
+            pokemon_num = pokemon_stat_get(pdata, pdata->party_sel, STAT_NUM, NONE);
             gender_ratio = table_stat_base_get(pdata->pokemon_table, pokemon_num, STAT_BASE_GENDER_RATIO, NONE);
             /* If the pokemon's gender is static (always male, always female,
              * or unknown), then don't transition to the gender selection scene.
              */
-            if(pokemon_gender_is_static(pdata, gender_ratio))
+            if(pokemon_gender_is_static(pdata, pdata->party_sel, gender_ratio))
                 goto out;
             break;
         }
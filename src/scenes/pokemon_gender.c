@@ -9,7 +9,7 @@
 static void select_gender_selected_callback(void* context, uint32_t index) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
 
-    pokemon_gender_set(pokemon_fap->pdata, index);
+    pokemon_gender_set(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, index);
 
     view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, PokemonSceneBack);
 }
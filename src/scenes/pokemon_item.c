@@ -13,14 +13,16 @@ static void select_item_selected_callback(void* context, uint32_t index) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
     uint32_t item = scene_manager_get_scene_state(pokemon_fap->scene_manager, PokemonSceneItemSet);
 
-    pokemon_stat_set(pokemon_fap->pdata, STAT_HELD_ITEM, item, index);
+    pokemon_stat_set(
+        pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_HELD_ITEM, item, index);
 
     FURI_LOG_D(
         TAG,
         "[item] Set item %s",
         namedlist_name_get_index(
             pokemon_fap->pdata->item_list,
-            pokemon_stat_get(pokemon_fap->pdata, STAT_HELD_ITEM, item)));
+            pokemon_stat_get(
+                pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_HELD_ITEM, item)));
 
     /* Move back to Gen menu. This assumes this submenu is only ever used in Gen II */
     view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, (PokemonSceneSearch | PokemonSceneGenIITrade));
@@ -37,7 +39,9 @@ static void select_item_index_callback(void* context, uint32_t index) {
 void pokemon_scene_select_item_on_enter(void* context) {
     furi_assert(context);
     PokemonFap* pokemon_fap = (PokemonFap*)context;
-    int i;
+    size_t i;
+    size_t cnt;
+    uint32_t pos;
     const char* name;
     char letter[2] = {'\0'};
 
@@ -53,9 +57,11 @@ void pokemon_scene_select_item_on_enter(void* context) {
         select_item_selected_callback,
         pokemon_fap);
 
-    for(i = 1;; i++) {
-        name = namedlist_name_get_pos(pokemon_fap->pdata->item_list, i);
-        if(name == NULL) break;
+    cnt = namedlist_gen_cnt(pokemon_fap->pdata->item_list, pokemon_fap->pdata->gen);
+    for(i = 0; i < cnt; i++) {
+        pos = namedlist_gen_pos_get(pokemon_fap->pdata->item_list, pokemon_fap->pdata->gen, i);
+        if(pos == 0) continue;
+        name = namedlist_name_get_pos(pokemon_fap->pdata->item_list, pos);
         if(name[0] != letter[0]) {
             letter[0] = name[0];
             submenu_add_item(
@@ -96,23 +102,26 @@ void pokemon_scene_select_item_on_exit(void* context) {
 
 void pokemon_scene_select_item_set_on_enter(void* context) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
-    int i;
+    size_t i;
+    size_t cnt;
+    uint32_t pos;
     const char* name;
     char letter =
         (char)scene_manager_get_scene_state(pokemon_fap->scene_manager, PokemonSceneItemSet);
 
     /* Populate submenu with all items that start with `letter` */
-    /* NOTE! Start with pos of 1 in the item list since 0 should always be no item! */
+    /* NOTE! Skip pos 0 in the item list since it should always be no item! */
     submenu_reset(pokemon_fap->submenu);
-    for(i = 1;; i++) {
-        name = namedlist_name_get_pos(pokemon_fap->pdata->item_list, i);
-        if(name == NULL) break;
-        if(name[0] == letter &&
-           (pokemon_fap->pdata->gen & namedlist_gen_get_pos(pokemon_fap->pdata->item_list, i))) {
+    cnt = namedlist_gen_cnt(pokemon_fap->pdata->item_list, pokemon_fap->pdata->gen);
+    for(i = 0; i < cnt; i++) {
+        pos = namedlist_gen_pos_get(pokemon_fap->pdata->item_list, pokemon_fap->pdata->gen, i);
+        if(pos == 0) continue;
+        name = namedlist_name_get_pos(pokemon_fap->pdata->item_list, pos);
+        if(name[0] == letter) {
             submenu_add_item(
                 pokemon_fap->submenu,
                 name,
-                namedlist_index_get(pokemon_fap->pdata->item_list, i),
+                namedlist_index_get(pokemon_fap->pdata->item_list, pos),
                 select_item_selected_callback,
                 pokemon_fap);
         }
@@ -12,22 +12,27 @@
 static void select_move_selected_callback(void* context, uint32_t index) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
     uint32_t move = scene_manager_get_scene_state(pokemon_fap->scene_manager, PokemonSceneMove);
-    uint8_t num = pokemon_stat_get(pokemon_fap->pdata, STAT_NUM, NONE);
+    uint8_t num =
+        pokemon_stat_get(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_NUM, NONE);
 
     if(index == UINT32_MAX) {
         pokemon_stat_set(
             pokemon_fap->pdata,
+            pokemon_fap->pdata->party_sel,
             STAT_MOVE,
             move,
             table_stat_base_get(pokemon_fap->pdata->pokemon_table, num, STAT_MOVE, move));
     } else {
-        pokemon_stat_set(pokemon_fap->pdata, STAT_MOVE, move, index);
+        pokemon_stat_set(
+            pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_MOVE, move, index);
     }
     FURI_LOG_D(
         TAG,
         "[move] Set move %s to %d",
         namedlist_name_get_index(
-            pokemon_fap->pdata->move_list, pokemon_stat_get(pokemon_fap->pdata, STAT_MOVE, move)),
+            pokemon_fap->pdata->move_list,
+            pokemon_stat_get(
+                pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_MOVE, move)),
         (int)move);
 
     /* Move back to move menu */
@@ -68,7 +73,8 @@ void pokemon_scene_select_move_on_enter(void* context) {
             i + 1,
             namedlist_name_get_index(
                 pokemon_fap->pdata->move_list,
-                pokemon_stat_get(pokemon_fap->pdata, STAT_MOVE, i)));
+                pokemon_stat_get(
+                    pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_MOVE, i)));
         submenu_add_item(pokemon_fap->submenu, buf, i, select_move_number_callback, pokemon_fap);
     }
 
@@ -109,7 +115,9 @@ void pokemon_scene_select_move_on_exit(void* context) {
 
 void pokemon_scene_select_move_index_on_enter(void* context) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
-    int i;
+    size_t i;
+    size_t cnt;
+    uint32_t pos;
     char letter[2] = {'\0'};
     char buf[32];
     const char* name;
@@ -135,20 +143,21 @@ void pokemon_scene_select_move_index_on_enter(void* context) {
             pokemon_fap->pdata->move_list,
             table_stat_base_get(
                 pokemon_fap->pdata->pokemon_table,
-                pokemon_stat_get(pokemon_fap->pdata, STAT_NUM, NONE),
+                pokemon_stat_get(
+                    pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_NUM, NONE),
                 STAT_MOVE,
                 move_num)));
     submenu_add_item(
         pokemon_fap->submenu, buf, UINT32_MAX, select_move_selected_callback, pokemon_fap);
 
-    /* Now, walk through the list and make a submenu item for each move's starting letter */
-    for(i = 1;; i++) {
-        name = namedlist_name_get_pos(pokemon_fap->pdata->move_list, i);
-        if(name == NULL) break;
-        /* TODO: Add check here for generation match. Currently, this will populate
-	 * the letters that have any move associated with them, even if not for the
-	 * generation currently being used.
-	 */
+    /* Now, walk through this generation's moves and make a submenu item for
+     * each starting letter. Position 0 is always No Move.
+     */
+    cnt = namedlist_gen_cnt(pokemon_fap->pdata->move_list, pokemon_fap->pdata->gen);
+    for(i = 0; i < cnt; i++) {
+        pos = namedlist_gen_pos_get(pokemon_fap->pdata->move_list, pokemon_fap->pdata->gen, i);
+        if(pos == 0) continue;
+        name = namedlist_name_get_pos(pokemon_fap->pdata->move_list, pos);
         if(name[0] != letter[0]) {
             letter[0] = name[0];
             submenu_add_item(
@@ -186,26 +195,29 @@ void pokemon_scene_select_move_index_on_exit(void* context) {
 
 void pokemon_scene_select_move_set_on_enter(void* context) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
-    int i;
+    size_t i;
+    size_t cnt;
+    uint32_t pos;
     const char* name;
     char letter =
         (char)scene_manager_get_scene_state(pokemon_fap->scene_manager, PokemonSceneMoveIndex);
 
     /* Populate submenu with all moves that start with `letter` */
-    /* NOTE! Start with index of 1 in the move list since 0 should always be no move! */
+    /* NOTE! Skip pos 0 in the move list since it should always be no move! */
     submenu_reset(pokemon_fap->submenu);
-    for(i = 1;; i++) {
-        name = namedlist_name_get_pos(pokemon_fap->pdata->move_list, i);
-        if(name == NULL) break;
-        if(name[0] == letter &&
-           (pokemon_fap->pdata->gen & namedlist_gen_get_pos(pokemon_fap->pdata->move_list, i))) {
+    cnt = namedlist_gen_cnt(pokemon_fap->pdata->move_list, pokemon_fap->pdata->gen);
+    for(i = 0; i < cnt; i++) {
+        pos = namedlist_gen_pos_get(pokemon_fap->pdata->move_list, pokemon_fap->pdata->gen, i);
+        if(pos == 0) continue;
+        name = namedlist_name_get_pos(pokemon_fap->pdata->move_list, pos);
+        if(name[0] == letter) {
             submenu_add_item(
                 pokemon_fap->submenu,
                 name,
-                namedlist_index_get(pokemon_fap->pdata->move_list, i),
+                namedlist_index_get(pokemon_fap->pdata->move_list, pos),
                 select_move_selected_callback,
                 pokemon_fap);
-        };
+        }
     }
 }
 
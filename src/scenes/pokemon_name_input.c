@@ -32,7 +32,8 @@ static bool select_name_input_validator(const char* text, FuriString* error, voi
     if(text[0] == '\0' && state == PokemonSceneNickname) {
         /* Get the pokemon's name and populate our buffer with it */
         /* TODO: Nidoran M/F are still a problem with this. */
-        pokemon_default_nickname_set(name_buf, pokemon_fap->pdata, sizeof(name_buf));
+        pokemon_default_nickname_set(
+            name_buf, pokemon_fap->pdata, pokemon_fap->pdata->party_sel, sizeof(name_buf));
         return true;
     }
 
@@ -54,13 +55,15 @@ static bool select_name_input_validator(const char* text, FuriString* error, voi
 
     switch(state) {
     case PokemonSceneNickname:
-        pokemon_name_set(pokemon_fap->pdata, STAT_NICKNAME, (char*)text);
+        pokemon_name_set(
+            pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_NICKNAME, (char*)text);
         break;
     case PokemonSceneOTName:
-        pokemon_name_set(pokemon_fap->pdata, STAT_OT_NAME, (char*)text);
+        pokemon_name_set(
+            pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_OT_NAME, (char*)text);
         break;
     case PokemonSceneUnownForm:
-        unown_form_set(pokemon_fap->pdata, text[0]);
+        unown_form_set(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, text[0]);
         break;
     default:
         furi_crash("Invalid scene");
@@ -107,10 +110,10 @@ void pokemon_scene_select_name_on_enter(void* context) {
 
     if(state == PokemonSceneUnownForm) {
         /* Put the current letter in the buffer */
-        name_buf[0] = unown_form_get(pokemon_fap->pdata);
+        name_buf[0] = unown_form_get(pokemon_fap->pdata, pokemon_fap->pdata->party_sel);
         name_buf[1] = '\0';
     } else {
-        pokemon_name_get(pokemon_fap->pdata, stat, name_buf, len);
+        pokemon_name_get(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, stat, name_buf, len);
     }
 
     text_input_reset(pokemon_fap->text_input);
@@ -0,0 +1,124 @@
+#include <gui/modules/submenu.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/pokemon_pkx.h>
+
+#include <src/scenes/include/pokemon_scene.h>
+
+/* Submenu indices past the party slots */
+#define PARTY_ADD PARTY_CNT_MAX
+#define PARTY_REMOVE (PARTY_CNT_MAX + 1)
+#define PARTY_IMPORT (PARTY_CNT_MAX + 2)
+#define PARTY_EXPORT (PARTY_CNT_MAX + 3)
+#define PARTY_BOX (PARTY_CNT_MAX + 4)
+
+static void select_party_selected_callback(void* context, uint32_t index) {
+    PokemonFap* pokemon_fap = (PokemonFap*)context;
+    PokemonData* pdata = pokemon_fap->pdata;
+
+    switch(index) {
+    case PARTY_ADD:
+        pdata->party_sel = pokemon_party_add(pdata);
+        break;
+    case PARTY_REMOVE:
+        pokemon_party_remove(pdata, pdata->party_sel);
+        break;
+    case PARTY_IMPORT:
+        pokemon_pkx_party_import(pdata, pdata->storage, PKX_DIR);
+        break;
+    case PARTY_EXPORT:
+        pokemon_pkx_party_export(pdata, pdata->storage, PKX_DIR);
+        break;
+    case PARTY_BOX:
+        view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, PokemonSceneBox);
+        return;
+    default:
+        pdata->party_sel = index;
+        break;
+    }
+
+    view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, PokemonSceneBack);
+}
+
+void pokemon_scene_select_party_on_enter(void* context) {
+    PokemonFap* pokemon_fap = (PokemonFap*)context;
+    PokemonData* pdata = pokemon_fap->pdata;
+    uint8_t party_cnt = pokemon_party_cnt_get(pdata);
+    char buf[32];
+    int i;
+
+    submenu_reset(pokemon_fap->submenu);
+    submenu_set_header(pokemon_fap->submenu, "Party");
+
+    for(i = 0; i < party_cnt; i++) {
+        snprintf(
+            buf,
+            sizeof(buf),
+            "%d: %s",
+            i + 1,
+            table_stat_name_get(
+                pdata->pokemon_table, pokemon_stat_get(pdata, i, STAT_NUM, NONE)));
+        submenu_add_item(pokemon_fap->submenu, buf, i, select_party_selected_callback, pokemon_fap);
+    }
+
+    if(party_cnt < PARTY_CNT_MAX) {
+        submenu_add_item(
+            pokemon_fap->submenu,
+            "Add Pokemon",
+            PARTY_ADD,
+            select_party_selected_callback,
+            pokemon_fap);
+    }
+
+    if(party_cnt > 1) {
+        snprintf(buf, sizeof(buf), "Remove %d", pdata->party_sel + 1);
+        submenu_add_item(
+            pokemon_fap->submenu, buf, PARTY_REMOVE, select_party_selected_callback, pokemon_fap);
+    }
+
+    /* Swap the whole party for the .pk1/.pk2 files on the SD card, or save it */
+    submenu_add_item(
+        pokemon_fap->submenu,
+        "Import from SD",
+        PARTY_IMPORT,
+        select_party_selected_callback,
+        pokemon_fap);
+    submenu_add_item(
+        pokemon_fap->submenu,
+        "Export to SD",
+        PARTY_EXPORT,
+        select_party_selected_callback,
+        pokemon_fap);
+
+    /* Put a Pokemon received in an earlier trade back in the selected slot */
+    if(pokemon_fap->box && pokemon_box_count(pokemon_fap->box)) {
+        snprintf(buf, sizeof(buf), "Restore from Box (%zu)", pokemon_box_count(pokemon_fap->box));
+        submenu_add_item(
+            pokemon_fap->submenu, buf, PARTY_BOX, select_party_selected_callback, pokemon_fap);
+    }
+
+    submenu_set_selected_item(pokemon_fap->submenu, pdata->party_sel);
+
+    view_dispatcher_switch_to_view(pokemon_fap->view_dispatcher, AppViewSubmenu);
+}
+
+bool pokemon_scene_select_party_on_event(void* context, SceneManagerEvent event) {
+    furi_assert(context);
+    PokemonFap* pokemon_fap = context;
+    bool consumed = false;
+
+    if (event.type == SceneManagerEventTypeCustom && event.event & PokemonSceneBack) {
+        scene_manager_previous_scene(pokemon_fap->scene_manager);
+        consumed = true;
+    } else if(event.type == SceneManagerEventTypeCustom) {
+        scene_manager_next_scene(pokemon_fap->scene_manager, event.event);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void pokemon_scene_select_party_on_exit(void* context) {
+    UNUSED(context);
+}
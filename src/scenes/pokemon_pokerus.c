@@ -38,7 +38,7 @@ static void select_strain_callback(VariableItem* item) {
     else
         index--;
 
-    pokerus_set_strain(pokemon_fap->pdata, index);
+    pokerus_set_strain(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, index);
 
     select_pokerus_rebuild_list(pokemon_fap);
     variable_item_list_set_selected_item(pokemon_fap->variable_item_list, 0);
@@ -48,7 +48,7 @@ static void select_days_callback(VariableItem* item) {
     uint8_t index = variable_item_get_current_value_index(item);
     PokemonFap* pokemon_fap = variable_item_get_context(item);
 
-    pokerus_set_days(pokemon_fap->pdata, index);
+    pokerus_set_days(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, index);
 
     select_pokerus_rebuild_list(pokemon_fap);
     variable_item_list_set_selected_item(pokemon_fap->variable_item_list, 1);
@@ -59,7 +59,7 @@ static void select_pokerus_rebuild_list(PokemonFap* pokemon_fap) {
     uint8_t days;
     FuriString* daystring = NULL;
 
-    days = pokemon_stat_get(pokemon_fap->pdata, STAT_POKERUS, NONE);
+    days = pokemon_stat_get(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_POKERUS, NONE);
     strain = (days >> 4);
     days &= 0x0f;
 
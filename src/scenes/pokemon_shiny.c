@@ -8,7 +8,7 @@
 static void select_shiny_selected_callback(void* context, uint32_t index) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
 
-    pokemon_set_shiny(pokemon_fap->pdata, (bool)index);
+    pokemon_set_shiny(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, (bool)index);
 
     view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, PokemonSceneBack);
 }
@@ -10,7 +10,7 @@
 static void select_stats_selected_callback(void* context, uint32_t index) {
     PokemonFap* pokemon_fap = (PokemonFap*)context;
 
-    pokemon_stat_set(pokemon_fap->pdata, STAT_SEL, NONE, index);
+    pokemon_stat_set(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_SEL, NONE, index);
 
     scene_manager_previous_scene(pokemon_fap->scene_manager);
 }
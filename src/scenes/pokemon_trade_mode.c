@@ -0,0 +1,53 @@
+#include <gui/modules/submenu.h>
+
+#include <src/include/pokemon_app.h>
+
+#include <src/views/trade.h>
+
+#include <src/scenes/include/pokemon_scene.h>
+
+static void select_trade_mode_selected_callback(void* context, uint32_t index) {
+    PokemonFap* pokemon_fap = (PokemonFap*)context;
+
+    trade_queue_mode_set(pokemon_fap->trade, (TradeQueueMode)index);
+
+    view_dispatcher_send_custom_event(pokemon_fap->view_dispatcher, PokemonSceneBack);
+}
+
+void pokemon_scene_select_trade_mode_on_enter(void* context) {
+    PokemonFap* pokemon_fap = (PokemonFap*)context;
+    int i;
+
+    submenu_reset(pokemon_fap->submenu);
+    submenu_set_header(pokemon_fap->submenu, "Trade Mode");
+
+    for(i = 0; i < TRADE_QUEUE_COUNT; i++) {
+        submenu_add_item(
+            pokemon_fap->submenu,
+            trade_queue_mode_name_get(i),
+            i,
+            select_trade_mode_selected_callback,
+            pokemon_fap);
+    }
+
+    submenu_set_selected_item(pokemon_fap->submenu, trade_queue_mode_get(pokemon_fap->trade));
+
+    view_dispatcher_switch_to_view(pokemon_fap->view_dispatcher, AppViewSubmenu);
+}
+
+bool pokemon_scene_select_trade_mode_on_event(void* context, SceneManagerEvent event) {
+    furi_assert(context);
+    PokemonFap* pokemon_fap = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom && event.event & PokemonSceneBack) {
+        scene_manager_previous_scene(pokemon_fap->scene_manager);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void pokemon_scene_select_trade_mode_on_exit(void* context) {
+    UNUSED(context);
+}
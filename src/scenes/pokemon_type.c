@@ -35,6 +35,7 @@ static void select_type_callback(VariableItem* item) {
         item, namedlist_name_get_pos(context->pokemon_fap->pdata->type_list, pos));
     pokemon_stat_set(
         context->pokemon_fap->pdata,
+        context->pokemon_fap->pdata->party_sel,
         STAT_TYPE,
         context->type,
         namedlist_index_get(context->pokemon_fap->pdata->type_list, pos));
@@ -54,7 +55,7 @@ void pokemon_scene_select_type_on_enter(void* context) {
     /* NOTE: 2 is a magic number, but pretty obvious */
     for(i = 0; i < 2; i++) {
         type_cb[i].pokemon_fap = pokemon_fap;
-        type = pokemon_stat_get(pokemon_fap->pdata, STAT_TYPE, i);
+        type = pokemon_stat_get(pokemon_fap->pdata, pokemon_fap->pdata->party_sel, STAT_TYPE, i);
         pos = namedlist_pos_get(pokemon_fap->pdata->type_list, type);
 
         vitype[i] = variable_item_list_add(
@@ -0,0 +1,436 @@
+#include <furi.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/sprite_cache.h>
+#include <src/include/sprite_pack.h>
+
+/* Every sprite is 56x56, and is stored in a slot as a struct fxbm_sprite */
+#define SPRITE_WIDTH 56
+#define SPRITE_HEIGHT 56
+#define SPRITE_DATA_SIZE ((SPRITE_WIDTH / 8) * SPRITE_HEIGHT)
+#define FXBM_SPRITE_DATA_SIZE (sizeof(struct fxbm_sprite) + SPRITE_DATA_SIZE)
+
+/* In the legacy pack, each sprite is a 4 byte length followed by the sprite */
+#define FXBM_SPRITE_SIZE (sizeof(uint32_t) + FXBM_SPRITE_DATA_SIZE)
+
+/* Sanity limit on the number of sprites in a pack, for the index */
+#define SPRITE_PACK_COUNT_MAX 1024
+
+#define PREFETCH_STACK_SZ 1024
+#define PREFETCH_FLAG_REQUEST (1 << 0)
+#define PREFETCH_FLAG_EXIT (1 << 1)
+
+struct sprite_cache_slot {
+    /* Pokedex number of the sprite in this slot, 0 if empty */
+    int num;
+    /* Value of the cache's use counter when this slot was last returned */
+    uint32_t used;
+    /* Kept as uint32_t for the alignment of struct fxbm_sprite */
+    uint32_t sprite[FXBM_SPRITE_DATA_SIZE / sizeof(uint32_t)];
+};
+
+/* Locking: lock protects everything except file and scratch, which are
+ * protected by file_lock, and callback and context, which are protected by
+ * callback_lock. When both file_lock and lock are needed, file_lock is taken
+ * first. lock is never held across an SD card access.
+ *
+ * callback_lock is only ever taken on its own, and is held while the callback
+ * runs. The callback updates a view, whose draw callback takes lock through a
+ * peek, so the callback must never run with lock or file_lock held.
+ */
+struct sprite_cache {
+    Storage* storage;
+    File* file;
+    bool file_ok;
+    /* The offset index of a compressed pack, NULL for the legacy format */
+    uint32_t* index;
+    uint16_t count;
+    FuriMutex* file_lock;
+    /* Sprites are read in to here as stored, then decoded in to a slot */
+    uint32_t scratch[FXBM_SPRITE_DATA_SIZE / sizeof(uint32_t)];
+    size_t scratch_len;
+
+    FuriMutex* lock;
+    uint32_t used;
+    uint32_t hits;
+    uint32_t misses;
+    /* The slot last returned, which is never replaced by a prefetch */
+    struct sprite_cache_slot* pinned;
+    struct sprite_cache_slot slot[SPRITE_CACHE_SLOTS];
+
+    /* The latest prefetch request, seq is bumped for each new request */
+    FuriThread* thread;
+    int req_num;
+    int req_dir;
+    int req_min;
+    int req_max;
+    uint32_t req_seq;
+
+    FuriMutex* callback_lock;
+    SpriteCacheCallback callback;
+    void* context;
+};
+
+/* Check for the header of a compressed pack and read its index. Anything
+ * else is read as the legacy format, which has no header.
+ */
+static bool sprite_cache_index_load(struct sprite_cache* cache) {
+    struct sprite_pack_hdr hdr;
+    size_t len;
+    int i;
+
+    if(storage_file_read(cache->file, &hdr, sizeof(hdr)) != sizeof(hdr) ||
+       memcmp(hdr.magic, SPRITE_PACK_MAGIC, sizeof(hdr.magic)))
+        return true;
+
+    if(hdr.version != SPRITE_PACK_VERSION || hdr.width != SPRITE_WIDTH ||
+       hdr.height != SPRITE_HEIGHT || hdr.count == 0 || hdr.count > SPRITE_PACK_COUNT_MAX) {
+        FURI_LOG_E(TAG, "[sprite] Unsupported pack");
+        return false;
+    }
+
+    len = (hdr.count + 1) * sizeof(uint32_t);
+    cache->index = malloc(len);
+    if(storage_file_read(cache->file, cache->index, len) != len) {
+        FURI_LOG_E(TAG, "[sprite] Failed to read pack index");
+        return false;
+    }
+
+    /* Checked once here so that every read can trust the index */
+    for(i = 0; i < hdr.count; i++) {
+        if(cache->index[i + 1] < cache->index[i] ||
+           cache->index[i + 1] - cache->index[i] > SPRITE_DATA_SIZE) {
+            FURI_LOG_E(TAG, "[sprite] Bad pack index at %d", i + 1);
+            return false;
+        }
+    }
+    cache->count = hdr.count;
+
+    return true;
+}
+
+struct sprite_cache* sprite_cache_alloc(Storage* storage, const char* path) {
+    furi_assert(storage);
+    furi_assert(path);
+    struct sprite_cache* cache = NULL;
+
+    cache = malloc(sizeof(struct sprite_cache));
+    memset(cache, '\0', sizeof(struct sprite_cache));
+
+    cache->lock = furi_mutex_alloc(FuriMutexTypeNormal);
+    cache->file_lock = furi_mutex_alloc(FuriMutexTypeNormal);
+    cache->callback_lock = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    cache->storage = storage;
+    cache->file = storage_file_alloc(storage);
+    cache->file_ok = storage_file_open(cache->file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    if(cache->file_ok) cache->file_ok = sprite_cache_index_load(cache);
+    if(cache->file_ok)
+        FURI_LOG_D(
+            TAG,
+            "[sprite] Opened %s file \'%s\'",
+            cache->index ? "pack" : "legacy",
+            path);
+    else
+        FURI_LOG_E(TAG, "[sprite] Failed to open \'%s\'", path);
+
+    return cache;
+}
+
+void sprite_cache_free(struct sprite_cache* cache) {
+    furi_assert(cache);
+
+    if(cache->thread) {
+        furi_thread_flags_set(furi_thread_get_id(cache->thread), PREFETCH_FLAG_EXIT);
+        furi_thread_join(cache->thread);
+        furi_thread_free(cache->thread);
+    }
+
+    FURI_LOG_I(TAG, "[sprite] cache hits %lu, misses %lu", cache->hits, cache->misses);
+
+    storage_file_close(cache->file);
+    storage_file_free(cache->file);
+    free(cache->index);
+    furi_mutex_free(cache->callback_lock);
+    furi_mutex_free(cache->file_lock);
+    furi_mutex_free(cache->lock);
+    free(cache);
+}
+
+/* Read sprite num from the pack in to scratch, as it is stored, returns false
+ * on any error. file_lock must be held.
+ */
+static bool sprite_cache_read(struct sprite_cache* cache, int num) {
+    uint32_t size;
+    uint32_t offset;
+
+    if(!cache->file_ok) return false;
+
+    if(cache->index) {
+        if(num > cache->count) return false;
+        offset = cache->index[num - 1];
+        size = cache->index[num] - offset;
+    } else {
+        offset = (num - 1) * FXBM_SPRITE_SIZE;
+        if(!storage_file_seek(cache->file, offset, true)) return false;
+        if(storage_file_read(cache->file, &size, sizeof(size)) != sizeof(size)) return false;
+        if(size != FXBM_SPRITE_DATA_SIZE) return false;
+        offset += sizeof(size);
+    }
+
+    if(!storage_file_seek(cache->file, offset, true)) return false;
+    cache->scratch_len = size;
+
+    return storage_file_read(cache->file, cache->scratch, size) == size;
+}
+
+/* Decode scratch in to slot, returns false if it isn't a valid sprite.
+ * file_lock must be held.
+ */
+static bool sprite_cache_decode(struct sprite_cache* cache, struct sprite_cache_slot* slot) {
+    struct fxbm_sprite* sprite = (struct fxbm_sprite*)slot->sprite;
+
+    if(!cache->index) {
+        memcpy(slot->sprite, cache->scratch, sizeof(slot->sprite));
+        return true;
+    }
+
+    sprite->width = SPRITE_WIDTH;
+    sprite->height = SPRITE_HEIGHT;
+
+    return sprite_pack_decode(
+        sprite->data, (uint8_t*)cache->scratch, cache->scratch_len, SPRITE_WIDTH, SPRITE_HEIGHT);
+}
+
+/* Returns the slot holding num, or NULL. lock must be held. */
+static struct sprite_cache_slot* sprite_cache_find(struct sprite_cache* cache, int num) {
+    int i;
+
+    for(i = 0; i < SPRITE_CACHE_SLOTS; i++) {
+        if(cache->slot[i].num == num) return &cache->slot[i];
+    }
+
+    return NULL;
+}
+
+/* Decode scratch in to the least recently used slot that isn't pinned, both
+ * locks must be held. Returns NULL, and leaves the slot empty, if the sprite
+ * doesn't decode.
+ */
+static struct sprite_cache_slot* sprite_cache_insert(struct sprite_cache* cache, int num) {
+    struct sprite_cache_slot* victim = NULL;
+    int i;
+
+    /* Empty slots have a used of 0, so are always picked first */
+    for(i = 0; i < SPRITE_CACHE_SLOTS; i++) {
+        if(&cache->slot[i] == cache->pinned) continue;
+        if(!victim || cache->slot[i].used < victim->used) victim = &cache->slot[i];
+    }
+
+    if(!sprite_cache_decode(cache, victim)) {
+        victim->num = 0;
+        victim->used = 0;
+        return NULL;
+    }
+    victim->num = num;
+    victim->used = ++cache->used;
+
+    return victim;
+}
+
+/* Mark slot as just used and pin it, lock must be held */
+static const struct fxbm_sprite*
+    sprite_cache_hit(struct sprite_cache* cache, struct sprite_cache_slot* slot) {
+    cache->hits++;
+    slot->used = ++cache->used;
+    cache->pinned = slot;
+
+    return (const struct fxbm_sprite*)slot->sprite;
+}
+
+const struct fxbm_sprite* sprite_cache_get(struct sprite_cache* cache, int num) {
+    furi_assert(cache);
+    furi_assert(num > 0);
+    struct sprite_cache_slot* slot;
+    const struct fxbm_sprite* sprite = NULL;
+    bool ok;
+
+    furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+    slot = sprite_cache_find(cache, num);
+    if(slot) sprite = sprite_cache_hit(cache, slot);
+    furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+    if(sprite) return sprite;
+
+    furi_check(furi_mutex_acquire(cache->file_lock, FuriWaitForever) == FuriStatusOk);
+    furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+    cache->misses++;
+    /* The prefetch may have loaded it while waiting for file_lock */
+    slot = sprite_cache_find(cache, num);
+    if(slot) {
+        cache->pinned = slot;
+        sprite = (const struct fxbm_sprite*)slot->sprite;
+    } else {
+        /* Only a sprite that was just read successfully gets a slot */
+        furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+        ok = sprite_cache_read(cache, num);
+        furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+        if(ok) slot = sprite_cache_insert(cache, num);
+        if(slot) {
+            cache->pinned = slot;
+            sprite = (const struct fxbm_sprite*)slot->sprite;
+        } else {
+            FURI_LOG_E(TAG, "[sprite] Failed to read sprite %d", num);
+        }
+    }
+    furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+    furi_check(furi_mutex_release(cache->file_lock) == FuriStatusOk);
+
+    return sprite;
+}
+
+const struct fxbm_sprite* sprite_cache_peek(struct sprite_cache* cache, int num) {
+    furi_assert(cache);
+    furi_assert(num > 0);
+    struct sprite_cache_slot* slot;
+    const struct fxbm_sprite* sprite = NULL;
+
+    furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+    slot = sprite_cache_find(cache, num);
+    if(slot)
+        sprite = sprite_cache_hit(cache, slot);
+    else
+        cache->misses++;
+    furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+
+    return sprite;
+}
+
+/* The n'th sprite to prefetch for a request. The requested sprite itself is
+ * first, followed by SPRITE_PREFETCH_AHEAD in the scroll direction, then
+ * SPRITE_PREFETCH_BEHIND in the other direction. Wraps within min and max.
+ */
+static int sprite_cache_prefetch_num(int num, int dir, int min, int max, int n) {
+    int span = max - min + 1;
+
+    if(n > SPRITE_PREFETCH_AHEAD) {
+        n -= SPRITE_PREFETCH_AHEAD;
+        dir = -dir;
+    }
+
+    num = (num - min + (dir * n)) % span;
+    if(num < 0) num += span;
+
+    return num + min;
+}
+
+static int32_t sprite_cache_prefetch_thread(void* context) {
+    struct sprite_cache* cache = context;
+    uint32_t flags;
+    uint32_t seq;
+    int num, dir, min, max;
+    int n;
+    int prefetch;
+    bool ok;
+
+    while(true) {
+        flags = furi_thread_flags_wait(
+            PREFETCH_FLAG_REQUEST | PREFETCH_FLAG_EXIT, FuriFlagWaitAny, FuriWaitForever);
+        if(flags & FuriFlagError) continue;
+        if(flags & PREFETCH_FLAG_EXIT) break;
+
+        furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+        seq = cache->req_seq;
+        num = cache->req_num;
+        dir = cache->req_dir;
+        min = cache->req_min;
+        max = cache->req_max;
+        furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+
+        for(n = 0; n <= SPRITE_PREFETCH_AHEAD + SPRITE_PREFETCH_BEHIND; n++) {
+            prefetch = sprite_cache_prefetch_num(num, dir, min, max, n);
+
+            furi_check(furi_mutex_acquire(cache->file_lock, FuriWaitForever) == FuriStatusOk);
+            furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+            /* A newer request is waiting in the flags, start over with it */
+            if(seq != cache->req_seq) {
+                furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+                furi_check(furi_mutex_release(cache->file_lock) == FuriStatusOk);
+                break;
+            }
+            ok = (sprite_cache_find(cache, prefetch) == NULL);
+            furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+
+            if(ok) ok = sprite_cache_read(cache, prefetch);
+
+            furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+            if(ok) ok = (sprite_cache_insert(cache, prefetch) != NULL);
+            furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+            furi_check(furi_mutex_release(cache->file_lock) == FuriStatusOk);
+
+            /* Let the view know that what it is waiting on is ready. This is
+             * under callback_lock so that the callback can't be cleared out
+             * from under it.
+             */
+            if(ok && prefetch == num) {
+                furi_check(
+                    furi_mutex_acquire(cache->callback_lock, FuriWaitForever) == FuriStatusOk);
+                if(cache->callback) cache->callback(cache->context);
+                furi_check(furi_mutex_release(cache->callback_lock) == FuriStatusOk);
+            }
+        }
+    }
+
+    return 0;
+}
+
+void sprite_cache_prefetch(struct sprite_cache* cache, int num, int dir, int min, int max) {
+    furi_assert(cache);
+    furi_assert(min > 0 && min <= num && num <= max);
+
+    if(!cache->file_ok) return;
+
+    if(!cache->thread) {
+        cache->thread = furi_thread_alloc_ex(
+            "PokemonSprites", PREFETCH_STACK_SZ, sprite_cache_prefetch_thread, cache);
+        furi_thread_start(cache->thread);
+    }
+
+    dir = (dir < 0) ? -1 : 1;
+
+    furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+    /* Nothing to do if this is already the latest request */
+    if(num == cache->req_num && dir == cache->req_dir) {
+        furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+        return;
+    }
+    cache->req_num = num;
+    cache->req_dir = dir;
+    cache->req_min = min;
+    cache->req_max = max;
+    cache->req_seq++;
+    furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+
+    furi_thread_flags_set(furi_thread_get_id(cache->thread), PREFETCH_FLAG_REQUEST);
+}
+
+void sprite_cache_callback_set(
+    struct sprite_cache* cache,
+    SpriteCacheCallback callback,
+    void* context) {
+    furi_assert(cache);
+
+    furi_check(furi_mutex_acquire(cache->callback_lock, FuriWaitForever) == FuriStatusOk);
+    cache->callback = callback;
+    cache->context = context;
+    furi_check(furi_mutex_release(cache->callback_lock) == FuriStatusOk);
+}
+
+void sprite_cache_stats_get(struct sprite_cache* cache, uint32_t* hits, uint32_t* misses) {
+    furi_assert(cache);
+
+    furi_check(furi_mutex_acquire(cache->lock, FuriWaitForever) == FuriStatusOk);
+    if(hits) *hits = cache->hits;
+    if(misses) *misses = cache->misses;
+    furi_check(furi_mutex_release(cache->lock) == FuriStatusOk);
+}
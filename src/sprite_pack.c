@@ -0,0 +1,53 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <src/include/sprite_pack.h>
+
+bool sprite_pack_decode(
+    uint8_t* dest,
+    const uint8_t* src,
+    size_t len,
+    uint16_t width,
+    uint16_t height) {
+    size_t stride = (width + 7) / 8;
+    size_t size = sprite_pack_data_size(width, height);
+    size_t mask_len = (size + 7) / 8;
+    const uint8_t* mask = src;
+    const uint8_t* end = src + len;
+    uint8_t bits;
+    size_t i, j;
+
+    if(len == size) {
+        memcpy(dest, src, size);
+        return true;
+    }
+
+    if(len < mask_len || len > size) return false;
+    src += mask_len;
+
+    for(i = 0; i < size; i += 8) {
+        bits = mask[i / 8];
+        /* Most of a sprite is blank, skip 8 bytes at a time where possible */
+        if(bits == 0) {
+            memset(&dest[i], 0, (size - i < 8) ? size - i : 8);
+            continue;
+        }
+        for(j = i; j < i + 8 && j < size; j++, bits >>= 1) {
+            if(bits & 1) {
+                if(src == end) return false;
+                dest[j] = *src++;
+            } else {
+                dest[j] = 0;
+            }
+        }
+    }
+
+    if(src != end) return false;
+
+    /* Undo the row delta from the top down, each row is now the real one */
+    for(i = stride; i < size; i++)
+        dest[i] ^= dest[i - stride];
+
+    return true;
+}
@@ -1,7 +1,7 @@
 #include <src/include/named_list.h>
 #include <src/include/stat_nl.h>
 
-const NamedList stat_list[] = {
+static const NamedListItem stat_list_items[] = {
     {"Random IV, Zero EV", RANDIV_ZEROEV, 0},
     {"Random IV, Max EV / Level", RANDIV_LEVELEV, 0},
     {"Random IV, Max EV", RANDIV_MAXEV, 0},
@@ -10,3 +10,32 @@ const NamedList stat_list[] = {
     {"Max IV, Max EV", MAXIV_MAXEV, 0},
     {},
 };
+
+/* Generated by tools/named_list_gen.py, do not edit below this line */
+
+static const uint8_t stat_list_index_pos[256] = {
+    0, 1, 2, 3, 4, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+const NamedList stat_list = {
+    .items = stat_list_items,
+    .cnt = 6,
+    .index_pos = stat_list_index_pos,
+    .gen_pos = {NULL, NULL},
+    .gen_cnt = {0, 0},
+};
@@ -9,6 +9,8 @@
 
 struct select_model {
     uint8_t curr_pokemon;
+    /* Direction of the last scroll, -1 or 1 */
+    int8_t dir;
     const void* pokemon_table;
     PokemonData* pdata;
 };
@@ -24,18 +26,15 @@ static void select_pokemon_render_callback(Canvas* canvas, void* model) {
     struct select_model* view_model = model;
     uint8_t curr_pokemon = view_model->curr_pokemon;
     char pokedex_num[5];
+    const struct fxbm_sprite* sprite;
 
     snprintf(pokedex_num, sizeof(pokedex_num), "#%03d", curr_pokemon + 1);
 
-    /* Update the bitmap in pdata if needed */
-    pokemon_icon_get(view_model->pdata, curr_pokemon + 1);
-    canvas_draw_xbm(
-        canvas,
-        0,
-        0,
-        view_model->pdata->bitmap->width,
-        view_model->pdata->bitmap->height,
-        view_model->pdata->bitmap->data);
+    /* Draws the placeholder until the sprite is loaded, so that holding a
+     * direction to scroll never waits on the SD card.
+     */
+    sprite = pokemon_icon_peek(view_model->pdata, curr_pokemon + 1, view_model->dir);
+    canvas_draw_xbm(canvas, 0, 0, sprite->width, sprite->height, sprite->data);
 
     canvas_set_font(canvas, FontPrimary);
     canvas_draw_str_aligned(
@@ -59,6 +58,7 @@ static bool select_pokemon_input_callback(InputEvent* event, void* context) {
     struct select_ctx* select = (struct select_ctx*)context;
     bool consumed = false;
     uint8_t selected_pokemon;
+    int8_t dir = 1;
 
     furi_assert(context);
 
@@ -74,13 +74,15 @@ static bool select_pokemon_input_callback(InputEvent* event, void* context) {
     switch(event->key) {
     /* Advance to next view with the selected pokemon */
     case InputKeyOk:
-        pokemon_stat_set(select->pdata, STAT_NUM, NONE, selected_pokemon);
+        pokemon_stat_set(
+            select->pdata, select->pdata->party_sel, STAT_NUM, NONE, selected_pokemon);
 	view_dispatcher_send_custom_event(select->view_dispatcher, PokemonSceneBack);
         consumed = true;
         break;
 
     /* Move back one through the pokedex listing */
     case InputKeyLeft:
+        dir = -1;
         if(selected_pokemon == 0)
             selected_pokemon = select->pdata->dex_max;
         else
@@ -92,6 +94,7 @@ static bool select_pokemon_input_callback(InputEvent* event, void* context) {
          * underflow.
          */
     case InputKeyDown:
+        dir = -1;
         if(selected_pokemon >= 10)
             selected_pokemon -= 10;
         else
@@ -127,12 +130,22 @@ static bool select_pokemon_input_callback(InputEvent* event, void* context) {
     with_view_model(
         select->view,
         struct select_model * model,
-        { model->curr_pokemon = selected_pokemon; },
+        {
+            model->curr_pokemon = selected_pokemon;
+            model->dir = dir;
+        },
         true);
 
     return consumed;
 }
 
+/* Run from the sprite prefetch thread, redraw now that the sprite is ready */
+static void select_pokemon_sprite_callback(void* context) {
+    struct select_ctx* select = (struct select_ctx*)context;
+
+    with_view_model(select->view, struct select_model * model, { UNUSED(model); }, true);
+}
+
 void select_pokemon_enter_callback(void* context) {
     struct select_ctx* select = (struct select_ctx*)context;
 
@@ -140,11 +153,21 @@ void select_pokemon_enter_callback(void* context) {
         select->view,
         struct select_model * model,
         {
-            model->curr_pokemon = pokemon_stat_get(select->pdata, STAT_NUM, NONE);
+            model->curr_pokemon =
+                pokemon_stat_get(select->pdata, select->pdata->party_sel, STAT_NUM, NONE);
             model->pokemon_table = select->pdata->pokemon_table;
             model->pdata = select->pdata;
+            model->dir = 1;
         },
         true);
+
+    pokemon_icon_callback_set(select->pdata, select_pokemon_sprite_callback, select);
+}
+
+void select_pokemon_exit_callback(void* context) {
+    struct select_ctx* select = (struct select_ctx*)context;
+
+    pokemon_icon_callback_set(select->pdata, NULL, NULL);
 }
 
 void* select_pokemon_alloc(
@@ -165,6 +188,7 @@ void* select_pokemon_alloc(
     view_set_draw_callback(select->view, select_pokemon_render_callback);
     view_set_input_callback(select->view, select_pokemon_input_callback);
     view_set_enter_callback(select->view, select_pokemon_enter_callback);
+    view_set_exit_callback(select->view, select_pokemon_exit_callback);
 
     view_dispatcher_add_view(view_dispatcher, viewid, select->view);
 
@@ -84,12 +84,16 @@
  *     trade_blocks will re-sync between them with the new data. If the Game Boy
  *     leave the trade menu while the Flipper is in the WAITING state, the
  *     Flipper will go back to the READY state.
+ *
+ * C) In the colosseum, steps 7 and 8 are the same, then the Game Boy battles
+ *     the Flipper's party rather than trading with it, see trade_battle.c.
+ *     The Flipper stays in the COLOSSEUM state throughout.
  */
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <stdatomic.h>
 
-#include <dolphin/dolphin.h>
 #include <notification/notification_messages.h>
 
 #include <gui/elements.h>
@@ -100,6 +104,10 @@
 #include <src/include/pokemon_app.h>
 #include <src/include/pokemon_data.h>
 #include <src/include/patch_list.h>
+#include <src/include/wire_image.h>
+
+#include <src/views/trade_i.h>
+#include <src/views/trade_trace.h>
 
 /* Uncomment the following line to enable graphics testing for the different
  * phases of the trade view. Pressing the okay button will step through each
@@ -108,128 +116,41 @@
  */
 //#define GRAPHICS_TESTING
 
-#define DELAY_MICROSECONDS 15
-#define PKMN_BLANK 0x00
-
-#define ITEM_1_HIGHLIGHTED 0xD0
-#define ITEM_2_HIGHLIGHTED 0xD1
-#define ITEM_3_HIGHLIGHTED 0xD2
-#define ITEM_1_SELECTED 0xD4
-#define ITEM_2_SELECTED 0xD5
-#define ITEM_3_SELECTED 0xD6
-
-#define SERIAL_PREAMBLE_BYTE 0xFD
-
-#define SERIAL_PREAMBLE_LENGTH 6
-#define SERIAL_RN_PREAMBLE_LENGTH 7
-#define SERIAL_TRADE_PREAMBLE_LENGTH 9
-#define SERIAL_RNS_LENGTH 10
-#define SERIAL_PATCH_LIST_PART_TERMINATOR 0xFF
-#define SERIAL_NO_DATA_BYTE 0xFE
-
-#define PKMN_MASTER 0x01
-#define PKMN_SLAVE 0x02
-
-#define PKMN_CONNECTED 0x60
-#define PKMN_CONNECTED_II 0x61
-#define PKMN_TRADE_ACCEPT_GEN_I 0x62
-#define PKMN_TRADE_ACCEPT_GEN_II 0x72
-#define PKMN_TRADE_REJECT_GEN_I 0x61
-#define PKMN_TRADE_REJECT_GEN_II 0x71
-#define PKMN_TABLE_LEAVE_GEN_I 0x6f
-#define PKMN_TABLE_LEAVE_GEN_II 0x7f
-#define PKMN_SEL_NUM_MASK_GEN_I 0x60
-#define PKMN_SEL_NUM_MASK_GEN_II 0x70
-#define PKMN_SEL_NUM_ONE_GEN_I 0x60
-#define PKMN_SEL_NUM_ONE_GEN_II 0x70
-
-#define PKMN_ACTION 0x60
-
-#define PKMN_TRADE_CENTRE ITEM_1_SELECTED
-#define PKMN_COLOSSEUM ITEM_2_SELECTED
-#define PKMN_BREAK_LINK ITEM_3_SELECTED
-
-struct important_bytes {
-    const uint8_t connected;
-    const uint8_t trade_accept;
-    const uint8_t trade_reject;
-    const uint8_t table_leave;
-    const uint8_t sel_num_mask;
-    const uint8_t sel_num_one;
-};
+/* The draw timer runs once per frame, the LED and trade animation only flip
+ * every TRADE_LED_FRAMES frames.
+ */
+#define TRADE_FRAME_MS 50
+#define TRADE_LED_FRAMES 5
 
-static const struct important_bytes gen_i = {
+const struct important_bytes gen_i = {
     PKMN_CONNECTED,
     PKMN_TRADE_ACCEPT_GEN_I,
     PKMN_TRADE_REJECT_GEN_I,
     PKMN_TABLE_LEAVE_GEN_I,
     PKMN_SEL_NUM_MASK_GEN_I,
     PKMN_SEL_NUM_ONE_GEN_I,
+    PKMN_BATTLE_MASK_GEN_I,
 };
 
-static const struct important_bytes gen_ii = {
+const struct important_bytes gen_ii = {
     PKMN_CONNECTED_II,
     PKMN_TRADE_ACCEPT_GEN_II,
     PKMN_TRADE_REJECT_GEN_II,
     PKMN_TABLE_LEAVE_GEN_II,
     PKMN_SEL_NUM_MASK_GEN_II,
     PKMN_SEL_NUM_ONE_GEN_II,
-};
-
-/* States specific to the trade process. */
-typedef enum {
-    TRADE_RESET,
-    TRADE_INIT,
-    TRADE_RANDOM,
-    TRADE_DATA,
-    TRADE_PATCH_HEADER,
-    TRADE_PATCH_DATA,
-    TRADE_SELECT,
-    TRADE_MAIL,
-    TRADE_PENDING,
-    TRADE_CONFIRMATION,
-    TRADE_DONE,
-    TRADE_CANCEL
-} trade_centre_state_t;
-
-/* Global states for the trade logic. These are used to dictate what gets drawn
- * to the screen but also handle a few sync states. The CONN states are to denote
- * if a link has been established or note. READY through TRADING are all specific
- * screens to draw in the trade center. COLOSSEUM causes a data loopback so the
- * player can fight themselves.
- */
-typedef enum {
-    GAMEBOY_CONN_FALSE,
-    GAMEBOY_CONN_TRUE,
-    GAMEBOY_READY,
-    GAMEBOY_WAITING,
-    GAMEBOY_TRADE_PENDING,
-    GAMEBOY_TRADING,
-    GAMEBOY_TRADE_CANCEL,
-    GAMEBOY_COLOSSEUM,
-    GAMEBOY_STATE_COUNT
-} render_gameboy_state_t;
-
-/* Anonymous struct */
-struct trade_ctx {
-    trade_centre_state_t trade_centre_state;
-    FuriTimer* draw_timer;
-    View* view;
-    uint8_t in_data;
-    uint8_t out_data;
-    uint8_t shift;
-    PokemonData* input_pdata;
-    struct patch_list* patch_list;
-    void* gblink_handle;
-    PokemonData* pdata;
-    NotificationApp* notifications;
+    PKMN_BATTLE_MASK_GEN_II,
 };
 
 /* These are the needed variables for the draw callback */
 struct trade_model {
     render_gameboy_state_t gameboy_status;
     bool ledon; // Controls the blue LED during trade
-    uint8_t curr_pokemon;
+    uint8_t curr_slot; // Party slot shown while at the trade table
+    /* Session trade count, and trades per minute x10 as of the last trade */
+    uint16_t trades;
+    uint16_t trades_per_min;
+    bool queue_done; // The whole staged party has been traded away
     PokemonData* pdata;
 };
 
@@ -252,33 +173,24 @@ static bool trade_input_callback(InputEvent* event, void* context) {
 
 #ifdef GRAPHICS_TESTING
     if(event->type == InputTypePress) {
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            {
-                if(event->key == InputKeyRight) {
-                    model->gameboy_status++;
-                    if(model->gameboy_status == GAMEBOY_STATE_COUNT)
-                        model->gameboy_status = GAMEBOY_CONN_FALSE;
-                } else if(event->key == InputKeyLeft) {
-                    if(model->gameboy_status == GAMEBOY_CONN_FALSE)
-                        model->gameboy_status = GAMEBOY_COLOSSEUM;
-                    else
-                        model->gameboy_status--;
-                }
-            },
-            true);
+        gameboy_status = trade_status_get(trade);
+        if(event->key == InputKeyRight) {
+            gameboy_status++;
+            if(gameboy_status == GAMEBOY_STATE_COUNT) gameboy_status = GAMEBOY_CONN_FALSE;
+        } else if(event->key == InputKeyLeft) {
+            if(gameboy_status == GAMEBOY_CONN_FALSE)
+                gameboy_status = GAMEBOY_COLOSSEUM;
+            else
+                gameboy_status--;
+        }
+        trade_status_set(trade, gameboy_status);
     }
 #endif
 
     /* Only handling back button */
     if(event->key != InputKeyBack) return false;
 
-    with_view_model(
-        trade->view,
-        struct trade_model * model,
-        { gameboy_status = model->gameboy_status; },
-        false);
+    gameboy_status = trade_status_get(trade);
 
     /* States READY or lower can be exited without issue, let the view_dispatcher
 	 * nav callback handle it.
@@ -292,50 +204,14 @@ static bool trade_input_callback(InputEvent* event, void* context) {
 	 * until the gameboy side gets the hint and cancels as well.
 	 */
     if(gameboy_status == GAMEBOY_WAITING && event->type == InputTypeShort) {
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            { model->gameboy_status = GAMEBOY_TRADE_CANCEL; },
-            false);
-        trade->trade_centre_state = TRADE_CANCEL;
+        trade_status_set(trade, GAMEBOY_TRADE_CANCEL);
+        trade->centre.state = TRADE_CANCEL;
     }
 
     /* Anything here, we should consider handled */
     return true;
 }
 
-/* A callback function that must be called outside of an interrupt context,
- * This will completely destroy the current patch list, and then rebuild it from
- * the current trade_block state. This is used mostly after a trade to rebuild
- * the list with the new data we just copied in.
- */
-static void pokemon_plist_recreate_callback(void* context, uint32_t arg) {
-    furi_assert(context);
-    UNUSED(arg);
-    struct trade_ctx* trade = context;
-
-    /* Award some XP to the dolphin after a completed trade. This needs to
-     * happen outside of an ISR context, so we slap it here.
-     */
-    dolphin_deed(DolphinDeedPluginGameWin);
-    plist_create(&(trade->patch_list), trade->pdata);
-}
-
-/* Call this at any point to reset the timer on the backlight turning off.
- * During trade, this should get called pretty frequently so long as data
- * is moving in and out.
- *
- * I hesitate to force the backlight on, as I don't want to be responsible
- * for draining someone's battery on accident.
- */
-static void trade_backlight_bump_callback(void* context, uint32_t arg) {
-    furi_assert(context);
-    UNUSED(arg);
-    struct trade_ctx* trade = context;
-
-    notification_message(trade->notifications, &sequence_display_backlight_on);
-}
-
 static void trade_draw_bottom_bar(Canvas* const canvas) {
     furi_assert(canvas);
 
@@ -391,33 +267,109 @@ static void trade_draw_frame(Canvas* canvas, const char* str) {
     canvas_draw_icon(canvas, 61, 2, &I_red_16x15);
 }
 
-/* Draws the Pokemon's image in the middle of the screen */
-static void trade_draw_pkmn_avatar(Canvas* canvas, PokemonData* pdata) {
+/* Draws the session trade counters under the text box, once there are any */
+static void trade_draw_counters(Canvas* canvas, struct trade_model* model) {
+    furi_assert(canvas);
+    char buf[16];
+
+    if(model->trades == 0) return;
+
+    canvas_set_font(canvas, FontSecondary);
+    snprintf(buf, sizeof(buf), "Trades: %u", model->trades);
+    canvas_draw_str(canvas, 62, 30, buf);
+    snprintf(
+        buf,
+        sizeof(buf),
+        "%u.%u/min",
+        model->trades_per_min / 10,
+        model->trades_per_min % 10);
+    canvas_draw_str(canvas, 62, 40, buf);
+    if(model->queue_done) canvas_draw_str(canvas, 62, 50, "Queue done");
+    canvas_set_font(canvas, FontPrimary);
+}
+
+/* Draws the image of the Pokemon in slot in the middle of the screen */
+static void trade_draw_pkmn_avatar(Canvas* canvas, PokemonData* pdata, uint8_t slot) {
     furi_assert(canvas);
     furi_assert(pdata);
 
-    /* First, ensure the icon we want is already loaded in to pdata->bitmap */
-    pokemon_icon_get(pdata, pokemon_stat_get(pdata, STAT_NUM, NONE) + 1);
-    canvas_draw_xbm(
-        canvas, 0, 0, pdata->bitmap->width, pdata->bitmap->height, pdata->bitmap->data);
+    const struct fxbm_sprite* sprite =
+        pokemon_icon_get(pdata, pokemon_stat_get(pdata, slot, STAT_NUM, NONE) + 1);
+
+    canvas_draw_xbm(canvas, 0, 0, sprite->width, sprite->height, sprite->data);
 
     furi_hal_light_set(LightBlue, 0x00);
     furi_hal_light_set(LightGreen, 0x00);
 }
 
-/* Called every 250 ms on a timer. This controls the blue LED when in TRADING
- * state. This is necessary as Flipper OS does not make any guarantees on when
- * draw updates may or may not be called. There are situations where a draw
- * update is called much faster. Therefore, we need to control the update rate
- * via the ledon view_model variable.
+/* Called every frame on a timer. This is the only place that the link state
+ * owned by the ISR is pushed to the view model, and the model is only
+ * committed if something actually changed.
+ *
+ * This also controls the blue LED when in TRADING state, flipping every
+ * TRADE_LED_FRAMES frames. This is necessary as Flipper OS does not make any
+ * guarantees on when draw updates may or may not be called. There are
+ * situations where a draw update is called much faster. Therefore, we need to
+ * control the update rate via the ledon view_model variable.
+ *
+ * If there was any link activity since the last frame, the backlight timer is
+ * reset so it stays on during a trade. I hesitate to force the backlight on,
+ * as I don't want to be responsible for draining someone's battery on accident.
  */
 static void trade_draw_timer_callback(void* context) {
     furi_assert(context);
 
     struct trade_ctx* trade = (struct trade_ctx*)context;
+    render_gameboy_state_t gameboy_status = trade_status_get(trade);
+    uint8_t curr_slot = trade->pdata->party_sel;
+    unsigned int trades = atomic_load(&trade->queue.trades);
+    bool queue_done = atomic_load(&trade->queue.done);
+    unsigned int ran = atomic_exchange(&trade->battle.ran, 0);
+    uint32_t elapsed;
+    bool led_flip = false;
+    bool update = false;
+
+    /* Once the Game Boy picks, show the Pokemon we are offering in return */
+    if(gameboy_status == GAMEBOY_TRADE_PENDING) curr_slot = trade->centre.out_pkmn_idx;
+
+    trade->frame_cnt++;
+    if(trade->frame_cnt >= TRADE_LED_FRAMES) {
+        trade->frame_cnt = 0;
+        led_flip = true;
+    }
 
     with_view_model(
-        trade->view, struct trade_model * model, { model->ledon ^= 1; }, true);
+        trade->view,
+        struct trade_model * model,
+        {
+            if(model->gameboy_status != gameboy_status || model->curr_slot != curr_slot) {
+                model->gameboy_status = gameboy_status;
+                model->curr_slot = curr_slot;
+                update = true;
+            }
+            if(led_flip) {
+                model->ledon ^= 1;
+                update = true;
+            }
+            if(model->trades != trades) {
+                /* Ticks are ms, rate is averaged over the whole session */
+                elapsed = furi_get_tick() - trade->queue.start_tick;
+                if(elapsed == 0) elapsed = 1;
+                model->trades = trades;
+                model->trades_per_min = ((uint64_t)trades * 600000) / elapsed;
+                update = true;
+            }
+            if(model->queue_done != queue_done) {
+                model->queue_done = queue_done;
+                update = true;
+            }
+        },
+        update);
+
+    if(atomic_exchange(&trade->link_activity, false))
+        notification_message(trade->notifications, &sequence_display_backlight_on);
+
+    if(ran) FURI_LOG_I(TAG, "[battle] Game Boy ran after %u exchanges", ran);
 }
 
 static void trade_draw_callback(Canvas* canvas, void* view_model) {
@@ -437,16 +389,19 @@ static void trade_draw_callback(Canvas* canvas, void* view_model) {
         trade_draw_connection(canvas, true);
         break;
     case GAMEBOY_READY:
-        trade_draw_pkmn_avatar(canvas, model->pdata);
+        trade_draw_pkmn_avatar(canvas, model->pdata, model->curr_slot);
         trade_draw_frame(canvas, "READY");
+        trade_draw_counters(canvas, model);
         break;
     case GAMEBOY_WAITING:
-        trade_draw_pkmn_avatar(canvas, model->pdata);
+        trade_draw_pkmn_avatar(canvas, model->pdata, model->curr_slot);
         trade_draw_frame(canvas, "WAITING");
+        trade_draw_counters(canvas, model);
         break;
     case GAMEBOY_TRADE_PENDING:
-        trade_draw_pkmn_avatar(canvas, model->pdata);
+        trade_draw_pkmn_avatar(canvas, model->pdata, model->curr_slot);
         trade_draw_frame(canvas, "DEAL?");
+        trade_draw_counters(canvas, model);
         break;
     case GAMEBOY_TRADING:
         furi_hal_light_set(LightGreen, 0x00);
@@ -481,11 +436,7 @@ static uint8_t getConnectResponse(struct trade_ctx* trade) {
     switch(trade->in_data) {
     case PKMN_CONNECTED:
     case PKMN_CONNECTED_II:
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            { model->gameboy_status = GAMEBOY_CONN_TRUE; },
-            false);
+        trade_status_set(trade, GAMEBOY_CONN_TRUE);
         break;
     case PKMN_MASTER:
         ret = PKMN_SLAVE;
@@ -494,11 +445,7 @@ static uint8_t getConnectResponse(struct trade_ctx* trade) {
         ret = PKMN_BLANK;
         break;
     default:
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            { model->gameboy_status = GAMEBOY_CONN_FALSE; },
-            false);
+        trade_status_set(trade, GAMEBOY_CONN_FALSE);
         ret = PKMN_BREAK_LINK;
         break;
     }
@@ -518,12 +465,8 @@ static uint8_t getConnectResponse(struct trade_ctx* trade) {
  * the linked Game Boy is still trying to negotiate roles and we need to
  * respond with a follower/slave byte.
  *
- * Note that, we can probably eventually drop colosseum/battle connections,
- * though it may be an interesting exercise in better understanding how the
- * "random" seeding is done between the units. As noted here:
- * http://www.adanscotney.com/2014/01/spoofing-pokemon-trades-with-stellaris.html
- * it is presumed these bytes are to sync the RNG seed between the units to
- * not need arbitration on various die rolls.
+ * Both the trade centre and the colosseum start with the same exchange at
+ * the table, the trade centre state machine is told which one it is in.
  */
 static uint8_t getMenuResponse(struct trade_ctx* trade) {
     furi_assert(trade);
@@ -542,26 +485,16 @@ static uint8_t getMenuResponse(struct trade_ctx* trade) {
         }
         [[fallthrough]];
     case PKMN_TRADE_CENTRE:
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            { model->gameboy_status = GAMEBOY_READY; },
-            false);
+        trade_centre_mode_set(&trade->centre, trade->pdata->gen, false);
+        trade_status_set(trade, GAMEBOY_READY);
         break;
     case PKMN_COLOSSEUM:
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            { model->gameboy_status = GAMEBOY_COLOSSEUM; },
-            false);
+        trade_centre_mode_set(&trade->centre, trade->pdata->gen, true);
+        trade_status_set(trade, GAMEBOY_COLOSSEUM);
         break;
     case PKMN_BREAK_LINK:
     case PKMN_MASTER:
-        with_view_model(
-            trade->view,
-            struct trade_model * model,
-            { model->gameboy_status = GAMEBOY_CONN_FALSE; },
-            false);
+        trade_status_set(trade, GAMEBOY_CONN_FALSE);
         response = PKMN_BREAK_LINK;
         break;
     default:
@@ -572,254 +505,38 @@ static uint8_t getMenuResponse(struct trade_ctx* trade) {
     return response;
 }
 
-static uint8_t getTradeCentreResponse(struct trade_ctx* trade) {
+uint8_t trade_link_byte(struct trade_ctx* trade, uint8_t in_byte) {
     furi_assert(trade);
 
-    uint8_t* trade_block_flat = (uint8_t*)trade->pdata->trade_block;
-    uint8_t* input_block_flat = (uint8_t*)trade->input_pdata->trade_block;
-    uint8_t* input_party_flat = (uint8_t*)trade->input_pdata->party;
-    struct trade_model* model = NULL;
-    uint8_t in = trade->in_data;
-    uint8_t send = in;
-    static bool patch_pt_2;
-    static size_t counter;
-    static uint8_t in_pkmn_idx;
-    const struct important_bytes* bytes = NULL;
-
-    if(trade->pdata->gen == GEN_I) bytes = &gen_i;
-    if(trade->pdata->gen == GEN_II) bytes = &gen_ii;
-
-    /* TODO: Figure out how we should respond to a no_data_byte and/or how to
-     * send one and what response to expect.
-     *
-     * This isn't a high priority since it should be unlikely that we would
-     * actually ever receive a NO_DATA_BYE as the Game Boy is the leader/master
-     * and therefore would only transmit when it has data ready.
-     */
+    uint8_t send;
 
-    /* Since this is a fairly long function, it doesn't call any other functions,
-     * the view model isn't locked, and we're in an interrupt context, lets just
-     * map the view model to a local var and commit it back when we're done.
-     */
-    model = view_get_model(trade->view);
-
-    /* There is a handful of communications that happen once the Game Boy
-     * clicks on the table. For all of them, the Flipper can just mirror back
-     * the byte the Game Boy sends. We can spin in this forever until we see 10x
-     * SERIAL_PREAMBLE_BYTEs. Once we receive those, the counters are synced,
-     * and every byte after that can be easily counted for the actual transfer
-     * of Pokemon data.
-     */
-    switch(trade->trade_centre_state) {
-    case TRADE_RESET:
-        /* Reset counters and other static variables */
-        counter = 0;
-        patch_pt_2 = false;
-        trade->trade_centre_state = TRADE_INIT;
-        break;
-
-    /* This state runs through the end of the random preamble */
-    case TRADE_INIT:
-        if(in == SERIAL_PREAMBLE_BYTE) {
-            counter++;
-            model->gameboy_status = GAMEBOY_WAITING;
-        }
-        if(counter == SERIAL_RNS_LENGTH) {
-            trade->trade_centre_state = TRADE_RANDOM;
-            counter = 0;
-        }
-        break;
-
-    /* Once we start getting PKMN_BLANKs, we mirror them until we get 10x
-     * SERIAL_PREAMBLE_BYTE, and then 10 random numbers. The 10 random
-     * numbers are for synchronizing the PRNG between the two systems,
-     * we do not use these numbers at this time.
-     *
-     * This waits through the end of the trade block preamble, a total of 19
-     * bytes.
-     */
-    case TRADE_RANDOM:
-        counter++;
-        if(counter == (SERIAL_RNS_LENGTH + SERIAL_TRADE_PREAMBLE_LENGTH)) {
-            trade->trade_centre_state = TRADE_DATA;
-            counter = 0;
-        }
-        break;
-
-    /* This is where we exchange trade_block data with the Game Boy */
-    case TRADE_DATA:
-        input_block_flat[counter] = in;
-        send = trade_block_flat[counter];
-        counter++;
-
-        if(counter == trade->input_pdata->trade_block_sz) {
-            trade->trade_centre_state = TRADE_PATCH_HEADER;
-            counter = 0;
-        }
-
-        break;
-
-    /* This absorbs the 3 byte ending sequence (DF FE 15) after the trade data is
-     * swapped, then the 3x SERIAL_PREAMBLE_BYTEs that end the trade data, and
-     * another 3x of them that start the patch data. By the time we're done with
-     * this state, the patch list BLANK bytes are ready to be transmitted.
-     * We only care about the 6x total preamble bytes.
-     */
-    case TRADE_PATCH_HEADER:
-        if(in == SERIAL_PREAMBLE_BYTE) {
-            counter++;
-        }
-
-        if(counter == 6) {
-            counter = 0;
-            trade->trade_centre_state = TRADE_PATCH_DATA;
-        } else {
-            break;
-        }
-        [[fallthrough]];
-    case TRADE_PATCH_DATA:
-        counter++;
-        /* This magic number is basically the header length, 10, minus
-	 * the 3x 0xFD that we should be transmitting as part of the patch
-	 * list header.
-	 */
-        if(counter > 8) {
-            send = plist_index_get(trade->patch_list, (counter - 9));
-        }
-
-        /* Patch received data */
-        /* This relies on the data sent only ever sending 0x00 after
-         * part 2 of the patch list has been terminated. This is the
-         * case in official Gen I code at this time.
-         */
-        switch(in) {
-        case PKMN_BLANK:
-            break;
-        case SERIAL_PATCH_LIST_PART_TERMINATOR:
-            patch_pt_2 = true;
-            break;
-        default: // Any nonzero value will cause a patch
-            if(!patch_pt_2) {
-                /* Pt 1 is 0x00 - 0xFB */
-                input_party_flat[in - 1] = SERIAL_NO_DATA_BYTE;
-            } else {
-                /* Pt 2 is 0xFC - 0x107
-		 * 0xFC + in - 1
-		 */
-                input_party_flat[0xFB + in] = SERIAL_NO_DATA_BYTE;
-            }
-            break;
-        }
-
-        /* What is interesting about the following check, is the Pokemon code
-	 * seems to allocate 203 bytes, 3x for the preamble, and then 200 bytes
-	 * of patch list. But in practice, the Game Boy seems to transmit 3x
-	 * preamble bytes, 7x 0x00, then 189 bytes for the patch list. A
-	 * total of 199 bytes transmitted.
-	 */
-        /* Gen I and II patch lists seem to be the same length */
-        if(counter == 196) {
-            if(trade->pdata->gen == GEN_I)
-                trade->trade_centre_state = TRADE_SELECT;
-            else if(trade->pdata->gen == GEN_II)
-                trade->trade_centre_state = TRADE_MAIL;
-
-            counter = 0;
-        }
-
-        break;
-
-    /* Preambled with 6x 0x20 bytes; 33*6 == 198 bytes of Mail, for each pokemon,
-     * even if they have no mail set; 14*6 == 84 bytes, for each pokemon's mail,
-     * the OT Name and ID; a 0xff; 100 zero bytes (unsure if they are always 0).
-     * This is 6 + 198 + 84 + 1 + 100 == 389.
-     */
-    case TRADE_MAIL:
-        counter++;
-        if(counter == 389) trade->trade_centre_state = TRADE_SELECT;
-        break;
-
-    /* Resets the incoming Pokemon index, and once a BLANK byte is received,
-     * moves to the pending state.
-     */
-    case TRADE_SELECT:
-        in_pkmn_idx = 0;
-        if(in == PKMN_BLANK) {
-            trade->trade_centre_state = TRADE_PENDING;
-        } else {
-            break;
-        }
-        [[fallthrough]];
-    /* Handle the Game Boy selecting a Pokemon to trade, or leaving the table */
-    /* XXX: TODO: Clean this up. Easiest is probably to use vars rather than
-     * macros to check against and set output to.
-     */
-    case TRADE_PENDING:
-        /* If the player leaves the trade menu and returns to the room */
-        if(in == bytes->table_leave) {
-            trade->trade_centre_state = TRADE_RESET;
-            send = bytes->table_leave;
-            model->gameboy_status = GAMEBOY_READY;
-            /* If the player selected a Pokemon to send from the Game Boy */
-        } else if((in & bytes->sel_num_mask) == bytes->sel_num_mask) {
-            in_pkmn_idx = in;
-            send = bytes->sel_num_one; // We always send the first pokemon
-            model->gameboy_status = GAMEBOY_TRADE_PENDING;
-            /* BLANKs are sent in a few places, we want to do nothing about them
-	 * unless the Game Boy already sent us an index they want to trade.
-	 */
-        } else if(in == PKMN_BLANK) {
-            if(in_pkmn_idx != 0) {
-                send = 0;
-                trade->trade_centre_state = TRADE_CONFIRMATION;
-                in_pkmn_idx &= 0x0F;
-            }
-        }
-        break;
-
-    /* Handle the Game Boy accepting or rejecting a trade deal */
-    case TRADE_CONFIRMATION:
-        if(in == bytes->trade_reject) {
-            trade->trade_centre_state = TRADE_SELECT;
-            model->gameboy_status = GAMEBOY_WAITING;
-        } else if(in == bytes->trade_accept) {
-            trade->trade_centre_state = TRADE_DONE;
-        }
-        break;
+    trade->in_data = in_byte;
 
-    /* Start the actual trade. Waits in reset until the Game Boy is done with
-     * its animation and re-exchanges updated party data.
-     */
-    case TRADE_DONE:
-        if(in == PKMN_BLANK) {
-            trade->trade_centre_state = TRADE_RESET;
-            model->gameboy_status = GAMEBOY_TRADING;
-
-            /* Copy the traded-in Pokemon's main data to our struct */
-            pokemon_stat_memcpy(trade->pdata, trade->input_pdata, in_pkmn_idx);
-            model->curr_pokemon = pokemon_stat_get(trade->pdata, STAT_NUM, NONE);
-
-            /* Schedule a callback outside of ISR context to rebuild the patch
-	     * list with the new Pokemon that we just accepted.
-	     */
-            furi_timer_pending_callback(pokemon_plist_recreate_callback, trade, 0);
-        }
+    /* Once a byte of data has been shifted in, process it */
+    switch(trade_status_get(trade)) {
+    case GAMEBOY_CONN_FALSE:
+        send = getConnectResponse(trade);
         break;
-
-    case TRADE_CANCEL:
-        if(in == bytes->table_leave) {
-            trade->trade_centre_state = TRADE_RESET;
-            model->gameboy_status = GAMEBOY_READY;
-        }
-        send = bytes->table_leave;
+    case GAMEBOY_CONN_TRUE:
+        send = getMenuResponse(trade);
         break;
-
+    /* Every other state is trade or colosseum related */
     default:
-        // Do Nothing
+        send = trade_centre_byte(trade, in_byte);
         break;
     }
 
-    view_commit_model(trade->view, false);
+    /* Flag that data is moving, the draw timer will bump the backlight */
+    atomic_store(&trade->link_activity, true);
+
+    if(trade->trace) {
+        trade_trace_record(
+            trade->trace,
+            in_byte,
+            send,
+            trade->centre.state,
+            trade_status_get(trade));
+    }
 
     return send;
 }
@@ -828,66 +545,96 @@ static void transferBit(void* context, uint8_t in_byte) {
     furi_assert(context);
 
     struct trade_ctx* trade = (struct trade_ctx*)context;
-    render_gameboy_state_t status;
 
-    with_view_model(
-        trade->view, struct trade_model * model, { status = model->gameboy_status; }, false);
-
-    trade->in_data = in_byte;
+    gblink_transfer(trade->gblink_handle, trade_link_byte(trade, in_byte));
+}
 
-    /* Once a byte of data has been shifted in, process it */
-    switch(status) {
-    case GAMEBOY_CONN_FALSE:
-        gblink_transfer(trade->gblink_handle, getConnectResponse(trade));
-        break;
-    case GAMEBOY_CONN_TRUE:
-        gblink_transfer(trade->gblink_handle, getMenuResponse(trade));
-        break;
-    case GAMEBOY_COLOSSEUM:
-        gblink_transfer(trade->gblink_handle, in_byte);
-        break;
-    /* Every other state is trade related */
-    default:
-        gblink_transfer(trade->gblink_handle, getTradeCentreResponse(trade));
-        break;
+/* Start a new trade session, and in TRADE_QUEUE_PARTY mode stage a copy of
+ * the party as it is right now.
+ */
+static void trade_queue_start(struct trade_ctx* trade) {
+    struct trade_queue* queue = &trade->queue;
+
+    queue->mode = queue->setting;
+    queue->slot = trade->pdata->party_sel;
+    if(queue->mode == TRADE_QUEUE_PARTY) {
+        memcpy(
+            queue->staged->trade_block,
+            trade->pdata->trade_block,
+            trade->pdata->trade_block_sz);
+        /* pokemon_stat_memcpy() brings the mail along from staged as well */
+        if(trade->pdata->mail) memcpy(queue->staged->mail, trade->pdata->mail, LEN_MAIL_BLOCK);
+        queue->next = (queue->slot + 1) % pokemon_party_cnt_get(trade->pdata);
     }
-
-    /* Each byte that comes in, bump the backlight timer so it stays on during a trade */
-    furi_timer_pending_callback(trade_backlight_bump_callback, trade, 0);
+    atomic_store(&queue->trades, 0);
+    atomic_store(&queue->done, false);
+    queue->start_tick = furi_get_tick();
 }
 
 void trade_enter_callback(void* context) {
     furi_assert(context);
     struct trade_ctx* trade = (struct trade_ctx*)context;
     struct trade_model* model;
+    render_gameboy_state_t gameboy_status = trade_status_get(trade);
+
+    /* A battle can't be picked back up, the Game Boy has to link up again */
+    if(gameboy_status == GAMEBOY_COLOSSEUM) {
+        gameboy_status = GAMEBOY_CONN_FALSE;
+        trade_centre_mode_set(&trade->centre, trade->pdata->gen, false);
+    } else if(gameboy_status > GAMEBOY_READY) {
+        gameboy_status = GAMEBOY_READY;
+    }
+    trade_status_set(trade, gameboy_status);
+    trade->centre.state = TRADE_RESET;
+    atomic_store(&trade->link_activity, false);
+    trade->frame_cnt = 0;
 
     model = view_get_model(trade->view);
-
-    if(model->gameboy_status == GAMEBOY_COLOSSEUM) {
-        model->gameboy_status = GAMEBOY_CONN_FALSE;
-    } else if(model->gameboy_status > GAMEBOY_READY) {
-        model->gameboy_status = GAMEBOY_READY;
-    }
-    trade->trade_centre_state = TRADE_RESET;
-    model->curr_pokemon = pokemon_stat_get(trade->pdata, STAT_NUM, NONE);
+    model->gameboy_status = gameboy_status;
+    model->curr_slot = trade->pdata->party_sel;
     model->ledon = false;
-
+    model->trades = 0;
+    model->queue_done = false;
     view_commit_model(trade->view, true);
 
+    /* Bring the trade patch list up to date with any changes made to the
+     * trade block, and then build the full outgoing wire image. These need
+     * to be ready before the link starts.
+     */
+    plist_update(trade->patch_list, trade->pdata);
+    wire_image_build(trade->wire_image, trade->pdata, trade->patch_list);
+
+#ifdef LINK_SIMULATOR
+    trade_sim_run(trade);
+#endif
+
+#ifdef LINK_REPLAY
+    trade_trace_replay(TRADE_TRACE_DIR "/replay.pktr");
+#endif
+
+    trade_queue_start(trade);
+
+    /* In debug mode, capture everything on the link to the SD card */
+    if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
+        trade->trace = trade_trace_start(
+            trade->pdata,
+            trade_status_get(trade),
+            trade->centre.state,
+            trade->queue.mode,
+            trade->queue.slot);
+    }
+
     gblink_callback_set(trade->gblink_handle, transferBit, trade);
     gblink_nobyte_set(trade->gblink_handle, SERIAL_NO_DATA_BYTE);
 
     gblink_start(trade->gblink_handle);
 
-    /* Every 250 ms, trigger a draw update. 250 ms was chosen so that during
-     * the trade process, each update can flip the LED and screen to make the
+    /* Every frame, push any link state changes to the view. Every
+     * TRADE_LED_FRAMES frames, 250 ms, the LED and screen flip to make the
      * trade animation.
      */
     trade->draw_timer = furi_timer_alloc(trade_draw_timer_callback, FuriTimerTypePeriodic, trade);
-    furi_timer_start(trade->draw_timer, furi_ms_to_ticks(250));
-
-    /* Create a trade patch list from the current trade block */
-    plist_create(&(trade->patch_list), trade->pdata);
+    furi_timer_start(trade->draw_timer, furi_ms_to_ticks(TRADE_FRAME_MS));
 }
 
 void disconnect_pin(const GpioPin* pin) {
@@ -911,14 +658,17 @@ void trade_exit_callback(void* context) {
     /* Stop the game boy link */
     gblink_stop(trade->gblink_handle);
 
-    /* Destroy the patch list, it is allocated on the enter callback */
-    plist_free(trade->patch_list);
-    trade->patch_list = NULL;
+    /* With the link stopped, nothing else will be added to the trace */
+    if(trade->trace) {
+        trade_trace_stop(trade->trace);
+        trade->trace = NULL;
+    }
 }
 
 void* trade_alloc(
     PokemonData* pdata,
     void *gblink_handle,
+    struct pokemon_box* box,
     ViewDispatcher* view_dispatcher,
     uint32_t view_id) {
     furi_assert(pdata);
@@ -929,9 +679,22 @@ void* trade_alloc(
     trade->view = view_alloc();
     trade->pdata = pdata;
     trade->input_pdata = pokemon_data_alloc(pdata->gen);
-    trade->patch_list = NULL;
+    /* The patch list is allocated and synced once here, and then updated in
+     * place as the trade block is modified.
+     */
+    trade->patch_list = plist_alloc();
+    plist_create(trade->patch_list, pdata);
+    trade->wire_image = wire_image_alloc();
+    trade_centre_init(&trade->centre, pdata);
+    trade->queue.staged = pokemon_data_alloc(pdata->gen);
+    atomic_init(&trade->queue.trades, 0);
+    atomic_init(&trade->queue.done, false);
+    trade->queue.start_tick = furi_get_tick();
     trade->notifications = furi_record_open(RECORD_NOTIFICATION);
     trade->gblink_handle = gblink_handle;
+    if(box) trade->archive = trade_archive_alloc(box);
+    atomic_init(&trade->gameboy_status, GAMEBOY_CONN_FALSE);
+    atomic_init(&trade->link_activity, false);
 
     view_set_context(trade->view, trade);
     view_allocate_model(trade->view, ViewModelTypeLockFree, sizeof(struct trade_model));
@@ -958,29 +721,103 @@ void trade_free(ViewDispatcher* view_dispatcher, uint32_t view_id, void* trade_c
     furi_record_close(RECORD_NOTIFICATION);
 
     view_free(trade->view);
+    plist_free(trade->patch_list);
+    wire_image_free(trade->wire_image);
+    /* After the link is stopped, so nothing more can be pushed */
+    if(trade->archive) trade_archive_free(trade->archive);
     pokemon_data_free(trade->input_pdata);
+    pokemon_data_free(trade->queue.staged);
+    free(trade);
+}
+
+struct trade_ctx* trade_headless_alloc(
+    uint8_t gen,
+    const void* trade_block,
+    const void* mail,
+    render_gameboy_state_t gameboy_status,
+    trade_centre_state_t trade_centre_state) {
+    furi_assert(trade_block);
+    struct trade_ctx* trade = NULL;
+
+    trade = malloc(sizeof(struct trade_ctx));
+    memset(trade, '\0', sizeof(struct trade_ctx));
+    trade->replay = true;
+    trade->pdata = pokemon_data_alloc(gen);
+    trade->input_pdata = pokemon_data_alloc(gen);
+    memcpy(trade->pdata->trade_block, trade_block, trade->pdata->trade_block_sz);
+    if(mail && trade->pdata->mail) memcpy(trade->pdata->mail, mail, LEN_MAIL_BLOCK);
+    pokemon_party_dirty_mark(trade->pdata, 0, trade->pdata->party_sz);
+
+    trade->patch_list = plist_alloc();
+    plist_create(trade->patch_list, trade->pdata);
+    trade->wire_image = wire_image_alloc();
+    wire_image_build(trade->wire_image, trade->pdata, trade->patch_list);
+
+    trade_centre_init(&trade->centre, trade->pdata);
+    trade->centre.state = trade_centre_state;
+    atomic_init(&trade->gameboy_status, gameboy_status);
+    atomic_init(&trade->link_activity, false);
+    atomic_init(&trade->queue.trades, 0);
+    atomic_init(&trade->queue.done, false);
+    trade->queue.start_tick = furi_get_tick();
+
+    return trade;
+}
+
+void trade_headless_queue_set(struct trade_ctx* trade, TradeQueueMode mode, uint8_t slot) {
+    furi_assert(trade);
+    furi_check(mode < TRADE_QUEUE_COUNT);
+    furi_check(slot < pokemon_party_cnt_get(trade->pdata));
+
+    if(!trade->queue.staged) trade->queue.staged = pokemon_data_alloc(trade->pdata->gen);
+    trade->queue.setting = mode;
+    trade->pdata->party_sel = slot;
+    trade_queue_start(trade);
+}
+
+void trade_headless_free(struct trade_ctx* trade) {
+    furi_assert(trade);
+
+    plist_free(trade->patch_list);
+    wire_image_free(trade->wire_image);
+    pokemon_data_free(trade->input_pdata);
+    pokemon_data_free(trade->pdata);
+    if(trade->queue.staged) pokemon_data_free(trade->queue.staged);
     free(trade);
 }
 
 void trade_reset_connection(void* trade_ctx) {
     struct trade_ctx *trade = trade_ctx;
 
-    with_view_model(
-        trade->view,
-        struct trade_model * model,
-        { model->gameboy_status = GAMEBOY_CONN_FALSE; },
-        false);
+    trade_status_set(trade, GAMEBOY_CONN_FALSE);
 }
 
 bool trade_connected(void* trade_ctx) {
     struct trade_ctx *trade = trade_ctx;
-    bool connected = false;
 
-    with_view_model(
-        trade->view,
-        struct trade_model * model,
-        { connected = (model->gameboy_status > GAMEBOY_CONN_FALSE); },
-        false);
+    return (trade_status_get(trade) > GAMEBOY_CONN_FALSE);
+}
+
+void trade_queue_mode_set(void* trade_ctx, TradeQueueMode mode) {
+    struct trade_ctx* trade = trade_ctx;
+
+    furi_check(mode < TRADE_QUEUE_COUNT);
+    trade->queue.setting = mode;
+}
+
+TradeQueueMode trade_queue_mode_get(void* trade_ctx) {
+    struct trade_ctx* trade = trade_ctx;
+
+    return trade->queue.setting;
+}
+
+const char* trade_queue_mode_name_get(TradeQueueMode mode) {
+    static const char* const names[TRADE_QUEUE_COUNT] = {
+        [TRADE_QUEUE_OFF] = "Normal",
+        [TRADE_QUEUE_PARTY] = "Queue Party",
+        [TRADE_QUEUE_RETURN] = "Send Back",
+    };
 
-    return connected;
+    furi_check(mode < TRADE_QUEUE_COUNT);
+    return names[mode];
 }
@@ -5,10 +5,27 @@
 
 #include <gui/view.h>
 #include <src/include/pokemon_data.h>
+#include <src/include/pokemon_box.h>
 
+/* What the trade view offers the Game Boy from one trade to the next */
+typedef enum {
+    /* Offer from the same slot the Game Boy picks, keep what is received */
+    TRADE_QUEUE_OFF,
+    /* Offer every party member in turn, starting from the selected slot, and
+     * trade normally once each has been offered. What is received is
+     * discarded.
+     */
+    TRADE_QUEUE_PARTY,
+    /* Always offer back the last Pokemon received, from the selected slot */
+    TRADE_QUEUE_RETURN,
+    TRADE_QUEUE_COUNT,
+} TradeQueueMode;
+
+/* Every Pokemon received is saved to box, which may be NULL */
 void* trade_alloc(
     PokemonData* pdata,
     void *gblink_handle,
+    struct pokemon_box* box,
     ViewDispatcher* view_dispatcher,
     uint32_t view_id);
 
@@ -18,4 +35,11 @@ void trade_reset_connection(void* trade_ctx);
 
 bool trade_connected(void* trade_ctx);
 
+/* Takes effect the next time the trade view is entered */
+void trade_queue_mode_set(void* trade_ctx, TradeQueueMode mode);
+
+TradeQueueMode trade_queue_mode_get(void* trade_ctx);
+
+const char* trade_queue_mode_name_get(TradeQueueMode mode);
+
 #endif /* TRADE_H */
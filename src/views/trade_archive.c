@@ -0,0 +1,150 @@
+#include <furi.h>
+#include <stdatomic.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_box.h>
+
+#include <src/views/trade_archive.h>
+
+#define TRADE_ARCHIVE_RING_MASK (TRADE_ARCHIVE_RING_SZ - 1)
+
+/* pokemon_box_save() with the storage calls and logging under it. The spare
+ * stack is logged when the worker exits, to see how close this is.
+ */
+#define ARCHIVE_STACK_SZ 2048
+#define ARCHIVE_FLAG_PUSH (1 << 0)
+#define ARCHIVE_FLAG_EXIT (1 << 1)
+
+struct trade_archive {
+    struct pokemon_box* box;
+    FuriThread* thread;
+    /* head is only written by the ISR, tail only by the worker. Both count up
+     * forever and are masked when indexing the ring.
+     */
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_uint dropped;
+    /* Only written by the worker */
+    atomic_uint lost;
+    PokemonRaw ring[TRADE_ARCHIVE_RING_SZ];
+};
+
+/* Save everything in the ring, returns false if a save failed and there is
+ * still something left to retry.
+ */
+static bool trade_archive_drain(struct trade_archive* archive) {
+    unsigned int head = atomic_load_explicit(&archive->head, memory_order_acquire);
+    unsigned int tail = atomic_load_explicit(&archive->tail, memory_order_relaxed);
+    unsigned int dropped = atomic_exchange(&archive->dropped, 0);
+
+    if(dropped) {
+        FURI_LOG_E(TAG, "[archive] ring full, %u Pokemon not saved", dropped);
+        atomic_fetch_add(&archive->lost, dropped);
+    }
+
+    while(tail != head) {
+        if(!pokemon_box_save(archive->box, &archive->ring[tail & TRADE_ARCHIVE_RING_MASK]))
+            return false;
+        tail++;
+        /* Only now can the ISR reuse the entry */
+        atomic_store_explicit(&archive->tail, tail, memory_order_release);
+    }
+
+    return true;
+}
+
+/* Stop trying to save what is left in the ring, so the ISR can reuse it */
+static void trade_archive_give_up(struct trade_archive* archive) {
+    unsigned int head = atomic_load_explicit(&archive->head, memory_order_acquire);
+    unsigned int tail = atomic_load_explicit(&archive->tail, memory_order_relaxed);
+
+    FURI_LOG_E(TAG, "[archive] giving up, %u Pokemon could not be saved", head - tail);
+    atomic_fetch_add(&archive->lost, head - tail);
+    atomic_store_explicit(&archive->tail, head, memory_order_release);
+}
+
+static int32_t trade_archive_thread(void* context) {
+    struct trade_archive* archive = context;
+    uint32_t timeout = FuriWaitForever;
+    unsigned int retries = 0;
+    uint32_t flags;
+    bool done = false;
+
+    while(!done) {
+        flags = furi_thread_flags_wait(
+            ARCHIVE_FLAG_PUSH | ARCHIVE_FLAG_EXIT, FuriFlagWaitAny, timeout);
+        if(!(flags & FuriFlagError) && (flags & ARCHIVE_FLAG_EXIT)) done = true;
+
+        /* A timeout is a retry of a save that failed. Anything pushed in the
+         * mean time is tried as well, but only timeouts count as retries.
+         */
+        if(trade_archive_drain(archive)) {
+            retries = 0;
+            timeout = FuriWaitForever;
+        } else if(done || ((flags & FuriFlagError) && ++retries >= TRADE_ARCHIVE_RETRY_MAX)) {
+            trade_archive_give_up(archive);
+            retries = 0;
+            timeout = FuriWaitForever;
+        } else {
+            timeout = furi_ms_to_ticks(TRADE_ARCHIVE_RETRY_MS);
+        }
+    }
+
+    FURI_LOG_D(
+        TAG,
+        "[archive] %lu bytes of stack spare",
+        furi_thread_get_stack_space(furi_thread_get_current_id()));
+
+    return 0;
+}
+
+struct trade_archive* trade_archive_alloc(struct pokemon_box* box) {
+    furi_assert(box);
+    struct trade_archive* archive = NULL;
+
+    archive = malloc(sizeof(struct trade_archive));
+    memset(archive, '\0', sizeof(struct trade_archive));
+    archive->box = box;
+    atomic_init(&archive->head, 0);
+    atomic_init(&archive->tail, 0);
+    atomic_init(&archive->dropped, 0);
+    atomic_init(&archive->lost, 0);
+
+    archive->thread =
+        furi_thread_alloc_ex("PokemonArchive", ARCHIVE_STACK_SZ, trade_archive_thread, archive);
+    furi_thread_start(archive->thread);
+
+    return archive;
+}
+
+void trade_archive_free(struct trade_archive* archive) {
+    furi_assert(archive);
+
+    furi_thread_flags_set(furi_thread_get_id(archive->thread), ARCHIVE_FLAG_EXIT);
+    furi_thread_join(archive->thread);
+    furi_thread_free(archive->thread);
+    free(archive);
+}
+
+bool trade_archive_push(struct trade_archive* archive, PokemonData* pdata, uint8_t slot) {
+    unsigned int head = atomic_load_explicit(&archive->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&archive->tail, memory_order_acquire);
+
+    if(head - tail == TRADE_ARCHIVE_RING_SZ) {
+        atomic_fetch_add_explicit(&archive->dropped, 1, memory_order_relaxed);
+        furi_thread_flags_set(furi_thread_get_id(archive->thread), ARCHIVE_FLAG_PUSH);
+        return false;
+    }
+
+    pokemon_raw_get(pdata, slot, &archive->ring[head & TRADE_ARCHIVE_RING_MASK]);
+    atomic_store_explicit(&archive->head, head + 1, memory_order_release);
+    furi_thread_flags_set(furi_thread_get_id(archive->thread), ARCHIVE_FLAG_PUSH);
+
+    return true;
+}
+
+unsigned int trade_archive_lost(struct trade_archive* archive) {
+    furi_assert(archive);
+
+    return atomic_load(&archive->lost);
+}
@@ -0,0 +1,53 @@
+#ifndef TRADE_ARCHIVE_H
+#define TRADE_ARCHIVE_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <src/include/pokemon_data.h>
+#include <src/include/pokemon_box.h>
+
+/* Saves Pokemon received over the link to a box without the link ISR ever
+ * touching the SD card.
+ *
+ * The ISR copies each received party member, with its names, in to a
+ * preallocated single producer, single consumer ring and wakes a worker
+ * thread. The worker saves everything in the ring to the box. A save that
+ * fails stays in the ring and is retried, up to TRADE_ARCHIVE_RETRY_MAX
+ * times. After that, everything in the ring is given up on so that later
+ * trades can still be saved, and it is logged and counted as lost.
+ */
+
+/* Number of Pokemon the ring holds, must be a power of 2. Enough for the
+ * whole party of every trade table visit in the time one save takes.
+ */
+#define TRADE_ARCHIVE_RING_SZ 16
+
+/* How long to wait before retrying a save that failed, and how many times */
+#define TRADE_ARCHIVE_RETRY_MS 500
+#define TRADE_ARCHIVE_RETRY_MAX 4
+
+struct trade_archive;
+
+/* Start the worker thread, saving to box. Must not be called from an ISR. */
+struct trade_archive* trade_archive_alloc(struct pokemon_box* box);
+
+/* Save everything still in the ring, then stop the worker. The link must
+ * already be stopped.
+ */
+void trade_archive_free(struct trade_archive* archive);
+
+/* Queue slot of pdata to be saved. Safe to call from an ISR, returns false
+ * if the ring is full, in which case it is counted and logged by the worker.
+ */
+bool trade_archive_push(struct trade_archive* archive, PokemonData* pdata, uint8_t slot);
+
+/* Number of Pokemon pushed that were not saved, either because the ring was
+ * full or the box would not take them. A full ring is only counted once the
+ * worker has woken up to log it.
+ */
+unsigned int trade_archive_lost(struct trade_archive* archive);
+
+#endif /* TRADE_ARCHIVE_H */
@@ -0,0 +1,349 @@
+/* The Flipper's side of a colosseum battle.
+ *
+ * Once both sides have each other's party, the Game Boy, as master, runs the
+ * whole battle on its own using the random numbers it sent at the start of the
+ * table exchange. All it needs from the other side is what to do each turn: a
+ * move slot, 0-3, or a party slot to switch to, 4-9, in the low nybble of a
+ * byte whose high nybble is the battle_mask of the gen. The Game Boy sends its
+ * own action until it sees one come back, then 10 more times, then 10x 0x00.
+ * The same reply is sent back for every action byte of that burst.
+ *
+ * The Flipper never finds out what actually happened in a turn. It keeps an
+ * estimate of both parties' HP from the average damage of each move, see
+ * battle_table.h, with no misses, critical hits, priority, or side effects,
+ * and picks the move expected to do the most damage. It never switches out on
+ * its own.
+ *
+ * The estimate matters most when a Pokemon faints, as that brings extra
+ * exchanges:
+ * - The Game Boy's fainted: it sends the party slot it sends out next, and
+ *   whatever is sent back is ignored.
+ * - The Flipper's fainted: the Game Boy sends the switch byte it sent last,
+ *   and the reply must be the party slot the Flipper sends out next.
+ * - Both fainted: the Game Boy's choice first, then the Flipper's.
+ * A move from the Game Boy is always a normal turn, which also corrects the
+ * estimate if it had either Pokemon fainted.
+ *
+ * This all runs in the link ISR, on the state in trade_ctx and the tables in
+ * flash, and so never allocates or logs.
+ */
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/battle_table.h>
+
+#include <src/views/trade_i.h>
+
+/* Low nybble of an action byte */
+#define BATTLE_ACTION_SWITCH 0x04
+#define BATTLE_ACTION_SWITCH_MAX 0x09
+#define BATTLE_ACTION_STRUGGLE 0x0E
+#define BATTLE_ACTION_RUN 0x0F
+
+/* Move index of Struggle, for when there are no moves with PP left */
+#define BATTLE_MOVE_STRUGGLE 0xA5
+
+/* Average of the 217 to 255 random damage roll, out of 255 */
+#define BATTLE_ROLL_AVG 236
+
+void trade_battle_reset(struct trade_battle* battle) {
+    furi_assert(battle);
+    memset(battle, 0, sizeof(struct trade_battle));
+}
+
+static void
+    trade_battle_party_load(struct trade_battle* battle, PokemonData* pdata, uint8_t side) {
+    struct trade_battle_mon* mon;
+    StatBlock block;
+    uint8_t cnt = pokemon_party_cnt_get(pdata);
+    uint8_t slot;
+    int i;
+
+    /* The Game Boy's party count is whatever it sent */
+    if(cnt > PARTY_CNT_MAX) cnt = PARTY_CNT_MAX;
+    battle->cnt[side] = cnt;
+
+    for(slot = 0; slot < cnt; slot++) {
+        mon = &battle->mon[side][slot];
+        pokemon_stat_block_get(pdata, slot, &block);
+
+        mon->hp = block.stat[STAT_HP];
+        mon->atk = block.stat[STAT_ATK];
+        mon->def = block.stat[STAT_DEF];
+        mon->spd = block.stat[STAT_SPD];
+        if(pdata->gen == GEN_I) {
+            mon->spc_atk = block.stat[STAT_SPC];
+            mon->spc_def = block.stat[STAT_SPC];
+        } else {
+            mon->spc_atk = block.stat[STAT_SPC_ATK];
+            mon->spc_def = block.stat[STAT_SPC_DEF];
+        }
+        mon->level = block.level;
+
+        /* Anything unknown, like an egg, is left as Normal */
+        for(i = TYPE_0; i <= TYPE_1; i++) {
+            if(pdata->gen == GEN_I)
+                mon->type[i] = pokemon_stat_get(pdata, slot, STAT_TYPE, i);
+            else if(block.num < BATTLE_SPECIES_CNT)
+                mon->type[i] = battle_species_type_gen_ii[block.num][i];
+        }
+
+        for(i = MOVE_0; i <= MOVE_3; i++) {
+            mon->move[i] = pokemon_stat_get(pdata, slot, STAT_MOVE, i);
+            mon->used[i] = 0;
+        }
+    }
+
+    /* The battle starts with the first Pokemon that can fight */
+    battle->active[side] = 0;
+    while(battle->active[side] + 1 < cnt && !battle->mon[side][battle->active[side]].hp)
+        battle->active[side]++;
+}
+
+static struct trade_battle_mon* trade_battle_active(struct trade_battle* battle, uint8_t side) {
+    return &battle->mon[side][battle->active[side]];
+}
+
+/* Average damage move does from atk to def */
+static uint16_t trade_battle_damage(
+    uint8_t gen,
+    const struct trade_battle_mon* atk,
+    const struct trade_battle_mon* def,
+    uint8_t move) {
+    const BattleMove* entry = battle_move_get(gen, move);
+    uint32_t dmg;
+    uint16_t a;
+    uint16_t d;
+
+    if(entry->flags & BATTLE_MOVE_LEVEL) return atk->level;
+    if(entry->flags & BATTLE_MOVE_FIXED) return entry->power;
+    if(entry->flags & BATTLE_MOVE_HALF_HP) return (def->hp > 1) ? def->hp / 2 : 1;
+    if(!entry->power) return 0;
+
+    if(entry->type >= BATTLE_TYPE_SPECIAL) {
+        a = atk->spc_atk;
+        d = def->spc_def;
+    } else {
+        a = atk->atk;
+        d = def->def;
+    }
+    if(!d) d = 1;
+
+    dmg = ((((2 * atk->level) / 5) + 2) * entry->power * a / d) / 50 + 2;
+    if(entry->type == atk->type[0] || entry->type == atk->type[1]) dmg += dmg / 2;
+    dmg = (dmg * battle_type_eff_get(gen, entry->type, def->type[0])) / 2;
+    if(def->type[1] != def->type[0])
+        dmg = (dmg * battle_type_eff_get(gen, entry->type, def->type[1])) / 2;
+    dmg = (dmg * BATTLE_ROLL_AVG) / 255;
+
+    return (dmg > UINT16_MAX) ? UINT16_MAX : dmg;
+}
+
+/* A PP of 0 in the table is a move the model does not track PP for */
+static bool trade_battle_move_usable(uint8_t gen, const struct trade_battle_mon* mon, uint8_t i) {
+    uint8_t pp;
+
+    if(!mon->move[i]) return false;
+    pp = battle_move_get(gen, mon->move[i])->pp;
+    return !pp || mon->used[i] < pp;
+}
+
+/* The move slot of the Flipper's Pokemon expected to do the most damage, or
+ * struggle if none have PP left.
+ */
+static uint8_t trade_battle_move_pick(struct trade_battle* battle, uint8_t gen) {
+    const struct trade_battle_mon* us = trade_battle_active(battle, BATTLE_US);
+    const struct trade_battle_mon* them = trade_battle_active(battle, BATTLE_THEM);
+    uint8_t pick = BATTLE_ACTION_STRUGGLE;
+    uint16_t best = 0;
+    uint16_t dmg;
+    uint8_t i;
+
+    for(i = MOVE_0; i <= MOVE_3; i++) {
+        if(!trade_battle_move_usable(gen, us, i)) continue;
+        dmg = trade_battle_damage(gen, us, them, us->move[i]);
+        if(pick == BATTLE_ACTION_STRUGGLE || dmg > best) {
+            pick = i;
+            best = dmg;
+        }
+    }
+
+    return pick;
+}
+
+/* The Flipper's Pokemon, other than the active one, that can do the most
+ * damage to the Game Boy's. If the estimate has no others left, the Game Boy
+ * knows better, so the next slot along is picked.
+ */
+static uint8_t trade_battle_switch_pick(struct trade_battle* battle, uint8_t gen) {
+    const struct trade_battle_mon* them = trade_battle_active(battle, BATTLE_THEM);
+    const struct trade_battle_mon* mon;
+    uint8_t active = battle->active[BATTLE_US];
+    uint8_t cnt = battle->cnt[BATTLE_US];
+    uint8_t pick = active;
+    uint16_t best = 0;
+    uint16_t dmg;
+    uint16_t move_dmg;
+    uint8_t slot;
+    uint8_t i;
+
+    for(slot = 0; slot < cnt; slot++) {
+        mon = &battle->mon[BATTLE_US][slot];
+        if(slot == active || !mon->hp) continue;
+
+        dmg = 0;
+        for(i = MOVE_0; i <= MOVE_3; i++) {
+            if(!mon->move[i]) continue;
+            move_dmg = trade_battle_damage(gen, mon, them, mon->move[i]);
+            if(move_dmg > dmg) dmg = move_dmg;
+        }
+        if(pick == active || dmg > best) {
+            pick = slot;
+            best = dmg;
+        }
+    }
+
+    if(pick == active && cnt > 1) pick = (active + 1) % cnt;
+
+    return pick;
+}
+
+/* The Flipper's Pokemon fainted, send out the next one */
+static uint8_t trade_battle_replace(struct trade_battle* battle, uint8_t gen) {
+    uint8_t slot = trade_battle_switch_pick(battle, gen);
+
+    trade_battle_active(battle, BATTLE_US)->hp = 0;
+    battle->active[BATTLE_US] = slot;
+    if(!battle->mon[BATTLE_US][slot].hp) battle->mon[BATTLE_US][slot].hp = 1;
+
+    return BATTLE_ACTION_SWITCH + slot;
+}
+
+static void
+    trade_battle_attack(struct trade_battle* battle, uint8_t gen, uint8_t side, uint8_t move) {
+    const struct trade_battle_mon* atk = trade_battle_active(battle, side);
+    struct trade_battle_mon* def = trade_battle_active(battle, !side);
+    uint16_t dmg;
+
+    /* The slower one may not get to move at all */
+    if(!atk->hp || !move) return;
+
+    dmg = trade_battle_damage(gen, atk, def, move);
+    def->hp = (dmg >= def->hp) ? 0 : def->hp - dmg;
+}
+
+/* Play out a turn, their_move is 0 if the Game Boy did not attack */
+static void
+    trade_battle_turn(struct trade_battle* battle, uint8_t gen, uint8_t their_move, uint8_t ours) {
+    struct trade_battle_mon* us = trade_battle_active(battle, BATTLE_US);
+    const struct trade_battle_mon* them = trade_battle_active(battle, BATTLE_THEM);
+    uint8_t our_move = BATTLE_MOVE_STRUGGLE;
+    bool us_first;
+
+    if(ours <= MOVE_3) {
+        our_move = us->move[ours];
+        us->used[ours]++;
+    }
+
+    /* Speed ties are broken by the Game Boy's random numbers in game, which
+     * is close enough for a tie break here as well.
+     */
+    us_first = (us->spd > them->spd) ||
+               ((us->spd == them->spd) && (battle->random[battle->turn % SERIAL_RNS_LENGTH] & 1));
+
+    if(us_first) {
+        trade_battle_attack(battle, gen, BATTLE_US, our_move);
+        trade_battle_attack(battle, gen, BATTLE_THEM, their_move);
+    } else {
+        trade_battle_attack(battle, gen, BATTLE_THEM, their_move);
+        trade_battle_attack(battle, gen, BATTLE_US, our_move);
+    }
+}
+
+/* Work out the reply to a new action from the Game Boy and play out what it
+ * means for the estimate.
+ */
+static uint8_t trade_battle_action(struct trade_battle* battle, uint8_t gen, uint8_t action) {
+    struct trade_battle_mon* us = trade_battle_active(battle, BATTLE_US);
+    struct trade_battle_mon* them = trade_battle_active(battle, BATTLE_THEM);
+    uint8_t their_move = 0;
+    uint8_t reply;
+    uint8_t slot;
+
+    battle->turn++;
+
+    if(action == BATTLE_ACTION_RUN) {
+        /* Logged by the draw timer, this is the ISR */
+        atomic_store(&battle->ran, battle->turn);
+        return trade_battle_move_pick(battle, gen);
+    }
+
+    if(action >= BATTLE_ACTION_SWITCH && action <= BATTLE_ACTION_SWITCH_MAX) {
+        slot = action - BATTLE_ACTION_SWITCH;
+
+        /* Not a slot it could switch to, so this is the left over byte of an
+         * exchange asking for the Flipper's next Pokemon.
+         */
+        if(slot == battle->active[BATTLE_THEM] || slot >= battle->cnt[BATTLE_THEM])
+            return trade_battle_replace(battle, gen);
+
+        if(!them->hp) {
+            /* The Game Boy's next Pokemon after one fainted. If the Flipper's
+             * fainted as well, it is asked for in the next exchange, and
+             * this reply is only a hint of it.
+             */
+            battle->active[BATTLE_THEM] = slot;
+            if(!us->hp) return BATTLE_ACTION_SWITCH + trade_battle_switch_pick(battle, gen);
+            return trade_battle_move_pick(battle, gen);
+        }
+
+        if(!us->hp) return trade_battle_replace(battle, gen);
+
+        /* Switching out takes its turn, only the Flipper attacks */
+        battle->active[BATTLE_THEM] = slot;
+        reply = trade_battle_move_pick(battle, gen);
+        trade_battle_turn(battle, gen, 0, reply);
+        return reply;
+    }
+
+    /* A move means both are still standing, whatever the estimate thought */
+    if(!us->hp) us->hp = 1;
+    if(!them->hp) them->hp = 1;
+
+    if(action <= MOVE_3)
+        their_move = them->move[action];
+    else if(action == BATTLE_ACTION_STRUGGLE)
+        their_move = BATTLE_MOVE_STRUGGLE;
+
+    reply = trade_battle_move_pick(battle, gen);
+    trade_battle_turn(battle, gen, their_move, reply);
+
+    return reply;
+}
+
+uint8_t trade_battle_byte(struct trade_ctx* trade, uint8_t mask, uint8_t in) {
+    furi_assert(trade);
+    struct trade_battle* battle = &trade->battle;
+    uint8_t gen = trade->pdata->gen;
+
+    /* Everything between actions is echoed, including the 0x00 padding */
+    if((in & 0xF0) != mask) {
+        battle->in_exchange = false;
+        return in;
+    }
+
+    if(!battle->loaded) {
+        trade_battle_party_load(battle, trade->pdata, BATTLE_US);
+        trade_battle_party_load(battle, trade->input_pdata, BATTLE_THEM);
+        battle->loaded = true;
+    }
+
+    if(!battle->in_exchange) {
+        battle->reply = mask | trade_battle_action(battle, gen, in & 0x0F);
+        battle->in_exchange = true;
+    }
+
+    return battle->reply;
+}
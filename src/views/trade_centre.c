@@ -0,0 +1,707 @@
+/* The trade centre state machine. This handles every byte once the Game Boy
+ * has selected the trade centre or the colosseum from the link menu.
+ *
+ * Every byte is first sorted in to an input class with a 256 entry lookup,
+ * then the transition table, indexed by the current state and that class,
+ * says what to send back, what state to move to, and any change to the
+ * gameboy_status. States that wait for a fixed number of bytes, e.g. the
+ * trade block, count them against a per-generation length table.
+ *
+ * Gen I and Gen II only differ in the class lookup and length tables, the
+ * transition table is shared. The colosseum only differs in its length
+ * tables, which go on to TRADE_BATTLE once the table exchange is done. All of
+ * the state lives in trade_ctx, so any number of contexts can run
+ * independently.
+ *
+ * Each byte costs one class lookup, one transition lookup, and one action,
+ * plus at most one more lookup and action when a state ends on a byte that
+ * also belongs to the next state. There are no loops or searches.
+ */
+
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <dolphin/dolphin.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/patch_list.h>
+#include <src/include/wire_image.h>
+
+#include <src/views/trade_i.h>
+
+/* Number of SERIAL_PREAMBLE_BYTEs at the end of the trade block and start of
+ * the patch list.
+ */
+#define SERIAL_PATCH_PREAMBLE_LENGTH 6
+
+/* Input classes. OTHER must be 0 so it is the default in the lookups. */
+typedef enum {
+    CLS_OTHER,
+    CLS_BLANK,
+    CLS_PREAMBLE,
+    CLS_TERMINATOR,
+    /* Matches the generation's sel_num_mask */
+    CLS_SEL,
+    CLS_ACCEPT,
+    CLS_REJECT,
+    CLS_LEAVE,
+    CLS_COUNT,
+} trade_centre_class_t;
+
+/* What to do with a byte, and what to send in response */
+typedef enum {
+    /* Send back the received byte */
+    ACT_ECHO,
+    /* Echo, and count toward the end of the current state */
+    ACT_COUNT,
+    /* Reset all per-exchange state, echo */
+    ACT_RESET,
+    /* Send the next byte of the wire image, and count */
+    ACT_IMAGE,
+    /* Keep the received random number, then as ACT_IMAGE */
+    ACT_IMAGE_RANDOM,
+    /* Store the received trade_block byte, then as ACT_IMAGE */
+    ACT_IMAGE_DATA,
+    /* Apply the received patch list entry, then as ACT_IMAGE */
+    ACT_IMAGE_PATCH,
+    /* Received patch list part terminator, then as ACT_IMAGE */
+    ACT_IMAGE_PATCH_PT2,
+    /* Store the received mail block byte or apply its patch, then as ACT_IMAGE */
+    ACT_IMAGE_MAIL,
+    /* The Game Boy selected a Pokemon, offer ours from the same slot */
+    ACT_SEL,
+    /* Selection is final, echo */
+    ACT_SEL_LOCK,
+    /* Copy in the selected Pokemon, echo */
+    ACT_TRADE,
+    /* Send the table leave byte */
+    ACT_LEAVE,
+    /* Hand the byte to the battle */
+    ACT_BATTLE,
+    /* The Game Boy is back at the table, reset all per-exchange state, echo,
+     * and count so the byte is handled again as the first preamble byte.
+     */
+    ACT_BATTLE_END,
+} trade_centre_action_t;
+
+#define STATUS_KEEP GAMEBOY_STATE_COUNT
+
+struct trade_centre_transition {
+    uint8_t next;
+    uint8_t status;
+    uint8_t action;
+};
+
+/* Per-generation length of each counted state, and where to go once that
+ * many bytes have been counted.
+ */
+struct trade_centre_len {
+    uint16_t len;
+    uint8_t done;
+    /* The byte that ends this state is also handled by the next state */
+    bool redispatch;
+};
+
+struct trade_centre_gen {
+    const struct important_bytes* bytes;
+    const uint8_t* class;
+    /* Keep the GAMEBOY_COLOSSEUM status rather than following the table */
+    bool colosseum;
+    struct trade_centre_len len[TRADE_STATE_COUNT];
+};
+
+/* Every byte that matches the sel_num_mask is CLS_SEL, unless it has a more
+ * specific meaning. Note that every ACCEPT, REJECT, LEAVE, PREAMBLE, and
+ * TERMINATOR byte also happens to match the mask in both generations, which
+ * the transition table relies on.
+ */
+static const uint8_t trade_centre_class_gen_i[256] = {
+    [PKMN_BLANK] = CLS_BLANK,
+    [0x60] = CLS_SEL,
+    [PKMN_TRADE_REJECT_GEN_I] = CLS_REJECT,
+    [PKMN_TRADE_ACCEPT_GEN_I] = CLS_ACCEPT,
+    [0x63 ... 0x6E] = CLS_SEL,
+    [PKMN_TABLE_LEAVE_GEN_I] = CLS_LEAVE,
+    [0x70 ... 0x7F] = CLS_SEL,
+    [0xE0 ... 0xFC] = CLS_SEL,
+    [SERIAL_PREAMBLE_BYTE] = CLS_PREAMBLE,
+    [SERIAL_NO_DATA_BYTE] = CLS_SEL,
+    [SERIAL_PATCH_LIST_PART_TERMINATOR] = CLS_TERMINATOR,
+};
+
+static const uint8_t trade_centre_class_gen_ii[256] = {
+    [PKMN_BLANK] = CLS_BLANK,
+    [0x70] = CLS_SEL,
+    [PKMN_TRADE_REJECT_GEN_II] = CLS_REJECT,
+    [PKMN_TRADE_ACCEPT_GEN_II] = CLS_ACCEPT,
+    [0x73 ... 0x7E] = CLS_SEL,
+    [PKMN_TABLE_LEAVE_GEN_II] = CLS_LEAVE,
+    [0xF0 ... 0xFC] = CLS_SEL,
+    [SERIAL_PREAMBLE_BYTE] = CLS_PREAMBLE,
+    [SERIAL_NO_DATA_BYTE] = CLS_SEL,
+    [SERIAL_PATCH_LIST_PART_TERMINATOR] = CLS_TERMINATOR,
+};
+
+/* The patch list section is the same length for both generations. Gen I has
+ * no mail, and goes straight to selection once the patch list is done.
+ */
+static const struct trade_centre_gen trade_centre_gen_i = {
+    .bytes = &gen_i,
+    .class = trade_centre_class_gen_i,
+    .len =
+        {
+            [TRADE_INIT] = {SERIAL_RNS_LENGTH, TRADE_RANDOM, false},
+            [TRADE_RANDOM] = {WIRE_RANDOM_SZ, TRADE_DATA, false},
+            [TRADE_DATA] = {TRADE_BLOCK_SZ_GEN_I, TRADE_PATCH_HEADER, false},
+            [TRADE_PATCH_HEADER] = {SERIAL_PATCH_PREAMBLE_LENGTH, TRADE_PATCH_DATA, true},
+            [TRADE_PATCH_DATA] = {WIRE_PATCH_SZ, TRADE_SELECT, false},
+        },
+};
+
+static const struct trade_centre_gen trade_centre_gen_ii = {
+    .bytes = &gen_ii,
+    .class = trade_centre_class_gen_ii,
+    .len =
+        {
+            [TRADE_INIT] = {SERIAL_RNS_LENGTH, TRADE_RANDOM, false},
+            [TRADE_RANDOM] = {WIRE_RANDOM_SZ, TRADE_DATA, false},
+            [TRADE_DATA] = {TRADE_BLOCK_SZ_GEN_II, TRADE_PATCH_HEADER, false},
+            [TRADE_PATCH_HEADER] = {SERIAL_PATCH_PREAMBLE_LENGTH, TRADE_PATCH_DATA, true},
+            [TRADE_PATCH_DATA] = {WIRE_PATCH_SZ, TRADE_MAIL, false},
+            [TRADE_MAIL] = {WIRE_MAIL_SZ, TRADE_SELECT, false},
+        },
+};
+
+/* The colosseum has no mail in Gen II either, the battle starts as soon as
+ * the patch list is done. A preamble byte in TRADE_BATTLE is the Game Boy
+ * coming back to the table, it is counted once to end the battle and then
+ * again by TRADE_INIT.
+ */
+static const struct trade_centre_gen trade_centre_gen_i_colosseum = {
+    .bytes = &gen_i,
+    .class = trade_centre_class_gen_i,
+    .colosseum = true,
+    .len =
+        {
+            [TRADE_INIT] = {SERIAL_RNS_LENGTH, TRADE_RANDOM, false},
+            [TRADE_RANDOM] = {WIRE_RANDOM_SZ, TRADE_DATA, false},
+            [TRADE_DATA] = {TRADE_BLOCK_SZ_GEN_I, TRADE_PATCH_HEADER, false},
+            [TRADE_PATCH_HEADER] = {SERIAL_PATCH_PREAMBLE_LENGTH, TRADE_PATCH_DATA, true},
+            [TRADE_PATCH_DATA] = {WIRE_PATCH_SZ, TRADE_BATTLE, false},
+            [TRADE_BATTLE] = {1, TRADE_INIT, true},
+        },
+};
+
+static const struct trade_centre_gen trade_centre_gen_ii_colosseum = {
+    .bytes = &gen_ii,
+    .class = trade_centre_class_gen_ii,
+    .colosseum = true,
+    .len =
+        {
+            [TRADE_INIT] = {SERIAL_RNS_LENGTH, TRADE_RANDOM, false},
+            [TRADE_RANDOM] = {WIRE_RANDOM_SZ, TRADE_DATA, false},
+            [TRADE_DATA] = {TRADE_BLOCK_SZ_GEN_II, TRADE_PATCH_HEADER, false},
+            [TRADE_PATCH_HEADER] = {SERIAL_PATCH_PREAMBLE_LENGTH, TRADE_PATCH_DATA, true},
+            [TRADE_PATCH_DATA] = {WIRE_PATCH_SZ, TRADE_BATTLE, false},
+            [TRADE_BATTLE] = {1, TRADE_INIT, true},
+        },
+};
+
+/* Indexed by [colosseum][gen == GEN_II] */
+static const struct trade_centre_gen* const trade_centre_gens[2][2] = {
+    {&trade_centre_gen_i, &trade_centre_gen_ii},
+    {&trade_centre_gen_i_colosseum, &trade_centre_gen_ii_colosseum},
+};
+
+#define T(next, status, action) {(next), (status), (action)}
+
+/* Indexed by [state][class]. Counted states list themselves as next, the
+ * length table decides when they actually end. In the PENDING states, every
+ * class other than OTHER, BLANK, and LEAVE is a byte matching sel_num_mask.
+ */
+static const struct trade_centre_transition trade_centre_table[TRADE_STATE_COUNT][CLS_COUNT] = {
+    /* The first byte after entering the trade centre, or leaving the table */
+    [TRADE_RESET] =
+        {
+            [CLS_OTHER] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_BLANK] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_PREAMBLE] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_TERMINATOR] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_SEL] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_ACCEPT] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_REJECT] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+            [CLS_LEAVE] = T(TRADE_INIT, STATUS_KEEP, ACT_RESET),
+        },
+
+    /* There is a handful of communications that happen once the Game Boy
+     * clicks on the table. For all of them, the Flipper can just mirror back
+     * the byte the Game Boy sends. We can spin in this forever until we see
+     * 10x SERIAL_PREAMBLE_BYTEs. Once we receive those, every byte after that
+     * can be easily counted for the actual transfer of Pokemon data.
+     */
+    [TRADE_INIT] =
+        {
+            [CLS_OTHER] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+            [CLS_PREAMBLE] = T(TRADE_INIT, GAMEBOY_WAITING, ACT_COUNT),
+            [CLS_TERMINATOR] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+            [CLS_SEL] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+            [CLS_ACCEPT] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+            [CLS_REJECT] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+            [CLS_LEAVE] = T(TRADE_INIT, STATUS_KEEP, ACT_ECHO),
+        },
+
+    /* 10 random numbers for synchronizing the PRNG between the two systems,
+     * only used by the colosseum battle, and then 9x SERIAL_PREAMBLE_BYTE. All
+     * echo slots in the wire image.
+     */
+    [TRADE_RANDOM] =
+        {
+            [CLS_OTHER] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_BLANK] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_PREAMBLE] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_TERMINATOR] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_SEL] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_ACCEPT] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_REJECT] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+            [CLS_LEAVE] = T(TRADE_RANDOM, STATUS_KEEP, ACT_IMAGE_RANDOM),
+        },
+
+    /* This is where we exchange trade_block data with the Game Boy */
+    [TRADE_DATA] =
+        {
+            [CLS_OTHER] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_BLANK] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_PREAMBLE] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_TERMINATOR] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_SEL] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_ACCEPT] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_REJECT] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+            [CLS_LEAVE] = T(TRADE_DATA, STATUS_KEEP, ACT_IMAGE_DATA),
+        },
+
+    /* This absorbs the 3 byte ending sequence (DF FE 15) after the trade data
+     * is swapped, then the 3x SERIAL_PREAMBLE_BYTEs that end the trade data,
+     * and another 3x of them that start the patch data. We only care about
+     * the 6x total preamble bytes, the last of which is also the first byte
+     * of the patch list section of the wire image.
+     */
+    [TRADE_PATCH_HEADER] =
+        {
+            [CLS_OTHER] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+            [CLS_PREAMBLE] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_COUNT),
+            [CLS_TERMINATOR] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+            [CLS_SEL] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+            [CLS_ACCEPT] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+            [CLS_REJECT] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+            [CLS_LEAVE] = T(TRADE_PATCH_HEADER, STATUS_KEEP, ACT_ECHO),
+        },
+
+    /* The wire image echoes the remainder of the header, and then sends the
+     * patch list itself. What is interesting, is the Pokemon code seems to
+     * allocate 203 bytes, 3x for the preamble, and then 200 bytes of patch
+     * list. But in practice, the Game Boy seems to transmit 3x preamble bytes,
+     * 7x 0x00, then 189 bytes for the patch list. A total of 199 bytes.
+     *
+     * This relies on the data sent only ever sending 0x00 after part 2 of the
+     * patch list has been terminated. This is the case in official code.
+     */
+    [TRADE_PATCH_DATA] =
+        {
+            [CLS_OTHER] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH),
+            [CLS_BLANK] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE),
+            [CLS_PREAMBLE] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH),
+            [CLS_TERMINATOR] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH_PT2),
+            [CLS_SEL] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH),
+            [CLS_ACCEPT] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH),
+            [CLS_REJECT] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH),
+            [CLS_LEAVE] = T(TRADE_PATCH_DATA, STATUS_KEEP, ACT_IMAGE_PATCH),
+        },
+
+    /* Once a BLANK byte is received, move to the pending state */
+    [TRADE_SELECT] =
+        {
+            [CLS_OTHER] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_PENDING, STATUS_KEEP, ACT_ECHO),
+            [CLS_PREAMBLE] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+            [CLS_TERMINATOR] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+            [CLS_SEL] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+            [CLS_ACCEPT] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+            [CLS_REJECT] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+            [CLS_LEAVE] = T(TRADE_SELECT, STATUS_KEEP, ACT_ECHO),
+        },
+
+    /* Preambled with 6x 0x20 bytes; 33*6 == 198 bytes of Mail, for each
+     * pokemon, even if they have no mail set; 14*6 == 84 bytes, for each
+     * pokemon's mail, the OT Name and ID; then 101 bytes of patch list for
+     * the 84 bytes of metadata. This is 6 + 198 + 84 + 101 == 389. The mail is
+     * stored in input_pdata, and ours is sent from the wire image.
+     */
+    [TRADE_MAIL] =
+        {
+            [CLS_OTHER] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_BLANK] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_PREAMBLE] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_TERMINATOR] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_SEL] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_ACCEPT] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_REJECT] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+            [CLS_LEAVE] = T(TRADE_MAIL, STATUS_KEEP, ACT_IMAGE_MAIL),
+        },
+
+    /* Handle the Game Boy selecting a Pokemon to trade, or leaving the table */
+    [TRADE_PENDING] =
+        {
+            [CLS_OTHER] = T(TRADE_PENDING, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_PENDING, STATUS_KEEP, ACT_ECHO),
+            [CLS_PREAMBLE] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_TERMINATOR] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_SEL] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_ACCEPT] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_REJECT] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_LEAVE] = T(TRADE_RESET, GAMEBOY_READY, ACT_ECHO),
+        },
+
+    /* Handle the Game Boy accepting or rejecting a trade deal */
+    [TRADE_CONFIRMATION] =
+        {
+            [CLS_OTHER] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_ECHO),
+            [CLS_PREAMBLE] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_ECHO),
+            [CLS_TERMINATOR] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_ECHO),
+            [CLS_SEL] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_ECHO),
+            [CLS_ACCEPT] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_REJECT] = T(TRADE_SELECT, GAMEBOY_WAITING, ACT_ECHO),
+            [CLS_LEAVE] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_ECHO),
+        },
+
+    /* Start the actual trade. Waits in reset until the Game Boy is done with
+     * its animation and re-exchanges updated party data.
+     */
+    [TRADE_DONE] =
+        {
+            [CLS_OTHER] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_RESET, GAMEBOY_TRADING, ACT_TRADE),
+            [CLS_PREAMBLE] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_TERMINATOR] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_SEL] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_ACCEPT] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_REJECT] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+            [CLS_LEAVE] = T(TRADE_DONE, STATUS_KEEP, ACT_ECHO),
+        },
+
+    /* The Flipper backed out, keep telling the Game Boy until it agrees */
+    [TRADE_CANCEL] =
+        {
+            [CLS_OTHER] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_BLANK] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_PREAMBLE] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_TERMINATOR] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_SEL] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_ACCEPT] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_REJECT] = T(TRADE_CANCEL, STATUS_KEEP, ACT_LEAVE),
+            [CLS_LEAVE] = T(TRADE_RESET, GAMEBOY_READY, ACT_LEAVE),
+        },
+
+    /* The Game Boy has a Pokemon selected, a BLANK confirms it. It can still
+     * change its selection or leave the table.
+     */
+    [TRADE_PENDING_SEL] =
+        {
+            [CLS_OTHER] = T(TRADE_PENDING_SEL, STATUS_KEEP, ACT_ECHO),
+            [CLS_BLANK] = T(TRADE_CONFIRMATION, STATUS_KEEP, ACT_SEL_LOCK),
+            [CLS_PREAMBLE] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_TERMINATOR] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_SEL] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_ACCEPT] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_REJECT] = T(TRADE_PENDING_SEL, GAMEBOY_TRADE_PENDING, ACT_SEL),
+            [CLS_LEAVE] = T(TRADE_RESET, GAMEBOY_READY, ACT_ECHO),
+        },
+
+    /* Colosseum only, every byte after the table exchange belongs to the
+     * battle until the Game Boy comes back to the table.
+     */
+    [TRADE_BATTLE] =
+        {
+            [CLS_OTHER] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+            [CLS_BLANK] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+            [CLS_PREAMBLE] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE_END),
+            [CLS_TERMINATOR] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+            [CLS_SEL] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+            [CLS_ACCEPT] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+            [CLS_REJECT] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+            [CLS_LEAVE] = T(TRADE_BATTLE, STATUS_KEEP, ACT_BATTLE),
+        },
+};
+
+#undef T
+
+void trade_centre_init(struct trade_centre* centre, PokemonData* pdata) {
+    furi_assert(centre);
+    furi_assert(pdata);
+
+    memset(centre, '\0', sizeof(struct trade_centre));
+    furi_check(pdata->gen == GEN_I || pdata->gen == GEN_II);
+    centre->gen = trade_centre_gens[false][pdata->gen == GEN_II];
+    furi_check(centre->gen->len[TRADE_DATA].len == pdata->trade_block_sz);
+    centre->state = TRADE_RESET;
+}
+
+void trade_centre_mode_set(struct trade_centre* centre, uint8_t gen, bool colosseum) {
+    furi_assert(centre);
+
+    centre->gen = trade_centre_gens[colosseum][gen == GEN_II];
+    centre->state = TRADE_RESET;
+}
+
+/* A callback function that must be called outside of an interrupt context,
+ * This will update the patch list with only the party bytes that changed and
+ * then rebuild the outgoing wire image from the current trade_block state.
+ * This is used mostly after a trade to re-arm with the new data we just
+ * copied in.
+ */
+static void pokemon_plist_recreate_callback(void* context, uint32_t arg) {
+    furi_assert(context);
+    struct trade_ctx* trade = context;
+    uint8_t slot = arg;
+    uint8_t level;
+
+    /* Award some XP to the dolphin after a completed trade. This needs to
+     * happen outside of an ISR context, so we slap it here.
+     */
+    dolphin_deed(DolphinDeedPluginGameWin);
+    plist_update(trade->patch_list, trade->pdata);
+    wire_image_build(trade->wire_image, trade->pdata, trade->patch_list);
+
+    /* The Game Boy trusts the level it is sent, but exp is what it levels
+     * up from. Point out a received Pokemon where the two disagree.
+     */
+    level = pokemon_exp_level_get(trade->pdata, slot);
+    if(level != pokemon_stat_get(trade->pdata, slot, STAT_LEVEL, NONE)) {
+        FURI_LOG_W(
+            TAG,
+            "[trade] slot %d is level %d but has exp for level %d",
+            slot,
+            pokemon_stat_get(trade->pdata, slot, STAT_LEVEL, NONE),
+            level);
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "[trade] %u trades in %lu s",
+        atomic_load(&trade->queue.trades),
+        (furi_get_tick() - trade->queue.start_tick) / 1000);
+}
+
+/* Swap the next staged Pokemon in to the queue slot, if queueing the party.
+ * The staged entries are offered from the queue slot on, wrapping around to
+ * the ones before it. Once they all have been, the session goes back to
+ * normal trading rather than offer any of them twice.
+ */
+static inline void trade_centre_queue_next(struct trade_ctx* trade) {
+    struct trade_queue* queue = &trade->queue;
+
+    if(queue->mode != TRADE_QUEUE_PARTY) return;
+
+    if(queue->next == queue->slot) {
+        queue->mode = TRADE_QUEUE_OFF;
+        atomic_store(&queue->done, true);
+        return;
+    }
+
+    pokemon_stat_memcpy(trade->pdata, queue->slot, queue->staged, queue->next);
+    queue->next = (queue->next + 1) % pokemon_party_cnt_get(queue->staged);
+}
+
+#ifdef TRADE_ARCHIVE_PARTY
+static void trade_centre_archive_party(struct trade_ctx* trade) {
+    uint8_t cnt = pokemon_party_cnt_get(trade->input_pdata);
+    uint8_t i;
+
+    if(!trade->archive) return;
+    if(cnt > PARTY_CNT_MAX) cnt = PARTY_CNT_MAX;
+
+    for(i = 0; i < cnt; i++)
+        trade_archive_push(trade->archive, trade->input_pdata, i);
+}
+#endif
+
+/* Mark a received party byte as needing to be restored to 0xFE */
+static inline void trade_centre_patch(struct trade_ctx* trade, size_t offs) {
+    /* Ignore anything that would land outside of the party */
+    if(offs < trade->input_pdata->party_sz)
+        ((uint8_t*)trade->input_pdata->party)[offs] = SERIAL_NO_DATA_BYTE;
+}
+
+/* Store a received mail byte, offs counts from the start of the mail preamble.
+ * The metadata has all arrived by the time its patch list does.
+ */
+static inline void trade_centre_mail(struct trade_ctx* trade, uint16_t offs, uint8_t in) {
+    struct trade_centre* centre = &trade->centre;
+    uint8_t* mail = (uint8_t*)trade->input_pdata->mail;
+    const uint16_t meta_offs = PARTY_CNT_MAX * LEN_MAIL_MSG;
+
+    if(offs < WIRE_MAIL_PREAMBLE_SZ) return;
+    offs -= WIRE_MAIL_PREAMBLE_SZ;
+
+    if(offs < meta_offs) {
+        mail[offs] = (in == SERIAL_MAIL_REPLACEMENT_BYTE) ? SERIAL_NO_DATA_BYTE : in;
+    } else if(offs < LEN_MAIL_BLOCK) {
+        mail[offs] = in;
+    } else if(!centre->mail_patch_end) {
+        if(in == SERIAL_PATCH_LIST_PART_TERMINATOR)
+            centre->mail_patch_end = true;
+        /* Ignore anything that would land outside of the metadata */
+        else if(in > 0 && in <= LEN_MAIL_BLOCK - meta_offs)
+            mail[meta_offs + in - 1] = SERIAL_NO_DATA_BYTE;
+    }
+}
+
+/* Handle one byte in the current state. Returns true if the state ended and
+ * the byte needs to be handled again by the next state.
+ */
+static bool trade_centre_step(struct trade_ctx* trade, uint8_t in, uint8_t* send) {
+    struct trade_centre* centre = &trade->centre;
+    const struct trade_centre_gen* gen = centre->gen;
+    const struct trade_centre_transition* t =
+        &trade_centre_table[centre->state][gen->class[in]];
+    const struct trade_centre_len* len = &gen->len[centre->state];
+    struct wire_image* image = trade->wire_image;
+    bool count = true;
+
+    switch(t->action) {
+    case ACT_COUNT:
+        *send = in;
+        break;
+    case ACT_BATTLE_END:
+    case ACT_RESET:
+        centre->patch_pt_2 = false;
+        centre->mail_patch_end = false;
+        wire_image_rewind(image);
+        trade_battle_reset(&trade->battle);
+        count = (t->action == ACT_BATTLE_END);
+        *send = in;
+        break;
+    case ACT_IMAGE_RANDOM:
+        if(centre->count < SERIAL_RNS_LENGTH) trade->battle.random[centre->count] = in;
+        *send = wire_image_next(image, in);
+        break;
+    case ACT_IMAGE_DATA:
+        ((uint8_t*)trade->input_pdata->trade_block)[centre->count] = in;
+        *send = wire_image_next(image, in);
+        break;
+    case ACT_IMAGE_PATCH:
+        /* The tail of the header is not part of the patch list */
+        if(centre->count >= WIRE_PATCH_ECHO_SZ) {
+            /* Pt 1 is 0x00 - 0xFB, Pt 2 is 0xFC - 0x107 */
+            trade_centre_patch(trade, centre->patch_pt_2 ? (0xFB + in) : (in - 1));
+        }
+        *send = wire_image_next(image, in);
+        break;
+    case ACT_IMAGE_PATCH_PT2:
+        if(centre->count >= WIRE_PATCH_ECHO_SZ) centre->patch_pt_2 = true;
+        [[fallthrough]];
+    case ACT_IMAGE:
+        *send = wire_image_next(image, in);
+        break;
+    case ACT_IMAGE_MAIL:
+        trade_centre_mail(trade, centre->count, in);
+        *send = wire_image_next(image, in);
+        break;
+    case ACT_SEL:
+        /* Offer our Pokemon from the same party slot the Game Boy picked, or
+         * our last one if our party is smaller. This lets a whole party be
+         * swapped in one trip to the table by trading each slot in turn.
+         * When queueing, always offer from the queue slot.
+         */
+        centre->in_pkmn_idx = in;
+        centre->out_pkmn_idx = in & 0x0F;
+        if(trade->queue.mode != TRADE_QUEUE_OFF) centre->out_pkmn_idx = trade->queue.slot;
+        if(centre->out_pkmn_idx >= pokemon_party_cnt_get(trade->pdata))
+            centre->out_pkmn_idx = pokemon_party_cnt_get(trade->pdata) - 1;
+        *send = gen->bytes->sel_num_one + centre->out_pkmn_idx;
+        count = false;
+        break;
+    case ACT_SEL_LOCK:
+        centre->in_pkmn_idx &= 0x0F;
+        *send = in;
+        count = false;
+        break;
+    case ACT_TRADE:
+        /* Copy the traded-in Pokemon in to the slot we traded away. A bogus
+         * selection byte from the Game Boy is not worth crashing over. It is
+         * archived from input_pdata first, as in a queue mode it may be
+         * swapped straight back out of the party.
+         */
+        if(centre->in_pkmn_idx < PARTY_CNT_MAX) {
+            if(trade->archive)
+                trade_archive_push(trade->archive, trade->input_pdata, centre->in_pkmn_idx);
+            pokemon_stat_memcpy(
+                trade->pdata, centre->out_pkmn_idx, trade->input_pdata, centre->in_pkmn_idx);
+        }
+        trade_centre_queue_next(trade);
+        atomic_fetch_add(&trade->queue.trades, 1);
+
+        /* Schedule a callback outside of ISR context to rebuild the patch
+         * list with the new Pokemon that we just accepted, or just swapped
+         * in from the queue. This has the whole trade animation on the Game
+         * Boy to finish before it comes back to the table and sends its
+         * block again. A replay is not in ISR context, and needs the rebuild
+         * done before the next byte.
+         */
+        if(trade->replay) {
+            plist_update(trade->patch_list, trade->pdata);
+            wire_image_build(trade->wire_image, trade->pdata, trade->patch_list);
+        } else {
+            furi_timer_pending_callback(
+                pokemon_plist_recreate_callback, trade, centre->out_pkmn_idx);
+        }
+        *send = in;
+        count = false;
+        break;
+    case ACT_LEAVE:
+        *send = gen->bytes->table_leave;
+        count = false;
+        break;
+    case ACT_BATTLE:
+        *send = trade_battle_byte(trade, gen->bytes->battle_mask, in);
+        count = false;
+        break;
+    case ACT_ECHO:
+    default:
+        *send = in;
+        count = false;
+        break;
+    }
+
+    if(t->status != STATUS_KEEP && !gen->colosseum) trade_status_set(trade, t->status);
+
+    if(count && ++centre->count == len->len) {
+#ifdef TRADE_ARCHIVE_PARTY
+        /* The Game Boy's block is only complete once its patches are in */
+        if(centre->state == TRADE_PATCH_DATA) trade_centre_archive_party(trade);
+#endif
+        centre->state = len->done;
+        centre->count = 0;
+        return len->redispatch;
+    }
+
+    if(t->next != centre->state) {
+        centre->state = t->next;
+        centre->count = 0;
+    }
+
+    return false;
+}
+
+uint8_t trade_centre_byte(struct trade_ctx* trade, uint8_t in) {
+    furi_assert(trade);
+    uint8_t send;
+
+    /* A redispatched byte always lands in a state that cannot end on it */
+    if(trade_centre_step(trade, in, &send)) trade_centre_step(trade, in, &send);
+
+    return send;
+}
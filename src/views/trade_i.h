@@ -0,0 +1,308 @@
+#ifndef TRADE_I_H
+#define TRADE_I_H
+
+#pragma once
+
+#include <furi.h>
+#include <stdatomic.h>
+
+#include <gui/view.h>
+#include <notification/notification_messages.h>
+
+#include <src/include/pokemon_data.h>
+#include <src/include/patch_list.h>
+#include <src/include/wire_image.h>
+
+#include <src/views/trade.h>
+#include <src/views/trade_archive.h>
+#include <src/views/trade_trace.h>
+
+/* Uncomment the following line to run a scripted Game Boy link partner
+ * against the trade protocol handler each time the trade view is entered,
+ * before the real link is started. The partner plays the leader/master role
+ * through a full trade centre session, checks every byte the Flipper sends
+ * back, and logs handler throughput. The Flipper's own Pokemon is traded away
+ * to the simulated partner, so this is for development only.
+ */
+//#define LINK_SIMULATOR
+
+/* Uncomment the following line to replay TRADE_TRACE_DIR/replay.pktr each
+ * time the trade view is entered and log whether it diverges. See
+ * trade_trace.h.
+ */
+//#define LINK_REPLAY
+
+/* Uncomment the following line to also archive every member of the Game
+ * Boy's party each time it sends its trade block, rather than only the
+ * Pokemon actually traded to the Flipper. The box will collect the same
+ * Pokemon again on every visit to the trade table.
+ */
+//#define TRADE_ARCHIVE_PARTY
+
+#define DELAY_MICROSECONDS 15
+
+#define PKMN_BLANK 0x00
+
+#define ITEM_1_HIGHLIGHTED 0xD0
+#define ITEM_2_HIGHLIGHTED 0xD1
+#define ITEM_3_HIGHLIGHTED 0xD2
+#define ITEM_1_SELECTED 0xD4
+#define ITEM_2_SELECTED 0xD5
+#define ITEM_3_SELECTED 0xD6
+
+#define TRADE_BLOCK_SZ_GEN_I 415
+#define TRADE_BLOCK_SZ_GEN_II 441
+
+#define SERIAL_PREAMBLE_BYTE 0xFD
+
+#define SERIAL_PREAMBLE_LENGTH 6
+#define SERIAL_RN_PREAMBLE_LENGTH 7
+#define SERIAL_TRADE_PREAMBLE_LENGTH 9
+#define SERIAL_RNS_LENGTH 10
+
+#define PKMN_MASTER 0x01
+#define PKMN_SLAVE 0x02
+
+#define PKMN_CONNECTED 0x60
+#define PKMN_CONNECTED_II 0x61
+#define PKMN_TRADE_ACCEPT_GEN_I 0x62
+#define PKMN_TRADE_ACCEPT_GEN_II 0x72
+#define PKMN_TRADE_REJECT_GEN_I 0x61
+#define PKMN_TRADE_REJECT_GEN_II 0x71
+#define PKMN_TABLE_LEAVE_GEN_I 0x6f
+#define PKMN_TABLE_LEAVE_GEN_II 0x7f
+#define PKMN_SEL_NUM_MASK_GEN_I 0x60
+#define PKMN_SEL_NUM_MASK_GEN_II 0x70
+#define PKMN_SEL_NUM_ONE_GEN_I 0x60
+#define PKMN_SEL_NUM_ONE_GEN_II 0x70
+
+/* High nybble of the move or switch byte sent on every turn of a colosseum
+ * battle. The Time Capsule uses the Gen I one.
+ */
+#define PKMN_BATTLE_MASK_GEN_I 0x60
+#define PKMN_BATTLE_MASK_GEN_II 0x80
+
+#define PKMN_TRADE_CENTRE ITEM_1_SELECTED
+#define PKMN_COLOSSEUM ITEM_2_SELECTED
+#define PKMN_BREAK_LINK ITEM_3_SELECTED
+
+struct important_bytes {
+    const uint8_t connected;
+    const uint8_t trade_accept;
+    const uint8_t trade_reject;
+    const uint8_t table_leave;
+    const uint8_t sel_num_mask;
+    const uint8_t sel_num_one;
+    const uint8_t battle_mask;
+};
+
+extern const struct important_bytes gen_i;
+extern const struct important_bytes gen_ii;
+
+/* States specific to the trade process. */
+typedef enum {
+    TRADE_RESET,
+    TRADE_INIT,
+    TRADE_RANDOM,
+    TRADE_DATA,
+    TRADE_PATCH_HEADER,
+    TRADE_PATCH_DATA,
+    TRADE_SELECT,
+    TRADE_MAIL,
+    TRADE_PENDING,
+    TRADE_CONFIRMATION,
+    TRADE_DONE,
+    TRADE_CANCEL,
+    TRADE_PENDING_SEL,
+    TRADE_BATTLE,
+    TRADE_STATE_COUNT
+} trade_centre_state_t;
+
+/* Global states for the trade logic. These are used to dictate what gets drawn
+ * to the screen but also handle a few sync states. The CONN states are to denote
+ * if a link has been established or note. READY through TRADING are all specific
+ * screens to draw in the trade center. COLOSSEUM exchanges the same data as
+ * the trade center and then battles the Game Boy, see trade_battle.c.
+ */
+typedef enum {
+    GAMEBOY_CONN_FALSE,
+    GAMEBOY_CONN_TRUE,
+    GAMEBOY_READY,
+    GAMEBOY_WAITING,
+    GAMEBOY_TRADE_PENDING,
+    GAMEBOY_TRADING,
+    GAMEBOY_TRADE_CANCEL,
+    GAMEBOY_COLOSSEUM,
+    GAMEBOY_STATE_COUNT
+} render_gameboy_state_t;
+
+struct trade_centre_gen;
+
+/* State of the trade centre state machine, see trade_centre.c */
+struct trade_centre {
+    trade_centre_state_t state;
+    /* Bytes counted so far in the current state */
+    uint16_t count;
+    bool patch_pt_2;
+    /* The mail patch list part terminator has been received */
+    bool mail_patch_end;
+    /* Party slot the Game Boy offered, and the slot we offered in return */
+    uint8_t in_pkmn_idx;
+    uint8_t out_pkmn_idx;
+    /* Tables for the generation being traded */
+    const struct trade_centre_gen* gen;
+};
+
+/* Sides of a colosseum battle, the Flipper and the Game Boy */
+#define BATTLE_US 0
+#define BATTLE_THEM 1
+
+/* One party member as the colosseum battle model sees it */
+struct trade_battle_mon {
+    uint16_t hp;
+    uint16_t atk;
+    uint16_t def;
+    uint16_t spd;
+    /* Gen I has SPC for both */
+    uint16_t spc_atk;
+    uint16_t spc_def;
+    uint8_t level;
+    uint8_t type[2];
+    uint8_t move[4];
+    /* Times each move has been used, only counted for the Flipper's party */
+    uint8_t used[4];
+};
+
+/* State of a colosseum battle, see trade_battle.c. It is part of trade_ctx so
+ * that nothing has to be allocated once the battle starts.
+ */
+struct trade_battle {
+    /* Indexed by BATTLE_US or BATTLE_THEM */
+    struct trade_battle_mon mon[2][PARTY_CNT_MAX];
+    uint8_t cnt[2];
+    uint8_t active[2];
+    /* The Game Boy's random numbers, captured at the start of the exchange */
+    uint8_t random[SERIAL_RNS_LENGTH];
+    /* Number of action exchanges so far */
+    uint8_t turn;
+    /* Sent back for every byte of the current action exchange */
+    uint8_t reply;
+    /* The last byte received was an action byte */
+    bool in_exchange;
+    /* The parties have been loaded in to mon */
+    bool loaded;
+    /* Set to turn when the Game Boy runs, taken by the draw timer */
+    atomic_uint ran;
+};
+
+/* Unattended batch trading, see TradeQueueMode. Set up each time the trade
+ * view is entered, which starts a new session.
+ */
+struct trade_queue {
+    /* The mode picked from the menu, and the mode of this session. A
+     * TRADE_QUEUE_PARTY session drops to TRADE_QUEUE_OFF once every staged
+     * entry has been offered.
+     */
+    TradeQueueMode setting;
+    TradeQueueMode mode;
+    /* Copy of the party at the start of the session. In TRADE_QUEUE_PARTY
+     * mode, each trade swaps the next entry in to slot.
+     */
+    PokemonData* staged;
+    /* The slot every trade offers from, and the next staged entry */
+    uint8_t slot;
+    uint8_t next;
+    /* Completed trades this session, counted by the ISR */
+    atomic_uint trades;
+    /* Set by the ISR when the end of the staged party is reached */
+    atomic_bool done;
+    uint32_t start_tick;
+};
+
+/* Anonymous struct */
+struct trade_ctx {
+    struct trade_centre centre;
+    struct trade_queue queue;
+    struct trade_battle battle;
+    /* The link ISR owns the current gameboy_status. The draw timer takes a
+     * snapshot of it once per frame and pushes that to the view model, so
+     * nothing in the per-byte path has to lock the model or queue timer
+     * callbacks.
+     */
+    atomic_int gameboy_status;
+    /* Set by the ISR on every byte, cleared once per frame by the draw timer */
+    atomic_bool link_activity;
+    uint8_t frame_cnt;
+    FuriTimer* draw_timer;
+    View* view;
+    uint8_t in_data;
+    uint8_t out_data;
+    uint8_t shift;
+    PokemonData* input_pdata;
+    struct patch_list* patch_list;
+    struct wire_image* wire_image;
+    void* gblink_handle;
+    PokemonData* pdata;
+    /* Where received Pokemon are saved, NULL if there is no box */
+    struct trade_archive* archive;
+    NotificationApp* notifications;
+    /* Only allocated while capturing a trace */
+    struct trade_trace* trace;
+    /* Set when the handler is being fed from a trace rather than the link,
+     * anything normally deferred out of ISR context happens immediately.
+     */
+    bool replay;
+};
+
+static inline render_gameboy_state_t trade_status_get(struct trade_ctx* trade) {
+    return atomic_load(&trade->gameboy_status);
+}
+
+static inline void trade_status_set(struct trade_ctx* trade, render_gameboy_state_t status) {
+    atomic_store(&trade->gameboy_status, status);
+}
+
+/* Process one byte received from the link partner and return the byte to
+ * send back. This is the entire trade protocol and is called from the link
+ * ISR, it must never block.
+ */
+uint8_t trade_link_byte(struct trade_ctx* trade, uint8_t in_byte);
+
+/* Allocate a trade context with no view or link attached, with its own copy
+ * of trade_block and, if not NULL, the Gen II mail block, that can only be
+ * driven by trade_link_byte(). Must not be called from an ISR.
+ */
+struct trade_ctx* trade_headless_alloc(
+    uint8_t gen,
+    const void* trade_block,
+    const void* mail,
+    render_gameboy_state_t gameboy_status,
+    trade_centre_state_t trade_centre_state);
+/* Run a headless context's session in a trade queue mode, staging its party
+ * as it is right now. Must not be called from an ISR.
+ */
+void trade_headless_queue_set(struct trade_ctx* trade, TradeQueueMode mode, uint8_t slot);
+void trade_headless_free(struct trade_ctx* trade);
+
+void trade_centre_init(struct trade_centre* centre, PokemonData* pdata);
+/* Pick the trade centre or the colosseum once the Game Boy selects one from
+ * the link menu. They share the exchange at the table, but the colosseum goes
+ * on to a battle instead of trade selection.
+ */
+void trade_centre_mode_set(struct trade_centre* centre, uint8_t gen, bool colosseum);
+
+/* Handle one byte once in the trade centre, returns the byte to send back */
+uint8_t trade_centre_byte(struct trade_ctx* trade, uint8_t in);
+
+/* Forget the battle, the parties are loaded again on the next battle byte */
+void trade_battle_reset(struct trade_battle* battle);
+/* Handle one byte once the colosseum exchange is done, mask is the
+ * battle_mask of the gen. Returns the byte to send back.
+ */
+uint8_t trade_battle_byte(struct trade_ctx* trade, uint8_t mask, uint8_t in);
+
+#ifdef LINK_SIMULATOR
+void trade_sim_run(struct trade_ctx* trade);
+#endif
+
+#endif /* TRADE_I_H */
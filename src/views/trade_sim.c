@@ -0,0 +1,578 @@
+/* A scripted Game Boy link partner, used to exercise and profile the trade
+ * protocol handler without any hardware attached. See LINK_SIMULATOR in
+ * trade_i.h.
+ *
+ * The partner always takes the leader/master role, like a real Game Boy
+ * would, and feeds bytes straight in to trade_link_byte(). Every response
+ * is checked against what the Flipper is expected to send, and any mismatch
+ * crashes with the offending byte logged. Note that on real hardware, the
+ * response to a byte is shifted out during the following transfer, that
+ * offset is not modeled here.
+ *
+ * What each side sends at the table is encoded here straight from its
+ * trade_block and mail, following the patch list rules the games use, and
+ * not from a wire image. The Flipper's responses are checked against its own
+ * data encoded this way, so a wire image that was built wrong, or not
+ * re-armed after a trade, does not go unnoticed.
+ *
+ * The final session is also fed, byte for byte interleaved, to a second
+ * headless trade context. It must respond identically to the real one, which
+ * checks that no protocol state is shared between contexts.
+ *
+ * Then the partner goes to the colosseum and plays a scripted battle against
+ * the Flipper's party, checking that every reply is an action the Game Boy
+ * would accept.
+ *
+ * Last, for each TradeQueueMode, the Flipper's party is staged in a headless
+ * context and the partner trades with it over and over, checking what is
+ * offered from one trade to the next.
+ */
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/patch_list.h>
+#include <src/include/wire_image.h>
+
+#include <src/views/trade_i.h>
+
+#ifdef LINK_SIMULATOR
+
+/* Number of times the partner walks up to the trade table, exchanges data,
+ * and leaves again, for the throughput measurement.
+ */
+#define SIM_TABLE_ITERATIONS 200
+
+/* Start of the metadata in a mail block */
+#define SIM_MAIL_META_OFFS (PARTY_CNT_MAX * LEN_MAIL_MSG)
+
+/* Number of times each action byte is repeated once the Flipper has
+ * replied, and of 0x00 bytes sent after that
+ */
+#define SIM_BATTLE_REPEAT 10
+/* Most turns to wait for the estimate to faint the partner's Pokemon */
+#define SIM_BATTLE_TURNS_MAX 100
+
+/* The partner sends far faster than a Game Boy, so when a trace is being
+ * captured it is flushed every this many bytes to keep up. This isn't a
+ * power of 2, so flushes also wrap around the end of the ring.
+ */
+#define SIM_TRACE_FLUSH_BYTES 1000
+
+/* The 3 byte ending sequence of the trade block */
+static const uint8_t sim_block_end[] = {0xDF, 0xFE, 0x15};
+
+/* The parts of a table exchange that are sent as they are encoded */
+struct sim_image {
+    uint8_t block[WIRE_TRADE_BLOCK_MAX_SZ];
+    uint8_t patch[WIRE_PATCH_SZ - WIRE_PATCH_ECHO_SZ];
+    uint8_t mail[WIRE_MAIL_SZ - WIRE_MAIL_PREAMBLE_SZ];
+};
+
+struct trade_sim {
+    struct trade_ctx* trade;
+    const struct important_bytes* bytes;
+    PokemonData* partner;
+    /* What the partner sends, and what the Flipper must send back */
+    struct sim_image* out;
+    struct sim_image* expect;
+    struct trade_ctx* shadow;
+    size_t count;
+    /* In the colosseum, which has no mail exchange */
+    bool colosseum;
+};
+
+/* Encode pdata for the table. 0xFE can't be sent, so in the party it goes as
+ * 0xFF and its offset is added to the patch list. The list is 1 indexed and in
+ * two parts, offsets from 0xFC on are in the second, each ended by 0xFF. In
+ * mail, a message byte goes as 0x21 and is not patched, a metadata byte goes
+ * as 0xFF and is patched, all in one part.
+ */
+static void sim_encode(PokemonData* pdata, struct sim_image* image) {
+    const uint8_t* mail = (const uint8_t*)pdata->mail;
+    uint8_t* party =
+        &image->block[(const uint8_t*)pdata->party - (const uint8_t*)pdata->trade_block];
+    uint8_t* patch = image->patch;
+    size_t i;
+
+    memset(image, '\0', sizeof(struct sim_image));
+    memcpy(image->block, pdata->trade_block, pdata->trade_block_sz);
+
+    for(i = 0; i < pdata->party_sz; i++) {
+        if(i == 0xFC) *patch++ = SERIAL_PATCH_LIST_PART_TERMINATOR;
+        if(party[i] != SERIAL_NO_DATA_BYTE) continue;
+        party[i] = 0xFF;
+        *patch++ = (i < 0xFC) ? (i + 1) : (i - 0xFC + 1);
+    }
+    if(pdata->party_sz <= 0xFC) *patch++ = SERIAL_PATCH_LIST_PART_TERMINATOR;
+    *patch = SERIAL_PATCH_LIST_PART_TERMINATOR;
+
+    if(!mail) return;
+
+    patch = &image->mail[LEN_MAIL_BLOCK];
+    for(i = 0; i < LEN_MAIL_BLOCK; i++) {
+        image->mail[i] = mail[i];
+        if(mail[i] != SERIAL_NO_DATA_BYTE) continue;
+        if(i < SIM_MAIL_META_OFFS) {
+            image->mail[i] = SERIAL_MAIL_REPLACEMENT_BYTE;
+        } else {
+            image->mail[i] = 0xFF;
+            *patch++ = i - SIM_MAIL_META_OFFS + 1;
+        }
+    }
+    *patch = SERIAL_PATCH_LIST_PART_TERMINATOR;
+}
+
+/* Send a byte as the Game Boy, returns the Flipper's response */
+static uint8_t sim_byte(struct trade_sim* sim, uint8_t out) {
+    uint8_t in = trade_link_byte(sim->trade, out);
+
+    sim->count++;
+    if(sim->trade->trace && (sim->count % SIM_TRACE_FLUSH_BYTES) == 0)
+        trade_trace_flush(sim->trade->trace);
+
+    return in;
+}
+
+/* Send a byte as the Game Boy, crash if the Flipper did not respond with the
+ * expected byte.
+ */
+static void sim_xfer(struct trade_sim* sim, uint8_t out, uint8_t expect) {
+    uint8_t in = sim_byte(sim, out);
+
+    if(in != expect) {
+        FURI_LOG_E(
+            TAG,
+            "[sim] byte %d: sent 0x%02X, expected 0x%02X, got 0x%02X",
+            sim->count,
+            out,
+            expect,
+            in);
+        furi_crash("Link sim mismatch");
+    }
+
+    if(sim->shadow) {
+        furi_check(trade_link_byte(sim->shadow, out) == in);
+        furi_check(sim->shadow->centre.state == sim->trade->centre.state);
+        furi_check(trade_status_get(sim->shadow) == trade_status_get(sim->trade));
+    }
+}
+
+static void sim_echo(struct trade_sim* sim, uint8_t out, size_t len) {
+    while(len--)
+        sim_xfer(sim, out, out);
+}
+
+static void sim_status_check(struct trade_sim* sim, render_gameboy_state_t status) {
+    if(trade_status_get(sim->trade) != status) {
+        FURI_LOG_E(
+            TAG,
+            "[sim] byte %d: expected status %d, got %d",
+            sim->count,
+            status,
+            trade_status_get(sim->trade));
+        furi_crash("Link sim bad status");
+    }
+}
+
+/* Negotiate roles and connect */
+static void sim_connect(struct trade_sim* sim) {
+    sim_xfer(sim, PKMN_MASTER, PKMN_SLAVE);
+    sim_echo(sim, PKMN_BLANK, 3);
+    sim_echo(sim, sim->bytes->connected, 1);
+    sim_status_check(sim, GAMEBOY_CONN_TRUE);
+    sim_echo(sim, PKMN_BLANK, 3);
+}
+
+/* Highlight and then select the trade centre in the link menu */
+static void sim_menu(struct trade_sim* sim) {
+    sim_echo(sim, ITEM_1_HIGHLIGHTED, 3);
+    sim_xfer(sim, PKMN_TRADE_CENTRE, PKMN_BLANK);
+    sim_status_check(sim, GAMEBOY_READY);
+}
+
+/* Walk up to the table and exchange trade blocks, patch lists, and mail */
+static void sim_table(struct trade_sim* sim) {
+    size_t i;
+
+    sim_encode(sim->partner, sim->out);
+    sim_encode(sim->trade->pdata, sim->expect);
+
+    sim_echo(sim, PKMN_BLANK, 3);
+    sim_echo(sim, SERIAL_PREAMBLE_BYTE, SERIAL_RNS_LENGTH);
+    sim_status_check(sim, sim->colosseum ? GAMEBOY_COLOSSEUM : GAMEBOY_WAITING);
+
+    /* Random numbers followed by the trade block preamble */
+    for(i = 0; i < SERIAL_RNS_LENGTH; i++)
+        sim_echo(sim, (uint8_t)(i * 37 + 11), 1);
+    sim_echo(sim, SERIAL_PREAMBLE_BYTE, WIRE_RANDOM_SZ - SERIAL_RNS_LENGTH);
+
+    for(i = 0; i < sim->partner->trade_block_sz; i++)
+        sim_xfer(sim, sim->out->block[i], sim->expect->block[i]);
+
+    /* Trade block ending, the 6x preamble bytes, then the patch list BLANKs */
+    for(i = 0; i < sizeof(sim_block_end); i++)
+        sim_echo(sim, sim_block_end[i], 1);
+    sim_echo(sim, SERIAL_PREAMBLE_BYTE, 6);
+    sim_echo(sim, PKMN_BLANK, WIRE_PATCH_ECHO_SZ - 1);
+
+    for(i = 0; i < sizeof(sim->out->patch); i++)
+        sim_xfer(sim, sim->out->patch[i], sim->expect->patch[i]);
+
+    /* Gen II mail, 6x preamble bytes and then the mail block and patch list */
+    if(sim->partner->gen == GEN_II && !sim->colosseum) {
+        sim_echo(sim, SERIAL_MAIL_PREAMBLE_BYTE, WIRE_MAIL_PREAMBLE_SZ);
+        for(i = 0; i < sizeof(sim->out->mail); i++)
+            sim_xfer(sim, sim->out->mail[i], sim->expect->mail[i]);
+        furi_check(
+            memcmp(sim->trade->input_pdata->mail, sim->partner->mail, LEN_MAIL_BLOCK) == 0);
+    }
+
+    /* The Flipper must have the partner's trade block with all patches applied */
+    furi_check(
+        memcmp(
+            sim->trade->input_pdata->trade_block,
+            sim->partner->trade_block,
+            sim->partner->trade_block_sz) == 0);
+}
+
+static void sim_table_leave(struct trade_sim* sim) {
+    sim_echo(sim, PKMN_BLANK, 1);
+    sim_echo(sim, sim->bytes->table_leave, 1);
+    sim_status_check(sim, GAMEBOY_READY);
+}
+
+/* Slot a of pdata must hold the same Pokemon, names, and mail as slot b of
+ * other.
+ */
+static void sim_slot_check(PokemonData* pdata, uint8_t a, PokemonData* other, uint8_t b) {
+    PokemonRaw raw_a;
+    PokemonRaw raw_b;
+
+    pokemon_raw_get(pdata, a, &raw_a);
+    pokemon_raw_get(other, b, &raw_b);
+    furi_check(memcmp(&raw_a, &raw_b, sizeof(PokemonRaw)) == 0);
+
+    if(pdata->gen == GEN_II) {
+        furi_check(
+            memcmp(
+                (uint8_t*)pdata->mail + (a * LEN_MAIL_MSG),
+                (uint8_t*)other->mail + (b * LEN_MAIL_MSG),
+                LEN_MAIL_MSG) == 0);
+        furi_check(
+            memcmp(
+                (uint8_t*)pdata->mail + SIM_MAIL_META_OFFS + (a * LEN_MAIL_META),
+                (uint8_t*)other->mail + SIM_MAIL_META_OFFS + (b * LEN_MAIL_META),
+                LEN_MAIL_META) == 0);
+    }
+}
+
+/* The slot the Flipper offers from when trading normally, the same one the
+ * partner offers from, or the Flipper's last if its party is smaller.
+ */
+static uint8_t sim_out_slot(struct trade_sim* sim) {
+    uint8_t slot = pokemon_party_cnt_get(sim->partner) - 1;
+
+    if(slot >= pokemon_party_cnt_get(sim->trade->pdata))
+        slot = pokemon_party_cnt_get(sim->trade->pdata) - 1;
+
+    return slot;
+}
+
+/* Offer the partner's last Pokemon and accept the trade, the Flipper must
+ * offer from out_slot.
+ */
+static void sim_trade(struct trade_sim* sim, uint8_t out_slot) {
+    uint8_t in_slot = pokemon_party_cnt_get(sim->partner) - 1;
+
+    sim_echo(sim, PKMN_BLANK, 1);
+    sim_xfer(sim, sim->bytes->sel_num_one + in_slot, sim->bytes->sel_num_one + out_slot);
+    sim_status_check(sim, GAMEBOY_TRADE_PENDING);
+    sim_echo(sim, PKMN_BLANK, 1);
+    sim_echo(sim, sim->bytes->trade_accept, 3);
+    sim_echo(sim, PKMN_BLANK, 1);
+    sim_status_check(sim, GAMEBOY_TRADING);
+}
+
+/* Stage the Flipper's party in a headless context and trade one more time
+ * than it has members, all in mode and offering from slot. Before each trade
+ * the slot must hold what mode says it should, and each table exchange after
+ * a trade checks that the wire image was re-armed with it.
+ */
+static void sim_queue(struct trade_sim* sim, TradeQueueMode mode, uint8_t slot) {
+    PokemonData* pdata = sim->trade->pdata;
+    uint8_t cnt = pokemon_party_cnt_get(pdata);
+    uint8_t in_slot = pokemon_party_cnt_get(sim->partner) - 1;
+    struct trade_sim queue = *sim;
+    struct trade_ctx* trade;
+    uint8_t out_slot;
+    uint8_t i;
+
+    trade = trade_headless_alloc(
+        pdata->gen, pdata->trade_block, pdata->mail, GAMEBOY_READY, TRADE_RESET);
+    trade_headless_queue_set(trade, mode, slot);
+    queue.trade = trade;
+    queue.shadow = NULL;
+
+    for(i = 0; i <= cnt; i++) {
+        out_slot = (trade->queue.mode == TRADE_QUEUE_OFF) ? sim_out_slot(&queue) : slot;
+
+        switch(mode) {
+        case TRADE_QUEUE_PARTY:
+            /* Each staged entry once, then normal trading from the end */
+            furi_check(atomic_load(&trade->queue.done) == (i == cnt));
+            if(i < cnt) {
+                furi_check(trade->queue.mode == TRADE_QUEUE_PARTY);
+                sim_slot_check(trade->pdata, slot, pdata, (slot + i) % cnt);
+            } else {
+                furi_check(trade->queue.mode == TRADE_QUEUE_OFF);
+                sim_slot_check(trade->pdata, slot, sim->partner, in_slot);
+            }
+            break;
+        case TRADE_QUEUE_RETURN:
+        case TRADE_QUEUE_OFF:
+        default:
+            /* What was received is what is offered next */
+            if(i == 0)
+                sim_slot_check(trade->pdata, out_slot, pdata, out_slot);
+            else
+                sim_slot_check(trade->pdata, out_slot, sim->partner, in_slot);
+            break;
+        }
+
+        sim_table(&queue);
+        sim_trade(&queue, out_slot);
+        furi_check(atomic_load(&trade->queue.trades) == i + 1U);
+    }
+    sim_table(&queue);
+    sim_table_leave(&queue);
+
+    FURI_LOG_I(
+        TAG,
+        "[sim] %s, %d trades from slot %d",
+        trade_queue_mode_name_get(mode),
+        atomic_load(&trade->queue.trades),
+        slot);
+    trade_headless_free(trade);
+}
+
+/* One action exchange of a colosseum battle, returns the Flipper's action */
+static uint8_t sim_battle_action(struct trade_sim* sim, uint8_t action) {
+    uint8_t mask = sim->bytes->battle_mask;
+    uint8_t reply = sim_byte(sim, mask | action);
+
+    if((reply & 0xF0) != mask) {
+        FURI_LOG_E(
+            TAG, "[sim] byte %d: sent 0x%02X, got 0x%02X", sim->count, mask | action, reply);
+        furi_crash("Link sim bad battle action");
+    }
+
+    for(int i = 0; i < SIM_BATTLE_REPEAT; i++)
+        sim_xfer(sim, mask | action, reply);
+    sim_echo(sim, PKMN_BLANK, SIM_BATTLE_REPEAT);
+    sim_status_check(sim, GAMEBOY_COLOSSEUM);
+
+    return reply & 0x0F;
+}
+
+/* The Flipper must pick a move its active Pokemon has, or struggle */
+static void sim_battle_move_check(struct trade_sim* sim, uint8_t reply) {
+    const struct trade_battle* battle = &sim->trade->battle;
+
+    if(reply == 0x0E) return;
+    furi_check(reply <= MOVE_3);
+    furi_check(battle->mon[BATTLE_US][battle->active[BATTLE_US]].move[reply]);
+}
+
+/* The Flipper must send out a different Pokemon that has not fainted */
+static void sim_battle_switch_check(struct trade_sim* sim, uint8_t reply, uint8_t prev) {
+    const struct trade_battle* battle = &sim->trade->battle;
+
+    furi_check(reply >= 4);
+    furi_check(reply - 4 < battle->cnt[BATTLE_US]);
+    furi_check(reply - 4 != prev);
+    furi_check(battle->active[BATTLE_US] == reply - 4);
+    furi_check(battle->mon[BATTLE_US][reply - 4].hp);
+}
+
+/* Go to the colosseum and play a scripted battle: a few turns of moves, a
+ * switch, the Flipper's Pokemon fainting, the partner's Pokemon fainting, and
+ * then running from the battle. Then walk back to the table.
+ */
+static void sim_battle(struct trade_sim* sim) {
+    struct trade_battle* battle = &sim->trade->battle;
+    uint8_t cnt = pokemon_party_cnt_get(sim->trade->pdata);
+    uint8_t prev;
+    uint8_t reply;
+    int i;
+
+    sim_echo(sim, ITEM_1_HIGHLIGHTED, 3);
+    sim_xfer(sim, PKMN_COLOSSEUM, PKMN_BLANK);
+    sim_status_check(sim, GAMEBOY_COLOSSEUM);
+
+    sim->colosseum = true;
+    sim_table(sim);
+    sim_status_check(sim, GAMEBOY_COLOSSEUM);
+    furi_check(sim->trade->centre.state == TRADE_BATTLE);
+    for(i = 0; i < SERIAL_RNS_LENGTH; i++) furi_check(battle->random[i] == (uint8_t)(i * 37 + 11));
+
+    /* Nothing is known about the parties until the first action */
+    sim_echo(sim, PKMN_BLANK, 3);
+    furi_check(!battle->loaded);
+
+    for(i = 0; i < 3; i++) sim_battle_move_check(sim, sim_battle_action(sim, MOVE_0));
+    furi_check(battle->loaded);
+    furi_check(battle->cnt[BATTLE_US] == cnt);
+    furi_check(battle->cnt[BATTLE_THEM] == pokemon_party_cnt_get(sim->partner));
+
+    /* The partner switches to its second Pokemon, the Flipper attacks it */
+    sim_battle_move_check(sim, sim_battle_action(sim, 4 + 1));
+    furi_check(battle->active[BATTLE_THEM] == 1);
+
+    /* Sending the active slot again asks for the Flipper's next Pokemon */
+    if(cnt > 1) {
+        prev = battle->active[BATTLE_US];
+        sim_battle_switch_check(sim, sim_battle_action(sim, 4 + 1), prev);
+    }
+
+    /* Attack until the estimate has the partner's Pokemon fainted, then send
+     * out the first one again.
+     */
+    for(i = 0; i < SIM_BATTLE_TURNS_MAX && battle->mon[BATTLE_THEM][1].hp; i++) {
+        reply = sim_battle_action(sim, MOVE_0);
+        sim_battle_move_check(sim, reply);
+    }
+    if(!battle->mon[BATTLE_THEM][1].hp) {
+        reply = sim_battle_action(sim, 4 + 0);
+        furi_check(battle->active[BATTLE_THEM] == 0);
+        if(battle->mon[BATTLE_US][battle->active[BATTLE_US]].hp)
+            sim_battle_move_check(sim, reply);
+        else
+            furi_check(reply >= 4);
+    }
+
+    /* A move is a normal turn, whatever the estimate thinks */
+    sim_battle_move_check(sim, sim_battle_action(sim, MOVE_0));
+
+    sim_battle_action(sim, 0x0F);
+    furi_check(atomic_load(&battle->ran) == battle->turn);
+    FURI_LOG_I(TAG, "[sim] battle over after %d exchanges", battle->turn);
+
+    /* Back to the table, which starts everything over */
+    sim_table(sim);
+    furi_check(sim->trade->centre.state == TRADE_BATTLE);
+    furi_check(!battle->loaded && !battle->turn);
+    sim->colosseum = false;
+}
+
+void trade_sim_run(struct trade_ctx* trade) {
+    furi_assert(trade);
+
+    struct trade_sim sim = {0};
+    uint32_t ticks;
+    uint32_t ms;
+    size_t count;
+    uint8_t* mail;
+    uint8_t slot;
+    int i;
+
+    sim.trade = trade;
+    sim.partner = pokemon_data_alloc(trade->pdata->gen);
+    sim.bytes = (trade->pdata->gen == GEN_I) ? &gen_i : &gen_ii;
+
+    /* Give the partner a second Pokemon to offer, make it distinct, and give
+     * it some party bytes that need patching.
+     */
+    slot = pokemon_party_add(sim.partner);
+    pokemon_stat_set(sim.partner, slot, STAT_NUM, NONE, 24);
+    pokemon_stat_set(sim.partner, slot, STAT_ATK_EV, NONE, 0xFEFE);
+
+    /* And mail, with 0xFE in both the message and the metadata */
+    if(sim.partner->mail) {
+        mail = (uint8_t*)sim.partner->mail;
+        for(i = 0; i < LEN_MAIL_MSG - 1; i++)
+            mail[(slot * LEN_MAIL_MSG) + i] = (i & 1) ? SERIAL_NO_DATA_BYTE : (0x80 + i);
+        for(i = 0; i < LEN_MAIL_META; i++)
+            mail[SIM_MAIL_META_OFFS + (slot * LEN_MAIL_META) + i] =
+                (i % 3) ? SERIAL_NO_DATA_BYTE : i;
+    }
+
+    sim.out = malloc(sizeof(struct sim_image));
+    sim.expect = malloc(sizeof(struct sim_image));
+
+    trade_status_set(trade, GAMEBOY_CONN_FALSE);
+    trade->centre.state = TRADE_RESET;
+    trade->queue.mode = TRADE_QUEUE_OFF;
+
+    sim_connect(&sim);
+    sim_menu(&sim);
+
+    count = sim.count;
+    ticks = furi_get_tick();
+    for(i = 0; i < SIM_TABLE_ITERATIONS; i++) {
+        sim_table(&sim);
+        sim_table_leave(&sim);
+    }
+    ms = furi_get_tick() - ticks;
+    count = sim.count - count;
+    if(ms == 0) ms = 1;
+    FURI_LOG_I(
+        TAG,
+        "[sim] %d table sessions, %d bytes in %lu ms, %lu bytes/s",
+        SIM_TABLE_ITERATIONS,
+        count,
+        ms,
+        (uint32_t)((count * 1000) / ms));
+
+    sim.shadow = trade_headless_alloc(
+        trade->pdata->gen,
+        trade->pdata->trade_block,
+        trade->pdata->mail,
+        trade_status_get(trade),
+        trade->centre.state);
+    sim_table(&sim);
+    slot = sim_out_slot(&sim);
+    sim_trade(&sim, slot);
+    sim_slot_check(trade->pdata, slot, sim.partner, pokemon_party_cnt_get(sim.partner) - 1);
+    furi_check(
+        memcmp(
+            sim.shadow->pdata->trade_block,
+            trade->pdata->trade_block,
+            trade->pdata->trade_block_sz) == 0);
+    trade_headless_free(sim.shadow);
+    sim.shadow = NULL;
+    FURI_LOG_I(TAG, "[sim] trade complete, %d bytes total", sim.count);
+
+    /* On the Flipper, linking up again means leaving the trade view and coming
+     * back, which starts a new trace. The trace ends here, so it only holds the
+     * one session that can be replayed from its header.
+     */
+    if(trade->trace) {
+        trade_trace_stop(trade->trace);
+        trade->trace = NULL;
+    }
+
+    /* Link up again, as the Game Boy would after saving */
+    trade_status_set(trade, GAMEBOY_CONN_FALSE);
+    trade->centre.state = TRADE_RESET;
+    sim_connect(&sim);
+    sim_battle(&sim);
+    FURI_LOG_I(TAG, "[sim] colosseum complete, %d bytes total", sim.count);
+
+    /* Runs of trades in each queue mode, from the middle of the party so that
+     * the queue wraps around to the start of it
+     */
+    slot = pokemon_party_cnt_get(trade->pdata) / 2;
+    for(i = 0; i < TRADE_QUEUE_COUNT; i++) sim_queue(&sim, i, slot);
+
+    /* Leave the link as it would be when first entering the view */
+    trade_status_set(trade, GAMEBOY_CONN_FALSE);
+    trade_centre_mode_set(&trade->centre, trade->pdata->gen, false);
+
+    free(sim.expect);
+    free(sim.out);
+    pokemon_data_free(sim.partner);
+}
+
+#endif /* LINK_SIMULATOR */
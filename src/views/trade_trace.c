@@ -0,0 +1,354 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <stdatomic.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/patch_list.h>
+#include <src/include/wire_image.h>
+
+#include <src/views/trade_i.h>
+#include <src/views/trade_trace.h>
+
+/* Number of records in the RAM ring, must be a power of 2. At 8 bytes each,
+ * this is 16 KiB, enough for ~64 ms of a double speed GBC link between
+ * flushes.
+ */
+#define TRADE_TRACE_RING_SZ 2048
+#define TRADE_TRACE_RING_MASK (TRADE_TRACE_RING_SZ - 1)
+
+/* Number of records read from a file at once during replay */
+#define TRADE_TRACE_REPLAY_CHUNK 64
+
+/* Storage writes and logging, the same as the archive worker. The spare
+ * stack is logged when the worker exits.
+ */
+#define TRACE_STACK_SZ 2048
+#define TRACE_FLAG_FLUSH (1 << 0)
+#define TRACE_FLAG_EXIT (1 << 1)
+
+/* Locking: lock is held for the whole of a flush, so the worker and
+ * trade_trace_flush() can't both write at once. file is only used with it
+ * held.
+ */
+struct trade_trace {
+    Storage* storage;
+    File* file;
+    FuriMutex* lock;
+    FuriThread* thread;
+    /* head is only written by the ISR, tail only by the flush. Both count up
+     * forever and are masked when indexing the ring.
+     */
+    atomic_uint head;
+    atomic_uint tail;
+    /* Once this is non-zero, nothing more is recorded */
+    atomic_uint dropped;
+    struct trade_trace_rec ring[TRADE_TRACE_RING_SZ];
+};
+
+/* Fill in the header's dropped count and close the file. lock must be held. */
+static void trade_trace_close(struct trade_trace* trace) {
+    uint32_t dropped = atomic_load(&trace->dropped);
+
+    if(dropped) FURI_LOG_E(TAG, "[trace] %lu records dropped, trace is cut short", dropped);
+
+    if(!storage_file_seek(trace->file, offsetof(struct trade_trace_hdr, dropped), true) ||
+       storage_file_write(trace->file, &dropped, sizeof(dropped)) != sizeof(dropped))
+        FURI_LOG_E(TAG, "[trace] unable to update header");
+
+    storage_file_close(trace->file);
+}
+
+/* Write out everything in the ring, lock must be held. If the SD card won't
+ * take it, the trace is closed where it is and everything from here on is
+ * dropped.
+ */
+static void trade_trace_flush_locked(struct trade_trace* trace) {
+    unsigned int head = atomic_load_explicit(&trace->head, memory_order_acquire);
+    unsigned int tail = atomic_load_explicit(&trace->tail, memory_order_relaxed);
+    size_t len;
+
+    /* Closed after a failed write, anything the ISR got in since is lost */
+    if(!storage_file_is_open(trace->file)) {
+        atomic_fetch_add(&trace->dropped, head - tail);
+        atomic_store_explicit(&trace->tail, head, memory_order_release);
+        return;
+    }
+
+    /* At most two writes, up to the end of the ring and then from the start */
+    while(tail != head) {
+        len = head - tail;
+        if(len > TRADE_TRACE_RING_SZ - (tail & TRADE_TRACE_RING_MASK))
+            len = TRADE_TRACE_RING_SZ - (tail & TRADE_TRACE_RING_MASK);
+        len *= sizeof(struct trade_trace_rec);
+
+        if(storage_file_write(
+               trace->file, &trace->ring[tail & TRADE_TRACE_RING_MASK], len) != len) {
+            FURI_LOG_E(TAG, "[trace] write failed, stopping the trace");
+            atomic_fetch_add(&trace->dropped, head - tail);
+            atomic_store_explicit(&trace->tail, head, memory_order_release);
+            trade_trace_close(trace);
+            return;
+        }
+
+        tail += len / sizeof(struct trade_trace_rec);
+        atomic_store_explicit(&trace->tail, tail, memory_order_release);
+    }
+}
+
+static int32_t trade_trace_thread(void* context) {
+    struct trade_trace* trace = context;
+    uint32_t flags = 0;
+
+    while(!(flags & TRACE_FLAG_EXIT)) {
+        flags = furi_thread_flags_wait(
+            TRACE_FLAG_FLUSH | TRACE_FLAG_EXIT,
+            FuriFlagWaitAny,
+            furi_ms_to_ticks(TRADE_TRACE_FLUSH_MS));
+        /* A timeout is a flush on schedule */
+        if(flags & FuriFlagError) flags = 0;
+
+        furi_check(furi_mutex_acquire(trace->lock, FuriWaitForever) == FuriStatusOk);
+        trade_trace_flush_locked(trace);
+        furi_check(furi_mutex_release(trace->lock) == FuriStatusOk);
+    }
+
+    FURI_LOG_D(
+        TAG,
+        "[trace] %lu bytes of stack spare",
+        furi_thread_get_stack_space(furi_thread_get_current_id()));
+
+    return 0;
+}
+
+struct trade_trace* trade_trace_start(
+    PokemonData* pdata,
+    uint8_t gameboy_status,
+    uint8_t trade_centre_state,
+    uint8_t queue_mode,
+    uint8_t queue_slot) {
+    furi_assert(pdata);
+    struct trade_trace* trace = NULL;
+    struct trade_trace_hdr hdr = {0};
+    FuriString* path;
+    bool ok = false;
+
+    trace = malloc(sizeof(struct trade_trace));
+    memset(trace, '\0', sizeof(struct trade_trace));
+    atomic_init(&trace->head, 0);
+    atomic_init(&trace->tail, 0);
+    atomic_init(&trace->dropped, 0);
+    trace->lock = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    trace->storage = furi_record_open(RECORD_STORAGE);
+    trace->file = storage_file_alloc(trace->storage);
+    storage_simply_mkdir(trace->storage, TRADE_TRACE_DIR);
+
+    path = furi_string_alloc_printf(
+        "%s/link_%lu.pktr", TRADE_TRACE_DIR, furi_hal_rtc_get_timestamp());
+
+    memcpy(hdr.magic, TRADE_TRACE_MAGIC, sizeof(hdr.magic));
+    hdr.version = TRADE_TRACE_VERSION;
+    hdr.gen = pdata->gen;
+    hdr.gameboy_status = gameboy_status;
+    hdr.trade_centre_state = trade_centre_state;
+    hdr.queue_mode = queue_mode;
+    hdr.queue_slot = queue_slot;
+    hdr.trade_block_sz = pdata->trade_block_sz;
+    hdr.rec_sz = sizeof(struct trade_trace_rec);
+    hdr.cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    if(storage_file_open(
+           trace->file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        ok = (storage_file_write(trace->file, &hdr, sizeof(hdr)) == sizeof(hdr)) &&
+             (storage_file_write(trace->file, pdata->trade_block, pdata->trade_block_sz) ==
+              pdata->trade_block_sz) &&
+             (!pdata->mail ||
+              storage_file_write(trace->file, pdata->mail, LEN_MAIL_BLOCK) == LEN_MAIL_BLOCK);
+    }
+
+    if(ok) {
+        FURI_LOG_D(TAG, "[trace] capturing to %s", furi_string_get_cstr(path));
+        trace->thread =
+            furi_thread_alloc_ex("PokemonTrace", TRACE_STACK_SZ, trade_trace_thread, trace);
+        furi_thread_start(trace->thread);
+    } else {
+        FURI_LOG_E(TAG, "[trace] unable to create %s", furi_string_get_cstr(path));
+        storage_file_close(trace->file);
+        storage_file_free(trace->file);
+        furi_record_close(RECORD_STORAGE);
+        furi_mutex_free(trace->lock);
+        free(trace);
+        trace = NULL;
+    }
+
+    furi_string_free(path);
+
+    return trace;
+}
+
+void trade_trace_record(
+    struct trade_trace* trace,
+    uint8_t rx,
+    uint8_t tx,
+    uint8_t trade_centre_state,
+    uint8_t gameboy_status) {
+    unsigned int head = atomic_load_explicit(&trace->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+    struct trade_trace_rec* rec;
+
+    /* A gap in the middle would replay as a divergence, so once one record is
+     * lost, so is the rest of the session.
+     */
+    if(atomic_load_explicit(&trace->dropped, memory_order_relaxed) ||
+       head - tail == TRADE_TRACE_RING_SZ) {
+        atomic_fetch_add_explicit(&trace->dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    rec = &trace->ring[head & TRADE_TRACE_RING_MASK];
+    rec->cycles = DWT->CYCCNT;
+    rec->rx = rx;
+    rec->tx = tx;
+    rec->trade_centre_state = trade_centre_state;
+    rec->gameboy_status = gameboy_status;
+
+    atomic_store_explicit(&trace->head, head + 1, memory_order_release);
+
+    /* Get the worker going early rather than wait for its next flush */
+    if(head + 1 - tail == TRADE_TRACE_RING_SZ / 2)
+        furi_thread_flags_set(furi_thread_get_id(trace->thread), TRACE_FLAG_FLUSH);
+}
+
+void trade_trace_flush(struct trade_trace* trace) {
+    furi_assert(trace);
+
+    furi_check(furi_mutex_acquire(trace->lock, FuriWaitForever) == FuriStatusOk);
+    trade_trace_flush_locked(trace);
+    furi_check(furi_mutex_release(trace->lock) == FuriStatusOk);
+}
+
+void trade_trace_stop(struct trade_trace* trace) {
+    furi_assert(trace);
+
+    furi_thread_flags_set(furi_thread_get_id(trace->thread), TRACE_FLAG_EXIT);
+    furi_thread_join(trace->thread);
+    furi_thread_free(trace->thread);
+
+    /* The worker's last flush may have come before the link was stopped */
+    furi_check(furi_mutex_acquire(trace->lock, FuriWaitForever) == FuriStatusOk);
+    trade_trace_flush_locked(trace);
+    if(storage_file_is_open(trace->file)) trade_trace_close(trace);
+    furi_check(furi_mutex_release(trace->lock) == FuriStatusOk);
+
+    storage_file_free(trace->file);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(trace->lock);
+    free(trace);
+}
+
+/* Too big for the stack of the view callbacks that replay runs from */
+struct trade_trace_replay_buf {
+    struct trade_trace_rec rec[TRADE_TRACE_REPLAY_CHUNK];
+    uint8_t trade_block[WIRE_TRADE_BLOCK_MAX_SZ];
+    uint8_t mail[LEN_MAIL_BLOCK];
+};
+
+bool trade_trace_replay(const char* path) {
+    furi_assert(path);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    struct trade_trace_replay_buf* buf = malloc(sizeof(struct trade_trace_replay_buf));
+    struct trade_trace_rec* rec = buf->rec;
+    struct trade_trace_hdr hdr;
+    struct trade_ctx* trade = NULL;
+    size_t count = 0;
+    size_t len;
+    size_t i;
+    uint8_t tx;
+    bool diverged = false;
+    bool ret = false;
+
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        FURI_LOG_E(TAG, "[trace] unable to open %s", path);
+        goto out;
+    }
+
+    if(storage_file_read(file, &hdr, sizeof(hdr)) != sizeof(hdr) ||
+       memcmp(hdr.magic, TRADE_TRACE_MAGIC, sizeof(hdr.magic)) ||
+       hdr.version != TRADE_TRACE_VERSION || hdr.rec_sz != sizeof(struct trade_trace_rec) ||
+       (hdr.gen != GEN_I && hdr.gen != GEN_II) || hdr.queue_mode >= TRADE_QUEUE_COUNT) {
+        FURI_LOG_E(TAG, "[trace] %s is not a trace", path);
+        goto out;
+    }
+
+    if(hdr.dropped) {
+        FURI_LOG_W(
+            TAG, "[trace] %lu records were dropped, replaying up to where it stops", hdr.dropped);
+    }
+
+    /* Restore the Flipper's trade block from the start of the capture */
+    if(hdr.trade_block_sz !=
+           ((hdr.gen == GEN_I) ? TRADE_BLOCK_SZ_GEN_I : TRADE_BLOCK_SZ_GEN_II) ||
+       storage_file_read(file, buf->trade_block, hdr.trade_block_sz) != hdr.trade_block_sz) {
+        FURI_LOG_E(TAG, "[trace] bad trade_block");
+        goto out;
+    }
+
+    if(hdr.gen == GEN_II &&
+       storage_file_read(file, buf->mail, sizeof(buf->mail)) != sizeof(buf->mail)) {
+        FURI_LOG_E(TAG, "[trace] bad mail");
+        goto out;
+    }
+
+    trade = trade_headless_alloc(
+        hdr.gen,
+        buf->trade_block,
+        (hdr.gen == GEN_II) ? buf->mail : NULL,
+        hdr.gameboy_status,
+        hdr.trade_centre_state);
+    if(hdr.queue_mode != TRADE_QUEUE_OFF)
+        trade_headless_queue_set(trade, hdr.queue_mode, hdr.queue_slot);
+
+    while(!diverged) {
+        len = storage_file_read(file, rec, sizeof(buf->rec)) / sizeof(struct trade_trace_rec);
+        if(len == 0) break;
+
+        for(i = 0; i < len; i++, count++) {
+            tx = trade_link_byte(trade, rec[i].rx);
+            if(tx != rec[i].tx || trade->centre.state != rec[i].trade_centre_state ||
+               trade_status_get(trade) != rec[i].gameboy_status) {
+                FURI_LOG_E(
+                    TAG,
+                    "[trace] diverged at record %d, rx 0x%02X: tx 0x%02X/0x%02X, "
+                    "state %d/%d, status %d/%d (recorded/replayed)",
+                    count,
+                    rec[i].rx,
+                    rec[i].tx,
+                    tx,
+                    rec[i].trade_centre_state,
+                    trade->centre.state,
+                    rec[i].gameboy_status,
+                    trade_status_get(trade));
+                diverged = true;
+                break;
+            }
+        }
+    }
+
+    if(!diverged) {
+        FURI_LOG_I(TAG, "[trace] %d records replayed with no divergence", count);
+        ret = true;
+    }
+
+    trade_headless_free(trade);
+
+out:
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    free(buf);
+
+    return ret;
+}
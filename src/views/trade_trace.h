@@ -0,0 +1,114 @@
+#ifndef TRADE_TRACE_H
+#define TRADE_TRACE_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <src/include/pokemon_data.h>
+
+/* Link session traces, for reproducing trade problems away from the Game Boy
+ * that caused them.
+ *
+ * When the Flipper is in debug mode (Settings > System > Debug), every byte
+ * exchanged while the trade view is open is recorded to a new trace file in
+ * TRADE_TRACE_DIR. The link ISR only writes to a preallocated RAM ring, the
+ * ring is flushed to the SD card by a worker thread, every
+ * TRADE_TRACE_FLUSH_MS or sooner once the ring is half full, and when the
+ * view exits.
+ *
+ * A trace file is a struct trade_trace_hdr, followed by the Flipper's full
+ * trade_block at the start of the session, and in Gen II its mail block,
+ * followed by one struct trade_trace_rec for each byte exchanged. All values
+ * are little endian.
+ *
+ * If the ring ever fills, or a write to the SD card fails, recording stops
+ * for the rest of the session rather than leaving a gap in the middle of the
+ * file. The trace is then a whole prefix of the session, and the header says
+ * how many records were left out at the end.
+ *
+ * Replaying a trace runs every received byte back through the trade protocol
+ * handler, starting from the same trade_block, mail, and state, and checks that the
+ * same bytes are sent and the same state transitions happen.
+ */
+
+#define TRADE_TRACE_DIR APP_DATA_PATH("traces")
+#define TRADE_TRACE_MAGIC "PKTR"
+#define TRADE_TRACE_VERSION 5
+
+/* Longest the ring waits to be written out */
+#define TRADE_TRACE_FLUSH_MS 50
+
+struct trade_trace_hdr {
+    char magic[4];
+    uint8_t version;
+    uint8_t gen;
+    /* State of the trade view when capture started */
+    uint8_t gameboy_status;
+    uint8_t trade_centre_state;
+    /* Trade queue mode and slot of the session, see TradeQueueMode */
+    uint8_t queue_mode;
+    uint8_t queue_slot;
+    uint16_t trade_block_sz;
+    uint16_t rec_sz;
+    /* Timestamps are the raw CPU cycle counter, this converts them to us */
+    uint32_t cycles_per_us;
+    /* Records missing from the end of the file, written when the trace is
+     * closed. Anything but 0 means the session went on past the last record.
+     */
+    uint32_t dropped;
+} __attribute__((packed));
+
+struct trade_trace_rec {
+    /* Low 32 bits of the cycle counter. Only the difference between records
+     * is meaningful, it wraps roughly every minute.
+     */
+    uint32_t cycles;
+    uint8_t rx;
+    uint8_t tx;
+    /* States after this byte was handled */
+    uint8_t trade_centre_state;
+    uint8_t gameboy_status;
+} __attribute__((packed));
+
+struct trade_trace;
+
+/* Allocate the ring, open a new trace file, and start the worker that writes
+ * to it. Returns NULL if the file could not be created. Must not be called
+ * from an ISR.
+ */
+struct trade_trace* trade_trace_start(
+    PokemonData* pdata,
+    uint8_t gameboy_status,
+    uint8_t trade_centre_state,
+    uint8_t queue_mode,
+    uint8_t queue_slot);
+
+/* Record one exchanged byte. Safe to call from an ISR. If the ring is full,
+ * this and every later record is dropped and counted.
+ */
+void trade_trace_record(
+    struct trade_trace* trace,
+    uint8_t rx,
+    uint8_t tx,
+    uint8_t trade_centre_state,
+    uint8_t gameboy_status);
+
+/* Write everything in the ring out to the trace file now, rather than waiting
+ * for the worker. Must not be called from an ISR.
+ */
+void trade_trace_flush(struct trade_trace* trace);
+
+/* Stop the worker, flush, write the header's dropped count, close the trace
+ * file, and free the ring. The link must already be stopped.
+ */
+void trade_trace_stop(struct trade_trace* trace);
+
+/* Replay the trace file at path. Returns true if every record matched, the
+ * first divergence is logged. A trace that stopped short of the end of its
+ * session is replayed as far as it goes.
+ */
+bool trade_trace_replay(const char* path);
+
+#endif /* TRADE_TRACE_H */
@@ -0,0 +1,99 @@
+#include <src/include/pokemon_app.h>
+#include <src/include/wire_image.h>
+
+struct wire_image* wire_image_alloc(void) {
+    struct wire_image* image = NULL;
+
+    image = malloc(sizeof(struct wire_image));
+    memset(image, '\0', sizeof(struct wire_image));
+
+    return image;
+}
+
+void wire_image_free(struct wire_image* image) {
+    free(image);
+}
+
+/* Every metadata byte could need a patch, and there is still the terminator */
+_Static_assert(
+    (PARTY_CNT_MAX * LEN_MAIL_META) < WIRE_MAIL_PATCH_SZ,
+    "Mail patch list does not fit");
+
+/* Copy mail to tx, followed by its patch list */
+static void wire_image_mail_build(uint8_t* tx, const MailBlockGenII* mail) {
+    const uint8_t* src = (const uint8_t*)mail;
+    uint8_t* patch = &tx[LEN_MAIL_BLOCK];
+    size_t meta_offs = PARTY_CNT_MAX * LEN_MAIL_MSG;
+    size_t i;
+
+    memcpy(tx, src, LEN_MAIL_BLOCK);
+    for(i = 0; i < LEN_MAIL_BLOCK; i++) {
+        if(src[i] != SERIAL_NO_DATA_BYTE) continue;
+        if(i < meta_offs) {
+            tx[i] = SERIAL_MAIL_REPLACEMENT_BYTE;
+        } else {
+            tx[i] = 0xFF;
+            *patch++ = i - meta_offs + 1;
+        }
+    }
+    *patch = SERIAL_PATCH_LIST_PART_TERMINATOR;
+}
+
+void wire_image_build(struct wire_image* image, PokemonData* pdata, struct patch_list* plist) {
+    furi_assert(image);
+    furi_assert(pdata);
+    furi_assert(plist);
+    furi_check(pdata->trade_block_sz <= WIRE_TRADE_BLOCK_MAX_SZ);
+    uint8_t* party;
+    size_t part_offs;
+    uint8_t idx;
+    size_t i;
+
+    image->data_offs = WIRE_RANDOM_SZ;
+    image->patch_offs = image->data_offs + pdata->trade_block_sz;
+    image->mail_offs = image->patch_offs + WIRE_PATCH_SZ;
+    image->len = image->mail_offs;
+    if(pdata->gen == GEN_II) image->len += WIRE_MAIL_SZ;
+
+    memset(image->tx, 0x00, image->len);
+    memset(image->echo, 0x00, image->len);
+
+    /* RANDOM, all echoed */
+    memset(image->echo, 0xFF, WIRE_RANDOM_SZ);
+
+    /* DATA, the trade block. Any party bytes that are 0xFE are sent as 0xFF,
+     * the patch list tells the other side which bytes to restore. The live
+     * party data itself is left untouched.
+     */
+    memcpy(&image->tx[image->data_offs], pdata->trade_block, pdata->trade_block_sz);
+    party = &image->tx[image->data_offs + ((uint8_t*)pdata->party - (uint8_t*)pdata->trade_block)];
+    part_offs = 0;
+    for(i = 0; i < PLIST_MAX_SZ; i++) {
+        idx = plist_index_get(plist, i);
+        /* Reading past the end of the list returns 0 */
+        if(idx == 0) break;
+        if(idx == 0xFF) {
+            part_offs += 0xFC;
+            continue;
+        }
+        party[part_offs + idx - 1] = 0xFF;
+    }
+
+    /* PATCH, the tail end of the header is echoed and then the patch list
+     * follows. Anything beyond the end of the patch list is 0x00.
+     */
+    memset(&image->echo[image->patch_offs], 0xFF, WIRE_PATCH_ECHO_SZ);
+    for(i = WIRE_PATCH_ECHO_SZ; i < WIRE_PATCH_SZ; i++) {
+        image->tx[image->patch_offs + i] = plist_index_get(plist, i - WIRE_PATCH_ECHO_SZ);
+    }
+
+    /* MAIL, the preamble is echoed, see the layout in wire_image.h */
+    if(pdata->mail) {
+        memset(&image->echo[image->mail_offs], 0xFF, WIRE_MAIL_PREAMBLE_SZ);
+        wire_image_mail_build(&image->tx[image->mail_offs + WIRE_MAIL_PREAMBLE_SZ], pdata->mail);
+    }
+
+    wire_image_rewind(image);
+
+    FURI_LOG_D(TAG, "[wire] built %d byte image", image->len);
+}
@@ -0,0 +1,388 @@
+/* The furi core on top of pthreads, for the host build. See
+ * tests/shim/include/furi.h.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <shim.h>
+
+/* Flag returned by furi_thread_flags_wait() when it times out */
+#define SHIM_FLAG_ERROR_TIMEOUT 0xFFFFFFFEU
+
+struct FuriString {
+    char* str;
+};
+
+struct FuriMutex {
+    pthread_mutex_t mutex;
+};
+
+struct FuriThread {
+    FuriThreadCallback callback;
+    void* context;
+    pthread_t pthread;
+    bool started;
+
+    /* Protects flags, cond is signalled each time they are set */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t flags;
+};
+
+struct FuriTimer {
+    FuriTimerCallback callback;
+    void* context;
+    bool running;
+};
+
+DWT_Type shim_dwt;
+
+/* The thread the caller runs in, the main thread gets one when first needed */
+static __thread FuriThread* shim_thread_current;
+
+void shim_crash(const char* file, int line, const char* msg) {
+    fprintf(stderr, "%s:%d: furi_check failed: %s\n", file, line, msg ? msg : "crash");
+    fflush(stderr);
+    abort();
+}
+
+/* SHIM_LOG picks the most verbose level shown, one of E, W, I, or D */
+void shim_log(char level, const char* tag, const char* fmt, ...) {
+    static const char levels[] = "EWID";
+    const char* max = getenv("SHIM_LOG");
+    va_list args;
+
+    if(strchr(levels, level) > strchr(levels, (max && *max) ? *max : 'I')) return;
+
+    fprintf(stderr, "%c [%s] ", level, tag);
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+uint32_t furi_get_tick(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+}
+
+uint32_t furi_ms_to_ticks(uint32_t ms) {
+    return ms;
+}
+
+void furi_delay_ms(uint32_t ms) {
+    struct timespec delay = {.tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L};
+
+    nanosleep(&delay, NULL);
+}
+
+void* furi_record_open(const char* name) {
+    static char record;
+
+    UNUSED(name);
+    return &record;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+FuriString* furi_string_alloc(void) {
+    return furi_string_alloc_set_str("");
+}
+
+FuriString* furi_string_alloc_set_str(const char* str) {
+    FuriString* string = malloc(sizeof(FuriString));
+
+    furi_check(string);
+    string->str = strdup(str);
+    furi_check(string->str);
+    return string;
+}
+
+FuriString* furi_string_alloc_set_string(const FuriString* source) {
+    return furi_string_alloc_set_str(source->str);
+}
+
+FuriString* furi_string_alloc_printf(const char* fmt, ...) {
+    FuriString* string = malloc(sizeof(FuriString));
+    va_list args;
+
+    furi_check(string);
+    va_start(args, fmt);
+    furi_check(vasprintf(&string->str, fmt, args) >= 0);
+    va_end(args);
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    free(string->str);
+    free(string);
+}
+
+void furi_string_set_str(FuriString* string, const char* str) {
+    char* copy = strdup(str);
+
+    furi_check(copy);
+    free(string->str);
+    string->str = copy;
+}
+
+void furi_string_set_string(FuriString* string, const FuriString* source) {
+    furi_string_set_str(string, source->str);
+}
+
+void furi_string_printf(FuriString* string, const char* fmt, ...) {
+    va_list args;
+
+    free(string->str);
+    va_start(args, fmt);
+    furi_check(vasprintf(&string->str, fmt, args) >= 0);
+    va_end(args);
+}
+
+void furi_string_cat_printf(FuriString* string, const char* fmt, ...) {
+    char* tail;
+    char* cat;
+    va_list args;
+
+    va_start(args, fmt);
+    furi_check(vasprintf(&tail, fmt, args) >= 0);
+    va_end(args);
+    furi_check(asprintf(&cat, "%s%s", string->str, tail) >= 0);
+    free(tail);
+    free(string->str);
+    string->str = cat;
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->str;
+}
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    FuriMutex* mutex = malloc(sizeof(FuriMutex));
+    pthread_mutexattr_t attr;
+
+    furi_check(mutex);
+    pthread_mutexattr_init(&attr);
+    if(type == FuriMutexTypeRecursive) pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    furi_check(pthread_mutex_init(&mutex->mutex, &attr) == 0);
+    pthread_mutexattr_destroy(&attr);
+    return mutex;
+}
+
+void furi_mutex_free(FuriMutex* mutex) {
+    furi_check(pthread_mutex_destroy(&mutex->mutex) == 0);
+    free(mutex);
+}
+
+/* Absolute CLOCK_REALTIME deadline timeout ticks from now */
+static struct timespec shim_deadline(uint32_t timeout) {
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (timeout % 1000) * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* mutex, uint32_t timeout) {
+    struct timespec deadline;
+    int ret;
+
+    if(timeout == FuriWaitForever) {
+        ret = pthread_mutex_lock(&mutex->mutex);
+    } else if(timeout == 0) {
+        ret = pthread_mutex_trylock(&mutex->mutex);
+    } else {
+        deadline = shim_deadline(timeout);
+        ret = pthread_mutex_timedlock(&mutex->mutex, &deadline);
+    }
+
+    if(ret == 0) return FuriStatusOk;
+    furi_check(ret == EBUSY || ret == ETIMEDOUT);
+    return FuriStatusErrorTimeout;
+}
+
+FuriStatus furi_mutex_release(FuriMutex* mutex) {
+    return (pthread_mutex_unlock(&mutex->mutex) == 0) ? FuriStatusOk : FuriStatusError;
+}
+
+static FuriThread* shim_thread_alloc(FuriThreadCallback callback, void* context) {
+    FuriThread* thread = malloc(sizeof(FuriThread));
+
+    furi_check(thread);
+    thread->callback = callback;
+    thread->context = context;
+    furi_check(pthread_mutex_init(&thread->lock, NULL) == 0);
+    furi_check(pthread_cond_init(&thread->cond, NULL) == 0);
+    return thread;
+}
+
+static FuriThread* shim_thread_self(void) {
+    if(!shim_thread_current) shim_thread_current = shim_thread_alloc(NULL, NULL);
+    return shim_thread_current;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    UNUSED(name);
+    UNUSED(stack_size);
+    return shim_thread_alloc(callback, context);
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_check(!thread->started);
+    pthread_cond_destroy(&thread->cond);
+    pthread_mutex_destroy(&thread->lock);
+    free(thread);
+}
+
+static void* shim_thread_run(void* context) {
+    FuriThread* thread = context;
+
+    shim_thread_current = thread;
+    thread->callback(thread->context);
+    return NULL;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_check(!thread->started);
+    furi_check(pthread_create(&thread->pthread, NULL, shim_thread_run, thread) == 0);
+    thread->started = true;
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    if(thread->started) {
+        furi_check(pthread_join(thread->pthread, NULL) == 0);
+        thread->started = false;
+    }
+    return true;
+}
+
+FuriThreadId furi_thread_get_id(FuriThread* thread) {
+    return thread;
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    return shim_thread_self();
+}
+
+/* There is no fixed size stack to measure on the host */
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return 0;
+}
+
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
+    FuriThread* thread = thread_id;
+    uint32_t ret;
+
+    pthread_mutex_lock(&thread->lock);
+    thread->flags |= flags;
+    ret = thread->flags;
+    pthread_cond_broadcast(&thread->cond);
+    pthread_mutex_unlock(&thread->lock);
+    return ret;
+}
+
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    FuriThread* thread = shim_thread_self();
+    struct timespec deadline = shim_deadline(timeout);
+    uint32_t ret;
+    bool done;
+
+    pthread_mutex_lock(&thread->lock);
+    while(1) {
+        if(options & FuriFlagWaitAll)
+            done = ((thread->flags & flags) == flags);
+        else
+            done = (thread->flags & flags);
+        if(done) break;
+
+        if(timeout == FuriWaitForever) {
+            pthread_cond_wait(&thread->cond, &thread->lock);
+        } else if(
+            timeout == 0 ||
+            pthread_cond_timedwait(&thread->cond, &thread->lock, &deadline) == ETIMEDOUT) {
+            pthread_mutex_unlock(&thread->lock);
+            return SHIM_FLAG_ERROR_TIMEOUT;
+        }
+    }
+    ret = thread->flags;
+    if(!(options & FuriFlagNoClear)) thread->flags &= ~flags;
+    pthread_mutex_unlock(&thread->lock);
+
+    return ret;
+}
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* context) {
+    FuriTimer* timer = malloc(sizeof(FuriTimer));
+
+    UNUSED(type);
+    furi_check(timer);
+    timer->callback = func;
+    timer->context = context;
+    return timer;
+}
+
+void furi_timer_free(FuriTimer* timer) {
+    free(timer);
+}
+
+FuriStatus furi_timer_start(FuriTimer* timer, uint32_t ticks) {
+    UNUSED(ticks);
+    timer->running = true;
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_stop(FuriTimer* timer) {
+    timer->running = false;
+    return FuriStatusOk;
+}
+
+FuriStatus
+    furi_timer_pending_callback(FuriTimerPendigCallback callback, void* context, uint32_t arg) {
+    callback(context, arg);
+    return FuriStatusOk;
+}
+
+void shim_timer_fire(FuriTimer* timer) {
+    furi_check(timer->running);
+    timer->callback(timer->context);
+}
+
+void furi_hal_gpio_init_simple(const GpioPin* gpio, GpioMode mode) {
+    UNUSED(gpio);
+    UNUSED(mode);
+}
+
+void furi_hal_light_set(Light light, uint8_t value) {
+    UNUSED(light);
+    UNUSED(value);
+}
+
+bool furi_hal_rtc_is_flag_set(FuriHalRtcFlag flag) {
+    return flag == FuriHalRtcFlagDebug;
+}
+
+uint32_t furi_hal_rtc_get_timestamp(void) {
+    return SHIM_RTC_TIMESTAMP;
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return 64;
+}
@@ -0,0 +1,245 @@
+/* Views, and the rest of the firmware services the app only calls in to,
+ * for the host build. Nothing is ever drawn, lit, or sent.
+ */
+
+#include <furi.h>
+#include <dolphin/dolphin.h>
+#include <gblink/include/gblink.h>
+#include <gui/elements.h>
+#include <gui/view_dispatcher.h>
+#include <notification/notification_messages.h>
+#include <pokemon_icons.h>
+#include <shim.h>
+
+/* Enough for every view the app allocates */
+#define SHIM_VIEWS_MAX 8
+
+struct Canvas {
+    uint8_t unused;
+};
+
+struct Icon {
+    uint8_t unused;
+};
+
+struct NotificationSequence {
+    uint8_t unused;
+};
+
+struct View {
+    void* context;
+    void* model;
+    ViewDrawCallback draw_callback;
+    ViewInputCallback input_callback;
+    ViewCallback enter_callback;
+    ViewCallback exit_callback;
+};
+
+struct ViewDispatcher {
+    View* views[SHIM_VIEWS_MAX];
+};
+
+const Icon I_Background_128x11;
+const Icon I_dolphin;
+const Icon I_game_boy;
+const Icon I_gb_step_1;
+const Icon I_gb_step_2;
+const Icon I_hand_cable;
+const Icon I_hand_thumbsup;
+const Icon I_red_16x15;
+const Icon I_surprised_pika;
+
+const NotificationSequence sequence_display_backlight_on;
+
+View* view_alloc(void) {
+    View* view = malloc(sizeof(View));
+
+    furi_check(view);
+    return view;
+}
+
+void view_free(View* view) {
+    free(view->model);
+    free(view);
+}
+
+void view_set_context(View* view, void* context) {
+    view->context = context;
+}
+
+void view_set_draw_callback(View* view, ViewDrawCallback callback) {
+    view->draw_callback = callback;
+}
+
+void view_set_input_callback(View* view, ViewInputCallback callback) {
+    view->input_callback = callback;
+}
+
+void view_set_enter_callback(View* view, ViewCallback callback) {
+    view->enter_callback = callback;
+}
+
+void view_set_exit_callback(View* view, ViewCallback callback) {
+    view->exit_callback = callback;
+}
+
+void view_allocate_model(View* view, ViewModelType type, size_t size) {
+    UNUSED(type);
+    furi_check(!view->model);
+    view->model = malloc(size);
+    furi_check(view->model);
+}
+
+void* view_get_model(View* view) {
+    return view->model;
+}
+
+void view_commit_model(View* view, bool update) {
+    UNUSED(view);
+    UNUSED(update);
+}
+
+ViewDispatcher* view_dispatcher_alloc(void) {
+    ViewDispatcher* view_dispatcher = malloc(sizeof(ViewDispatcher));
+
+    furi_check(view_dispatcher);
+    return view_dispatcher;
+}
+
+void view_dispatcher_free(ViewDispatcher* view_dispatcher) {
+    free(view_dispatcher);
+}
+
+void view_dispatcher_add_view(ViewDispatcher* view_dispatcher, uint32_t view_id, View* view) {
+    furi_check(view_id < SHIM_VIEWS_MAX && !view_dispatcher->views[view_id]);
+    view_dispatcher->views[view_id] = view;
+}
+
+void view_dispatcher_remove_view(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    furi_check(view_id < SHIM_VIEWS_MAX && view_dispatcher->views[view_id]);
+    view_dispatcher->views[view_id] = NULL;
+}
+
+static View* shim_view_get(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    furi_check(view_id < SHIM_VIEWS_MAX && view_dispatcher->views[view_id]);
+    return view_dispatcher->views[view_id];
+}
+
+void shim_view_enter(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    View* view = shim_view_get(view_dispatcher, view_id);
+
+    if(view->enter_callback) view->enter_callback(view->context);
+}
+
+void shim_view_draw(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    View* view = shim_view_get(view_dispatcher, view_id);
+    Canvas canvas = {0};
+
+    if(view->draw_callback) view->draw_callback(&canvas, view->model);
+}
+
+void shim_view_exit(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    View* view = shim_view_get(view_dispatcher, view_id);
+
+    if(view->exit_callback) view->exit_callback(view->context);
+}
+
+void canvas_clear(Canvas* canvas) {
+    UNUSED(canvas);
+}
+
+void canvas_set_color(Canvas* canvas, Color color) {
+    UNUSED(canvas);
+    UNUSED(color);
+}
+
+void canvas_set_font(Canvas* canvas, Font font) {
+    UNUSED(canvas);
+    UNUSED(font);
+}
+
+void canvas_set_bitmap_mode(Canvas* canvas, bool alpha) {
+    UNUSED(canvas);
+    UNUSED(alpha);
+}
+
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    furi_check(str);
+}
+
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(width);
+    UNUSED(height);
+}
+
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    furi_check(icon);
+}
+
+void canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(width);
+    UNUSED(height);
+    furi_check(bitmap);
+}
+
+void elements_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(width);
+    UNUSED(height);
+}
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence) {
+    UNUSED(app);
+    UNUSED(sequence);
+}
+
+void dolphin_deed(DolphinDeed deed) {
+    UNUSED(deed);
+}
+
+void gblink_callback_set(
+    void* handle,
+    void (*callback)(void* cb_context, uint8_t in),
+    void* cb_context) {
+    UNUSED(handle);
+    UNUSED(callback);
+    UNUSED(cb_context);
+}
+
+void gblink_nobyte_set(void* handle, uint8_t val) {
+    UNUSED(handle);
+    UNUSED(val);
+}
+
+void gblink_start(void* handle) {
+    UNUSED(handle);
+}
+
+void gblink_stop(void* handle) {
+    UNUSED(handle);
+}
+
+void gblink_transfer(void* handle, uint8_t val) {
+    UNUSED(handle);
+    UNUSED(val);
+}
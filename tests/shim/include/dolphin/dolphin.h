@@ -0,0 +1,14 @@
+#ifndef SHIM_DOLPHIN_H
+#define SHIM_DOLPHIN_H
+
+#pragma once
+
+#include <furi.h>
+
+typedef enum {
+    DolphinDeedPluginGameWin,
+} DolphinDeed;
+
+void dolphin_deed(DolphinDeed deed);
+
+#endif /* SHIM_DOLPHIN_H */
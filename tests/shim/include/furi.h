@@ -0,0 +1,152 @@
+#ifndef SHIM_FURI_H
+#define SHIM_FURI_H
+
+#pragma once
+
+/* Just enough of the furi API for the app sources to build and run on a
+ * Linux host. See tests/shim/furi.c.
+ *
+ * furi_check() and furi_assert() are always on and abort with the failing
+ * expression, and logs go to stderr. malloc() is redefined to hand out zeroed
+ * memory, like furi's does, as the app relies on it.
+ */
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define malloc(x) calloc(1, (x))
+
+void shim_crash(const char* file, int line, const char* msg) __attribute__((noreturn));
+void shim_log(char level, const char* tag, const char* fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#define furi_crash(msg) shim_crash(__FILE__, __LINE__, (msg))
+#define furi_check(x)                                \
+    do {                                             \
+        if(!(x)) shim_crash(__FILE__, __LINE__, #x); \
+    } while(0)
+#define furi_assert(x) furi_check(x)
+
+#define FURI_LOG_E(tag, fmt, ...) shim_log('E', (tag), fmt, ##__VA_ARGS__)
+#define FURI_LOG_W(tag, fmt, ...) shim_log('W', (tag), fmt, ##__VA_ARGS__)
+#define FURI_LOG_I(tag, fmt, ...) shim_log('I', (tag), fmt, ##__VA_ARGS__)
+#define FURI_LOG_D(tag, fmt, ...) shim_log('D', (tag), fmt, ##__VA_ARGS__)
+
+#define UNUSED(x) (void)(x)
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+
+#define APP_ASSETS_PATH(path) "/ext/apps_assets/pokemon/" path
+#define APP_DATA_PATH(path) "/ext/apps_data/pokemon/" path
+
+typedef enum {
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+    FuriStatusErrorTimeout = -2,
+} FuriStatus;
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+/* Ticks are milliseconds */
+uint32_t furi_get_tick(void);
+uint32_t furi_ms_to_ticks(uint32_t ms);
+void furi_delay_ms(uint32_t ms);
+
+/* Records are opaque, and nothing looks inside them */
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
+
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+FuriString* furi_string_alloc_set_str(const char* str);
+FuriString* furi_string_alloc_set_string(const FuriString* source);
+FuriString* furi_string_alloc_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void furi_string_free(FuriString* string);
+void furi_string_set_str(FuriString* string, const char* str);
+void furi_string_set_string(FuriString* string, const FuriString* source);
+void furi_string_printf(FuriString* string, const char* fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+void furi_string_cat_printf(FuriString* string, const char* fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+const char* furi_string_get_cstr(const FuriString* string);
+
+/* Like furi, these take either a C string or a FuriString */
+#define furi_string_alloc_set(x)                     \
+    _Generic(                                        \
+        (x),                                         \
+        char*: furi_string_alloc_set_str,            \
+        const char*: furi_string_alloc_set_str,      \
+        FuriString*: furi_string_alloc_set_string,   \
+        const FuriString*: furi_string_alloc_set_string)(x)
+#define furi_string_set(s, x)                  \
+    _Generic(                                  \
+        (x),                                   \
+        char*: furi_string_set_str,            \
+        const char*: furi_string_set_str,      \
+        FuriString*: furi_string_set_string,   \
+        const FuriString*: furi_string_set_string)(s, x)
+
+typedef enum {
+    FuriMutexTypeNormal,
+    FuriMutexTypeRecursive,
+} FuriMutexType;
+
+typedef struct FuriMutex FuriMutex;
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type);
+void furi_mutex_free(FuriMutex* mutex);
+FuriStatus furi_mutex_acquire(FuriMutex* mutex, uint32_t timeout);
+FuriStatus furi_mutex_release(FuriMutex* mutex);
+
+typedef enum {
+    FuriFlagWaitAny = 0,
+    FuriFlagWaitAll = 1,
+    FuriFlagNoClear = 2,
+} FuriFlag;
+
+#define FuriFlagError 0x80000000U
+
+typedef struct FuriThread FuriThread;
+typedef void* FuriThreadId;
+typedef int32_t (*FuriThreadCallback)(void* context);
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context);
+void furi_thread_free(FuriThread* thread);
+void furi_thread_start(FuriThread* thread);
+bool furi_thread_join(FuriThread* thread);
+FuriThreadId furi_thread_get_id(FuriThread* thread);
+FuriThreadId furi_thread_get_current_id(void);
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags);
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+/* Timers never fire on their own, see shim_timer_fire(). Pending callbacks
+ * run immediately in the caller's thread.
+ */
+typedef enum {
+    FuriTimerTypeOnce,
+    FuriTimerTypePeriodic,
+} FuriTimerType;
+
+typedef struct FuriTimer FuriTimer;
+typedef void (*FuriTimerCallback)(void* context);
+typedef void (*FuriTimerPendigCallback)(void* context, uint32_t arg);
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* context);
+void furi_timer_free(FuriTimer* timer);
+FuriStatus furi_timer_start(FuriTimer* timer, uint32_t ticks);
+FuriStatus furi_timer_stop(FuriTimer* timer);
+FuriStatus
+    furi_timer_pending_callback(FuriTimerPendigCallback callback, void* context, uint32_t arg);
+
+#endif /* SHIM_FURI_H */
@@ -0,0 +1,48 @@
+#ifndef SHIM_FURI_HAL_H
+#define SHIM_FURI_HAL_H
+
+#pragma once
+
+/* The HAL calls made by the app. The RTC debug flag is always set so link
+ * traces get recorded, and the timestamp is fixed so their file names are
+ * known in advance. DWT->CYCCNT counts nothing.
+ */
+
+#include <furi.h>
+
+typedef struct GpioPin GpioPin;
+
+typedef enum {
+    GpioModeAnalog,
+} GpioMode;
+
+void furi_hal_gpio_init_simple(const GpioPin* gpio, GpioMode mode);
+
+typedef enum {
+    LightRed = (1 << 0),
+    LightGreen = (1 << 1),
+    LightBlue = (1 << 2),
+    LightBacklight = (1 << 3),
+} Light;
+
+void furi_hal_light_set(Light light, uint8_t value);
+
+typedef enum {
+    FuriHalRtcFlagDebug = (1 << 0),
+} FuriHalRtcFlag;
+
+#define SHIM_RTC_TIMESTAMP 1234
+
+bool furi_hal_rtc_is_flag_set(FuriHalRtcFlag flag);
+uint32_t furi_hal_rtc_get_timestamp(void);
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void);
+
+typedef struct {
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+extern DWT_Type shim_dwt;
+#define DWT (&shim_dwt)
+
+#endif /* SHIM_FURI_HAL_H */
@@ -0,0 +1,8 @@
+#ifndef SHIM_FURI_HAL_LIGHT_H
+#define SHIM_FURI_HAL_LIGHT_H
+
+#pragma once
+
+#include <furi_hal.h>
+
+#endif /* SHIM_FURI_HAL_LIGHT_H */
@@ -0,0 +1,8 @@
+#ifndef SHIM_GBLINK_ROOT_H
+#define SHIM_GBLINK_ROOT_H
+
+#pragma once
+
+#include <gblink/include/gblink.h>
+
+#endif /* SHIM_GBLINK_ROOT_H */
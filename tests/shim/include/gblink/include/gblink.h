@@ -0,0 +1,21 @@
+#ifndef SHIM_GBLINK_H
+#define SHIM_GBLINK_H
+
+#pragma once
+
+/* The link is never started on the host, bytes are fed to the app's
+ * callback directly, e.g. by trade_sim_run().
+ */
+
+#include <furi.h>
+
+void gblink_callback_set(
+    void* handle,
+    void (*callback)(void* cb_context, uint8_t in),
+    void* cb_context);
+void gblink_nobyte_set(void* handle, uint8_t val);
+void gblink_start(void* handle);
+void gblink_stop(void* handle);
+void gblink_transfer(void* handle, uint8_t val);
+
+#endif /* SHIM_GBLINK_H */
@@ -0,0 +1,10 @@
+#ifndef SHIM_GUI_ELEMENTS_H
+#define SHIM_GUI_ELEMENTS_H
+
+#pragma once
+
+#include <gui/view.h>
+
+void elements_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+
+#endif /* SHIM_GUI_ELEMENTS_H */
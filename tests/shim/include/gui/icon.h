@@ -0,0 +1,10 @@
+#ifndef SHIM_GUI_ICON_H
+#define SHIM_GUI_ICON_H
+
+#pragma once
+
+#include <furi.h>
+
+typedef struct Icon Icon;
+
+#endif /* SHIM_GUI_ICON_H */
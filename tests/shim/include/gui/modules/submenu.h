@@ -0,0 +1,11 @@
+#ifndef SHIM_GUI_MODULES_SUBMENU_H
+#define SHIM_GUI_MODULES_SUBMENU_H
+
+#pragma once
+
+#include <gui/view.h>
+
+/* Scenes are not part of the host build, only the type is needed */
+typedef struct Submenu Submenu;
+
+#endif /* SHIM_GUI_MODULES_SUBMENU_H */
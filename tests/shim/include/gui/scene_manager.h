@@ -0,0 +1,11 @@
+#ifndef SHIM_GUI_SCENE_MANAGER_H
+#define SHIM_GUI_SCENE_MANAGER_H
+
+#pragma once
+
+#include <furi.h>
+
+/* Scenes are not part of the host build, only the type is needed */
+typedef struct SceneManager SceneManager;
+
+#endif /* SHIM_GUI_SCENE_MANAGER_H */
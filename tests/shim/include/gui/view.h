@@ -0,0 +1,93 @@
+#ifndef SHIM_GUI_VIEW_H
+#define SHIM_GUI_VIEW_H
+
+#pragma once
+
+/* Views keep their model and callbacks so a test can drive them, see
+ * shim.h. Drawing does nothing.
+ */
+
+#include <furi.h>
+#include <gui/icon.h>
+
+typedef struct Canvas Canvas;
+
+typedef enum {
+    ColorWhite = 0x00,
+    ColorBlack = 0x01,
+    ColorXOR = 0x02,
+} Color;
+
+typedef enum {
+    FontPrimary,
+    FontSecondary,
+} Font;
+
+void canvas_clear(Canvas* canvas);
+void canvas_set_color(Canvas* canvas, Color color);
+void canvas_set_font(Canvas* canvas, Font font);
+void canvas_set_bitmap_mode(Canvas* canvas, bool alpha);
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str);
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon);
+void canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap);
+
+typedef enum {
+    InputKeyUp,
+    InputKeyDown,
+    InputKeyRight,
+    InputKeyLeft,
+    InputKeyOk,
+    InputKeyBack,
+} InputKey;
+
+typedef enum {
+    InputTypePress,
+    InputTypeRelease,
+    InputTypeShort,
+    InputTypeLong,
+    InputTypeRepeat,
+} InputType;
+
+typedef struct {
+    InputKey key;
+    InputType type;
+} InputEvent;
+
+typedef struct View View;
+
+typedef enum {
+    ViewModelTypeNone,
+    ViewModelTypeLockFree,
+    ViewModelTypeLocking,
+} ViewModelType;
+
+typedef void (*ViewDrawCallback)(Canvas* canvas, void* model);
+typedef bool (*ViewInputCallback)(InputEvent* event, void* context);
+typedef void (*ViewCallback)(void* context);
+
+View* view_alloc(void);
+void view_free(View* view);
+void view_set_context(View* view, void* context);
+void view_set_draw_callback(View* view, ViewDrawCallback callback);
+void view_set_input_callback(View* view, ViewInputCallback callback);
+void view_set_enter_callback(View* view, ViewCallback callback);
+void view_set_exit_callback(View* view, ViewCallback callback);
+void view_allocate_model(View* view, ViewModelType type, size_t size);
+void* view_get_model(View* view);
+void view_commit_model(View* view, bool update);
+
+#define with_view_model(view, type, code, update) \
+    {                                             \
+        type = view_get_model(view);              \
+        {code};                                   \
+        view_commit_model(view, update);          \
+    }
+
+#endif /* SHIM_GUI_VIEW_H */
@@ -0,0 +1,15 @@
+#ifndef SHIM_GUI_VIEW_DISPATCHER_H
+#define SHIM_GUI_VIEW_DISPATCHER_H
+
+#pragma once
+
+#include <gui/view.h>
+
+typedef struct ViewDispatcher ViewDispatcher;
+
+ViewDispatcher* view_dispatcher_alloc(void);
+void view_dispatcher_free(ViewDispatcher* view_dispatcher);
+void view_dispatcher_add_view(ViewDispatcher* view_dispatcher, uint32_t view_id, View* view);
+void view_dispatcher_remove_view(ViewDispatcher* view_dispatcher, uint32_t view_id);
+
+#endif /* SHIM_GUI_VIEW_DISPATCHER_H */
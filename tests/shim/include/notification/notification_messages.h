@@ -0,0 +1,17 @@
+#ifndef SHIM_NOTIFICATION_MESSAGES_H
+#define SHIM_NOTIFICATION_MESSAGES_H
+
+#pragma once
+
+#include <furi.h>
+
+#define RECORD_NOTIFICATION "notification"
+
+typedef struct NotificationApp NotificationApp;
+typedef struct NotificationSequence NotificationSequence;
+
+extern const NotificationSequence sequence_display_backlight_on;
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence);
+
+#endif /* SHIM_NOTIFICATION_MESSAGES_H */
@@ -0,0 +1,20 @@
+#ifndef SHIM_POKEMON_ICONS_H
+#define SHIM_POKEMON_ICONS_H
+
+#pragma once
+
+/* Stands in for the header fbt generates from assets/ */
+
+#include <gui/icon.h>
+
+extern const Icon I_Background_128x11;
+extern const Icon I_dolphin;
+extern const Icon I_game_boy;
+extern const Icon I_gb_step_1;
+extern const Icon I_gb_step_2;
+extern const Icon I_hand_cable;
+extern const Icon I_hand_thumbsup;
+extern const Icon I_red_16x15;
+extern const Icon I_surprised_pika;
+
+#endif /* SHIM_POKEMON_ICONS_H */
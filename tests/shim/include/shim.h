@@ -0,0 +1,27 @@
+#ifndef SHIM_H
+#define SHIM_H
+
+#pragma once
+
+/* Hooks for host tests to do what the Flipper firmware would otherwise do */
+
+#include <furi.h>
+#include <gui/view_dispatcher.h>
+
+/* Call the enter, draw, or exit callback of the view added with view_id */
+void shim_view_enter(ViewDispatcher* view_dispatcher, uint32_t view_id);
+void shim_view_draw(ViewDispatcher* view_dispatcher, uint32_t view_id);
+void shim_view_exit(ViewDispatcher* view_dispatcher, uint32_t view_id);
+
+/* Run the callback of a started timer once, in the caller's thread */
+void shim_timer_fire(FuriTimer* timer);
+
+/* Host directory that stands in for /ext, from SHIM_SD or "sd" */
+const char* shim_sd_root(void);
+
+/* While set, every storage_file_write() writes nothing, as if the SD card
+ * had gone away
+ */
+void shim_storage_write_fail(bool fail);
+
+#endif /* SHIM_H */
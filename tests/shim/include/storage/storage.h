@@ -0,0 +1,76 @@
+#ifndef SHIM_STORAGE_H
+#define SHIM_STORAGE_H
+
+#pragma once
+
+/* Storage on top of stdio. Paths under /ext are looked up below the
+ * directory named by the SHIM_SD environment variable, see
+ * tests/shim/storage.c.
+ */
+
+#include <furi.h>
+
+#define RECORD_STORAGE "storage"
+
+typedef struct Storage Storage;
+typedef struct File File;
+
+typedef enum {
+    FSAM_READ = (1 << 0),
+    FSAM_WRITE = (1 << 1),
+    FSAM_READ_WRITE = FSAM_READ | FSAM_WRITE,
+} FS_AccessMode;
+
+typedef enum {
+    FSOM_OPEN_EXISTING = 1,
+    FSOM_OPEN_ALWAYS = 2,
+    FSOM_OPEN_APPEND = 4,
+    FSOM_CREATE_NEW = 8,
+    FSOM_CREATE_ALWAYS = 16,
+} FS_OpenMode;
+
+typedef enum {
+    FSE_OK,
+    FSE_NOT_READY,
+    FSE_EXIST,
+    FSE_NOT_EXIST,
+    FSE_INVALID_PARAMETER,
+    FSE_DENIED,
+    FSE_INVALID_NAME,
+    FSE_INTERNAL,
+    FSE_NOT_IMPLEMENTED,
+    FSE_ALREADY_OPEN,
+} FS_Error;
+
+#define FSF_DIRECTORY (1 << 0)
+
+typedef struct {
+    uint8_t flags;
+    uint64_t size;
+} FileInfo;
+
+bool file_info_is_dir(const FileInfo* file_info);
+
+File* storage_file_alloc(Storage* storage);
+void storage_file_free(File* file);
+bool storage_file_open(File* file, const char* path, FS_AccessMode access, FS_OpenMode mode);
+bool storage_file_close(File* file);
+bool storage_file_is_open(File* file);
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read);
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write);
+bool storage_file_seek(File* file, uint32_t offset, bool from_start);
+uint64_t storage_file_size(File* file);
+bool storage_file_truncate(File* file);
+bool storage_file_sync(File* file);
+bool storage_file_exists(Storage* storage, const char* path);
+
+bool storage_dir_open(File* file, const char* path);
+bool storage_dir_close(File* file);
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
+
+FS_Error storage_common_remove(Storage* storage, const char* path);
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path);
+void storage_common_resolve_path_and_ensure_app_directory(Storage* storage, FuriString* path);
+bool storage_simply_mkdir(Storage* storage, const char* path);
+
+#endif /* SHIM_STORAGE_H */
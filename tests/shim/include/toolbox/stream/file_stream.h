@@ -0,0 +1,8 @@
+#ifndef SHIM_FILE_STREAM_H
+#define SHIM_FILE_STREAM_H
+
+#pragma once
+
+#include <storage/storage.h>
+
+#endif /* SHIM_FILE_STREAM_H */
@@ -0,0 +1,8 @@
+#ifndef SHIM_STREAM_H
+#define SHIM_STREAM_H
+
+#pragma once
+
+#include <storage/storage.h>
+
+#endif /* SHIM_STREAM_H */
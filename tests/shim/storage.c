@@ -0,0 +1,276 @@
+/* Storage on top of stdio and POSIX directories, for the host build. Every
+ * path must start with /ext, which is replaced with shim_sd_root().
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <shim.h>
+
+#define SHIM_EXT "/ext"
+
+static atomic_bool shim_write_fail;
+
+struct File {
+    FILE* fp;
+    DIR* dir;
+    char* path;
+};
+
+void shim_storage_write_fail(bool fail) {
+    atomic_store(&shim_write_fail, fail);
+}
+
+const char* shim_sd_root(void) {
+    const char* root = getenv("SHIM_SD");
+
+    return (root && *root) ? root : "sd";
+}
+
+static void shim_mkdir_p(const char* host) {
+    char* dir = strdup(host);
+    char* c;
+
+    furi_check(dir);
+    for(c = strchr(dir + 1, '/'); c; c = strchr(c + 1, '/')) {
+        *c = '\0';
+        mkdir(dir, 0777);
+        *c = '/';
+    }
+    mkdir(dir, 0777);
+    free(dir);
+}
+
+/* Returns a host path that must be freed. Like the firmware, the app's data
+ * directory is created the first time anything in it is used.
+ */
+static char* shim_path(const char* path) {
+    char* host;
+    char* data;
+
+    if(strncmp(path, SHIM_EXT, strlen(SHIM_EXT)) != 0) {
+        FURI_LOG_E("shim", "path %s is not on the SD card", path);
+        furi_crash("bad path");
+    }
+    furi_check(asprintf(&host, "%s%s", shim_sd_root(), path + strlen(SHIM_EXT)) >= 0);
+
+    if(strncmp(path, APP_DATA_PATH(), strlen(APP_DATA_PATH())) == 0) {
+        data = strndup(host, strlen(host) - strlen(path) + strlen(APP_DATA_PATH()));
+        furi_check(data);
+        shim_mkdir_p(data);
+        free(data);
+    }
+    return host;
+}
+
+bool file_info_is_dir(const FileInfo* file_info) {
+    return file_info->flags & FSF_DIRECTORY;
+}
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return malloc(sizeof(File));
+}
+
+void storage_file_free(File* file) {
+    if(file->fp) storage_file_close(file);
+    if(file->dir) storage_dir_close(file);
+    free(file);
+}
+
+bool storage_file_open(File* file, const char* path, FS_AccessMode access, FS_OpenMode mode) {
+    char* host = shim_path(path);
+    const char* fmode;
+    int flags;
+    int fd;
+
+    furi_check(!file->fp && !file->dir);
+
+    if(access == FSAM_READ_WRITE) {
+        flags = O_RDWR;
+        fmode = "r+b";
+    } else if(access == FSAM_WRITE) {
+        flags = O_WRONLY;
+        fmode = (mode == FSOM_OPEN_APPEND) ? "ab" : "wb";
+    } else {
+        flags = O_RDONLY;
+        fmode = "rb";
+    }
+
+    switch(mode) {
+    case FSOM_OPEN_ALWAYS:
+        flags |= O_CREAT;
+        break;
+    case FSOM_OPEN_APPEND:
+        flags |= O_CREAT | O_APPEND;
+        break;
+    case FSOM_CREATE_NEW:
+        flags |= O_CREAT | O_EXCL;
+        break;
+    case FSOM_CREATE_ALWAYS:
+        flags |= O_CREAT | O_TRUNC;
+        break;
+    default:
+        break;
+    }
+
+    fd = open(host, flags, 0666);
+    free(host);
+    if(fd < 0) return false;
+
+    file->fp = fdopen(fd, fmode);
+    furi_check(file->fp);
+    return true;
+}
+
+bool storage_file_close(File* file) {
+    if(!file->fp) return false;
+    fclose(file->fp);
+    file->fp = NULL;
+    return true;
+}
+
+bool storage_file_is_open(File* file) {
+    return file->fp || file->dir;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    furi_check(file->fp);
+    return fread(buff, 1, bytes_to_read, file->fp);
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    furi_check(file->fp);
+    if(atomic_load(&shim_write_fail)) return 0;
+    return fwrite(buff, 1, bytes_to_write, file->fp);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    furi_check(file->fp);
+    return fseek(file->fp, offset, from_start ? SEEK_SET : SEEK_CUR) == 0;
+}
+
+uint64_t storage_file_size(File* file) {
+    struct stat st;
+
+    furi_check(file->fp);
+    fflush(file->fp);
+    furi_check(fstat(fileno(file->fp), &st) == 0);
+    return st.st_size;
+}
+
+/* Cuts the file off at the current position */
+bool storage_file_truncate(File* file) {
+    furi_check(file->fp);
+    fflush(file->fp);
+    return ftruncate(fileno(file->fp), ftell(file->fp)) == 0;
+}
+
+bool storage_file_sync(File* file) {
+    furi_check(file->fp);
+    return fflush(file->fp) == 0;
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    char* host = shim_path(path);
+    struct stat st;
+    bool exists;
+
+    UNUSED(storage);
+    exists = (stat(host, &st) == 0) && S_ISREG(st.st_mode);
+    free(host);
+    return exists;
+}
+
+bool storage_dir_open(File* file, const char* path) {
+    furi_check(!file->fp && !file->dir);
+    file->path = shim_path(path);
+    file->dir = opendir(file->path);
+    if(file->dir) return true;
+
+    free(file->path);
+    file->path = NULL;
+    return false;
+}
+
+bool storage_dir_close(File* file) {
+    if(!file->dir) return false;
+    closedir(file->dir);
+    file->dir = NULL;
+    free(file->path);
+    file->path = NULL;
+    return true;
+}
+
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    struct dirent* entry;
+    struct stat st;
+    char* host;
+
+    furi_check(file->dir);
+    do {
+        entry = readdir(file->dir);
+        if(!entry) return false;
+    } while(!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."));
+
+    if(name) snprintf(name, name_length, "%s", entry->d_name);
+    if(fileinfo) {
+        furi_check(asprintf(&host, "%s/%s", file->path, entry->d_name) >= 0);
+        furi_check(stat(host, &st) == 0);
+        free(host);
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = st.st_size;
+    }
+    return true;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    char* host = shim_path(path);
+    int ret;
+
+    UNUSED(storage);
+    ret = remove(host);
+    free(host);
+    return (ret == 0) ? FSE_OK : FSE_NOT_EXIST;
+}
+
+/* Like the Flipper, this does not replace an existing file */
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    char* old_host = shim_path(old_path);
+    char* new_host = shim_path(new_path);
+    struct stat st;
+    FS_Error ret = FSE_OK;
+
+    UNUSED(storage);
+    if(stat(new_host, &st) == 0)
+        ret = FSE_EXIST;
+    else if(rename(old_host, new_host) != 0)
+        ret = FSE_NOT_EXIST;
+    free(old_host);
+    free(new_host);
+    return ret;
+}
+
+void storage_common_resolve_path_and_ensure_app_directory(Storage* storage, FuriString* path) {
+    char* host = shim_path(furi_string_get_cstr(path));
+
+    UNUSED(storage);
+    shim_mkdir_p(host);
+    free(host);
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    char* host = shim_path(path);
+    struct stat st;
+    bool ok;
+
+    UNUSED(storage);
+    ok = (mkdir(host, 0777) == 0) || (stat(host, &st) == 0 && S_ISDIR(st.st_mode));
+    free(host);
+    return ok;
+}
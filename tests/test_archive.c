@@ -0,0 +1,124 @@
+/* Pushes Pokemon through src/views/trade_archive.c the way the link ISR does
+ * after a trade, while the SD card comes and goes under it.
+ *
+ * Saves that fail are retried and must all land in the box once the card
+ * is back. With the card gone, the ring fills, and every push past the end
+ * of it must be refused and counted as lost, not silently dropped. Left
+ * gone, the worker gives up on what is in the ring after a bounded number
+ * of retries, counts that as lost too, and goes on saving later pushes.
+ */
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <shim.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_box.h>
+#include <src/include/pokemon_data.h>
+
+#include <src/views/trade_archive.h>
+
+#define BOX_PATH APP_DATA_PATH("archive.pkbx")
+
+/* Long enough for the worker to have given up, with plenty to spare */
+#define WAIT_MS ((TRADE_ARCHIVE_RETRY_MAX + 4) * TRADE_ARCHIVE_RETRY_MS)
+#define POLL_MS 10
+
+static bool wait_count(struct pokemon_box* box, size_t count) {
+    uint32_t ms;
+
+    for(ms = 0; ms < WAIT_MS; ms += POLL_MS) {
+        if(pokemon_box_count(box) == count) return true;
+        furi_delay_ms(POLL_MS);
+    }
+    return false;
+}
+
+static bool wait_lost(struct trade_archive* archive, unsigned int lost) {
+    uint32_t ms;
+
+    for(ms = 0; ms < WAIT_MS; ms += POLL_MS) {
+        if(trade_archive_lost(archive) == lost) return true;
+        furi_delay_ms(POLL_MS);
+    }
+    return false;
+}
+
+/* Every Pokemon in the box from first on must be slot of pdata */
+static void box_check(struct pokemon_box* box, size_t first, PokemonData* pdata, uint8_t slot) {
+    PokemonRaw expect;
+    PokemonRaw raw;
+    size_t i;
+
+    pokemon_raw_get(pdata, slot, &expect);
+    for(i = first; i < pokemon_box_count(box); i++) {
+        furi_check(pokemon_box_load(box, i, &raw));
+        furi_check(memcmp(&raw, &expect, sizeof(PokemonRaw)) == 0);
+    }
+}
+
+static void archive_run(uint8_t gen) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    struct pokemon_box* box;
+    struct trade_archive* archive;
+    int i;
+
+    storage_common_remove(storage, BOX_PATH);
+    box = pokemon_box_open(storage, BOX_PATH);
+    furi_check(box);
+    archive = trade_archive_alloc(box);
+
+    /* The card is back before the worker gives up, nothing is lost */
+    shim_storage_write_fail(true);
+    for(i = 0; i < 3; i++) furi_check(trade_archive_push(archive, pdata, 0));
+    furi_delay_ms(TRADE_ARCHIVE_RETRY_MS / 2);
+    furi_check(pokemon_box_count(box) == 0);
+    shim_storage_write_fail(false);
+    furi_check(wait_count(box, 3));
+    furi_check(trade_archive_lost(archive) == 0);
+
+    /* Fill the ring, the two pushes that don't fit are refused and lost */
+    shim_storage_write_fail(true);
+    for(i = 0; i < TRADE_ARCHIVE_RING_SZ; i++) furi_check(trade_archive_push(archive, pdata, 0));
+    furi_check(!trade_archive_push(archive, pdata, 0));
+    furi_check(!trade_archive_push(archive, pdata, 0));
+    furi_check(wait_lost(archive, 2));
+
+    /* Still gone, the whole ring is given up on */
+    furi_check(wait_lost(archive, 2 + TRADE_ARCHIVE_RING_SZ));
+    furi_check(pokemon_box_count(box) == 3);
+
+    /* And there is room again for what comes next */
+    shim_storage_write_fail(false);
+    pokemon_party_add(pdata);
+    pokemon_stat_set(pdata, 1, STAT_NUM, NONE, 24);
+    furi_check(trade_archive_push(archive, pdata, 1));
+    furi_check(wait_count(box, 4));
+    box_check(box, 3, pdata, 1);
+
+    /* Anything still waiting is saved on the way out */
+    shim_storage_write_fail(true);
+    for(i = 0; i < 2; i++) furi_check(trade_archive_push(archive, pdata, 1));
+    shim_storage_write_fail(false);
+    trade_archive_free(archive);
+    furi_check(pokemon_box_count(box) == 6);
+
+    pokemon_box_close(box);
+    box = pokemon_box_open(storage, BOX_PATH);
+    furi_check(box);
+    furi_check(pokemon_box_count(box) == 6);
+    box_check(box, 3, pdata, 1);
+    pokemon_box_close(box);
+
+    storage_common_remove(storage, BOX_PATH);
+    pokemon_data_free(pdata);
+    furi_record_close(RECORD_STORAGE);
+}
+
+int main(void) {
+    archive_run(GEN_I);
+    archive_run(GEN_II);
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/* Plays scripted colosseum battles against the battle model in
+ * src/views/trade_battle.c, for both gens, through trade_battle_byte() the
+ * way the link handler does once the parties have been exchanged.
+ *
+ * Each action goes out as a burst like the Game Boy's, the action byte until
+ * a reply comes back and then 10 more times, followed by 10x 0x00. The reply
+ * must hold for the whole burst and the padding must be echoed.
+ *
+ * The battles check that the Flipper picks the move with the best type
+ * matchup, falls back to Struggle once its only move is out of PP, sends out
+ * its next Pokemon when its own faints, fights on when the Game Boy's faints,
+ * and notices when the Game Boy runs.
+ */
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/battle_table.h>
+
+#include <src/views/trade_i.h>
+
+/* Repeats of the action byte after the reply, and of the 0x00 after that */
+#define BURST_LEN 10
+
+/* Low nybble of an action byte, see trade_battle.c */
+#define ACTION_SWITCH 0x04
+#define ACTION_STRUGGLE 0x0E
+#define ACTION_RUN 0x0F
+
+/* Species, by 0 indexed pokedex number */
+#define SQUIRTLE 6
+#define PIDGEY 15
+#define RATTATA 18
+#define PIKACHU 24
+#define GEODUDE 73
+#define SNORLAX 142
+#define MEWTWO 149
+
+#define MOVE_TACKLE 0x21
+#define MOVE_WATER_GUN 0x37
+#define MOVE_THUNDERSHOCK 0x54
+#define MOVE_THUNDER 0x57
+#define MOVE_PSYCHIC 0x5E
+
+struct battle_mon {
+    uint8_t num;
+    uint8_t level;
+    uint8_t move[4];
+};
+
+struct battle {
+    struct trade_ctx* trade;
+    uint8_t gen;
+    uint8_t mask;
+};
+
+static void party_set(PokemonData* pdata, const struct battle_mon* mons, uint8_t cnt) {
+    uint8_t slot;
+    int i;
+
+    while(pokemon_party_cnt_get(pdata) < cnt) pokemon_party_add(pdata);
+    while(pokemon_party_cnt_get(pdata) > cnt)
+        pokemon_party_remove(pdata, pokemon_party_cnt_get(pdata) - 1);
+
+    for(slot = 0; slot < cnt; slot++) {
+        pokemon_stat_set(pdata, slot, STAT_NUM, NONE, mons[slot].num);
+        pokemon_stat_set(pdata, slot, STAT_LEVEL, NONE, mons[slot].level);
+        pokemon_recalculate_pending(pdata);
+        for(i = MOVE_0; i <= MOVE_3; i++)
+            pokemon_stat_set(pdata, slot, STAT_MOVE, i, mons[slot].move[i]);
+    }
+    pokemon_recalculate_pending(pdata);
+}
+
+/* Line up a new battle between ours and theirs */
+static void battle_start(
+    struct battle* battle,
+    const struct battle_mon* ours,
+    uint8_t our_cnt,
+    const struct battle_mon* theirs,
+    uint8_t their_cnt) {
+    party_set(battle->trade->pdata, ours, our_cnt);
+    party_set(battle->trade->input_pdata, theirs, their_cnt);
+    trade_battle_reset(&battle->trade->battle);
+}
+
+/* One action burst from the Game Boy, returns the Flipper's action */
+static uint8_t battle_action(struct battle* battle, uint8_t action) {
+    uint8_t out = battle->mask | action;
+    uint8_t reply;
+    int i;
+
+    reply = trade_battle_byte(battle->trade, battle->mask, out);
+    furi_check((reply & 0xF0) == battle->mask);
+    for(i = 0; i < BURST_LEN; i++)
+        furi_check(trade_battle_byte(battle->trade, battle->mask, out) == reply);
+    for(i = 0; i < BURST_LEN; i++)
+        furi_check(trade_battle_byte(battle->trade, battle->mask, 0x00) == 0x00);
+
+    return reply & 0x0F;
+}
+
+static const struct trade_battle_mon* battle_mon(struct battle* battle, uint8_t side) {
+    const struct trade_battle* state = &battle->trade->battle;
+
+    return &state->mon[side][state->active[side]];
+}
+
+/* Thundershock against Water, Water Gun against Rock/Ground, which Electric
+ * does nothing to.
+ */
+static void battle_type_test(struct battle* battle) {
+    const struct battle_mon ours[] = {
+        {PIKACHU, 50, {MOVE_TACKLE, MOVE_WATER_GUN, MOVE_THUNDERSHOCK, 0}},
+    };
+    const struct battle_mon squirtle[] = {{SQUIRTLE, 50, {MOVE_TACKLE, 0, 0, 0}}};
+    const struct battle_mon geodude[] = {{GEODUDE, 50, {MOVE_TACKLE, 0, 0, 0}}};
+
+    battle_start(battle, ours, COUNT_OF(ours), squirtle, COUNT_OF(squirtle));
+    furi_check(battle_action(battle, MOVE_0) == 2);
+
+    battle_start(battle, ours, COUNT_OF(ours), geodude, COUNT_OF(geodude));
+    furi_check(battle_action(battle, MOVE_0) == 1);
+}
+
+/* A weak Pokemon with only Thunder against one that never attacks and takes
+ * more than all of Thunder's PP to bring down.
+ */
+static void battle_struggle_test(struct battle* battle) {
+    const struct battle_mon ours[] = {{PIKACHU, 2, {MOVE_THUNDER, 0, 0, 0}}};
+    const struct battle_mon theirs[] = {{SNORLAX, 100, {0, 0, 0, 0}}};
+    uint8_t pp = battle_move_get(battle->gen, MOVE_THUNDER)->pp;
+    uint8_t i;
+
+    battle_start(battle, ours, COUNT_OF(ours), theirs, COUNT_OF(theirs));
+    furi_check(pp);
+    for(i = 0; i < pp; i++) furi_check(battle_action(battle, MOVE_0) == 0);
+    furi_check(battle_mon(battle, BATTLE_THEM)->hp);
+    furi_check(battle_action(battle, MOVE_0) == ACTION_STRUGGLE);
+    furi_check(battle_action(battle, MOVE_0) == ACTION_STRUGGLE);
+}
+
+static void battle_faint_test(struct battle* battle) {
+    const struct battle_mon strong[] = {{MEWTWO, 100, {MOVE_PSYCHIC, 0, 0, 0}}};
+    const struct battle_mon weak[] = {
+        {RATTATA, 2, {MOVE_TACKLE, 0, 0, 0}},
+        {PIDGEY, 2, {MOVE_TACKLE, 0, 0, 0}},
+    };
+    const struct trade_battle* state = &battle->trade->battle;
+
+    /* The Game Boy's faints, it sends out its next and the battle goes on */
+    battle_start(battle, strong, COUNT_OF(strong), weak, COUNT_OF(weak));
+    furi_check(battle_action(battle, MOVE_0) == 0);
+    furi_check(!battle_mon(battle, BATTLE_THEM)->hp);
+    furi_check(battle_action(battle, ACTION_SWITCH + 1) == 0);
+    furi_check(state->active[BATTLE_THEM] == 1);
+    furi_check(battle_mon(battle, BATTLE_THEM)->hp);
+
+    /* The Flipper's faints, the Game Boy repeats its last switch byte and
+     * must get the Flipper's next Pokemon back.
+     */
+    battle_start(battle, weak, COUNT_OF(weak), strong, COUNT_OF(strong));
+    furi_check(battle_action(battle, MOVE_0) == 0);
+    furi_check(!battle_mon(battle, BATTLE_US)->hp);
+    furi_check(battle_action(battle, ACTION_SWITCH + 0) == ACTION_SWITCH + 1);
+    furi_check(state->active[BATTLE_US] == 1);
+    furi_check(battle_mon(battle, BATTLE_US)->hp);
+
+    /* A move from the Game Boy means both are still up, whatever the
+     * estimate says.
+     */
+    furi_check(battle_action(battle, MOVE_0) == 0);
+    furi_check(state->active[BATTLE_US] == 1);
+}
+
+static void battle_run_test(struct battle* battle) {
+    const struct battle_mon mons[] = {{PIKACHU, 50, {MOVE_THUNDERSHOCK, 0, 0, 0}}};
+    const struct trade_battle* state = &battle->trade->battle;
+
+    battle_start(battle, mons, COUNT_OF(mons), mons, COUNT_OF(mons));
+    furi_check(battle_action(battle, MOVE_0) == 0);
+    furi_check(!atomic_load(&state->ran));
+    battle_action(battle, ACTION_RUN);
+    furi_check(atomic_load(&state->ran) == state->turn);
+}
+
+static void battle_run(uint8_t gen) {
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    struct battle battle = {
+        .gen = gen,
+        .mask = (gen == GEN_I) ? gen_i.battle_mask : gen_ii.battle_mask,
+    };
+
+    battle.trade = trade_headless_alloc(
+        gen, pdata->trade_block, pdata->mail, GAMEBOY_COLOSSEUM, TRADE_RESET);
+
+    battle_type_test(&battle);
+    battle_struggle_test(&battle);
+    battle_faint_test(&battle);
+    battle_run_test(&battle);
+
+    trade_headless_free(battle.trade);
+    pokemon_data_free(pdata);
+}
+
+int main(void) {
+    battle_run(GEN_I);
+    battle_run(GEN_II);
+
+    return 0;
+}
@@ -0,0 +1,359 @@
+/* Saves, loads, and deletes Pokemon in the box log of src/pokemon_box.c, and
+ * checks it against a plain list of what should be in it after every step
+ * and after reopening the box, which rebuilds the index from the log.
+ *
+ * Then the log is damaged the ways the SD card can leave it: a record cut
+ * short at the end, records with a bad CRC, and a compaction that stopped
+ * partway through swapping in the new log. The box must come back with
+ * everything that survived, and keep working. A file that isn't a box must be
+ * left as it is.
+ */
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_box.h>
+#include <src/include/pokemon_data.h>
+
+#define BOX_PATH APP_DATA_PATH("test.pkbx")
+#define BOX_TMP_PATH BOX_PATH ".tmp"
+
+/* File offset of a record in the log */
+#define REC_OFFSET(rec) \
+    (sizeof(struct pokemon_box_hdr) + ((rec) * sizeof(struct pokemon_box_rec)))
+
+#define MODEL_MAX 64
+
+/* What the box should hold, oldest first */
+struct model {
+    uint32_t id[MODEL_MAX];
+    PokemonRaw raw[MODEL_MAX];
+    size_t count;
+};
+
+static void raw_random(PokemonRaw* raw) {
+    size_t i;
+
+    raw->gen = (rand() % 2) ? GEN_I : GEN_II;
+    raw->species = 1 + (rand() % 250);
+    for(i = 0; i < sizeof(raw->member); i++) raw->member[i] = rand();
+    for(i = 0; i < LEN_NAME_BUF; i++) {
+        raw->ot_name[i] = rand();
+        raw->nickname[i] = rand();
+    }
+}
+
+static void model_save(struct pokemon_box* box, struct model* model) {
+    uint32_t id;
+
+    furi_check(model->count < MODEL_MAX);
+    raw_random(&model->raw[model->count]);
+    id = pokemon_box_save(box, &model->raw[model->count]);
+    /* ids only ever go up */
+    furi_check(id);
+    furi_check(!model->count || id > model->id[model->count - 1]);
+    model->id[model->count++] = id;
+}
+
+static void model_remove(struct model* model, size_t idx) {
+    model->count--;
+    memmove(&model->id[idx], &model->id[idx + 1], (model->count - idx) * sizeof(uint32_t));
+    memmove(&model->raw[idx], &model->raw[idx + 1], (model->count - idx) * sizeof(PokemonRaw));
+}
+
+static void model_delete(struct pokemon_box* box, struct model* model, size_t idx) {
+    furi_check(pokemon_box_delete(box, idx));
+    model_remove(model, idx);
+}
+
+static void box_check(struct pokemon_box* box, const struct model* model) {
+    struct pokemon_box_entry entry;
+    PokemonRaw raw;
+    size_t i;
+
+    furi_check(pokemon_box_count(box) == model->count);
+    for(i = 0; i < model->count; i++) {
+        furi_check(pokemon_box_entry_get(box, i, &entry));
+        furi_check(entry.id == model->id[i]);
+        furi_check(entry.gen == model->raw[i].gen && entry.species == model->raw[i].species);
+        furi_check(pokemon_box_load(box, i, &raw));
+        if(memcmp(&raw, &model->raw[i], sizeof(PokemonRaw)) != 0) {
+            FURI_LOG_E(TAG, "[test] box entry %zu, id %u, differs", i, model->id[i]);
+            furi_crash("Box mismatch");
+        }
+    }
+
+    /* Nothing past the end */
+    furi_check(!pokemon_box_entry_get(box, model->count, &entry));
+    furi_check(!pokemon_box_load(box, model->count, &raw));
+    furi_check(!pokemon_box_delete(box, model->count));
+}
+
+static struct pokemon_box* box_reopen(Storage* storage, struct pokemon_box* box) {
+    if(box) pokemon_box_close(box);
+    box = pokemon_box_open(storage, BOX_PATH);
+    furi_check(box);
+
+    return box;
+}
+
+static uint64_t file_size(Storage* storage, const char* path) {
+    File* file = storage_file_alloc(storage);
+    uint64_t size;
+
+    furi_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    size = storage_file_size(file);
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return size;
+}
+
+/* Write buf over the file at offs, or at the end if offs is UINT32_MAX */
+static void
+    file_patch(Storage* storage, const char* path, uint32_t offs, const void* buf, size_t len) {
+    File* file = storage_file_alloc(storage);
+
+    furi_check(storage_file_open(file, path, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS));
+    if(offs == UINT32_MAX) offs = storage_file_size(file);
+    furi_check(storage_file_seek(file, offs, true));
+    furi_check(storage_file_write(file, buf, len) == len);
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+/* Flip a byte in the middle of a record, so its CRC fails */
+static void rec_corrupt(Storage* storage, uint32_t rec) {
+    File* file = storage_file_alloc(storage);
+    uint32_t offs = REC_OFFSET(rec) + offsetof(struct pokemon_box_rec, member);
+    uint8_t byte;
+
+    furi_check(storage_file_open(file, BOX_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING));
+    furi_check(storage_file_seek(file, offs, true));
+    furi_check(storage_file_read(file, &byte, 1) == 1);
+    byte ^= 0x5A;
+    furi_check(storage_file_seek(file, offs, true));
+    furi_check(storage_file_write(file, &byte, 1) == 1);
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+static struct pokemon_box* box_fresh(Storage* storage, struct model* model) {
+    storage_common_remove(storage, BOX_PATH);
+    storage_common_remove(storage, BOX_TMP_PATH);
+    model->count = 0;
+
+    return box_reopen(storage, NULL);
+}
+
+static void basic_test(Storage* storage) {
+    struct model model;
+    struct pokemon_box* box = box_fresh(storage, &model);
+    int i;
+
+    box_check(box, &model);
+    pokemon_box_close(box);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(0));
+    box = box_reopen(storage, NULL);
+
+    for(i = 0; i < 10; i++) model_save(box, &model);
+    box_check(box, &model);
+    box = box_reopen(storage, box);
+    box_check(box, &model);
+
+    /* The first, one in the middle, and the last */
+    model_delete(box, &model, 0);
+    model_delete(box, &model, 4);
+    model_delete(box, &model, model.count - 1);
+    box_check(box, &model);
+    box = box_reopen(storage, box);
+    box_check(box, &model);
+
+    /* The id of the deleted last one isn't given out again */
+    model_save(box, &model);
+    furi_check(model.id[model.count - 1] == 11);
+    box_check(box, &model);
+
+    pokemon_box_close(box);
+}
+
+static void compact_test(Storage* storage) {
+    struct model model;
+    struct pokemon_box* box = box_fresh(storage, &model);
+    int i;
+
+    for(i = 0; i < 40; i++) model_save(box, &model);
+
+    /* Each delete kills two records. The 16th makes 32 dead records against 24
+     * live ones, which is enough to compact.
+     */
+    for(i = 0; i < 15; i++) model_delete(box, &model, i % model.count);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(40 + 15));
+    model_delete(box, &model, 0);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(24));
+    box_check(box, &model);
+
+    /* Not enough dead to compact on its own, so do it by hand */
+    for(i = 0; i < 10; i++) model_delete(box, &model, model.count / 2);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(24 + 10));
+    furi_check(pokemon_box_compact(box));
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(14));
+    box_check(box, &model);
+
+    /* Appends land after the compacted log */
+    model_save(box, &model);
+    box = box_reopen(storage, box);
+    box_check(box, &model);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(15));
+
+    /* Enough bad records to compact when opened */
+    for(i = 0; i < 40; i++) model_save(box, &model);
+    pokemon_box_close(box);
+    for(i = 0; i < 35; i++) {
+        rec_corrupt(storage, 15 + i);
+        model_remove(&model, 15);
+    }
+    box = box_reopen(storage, NULL);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(20));
+    box_check(box, &model);
+
+    pokemon_box_close(box);
+}
+
+/* A record cut short by the power going out while it was written */
+static void torn_test(Storage* storage) {
+    struct model model;
+    struct pokemon_box* box = box_fresh(storage, &model);
+    uint8_t junk[sizeof(struct pokemon_box_rec) / 2];
+    int i;
+
+    for(i = 0; i < 5; i++) model_save(box, &model);
+    pokemon_box_close(box);
+
+    memset(junk, 0xA5, sizeof(junk));
+    file_patch(storage, BOX_PATH, UINT32_MAX, junk, sizeof(junk));
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(5) + sizeof(junk));
+
+    box = box_reopen(storage, NULL);
+    box_check(box, &model);
+    furi_check(file_size(storage, BOX_PATH) == REC_OFFSET(5));
+
+    model_save(box, &model);
+    box = box_reopen(storage, box);
+    box_check(box, &model);
+
+    pokemon_box_close(box);
+}
+
+static void corrupt_test(Storage* storage) {
+    struct model model;
+    struct pokemon_box* box = box_fresh(storage, &model);
+    int i;
+
+    /* Records 0-5 are saves, 6 deletes 1 */
+    for(i = 0; i < 6; i++) model_save(box, &model);
+    model_delete(box, &model, 1);
+    pokemon_box_close(box);
+
+    /* A dead record going bad changes nothing */
+    rec_corrupt(storage, 1);
+    box = box_reopen(storage, NULL);
+    box_check(box, &model);
+    pokemon_box_close(box);
+
+    /* A live one is lost, and only that one */
+    rec_corrupt(storage, 4);
+    model_remove(&model, 3);
+    box = box_reopen(storage, NULL);
+    box_check(box, &model);
+
+    /* The box still takes new Pokemon after the bad record */
+    model_save(box, &model);
+    model_delete(box, &model, 0);
+    box = box_reopen(storage, box);
+    box_check(box, &model);
+
+    pokemon_box_close(box);
+}
+
+static void swap_test(Storage* storage) {
+    struct model model;
+    struct pokemon_box* box = box_fresh(storage, &model);
+    const char junk[] = "not a box";
+    int i;
+
+    for(i = 0; i < 8; i++) model_save(box, &model);
+    model_delete(box, &model, 2);
+    furi_check(pokemon_box_compact(box));
+    pokemon_box_close(box);
+
+    /* Stopped after the new log was written, before the old one was removed.
+     * The old log is still whole, so it is the one used.
+     */
+    file_patch(storage, BOX_TMP_PATH, 0, junk, sizeof(junk));
+    box = box_reopen(storage, NULL);
+    box_check(box, &model);
+    pokemon_box_close(box);
+    storage_common_remove(storage, BOX_TMP_PATH);
+
+    /* Stopped after the old log was removed, before the new one was renamed */
+    furi_check(storage_common_rename(storage, BOX_PATH, BOX_TMP_PATH) == FSE_OK);
+    box = box_reopen(storage, NULL);
+    furi_check(!storage_file_exists(storage, BOX_TMP_PATH));
+    box_check(box, &model);
+
+    model_save(box, &model);
+    box = box_reopen(storage, box);
+    box_check(box, &model);
+
+    pokemon_box_close(box);
+}
+
+/* Anything at the box path that isn't a box is not touched */
+static void foreign_test(Storage* storage) {
+    struct pokemon_box_hdr hdr = {0};
+    const char text[] = "This is not a box, and is longer than a box header";
+    char buf[sizeof(text)];
+    File* file;
+
+    storage_common_remove(storage, BOX_PATH);
+    file_patch(storage, BOX_PATH, 0, text, sizeof(text));
+    furi_check(!pokemon_box_open(storage, BOX_PATH));
+
+    file = storage_file_alloc(storage);
+    furi_check(storage_file_open(file, BOX_PATH, FSAM_READ, FSOM_OPEN_EXISTING));
+    furi_check(storage_file_size(file) == sizeof(text));
+    furi_check(storage_file_read(file, buf, sizeof(buf)) == sizeof(buf));
+    furi_check(memcmp(buf, text, sizeof(text)) == 0);
+    storage_file_close(file);
+    storage_file_free(file);
+
+    /* A box from a later version */
+    memcpy(hdr.magic, POKEMON_BOX_MAGIC, sizeof(hdr.magic));
+    hdr.version = POKEMON_BOX_VERSION + 1;
+    hdr.rec_sz = sizeof(struct pokemon_box_rec);
+    storage_common_remove(storage, BOX_PATH);
+    file_patch(storage, BOX_PATH, 0, &hdr, sizeof(hdr));
+    file_patch(storage, BOX_PATH, UINT32_MAX, text, sizeof(text));
+    furi_check(!pokemon_box_open(storage, BOX_PATH));
+    furi_check(file_size(storage, BOX_PATH) == sizeof(hdr) + sizeof(text));
+
+    storage_common_remove(storage, BOX_PATH);
+}
+
+int main(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    srand(1);
+    basic_test(storage);
+    compact_test(storage);
+    torn_test(storage);
+    corrupt_test(storage);
+    swap_test(storage);
+    foreign_test(storage);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
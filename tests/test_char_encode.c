@@ -0,0 +1,446 @@
+/* Checks the text encoding tables against the switch statements they
+ * replaced, for all 256 inputs in both directions, and then the whole name
+ * encode and decode built on them.
+ *
+ * The old functions are kept below exactly as they were, apart from their
+ * names. The tables only differ from them for the punctuation and glyphs
+ * that the old code had no mapping for, listed in new_chars, and every one of
+ * those must now round trip.
+ */
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_char_encode.h>
+#include <src/include/pokemon_data.h>
+
+/* Characters with an encoding now that had none before */
+static const char new_chars[] = {
+    ' ',
+    '(',
+    ')',
+    ':',
+    ';',
+    '[',
+    ']',
+    '\'',
+    '?',
+    '!',
+    '.',
+    CHAR_PK,
+    CHAR_MN,
+    CHAR_e_ACCENT,
+    CHAR_d_TICK,
+    CHAR_l_TICK,
+    CHAR_s_TICK,
+    CHAR_t_TICK,
+    CHAR_v_TICK,
+    CHAR_r_TICK,
+    CHAR_m_TICK,
+    CHAR_R_ARR,
+    CHAR_D_ARR,
+};
+
+static char old_char_to_encoded(int byte) {
+    switch(byte) {
+    case 'A':
+        return A_;
+    case 'B':
+        return B_;
+    case 'C':
+        return C_;
+    case 'D':
+        return D_;
+    case 'E':
+        return E_;
+    case 'F':
+        return F_;
+    case 'G':
+        return G_;
+    case 'H':
+        return H_;
+    case 'I':
+        return I_;
+    case 'J':
+        return J_;
+    case 'K':
+        return K_;
+    case 'L':
+        return L_;
+    case 'M':
+        return M_;
+    case 'N':
+        return N_;
+    case 'O':
+        return O_;
+    case 'P':
+        return P_;
+    case 'Q':
+        return Q_;
+    case 'R':
+        return R_;
+    case 'S':
+        return S_;
+    case 'T':
+        return T_;
+    case 'U':
+        return U_;
+    case 'V':
+        return V_;
+    case 'W':
+        return W_;
+    case 'X':
+        return X_;
+    case 'Y':
+        return Y_;
+    case 'Z':
+        return Z_;
+    case 'a':
+        return a_;
+    case 'b':
+        return b_;
+    case 'c':
+        return c_;
+    case 'd':
+        return d_;
+    case 'e':
+        return e_;
+    case 'f':
+        return f_;
+    case 'g':
+        return g_;
+    case 'h':
+        return h_;
+    case 'i':
+        return i_;
+    case 'j':
+        return j_;
+    case 'k':
+        return k_;
+    case 'l':
+        return l_;
+    case 'm':
+        return m_;
+    case 'n':
+        return n_;
+    case 'o':
+        return o_;
+    case 'p':
+        return p_;
+    case 'q':
+        return q_;
+    case 'r':
+        return r_;
+    case 's':
+        return s_;
+    case 't':
+        return t_;
+    case 'u':
+        return u_;
+    case 'v':
+        return v_;
+    case 'w':
+        return w_;
+    case 'x':
+        return x_;
+    case 'y':
+        return y_;
+    case 'z':
+        return z_;
+    case '-':
+        return HYPHEN_;
+    case '0':
+        return _0_;
+    case '1':
+        return _1_;
+    case '2':
+        return _2_;
+    case '3':
+        return _3_;
+    case '4':
+        return _4_;
+    case '5':
+        return _5_;
+    case '6':
+        return _6_;
+    case '7':
+        return _7_;
+    case '8':
+        return _8_;
+    case '9':
+        return _9_;
+
+    case '\201':
+        return MALE_;
+    case '\200':
+        return FEMALE_;
+    default:
+        return TERM_;
+    }
+}
+
+static int old_encoded_to_char(char byte) {
+    switch(byte) {
+    case A_:
+        return 'A';
+    case B_:
+        return 'B';
+    case C_:
+        return 'C';
+    case D_:
+        return 'D';
+    case E_:
+        return 'E';
+    case F_:
+        return 'F';
+    case G_:
+        return 'G';
+    case H_:
+        return 'H';
+    case I_:
+        return 'I';
+    case J_:
+        return 'J';
+    case K_:
+        return 'K';
+    case L_:
+        return 'L';
+    case M_:
+        return 'M';
+    case N_:
+        return 'N';
+    case O_:
+        return 'O';
+    case P_:
+        return 'P';
+    case Q_:
+        return 'Q';
+    case R_:
+        return 'R';
+    case S_:
+        return 'S';
+    case T_:
+        return 'T';
+    case U_:
+        return 'U';
+    case V_:
+        return 'V';
+    case W_:
+        return 'W';
+    case X_:
+        return 'X';
+    case Y_:
+        return 'Y';
+    case Z_:
+        return 'Z';
+    case a_:
+        return 'a';
+    case b_:
+        return 'b';
+    case c_:
+        return 'c';
+    case d_:
+        return 'd';
+    case e_:
+        return 'e';
+    case f_:
+        return 'f';
+    case g_:
+        return 'g';
+    case h_:
+        return 'h';
+    case i_:
+        return 'i';
+    case j_:
+        return 'j';
+    case k_:
+        return 'k';
+    case l_:
+        return 'l';
+    case m_:
+        return 'm';
+    case n_:
+        return 'n';
+    case o_:
+        return 'o';
+    case p_:
+        return 'p';
+    case q_:
+        return 'q';
+    case r_:
+        return 'r';
+    case s_:
+        return 's';
+    case t_:
+        return 't';
+    case u_:
+        return 'u';
+    case v_:
+        return 'v';
+    case w_:
+        return 'w';
+    case x_:
+        return 'x';
+    case y_:
+        return 'y';
+    case z_:
+        return 'z';
+    case HYPHEN_:
+        return '-';
+    case _0_:
+        return '0';
+    case _1_:
+        return '1';
+    case _2_:
+        return '2';
+    case _3_:
+        return '3';
+    case _4_:
+        return '4';
+    case _5_:
+        return '5';
+    case _6_:
+        return '6';
+    case _7_:
+        return '7';
+    case _8_:
+        return '8';
+    case _9_:
+        return '9';
+
+    case MALE_:
+        return '\201';
+    case FEMALE_:
+        return '\200';
+    default:
+        return '\0';
+    }
+}
+
+static bool new_char_is(char c) {
+    size_t i;
+
+    for(i = 0; i < COUNT_OF(new_chars); i++) {
+        if(new_chars[i] == c) return true;
+    }
+
+    return false;
+}
+
+static bool new_encoded_is(uint8_t byte) {
+    size_t i;
+
+    for(i = 0; i < COUNT_OF(new_chars); i++) {
+        if((uint8_t)pokemon_char_to_encoded(new_chars[i]) == byte) return true;
+    }
+
+    return false;
+}
+
+static void char_test(void) {
+    uint8_t encoded;
+    int c;
+    int i;
+
+    for(i = 0; i < 256; i++) {
+        /* Characters */
+        encoded = pokemon_char_to_encoded(i);
+        if(new_char_is(i)) {
+            furi_check((uint8_t)old_char_to_encoded(i) == TERM_);
+            furi_check(encoded != TERM_);
+        } else if(encoded != (uint8_t)old_char_to_encoded(i)) {
+            FURI_LOG_E(
+                TAG,
+                "[test] char 0x%02X: got 0x%02X, expected 0x%02X",
+                i,
+                encoded,
+                (uint8_t)old_char_to_encoded(i));
+            furi_crash("Encode mismatch");
+        }
+        if(encoded != TERM_) furi_check(pokemon_encoded_to_char(encoded) == i);
+
+        /* Encoded bytes */
+        c = pokemon_encoded_to_char(i);
+        if(new_encoded_is(i)) {
+            furi_check(old_encoded_to_char(i) == '\0');
+            furi_check(c != '\0');
+        } else if(c != old_encoded_to_char(i)) {
+            FURI_LOG_E(
+                TAG,
+                "[test] encoded 0x%02X: got 0x%02X, expected 0x%02X",
+                i,
+                c,
+                old_encoded_to_char(i));
+            furi_crash("Decode mismatch");
+        }
+        if(c != '\0') furi_check((uint8_t)pokemon_char_to_encoded(c) == i);
+    }
+}
+
+/* The array functions must give the same as a byte at a time */
+static void array_test(void) {
+    char str[256];
+    char str_out[256];
+    uint8_t encoded[256];
+    int i;
+
+    for(i = 0; i < 256; i++) {
+        str[i] = i;
+        encoded[i] = i;
+    }
+
+    pokemon_str_to_encoded_array(encoded, str, sizeof(str));
+    for(i = 0; i < 256; i++) furi_check(encoded[i] == (uint8_t)pokemon_char_to_encoded(i));
+
+    for(i = 0; i < 256; i++) encoded[i] = i;
+    pokemon_encoded_array_to_str(str_out, encoded, sizeof(encoded));
+    for(i = 0; i < 256; i++) furi_check(str_out[i] == pokemon_encoded_to_char(i));
+}
+
+static void name_check(const char* name, size_t len, const char* expect) {
+    uint8_t buf[LEN_NAME_BUF + 1];
+    char out[LEN_NAME_BUF + 1];
+    size_t expect_len = strlen(expect);
+    size_t i;
+
+    /* The byte past the name buffer must never be touched */
+    memset(buf, 0xAA, sizeof(buf));
+    pokemon_name_encode(buf, LEN_NAME_BUF, name, len);
+    for(i = 0; i < LEN_NAME_BUF; i++) {
+        if(i < expect_len)
+            furi_check(buf[i] == (uint8_t)pokemon_char_to_encoded(expect[i]));
+        else
+            furi_check(buf[i] == TERM_);
+    }
+    furi_check(buf[LEN_NAME_BUF] == 0xAA);
+
+    /* Decoding always leaves room for, and writes, the NUL */
+    memset(out, 0xAA, sizeof(out));
+    pokemon_name_decode(out, sizeof(out), buf);
+    furi_check(strcmp(out, expect) == 0);
+
+    /* And stops short when dest is smaller than the name */
+    pokemon_name_decode(out, 4, buf);
+    furi_check(strncmp(out, expect, 3) == 0);
+    furi_check(strlen(out) == ((expect_len < 3) ? expect_len : 3));
+}
+
+static void name_test(void) {
+    name_check("FARFETCH'D", LEN_NAME_BUF - 1, "FARFETCH'D");
+    name_check("MR.MIME", LEN_NAME_BUF - 1, "MR.MIME");
+    name_check("NIDORAN\200", LEN_NAME_BUF - 1, "NIDORAN\200");
+    name_check("NIDORAN\201", LEN_NAME_BUF - 1, "NIDORAN\201");
+    name_check("", LEN_NAME_BUF - 1, "");
+
+    /* Longer than the buffer, and cut short by len */
+    name_check("ABCDEFGHIJKLMNOP", 64, "ABCDEFGHIJK");
+    name_check("PIKACHU", 4, "PIKA");
+}
+
+int main(void) {
+    char_test();
+    array_test();
+    name_test();
+
+    return 0;
+}
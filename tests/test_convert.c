@@ -0,0 +1,214 @@
+/* Converts every Gen I species to Gen II and back, at the lowest and highest
+ * level and at random ones, with random EV and IV spreads, catch rates, and
+ * damage.
+ *
+ * Going up, everything the two gens share must carry over as is, the catch
+ * rate must become the held item the games would give, and every stat must
+ * be what the app itself works out for the Gen II Pokemon. Going back down
+ * must give back exactly the Pokemon that went up, apart from the catch rates
+ * that Gen II swaps for an item.
+ *
+ * Then everything Gen I has no room for must be turned away: the Gen II only
+ * species, eggs, and Gen II only moves.
+ */
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_convert.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/pokemon_table.h>
+#include <src/pokemon_data_i.h>
+
+#define GEN_I_DEX_CNT 151
+
+/* Levels tried for each species, the first two are always 2 and 100 */
+#define LEVELS 8
+
+/* Friendship of a Pokemon that comes through the Time Capsule */
+#define FRIENDSHIP_BASE 70
+
+/* Moves only Gen II has, either side of the last Gen I move, Struggle */
+#define MOVE_SKETCH 0xA6
+#define MOVE_AEROBLAST 0xB1
+#define MOVE_BEAT_UP 0xFB
+
+#define GEN_I_MEMBER(raw) ((PokemonPartyGenI*)(raw)->member)
+#define GEN_II_MEMBER(raw) ((PokemonPartyGenII*)(raw)->member)
+
+/* Catch rates Gen II gives a different held item for, and that item */
+static const uint8_t catch_items[][2] = {
+    {0x19, 0x92}, // Leftovers
+    {0x2D, 0x53}, // Bitter Berry
+    {0x32, 0xAE}, // Gold Berry
+    {0x5A, 0xAD}, // Berry
+    {0x64, 0xAD},
+    {0x78, 0xAD},
+    {0x87, 0xAD},
+    {0xBE, 0xAD},
+    {0xC3, 0xAD},
+    {0xDC, 0xAD},
+    {0xFA, 0xAD},
+    {0xFF, 0xAD},
+};
+
+static uint8_t catch_item(uint8_t catch_rate) {
+    size_t i;
+
+    for(i = 0; i < COUNT_OF(catch_items); i++) {
+        if(catch_items[i][0] == catch_rate) return catch_items[i][1];
+    }
+
+    return catch_rate;
+}
+
+/* Everything Gen II keeps must match between the two slots */
+static void shared_check(PokemonData* gen_i, PokemonData* gen_ii) {
+    int i;
+
+    furi_check(
+        pokemon_stat_get(gen_ii, 0, STAT_NUM, NONE) == pokemon_stat_get(gen_i, 0, STAT_NUM, NONE));
+    furi_check(
+        pokemon_stat_get(gen_ii, 0, STAT_LEVEL, NONE) ==
+        pokemon_stat_get(gen_i, 0, STAT_LEVEL, NONE));
+    furi_check(pokemon_exp_get(gen_ii, 0) == pokemon_exp_get(gen_i, 0));
+    furi_check(
+        pokemon_stat_get(gen_ii, 0, STAT_OT_ID, NONE) ==
+        pokemon_stat_get(gen_i, 0, STAT_OT_ID, NONE));
+
+    for(i = MOVE_0; i <= MOVE_3; i++) {
+        furi_check(
+            pokemon_stat_get(gen_ii, 0, STAT_MOVE, i) == pokemon_stat_get(gen_i, 0, STAT_MOVE, i));
+    }
+    for(i = STAT_EV; i < STAT_EV_END; i++) {
+        furi_check(pokemon_stat_get(gen_ii, 0, i, NONE) == pokemon_stat_get(gen_i, 0, i, NONE));
+    }
+    for(i = STAT_ATK_IV; i < STAT_IV_END; i++) {
+        furi_check(pokemon_stat_get(gen_ii, 0, i, NONE) == pokemon_stat_get(gen_i, 0, i, NONE));
+    }
+}
+
+static void species_test(PokemonData* gen_i, PokemonData* gen_ii, uint8_t num) {
+    PokemonRaw raw;
+    PokemonRaw up;
+    PokemonRaw down;
+    PokemonRaw calc;
+    uint8_t catch_rate;
+    int level;
+    int k;
+
+    for(k = 0; k < LEVELS; k++) {
+        level = (k == 0) ? 2 : (k == 1) ? 100 : 2 + (rand() % 99);
+        pokemon_stat_set(gen_i, 0, STAT_NUM, NONE, num);
+        pokemon_stat_set(gen_i, 0, STAT_SEL, NONE, rand() % 6);
+        pokemon_stat_set(gen_i, 0, STAT_LEVEL, NONE, level);
+        pokemon_recalculate_pending(gen_i);
+        pokemon_raw_get(gen_i, 0, &raw);
+
+        catch_rate = rand();
+        GEN_I_MEMBER(&raw)->catch_held = catch_rate;
+        /* Hurt, so current HP isn't just max HP */
+        if(k == 2) GEN_I_MEMBER(&raw)->hp = __builtin_bswap16(3);
+
+        furi_check(pokemon_convert(&raw, GEN_II, &up) == CONVERT_OK);
+        furi_check(up.gen == GEN_II && up.species == num + 1 && up.member[0] == num + 1);
+        furi_check(memcmp(up.ot_name, raw.ot_name, LEN_NAME_BUF) == 0);
+        furi_check(memcmp(up.nickname, raw.nickname, LEN_NAME_BUF) == 0);
+        furi_check(GEN_II_MEMBER(&up)->held_item == catch_item(catch_rate));
+        furi_check(GEN_II_MEMBER(&up)->friendship == FRIENDSHIP_BASE);
+        furi_check(GEN_II_MEMBER(&up)->hp == GEN_I_MEMBER(&raw)->hp);
+        furi_check(GEN_II_MEMBER(&up)->status_condition == GEN_I_MEMBER(&raw)->status_condition);
+
+        furi_check(pokemon_raw_set(gen_ii, 0, &up));
+        pokemon_recalculate_pending(gen_ii);
+        shared_check(gen_i, gen_ii);
+
+        /* The app working out the stats again must come up with the same */
+        pokemon_stats_calc(gen_ii, 0);
+        pokemon_raw_get(gen_ii, 0, &calc);
+        furi_check(
+            memcmp(
+                &calc.member[offsetof(PokemonPartyGenII, max_hp)],
+                &up.member[offsetof(PokemonPartyGenII, max_hp)],
+                sizeof(PokemonPartyGenII) - offsetof(PokemonPartyGenII, max_hp)) == 0);
+
+        /* And back down, the same Pokemon, even in place */
+        furi_check(pokemon_convert(&up, GEN_I, &down) == CONVERT_OK);
+        GEN_I_MEMBER(&down)->catch_held = catch_rate;
+        furi_check(memcmp(&raw, &down, sizeof(PokemonRaw)) == 0);
+        if(catch_item(catch_rate) == catch_rate) {
+            furi_check(pokemon_convert(&up, GEN_I, &up) == CONVERT_OK);
+            furi_check(memcmp(&raw, &up, sizeof(PokemonRaw)) == 0);
+        }
+
+        /* Same gen is a copy */
+        furi_check(pokemon_convert(&raw, GEN_I, &down) == CONVERT_OK);
+        furi_check(memcmp(&raw, &down, sizeof(PokemonRaw)) == 0);
+    }
+}
+
+static void reject_test(PokemonData* gen_i, PokemonData* gen_ii) {
+    PokemonRaw raw;
+    PokemonRaw out;
+    uint8_t* move;
+    int num;
+
+    for(num = 0; num <= gen_ii->dex_max; num++) {
+        pokemon_stat_set(gen_ii, 0, STAT_NUM, NONE, num);
+        pokemon_stat_set(gen_ii, 0, STAT_LEVEL, NONE, 50);
+        pokemon_recalculate_pending(gen_ii);
+        pokemon_raw_get(gen_ii, 0, &raw);
+
+        if(num >= GEN_I_DEX_CNT) {
+            furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_ERR_SPECIES);
+            continue;
+        }
+
+        /* The default moves are all Gen I moves */
+        furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_OK);
+        furi_check(
+            out.member[0] ==
+            table_stat_base_get(gen_i->pokemon_table, num, STAT_BASE_INDEX, NONE));
+
+        move = GEN_II_MEMBER(&raw)->move;
+        move[MOVE_0] = MOVE_AEROBLAST;
+        furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_ERR_MOVE);
+        move[MOVE_0] = 0x21; // Tackle
+        move[MOVE_3] = MOVE_BEAT_UP;
+        furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_ERR_MOVE);
+        move[MOVE_3] = MOVE_SKETCH;
+        furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_ERR_MOVE);
+        move[MOVE_3] = 0;
+        furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_OK);
+
+        raw.species = 0xFD; // Egg
+        furi_check(pokemon_convert(&raw, GEN_I, &out) == CONVERT_ERR_SPECIES);
+    }
+
+    /* Gen I indices that aren't a species */
+    pokemon_raw_get(gen_i, 0, &raw);
+    raw.member[0] = 0x1F;
+    furi_check(pokemon_convert(&raw, GEN_II, &out) == CONVERT_ERR_SPECIES);
+    raw.member[0] = 0;
+    furi_check(pokemon_convert(&raw, GEN_II, &out) == CONVERT_ERR_SPECIES);
+
+    raw.gen = GEN_II + 1;
+    furi_check(pokemon_convert(&raw, GEN_II, &out) == CONVERT_ERR_GEN);
+    pokemon_raw_get(gen_i, 0, &raw);
+    furi_check(pokemon_convert(&raw, GEN_II + 1, &out) == CONVERT_ERR_GEN);
+}
+
+int main(void) {
+    PokemonData* gen_i = pokemon_data_alloc(GEN_I);
+    PokemonData* gen_ii = pokemon_data_alloc(GEN_II);
+    int num;
+
+    srand(1);
+    for(num = 0; num < GEN_I_DEX_CNT; num++) species_test(gen_i, gen_ii, num);
+    reject_test(gen_i, gen_ii);
+
+    pokemon_data_free(gen_ii);
+    pokemon_data_free(gen_i);
+
+    return 0;
+}
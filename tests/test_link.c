@@ -0,0 +1,101 @@
+/* Runs the scripted link partner in src/views/trade_sim.c against the trade
+ * view, for both gens and with a party of one and a full party. The partner
+ * checks every byte of the trade centre and colosseum sessions, and logs
+ * the handler's throughput.
+ *
+ * The view is entered the way the firmware would, which runs the partner
+ * once before the trace is started. The partner is then run again with the
+ * trace recording, flushing it as it goes. The trace ends when the partner
+ * links up again for the colosseum, and must hold the whole trade, many times
+ * the size of the ring, with nothing dropped, and replay without diverging.
+ * Every Pokemon the partner trades to the Flipper must end up in the box.
+ */
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <shim.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_box.h>
+#include <src/include/pokemon_data.h>
+
+#include <src/views/trade_i.h>
+
+#define TRACE_PATH(ts) TRADE_TRACE_DIR "/link_" #ts ".pktr"
+#define TRACE_PATH_EXPAND(ts) TRACE_PATH(ts)
+
+/* The trace must have every record, up to the end of the trade */
+static void trace_check(Storage* storage, uint8_t gen) {
+    File* file = storage_file_alloc(storage);
+    struct trade_trace_hdr hdr;
+    struct trade_trace_rec rec;
+    uint64_t offs;
+    uint64_t size;
+
+    furi_check(storage_file_open(
+        file, TRACE_PATH_EXPAND(SHIM_RTC_TIMESTAMP), FSAM_READ, FSOM_OPEN_EXISTING));
+    furi_check(storage_file_read(file, &hdr, sizeof(hdr)) == sizeof(hdr));
+    furi_check(hdr.gen == gen);
+    furi_check(hdr.dropped == 0);
+
+    offs = sizeof(hdr) + hdr.trade_block_sz + ((gen == GEN_II) ? LEN_MAIL_BLOCK : 0);
+
+    size = storage_file_size(file);
+    furi_check((size - offs) % sizeof(rec) == 0);
+    furi_check(storage_file_seek(file, size - sizeof(rec), true));
+    furi_check(storage_file_read(file, &rec, sizeof(rec)) == sizeof(rec));
+    furi_check(rec.trade_centre_state == TRADE_RESET);
+    furi_check(rec.gameboy_status == GAMEBOY_TRADING);
+    FURI_LOG_I(TAG, "[test] %d records in the trace", (int)((size - offs) / sizeof(rec)));
+
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+static void link_run(uint8_t gen, uint8_t party_cnt) {
+    ViewDispatcher* view_dispatcher = view_dispatcher_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    struct pokemon_box* box;
+    struct trade_ctx* trade;
+
+    FURI_LOG_I(TAG, "[test] gen %d, %d in party", gen, party_cnt);
+
+    while(pokemon_party_cnt_get(pdata) < party_cnt) pokemon_party_add(pdata);
+
+    storage_common_remove(storage, POKEMON_BOX_PATH);
+    box = pokemon_box_open(storage, POKEMON_BOX_PATH);
+    furi_check(box);
+
+    trade = trade_alloc(pdata, NULL, box, view_dispatcher, AppViewTrade);
+    furi_check(trade);
+
+    shim_view_enter(view_dispatcher, AppViewTrade);
+    furi_check(trade->trace);
+    trade_sim_run(trade);
+    shim_timer_fire(trade->draw_timer);
+    shim_view_draw(view_dispatcher, AppViewTrade);
+    shim_view_exit(view_dispatcher, AppViewTrade);
+
+    trace_check(storage, gen);
+    furi_check(trade_trace_replay(TRACE_PATH_EXPAND(SHIM_RTC_TIMESTAMP)));
+
+    trade_free(view_dispatcher, AppViewTrade, trade);
+
+    /* One trade each time the partner ran */
+    furi_check(pokemon_box_count(box) == 2);
+    pokemon_box_close(box);
+
+    pokemon_data_free(pdata);
+    furi_record_close(RECORD_STORAGE);
+    view_dispatcher_free(view_dispatcher);
+}
+
+int main(void) {
+    link_run(GEN_I, 1);
+    link_run(GEN_I, PARTY_CNT_MAX);
+    link_run(GEN_II, 1);
+    link_run(GEN_II, PARTY_CNT_MAX);
+
+    return 0;
+}
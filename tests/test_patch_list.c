@@ -0,0 +1,297 @@
+/* The patch list against a reference built straight from the party bytes,
+ * both from scratch and when only the dirty bytes are rechecked.
+ *
+ * Then a benchmark of the link handler with both parties full of 0xFE, the
+ * worst case for the patch list, where every party byte needs a patch in
+ * each direction. A partner like the one in trade_sim.c walks up to the
+ * table and leaves BENCH_SESSIONS times, and every call in to the handler is
+ * timed. The fastest of those runs for each byte of the session, less the
+ * cost of reading the clock, is taken as its cost, which leaves out the host
+ * being preempted. The slowest byte and the average, for the whole session
+ * and for the patch list alone, are reported for each gen.
+ */
+
+#include <time.h>
+
+#include <furi.h>
+#include <shim.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/patch_list.h>
+#include <src/include/wire_image.h>
+
+#include <src/views/trade_i.h>
+
+#define BENCH_SESSIONS 1000
+
+/* Comfortably more than the bytes in one table session */
+#define BENCH_BYTES_MAX 2048
+
+/* Number of random single byte changes checked against a full rebuild */
+#define UPDATE_ROUNDS 2000
+
+struct bench {
+    struct trade_ctx* trade;
+    struct wire_image* partner;
+    const struct important_bytes* bytes;
+    uint8_t gen;
+
+    /* Position of the next byte in the session, and the fastest time seen
+     * for each position along with the state it was handled in.
+     */
+    size_t pos;
+    uint32_t clock_ns;
+    uint32_t best_ns[BENCH_BYTES_MAX];
+    uint8_t state[BENCH_BYTES_MAX];
+};
+
+/* The list plist_generate() should come up with for party */
+static size_t plist_reference(const uint8_t* party, size_t party_sz, uint8_t* ref) {
+    bool pt_2 = false;
+    size_t len = 0;
+    size_t offs;
+
+    for(offs = 0; offs < party_sz; offs++) {
+        if(party[offs] != SERIAL_NO_DATA_BYTE) continue;
+        if(offs >= 0xFC && !pt_2) {
+            ref[len++] = SERIAL_PATCH_LIST_PART_TERMINATOR;
+            pt_2 = true;
+        }
+        ref[len++] = pt_2 ? (offs - 0xFC + 1) : (offs + 1);
+    }
+    if(!pt_2) ref[len++] = SERIAL_PATCH_LIST_PART_TERMINATOR;
+    ref[len++] = SERIAL_PATCH_LIST_PART_TERMINATOR;
+
+    return len;
+}
+
+static void plist_check(struct patch_list* plist, PokemonData* pdata) {
+    uint8_t ref[PLIST_MAX_SZ];
+    size_t len = plist_reference(pdata->party, pdata->party_sz, ref);
+    size_t i;
+
+    for(i = 0; i < len; i++) furi_check(plist_index_get(plist, i) == ref[i]);
+
+    /* Past the end, and before the start, is always 0 */
+    furi_check(plist_index_get(plist, len) == 0);
+    furi_check(plist_index_get(plist, PLIST_MAX_SZ) == 0);
+    furi_check(plist_index_get(plist, -1) == 0);
+}
+
+/* Adding a party member leaves its stats to be calculated on the next
+ * update, that needs to happen first or it would overwrite val.
+ */
+static void party_fill(PokemonData* pdata, uint8_t val) {
+    while(pokemon_party_cnt_get(pdata) < PARTY_CNT_MAX) pokemon_party_add(pdata);
+    pokemon_recalculate_pending(pdata);
+    memset(pdata->party, val, pdata->party_sz);
+    pokemon_party_dirty_mark(pdata, 0, pdata->party_sz);
+}
+
+static void plist_test(uint8_t gen) {
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    struct patch_list* plist = plist_alloc();
+    uint8_t* party = pdata->party;
+    size_t offs;
+    int i;
+
+    /* Every byte, and then no byte, needing a patch */
+    party_fill(pdata, SERIAL_NO_DATA_BYTE);
+    plist_create(plist, pdata);
+    plist_check(plist, pdata);
+    furi_check(plist_index_get(plist, pdata->party_sz + 1) == SERIAL_PATCH_LIST_PART_TERMINATOR);
+    furi_check(plist_index_get(plist, pdata->party_sz + 2) == 0);
+
+    party_fill(pdata, 0x00);
+    furi_check(plist_update(plist, pdata));
+    plist_check(plist, pdata);
+    furi_check(!plist_update(plist, pdata));
+
+    /* Flip single bytes and only mark those dirty, the list must always match
+     * the party. A byte that stays or stops being 0xFE is as important as one
+     * that becomes 0xFE.
+     */
+    srand(gen);
+    for(i = 0; i < UPDATE_ROUNDS; i++) {
+        offs = rand() % pdata->party_sz;
+        party[offs] = (rand() & 1) ? SERIAL_NO_DATA_BYTE : (rand() & 0xFF);
+        pokemon_party_dirty_mark(pdata, offs, 1);
+        plist_update(plist, pdata);
+        plist_check(plist, pdata);
+    }
+
+    plist_free(plist);
+    pokemon_data_free(pdata);
+}
+
+static uint32_t bench_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec * 1000000000ULL) + now.tv_nsec);
+}
+
+static void bench_xfer(struct bench* bench, uint8_t out, uint8_t expect) {
+    uint8_t state = bench->trade->centre.state;
+    uint32_t start;
+    uint32_t ns;
+    uint8_t in;
+
+    start = bench_ns();
+    in = trade_link_byte(bench->trade, out);
+    ns = bench_ns() - start;
+    ns = (ns > bench->clock_ns) ? (ns - bench->clock_ns) : 0;
+
+    if(in != expect) {
+        FURI_LOG_E(
+            TAG,
+            "[bench] byte %zu: sent 0x%02X, expected 0x%02X, got 0x%02X",
+            bench->pos,
+            out,
+            expect,
+            in);
+        furi_crash("Benchmark link mismatch");
+    }
+
+    furi_check(bench->pos < BENCH_BYTES_MAX);
+    if(ns < bench->best_ns[bench->pos]) bench->best_ns[bench->pos] = ns;
+    bench->state[bench->pos] = state;
+    bench->pos++;
+}
+
+static void bench_echo(struct bench* bench, uint8_t out, size_t len) {
+    while(len--) bench_xfer(bench, out, out);
+}
+
+/* One trip to the table and back, see sim_table() in trade_sim.c */
+static void bench_session(struct bench* bench) {
+    struct wire_image* flipper = bench->trade->wire_image;
+    struct wire_image* partner = bench->partner;
+    size_t i;
+
+    bench->pos = 0;
+
+    bench_echo(bench, PKMN_BLANK, 3);
+    bench_echo(bench, SERIAL_PREAMBLE_BYTE, SERIAL_RNS_LENGTH);
+    for(i = 0; i < SERIAL_RNS_LENGTH; i++) bench_echo(bench, (uint8_t)(i * 37 + 11), 1);
+    bench_echo(bench, SERIAL_PREAMBLE_BYTE, WIRE_RANDOM_SZ - SERIAL_RNS_LENGTH);
+
+    for(i = partner->data_offs; i < partner->patch_offs; i++)
+        bench_xfer(bench, partner->tx[i], flipper->tx[i]);
+
+    bench_echo(bench, 0xDF, 1);
+    bench_echo(bench, SERIAL_NO_DATA_BYTE, 1);
+    bench_echo(bench, 0x15, 1);
+    bench_echo(bench, SERIAL_PREAMBLE_BYTE, 6);
+    bench_echo(bench, PKMN_BLANK, WIRE_PATCH_ECHO_SZ - 1);
+
+    for(i = partner->patch_offs + WIRE_PATCH_ECHO_SZ; i < partner->mail_offs; i++)
+        bench_xfer(bench, partner->tx[i], flipper->tx[i]);
+
+    if(bench->gen == GEN_II) {
+        bench_echo(bench, SERIAL_MAIL_PREAMBLE_BYTE, WIRE_MAIL_PREAMBLE_SZ);
+        for(i = partner->mail_offs + WIRE_MAIL_PREAMBLE_SZ; i < partner->len; i++)
+            bench_xfer(bench, partner->tx[i], flipper->tx[i]);
+    }
+
+    bench_echo(bench, PKMN_BLANK, 1);
+    bench_echo(bench, bench->bytes->table_leave, 1);
+    furi_check(trade_status_get(bench->trade) == GAMEBOY_READY);
+}
+
+static void bench_report(struct bench* bench, const char* what, int state) {
+    uint32_t worst = 0;
+    uint64_t total = 0;
+    size_t cnt = 0;
+    size_t i;
+
+    for(i = 0; i < bench->pos; i++) {
+        if(state >= 0 && bench->state[i] != state) continue;
+        if(bench->best_ns[i] > worst) worst = bench->best_ns[i];
+        total += bench->best_ns[i];
+        cnt++;
+    }
+    furi_check(cnt);
+
+    FURI_LOG_I(
+        TAG,
+        "[bench] gen %d %s: %zu bytes, worst %u ns/byte, average %u ns/byte",
+        bench->gen,
+        what,
+        cnt,
+        worst,
+        (uint32_t)(total / cnt));
+}
+
+static void bench_run(uint8_t gen) {
+    struct bench* bench = malloc(sizeof(struct bench));
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    PokemonData* partner = pokemon_data_alloc(gen);
+    struct patch_list* plist = plist_alloc();
+    uint32_t start;
+    uint32_t ns;
+    int i;
+
+    furi_check(bench);
+    bench->gen = gen;
+    bench->bytes = (gen == GEN_I) ? &gen_i : &gen_ii;
+    bench->clock_ns = UINT32_MAX;
+    for(i = 0; i < BENCH_SESSIONS; i++) {
+        start = bench_ns();
+        ns = bench_ns() - start;
+        if(ns < bench->clock_ns) bench->clock_ns = ns;
+    }
+    memset(bench->best_ns, 0xFF, sizeof(bench->best_ns));
+
+    party_fill(pdata, SERIAL_NO_DATA_BYTE);
+    party_fill(partner, SERIAL_NO_DATA_BYTE);
+    plist_create(plist, partner);
+    bench->partner = wire_image_alloc();
+    wire_image_build(bench->partner, partner, plist);
+
+    bench->trade = trade_headless_alloc(
+        gen, pdata->trade_block, pdata->mail, GAMEBOY_CONN_FALSE, TRADE_RESET);
+
+    /* Connect and pick the trade centre, see sim_connect() and sim_menu() */
+    bench_xfer(bench, PKMN_MASTER, PKMN_SLAVE);
+    bench_echo(bench, PKMN_BLANK, 3);
+    bench_echo(bench, bench->bytes->connected, 1);
+    bench_echo(bench, PKMN_BLANK, 3);
+    bench_echo(bench, ITEM_1_HIGHLIGHTED, 3);
+    bench_xfer(bench, PKMN_TRADE_CENTRE, PKMN_BLANK);
+    furi_check(trade_status_get(bench->trade) == GAMEBOY_READY);
+
+    memset(bench->best_ns, 0xFF, sizeof(bench->best_ns));
+    for(i = 0; i < BENCH_SESSIONS; i++) bench_session(bench);
+
+    /* The list on the wire only has room for WIRE_PATCH_SZ - WIRE_PATCH_ECHO_SZ
+     * entries, the same as the Game Boy's, so that is how much of a party
+     * full of 0xFE gets patched back in.
+     */
+    furi_check(
+        memcmp(
+            bench->trade->input_pdata->party,
+            partner->party,
+            WIRE_PATCH_SZ - WIRE_PATCH_ECHO_SZ) == 0);
+
+    bench_report(bench, "session", -1);
+    bench_report(bench, "patch list", TRADE_PATCH_DATA);
+
+    trade_headless_free(bench->trade);
+    wire_image_free(bench->partner);
+    plist_free(plist);
+    pokemon_data_free(partner);
+    pokemon_data_free(pdata);
+    free(bench);
+}
+
+int main(void) {
+    plist_test(GEN_I);
+    plist_test(GEN_II);
+
+    bench_run(GEN_I);
+    bench_run(GEN_II);
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+/* Round trips .pk1 and .pk2 files, first a corpus of random Pokemon through
+ * the encoder and decoder, then whole parties through export and import on
+ * the SD card.
+ *
+ * Every file must decode back to exactly what it was encoded from and encode
+ * back to the same bytes. A file that is cut short, has a bad party list, or
+ * has a name with no terminator must be rejected. Import must pick the first
+ * PARTY_CNT_MAX well formed files in name order, skip everything else in the
+ * directory, and convert files from the other gen.
+ */
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_char_encode.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/pokemon_pkx.h>
+
+#define CORPUS_SZ 2000
+
+#define TEST_DIR PKX_DIR "/test"
+#define EMPTY_DIR PKX_DIR "/empty"
+
+/* Where member starts in a file */
+#define PKX_MEMBER_OFFS PKX_HDR_SZ
+
+/* A random Pokemon, sometimes a Gen II egg, with names that end somewhere */
+static void raw_random(PokemonRaw* raw, uint8_t gen) {
+    size_t member_sz = pokemon_pkx_size(gen) - PKX_HDR_SZ - (2 * LEN_NAME_BUF);
+    size_t i;
+
+    memset(raw, '\0', sizeof(PokemonRaw));
+    raw->gen = gen;
+    for(i = 0; i < member_sz; i++) raw->member[i] = rand();
+    raw->member[0] = 1 + (rand() % 250);
+    raw->species = (gen == GEN_II && (rand() % 8) == 0) ? 0xFD : raw->member[0];
+    for(i = 0; i < LEN_NAME_BUF; i++) {
+        raw->ot_name[i] = rand();
+        raw->nickname[i] = rand();
+    }
+    raw->ot_name[rand() % LEN_NAME_BUF] = TERM_;
+    raw->nickname[rand() % LEN_NAME_BUF] = TERM_;
+}
+
+static void corpus_test(uint8_t gen) {
+    uint8_t buf[PKX_FILE_SZ_MAX];
+    uint8_t bad[PKX_FILE_SZ_MAX];
+    PokemonRaw raw;
+    PokemonRaw out;
+    size_t len;
+    int i;
+
+    srand(gen);
+    for(i = 0; i < CORPUS_SZ; i++) {
+        raw_random(&raw, gen);
+        len = pokemon_pkx_encode(&raw, buf, sizeof(buf));
+        furi_check(len == pokemon_pkx_size(gen));
+        furi_check(buf[0] == 1 && buf[1] == raw.species && buf[2] == 0xFF);
+
+        furi_check(pokemon_pkx_decode(buf, len, &out));
+        furi_check(memcmp(&raw, &out, sizeof(PokemonRaw)) == 0);
+        furi_check(pokemon_pkx_encode(&out, bad, sizeof(bad)) == len);
+        furi_check(memcmp(buf, bad, len) == 0);
+
+        /* Too short, in either direction */
+        furi_check(!pokemon_pkx_decode(buf, len - 1, &out));
+        furi_check(pokemon_pkx_encode(&raw, bad, len - 1) == 0);
+
+        /* A party list that isn't one Pokemon */
+        memcpy(bad, buf, len);
+        bad[0] = 2;
+        furi_check(!pokemon_pkx_decode(bad, len, &out));
+        memcpy(bad, buf, len);
+        bad[2] = 0;
+        furi_check(!pokemon_pkx_decode(bad, len, &out));
+
+        /* The list and the party struct disagreeing on the species */
+        memcpy(bad, buf, len);
+        bad[1] ^= 0x40;
+        if(bad[1] != 0xFD && bad[1] != bad[PKX_MEMBER_OFFS])
+            furi_check(!pokemon_pkx_decode(bad, len, &out));
+
+        /* A nickname that never ends */
+        memcpy(bad, buf, len);
+        memset(&bad[len - LEN_NAME_BUF], TERM_ + 1, LEN_NAME_BUF);
+        furi_check(!pokemon_pkx_decode(bad, len, &out));
+    }
+}
+
+static void file_write(Storage* storage, const char* path, const void* buf, size_t len) {
+    File* file = storage_file_alloc(storage);
+
+    furi_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    furi_check(storage_file_write(file, buf, len) == len);
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+/* Empty dir of files and empty directories left by an earlier run */
+static void dir_clear(Storage* storage, const char* dir) {
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    char name[256];
+    bool found = true;
+
+    while(found) {
+        found = storage_dir_open(file, dir) && storage_dir_read(file, NULL, name, sizeof(name));
+        storage_dir_close(file);
+        if(found) {
+            furi_string_printf(path, "%s/%s", dir, name);
+            furi_check(storage_common_remove(storage, furi_string_get_cstr(path)) == FSE_OK);
+        }
+    }
+
+    furi_string_free(path);
+    storage_file_free(file);
+}
+
+static void slot_check(PokemonData* a, uint8_t a_slot, PokemonData* b, uint8_t b_slot) {
+    PokemonRaw a_raw;
+    PokemonRaw b_raw;
+
+    pokemon_raw_get(a, a_slot, &a_raw);
+    pokemon_raw_get(b, b_slot, &b_raw);
+    furi_check(memcmp(&a_raw, &b_raw, sizeof(PokemonRaw)) == 0);
+}
+
+static void party_test(Storage* storage, uint8_t gen) {
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    PokemonData* in = pokemon_data_alloc(gen);
+    uint8_t other = (gen == GEN_I) ? GEN_II : GEN_I;
+    uint8_t buf[PKX_FILE_SZ_MAX];
+    FuriString* path = furi_string_alloc();
+    PokemonRaw raw;
+    size_t len;
+    uint8_t i;
+
+    storage_simply_mkdir(storage, PKX_DIR);
+    storage_simply_mkdir(storage, TEST_DIR);
+    dir_clear(storage, TEST_DIR);
+
+    /* Export 5, and import them over a party of 2 */
+    for(i = 1; i < 5; i++) {
+        pokemon_party_add(pdata);
+        pokemon_stat_set(pdata, i, STAT_NUM, NONE, i * 20);
+        pokemon_stat_set(pdata, i, STAT_LEVEL, NONE, 10 + (i * 7));
+    }
+    pokemon_name_set(pdata, 2, STAT_NICKNAME, "MR. MIME");
+    furi_check(pokemon_pkx_party_export(pdata, storage, TEST_DIR) == 5);
+    furi_string_printf(path, "%s/3_MR__MIME%s", TEST_DIR, pokemon_pkx_ext(gen));
+    furi_check(storage_file_exists(storage, furi_string_get_cstr(path)));
+
+    pokemon_party_add(in);
+    furi_check(pokemon_pkx_party_import(in, storage, TEST_DIR) == 5);
+    furi_check(pokemon_party_cnt_get(in) == 5);
+    for(i = 0; i < 5; i++) slot_check(pdata, i, in, i);
+
+    /* Junk, directories, the other gen's extension, upper case, and one more
+     * than fits in the party, which sorts last and is left out.
+     */
+    file_write(storage, TEST_DIR "/0_junk.pk1", "junk", 4);
+    file_write(storage, TEST_DIR "/0_junk.pk2", "junk", 4);
+    storage_simply_mkdir(storage, TEST_DIR "/0_dir.pk1");
+    storage_simply_mkdir(storage, TEST_DIR "/0_dir.pk2");
+
+    pokemon_raw_get(pdata, 3, &raw);
+    len = pokemon_pkx_encode(&raw, buf, sizeof(buf));
+    file_write(
+        storage, (gen == GEN_I) ? TEST_DIR "/0_A.PK1" : TEST_DIR "/0_A.PK2", buf, len);
+    furi_string_printf(path, "%s/0_B%s", TEST_DIR, pokemon_pkx_ext(other));
+    file_write(storage, furi_string_get_cstr(path), buf, len);
+    furi_string_printf(path, "%s/9_Z%s", TEST_DIR, pokemon_pkx_ext(gen));
+    file_write(storage, furi_string_get_cstr(path), buf, len);
+
+    pokemon_data_free(in);
+    in = pokemon_data_alloc(gen);
+    furi_check(pokemon_pkx_party_import(in, storage, TEST_DIR) == PARTY_CNT_MAX);
+    slot_check(pdata, 3, in, 0);
+    slot_check(pdata, 3, in, 1);
+    for(i = 0; i < 4; i++) slot_check(pdata, i, in, i + 2);
+
+    /* Nothing to import leaves the party alone */
+    furi_check(pokemon_pkx_party_import(in, storage, EMPTY_DIR) == 0);
+    furi_check(pokemon_party_cnt_get(in) == PARTY_CNT_MAX);
+    slot_check(pdata, 3, in, 0);
+
+    /* The same party exported by the other gen is converted on import */
+    dir_clear(storage, TEST_DIR);
+    pokemon_data_free(in);
+    in = pokemon_data_alloc(other);
+    for(i = 1; i < 5; i++) pokemon_party_add(in);
+    for(i = 0; i < 5; i++) pokemon_stat_set(in, i, STAT_NUM, NONE, (i * 20) + 1);
+    furi_check(pokemon_pkx_party_export(in, storage, TEST_DIR) == 5);
+    furi_check(pokemon_pkx_party_import(pdata, storage, TEST_DIR) == 5);
+    for(i = 0; i < 5; i++) {
+        furi_check(
+            pokemon_stat_get(pdata, i, STAT_NUM, NONE) ==
+            pokemon_stat_get(in, i, STAT_NUM, NONE));
+    }
+
+    furi_string_free(path);
+    pokemon_data_free(in);
+    pokemon_data_free(pdata);
+}
+
+int main(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    furi_check(PK1_FILE_SZ == 69 && PK2_FILE_SZ == 73);
+
+    corpus_test(GEN_I);
+    corpus_test(GEN_II);
+
+    party_test(storage, GEN_I);
+    party_test(storage, GEN_II);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
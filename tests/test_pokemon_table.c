@@ -0,0 +1,148 @@
+/* Checks the generated pokemon_index_pos against pokemon_table itself, in both
+ * directions.
+ *
+ * From index to position, every one of the 256 indices must give the first
+ * entry in the table with that index, or the first entry if there is none.
+ * From position to index, every Gen I species' index must lead straight back
+ * to it.
+ *
+ * The experience tables are checked against the published formula for each
+ * growth rate at every level, and the level lookup against a plain walk up
+ * those levels for every amount of experience up to past level 100.
+ */
+
+#include <math.h>
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/pokemon_table.h>
+
+/* Experience past level 100 that the level lookup is also checked for */
+#define EXP_OVER 1000
+
+/* a / b * n^3 + c * n^2 + d * n + e for each growth rate */
+static const int growth_coeff[GROWTH_COUNT][5] = {
+    [GROWTH_MEDIUM_FAST] = {1, 1, 0, 0, 0},
+    [GROWTH_SLIGHTLY_FAST] = {3, 4, 10, 0, -30},
+    [GROWTH_SLIGHTLY_SLOW] = {3, 4, 20, 0, -70},
+    [GROWTH_MEDIUM_SLOW] = {6, 5, -15, 100, -140},
+    [GROWTH_FAST] = {4, 5, 0, 0, 0},
+    [GROWTH_SLOW] = {5, 4, 0, 0, 0},
+};
+
+/* First entry in the table with index, found the slow way */
+static int index_reference(const PokemonTable* table, int table_sz, uint8_t index) {
+    int pos;
+
+    for(pos = 0; pos < table_sz; pos++) {
+        if(table_stat_base_get(table, pos, STAT_BASE_INDEX, NONE) == index) return pos;
+    }
+
+    return 0;
+}
+
+static void index_test(void) {
+    PokemonData* pdata = pokemon_data_alloc(GEN_II);
+    const PokemonTable* table = pdata->pokemon_table;
+    /* Gen II goes to the end of the table */
+    int table_sz = pdata->dex_max + 1;
+    uint8_t index;
+    int pos;
+    int ref;
+    int i;
+
+    for(i = 0; i < 256; i++) {
+        ref = index_reference(table, table_sz, i);
+        pos = table_pokemon_pos_get(table, i);
+        if(pos != ref) {
+            FURI_LOG_E(TAG, "[test] index 0x%02X: got %d, expected %d", i, pos, ref);
+            furi_crash("Index map mismatch");
+        }
+    }
+
+    /* Every Gen I species has its own index, only the Gen II ones share 0 */
+    pokemon_data_free(pdata);
+    pdata = pokemon_data_alloc(GEN_I);
+    table = pdata->pokemon_table;
+    for(pos = 0; pos <= pdata->dex_max; pos++) {
+        index = table_stat_base_get(table, pos, STAT_BASE_INDEX, NONE);
+        furi_check(index);
+        if(table_pokemon_pos_get(table, index) != pos) {
+            FURI_LOG_E(
+                TAG,
+                "[test] %s, index 0x%02X: got %d back",
+                table_stat_name_get(table, pos),
+                index,
+                table_pokemon_pos_get(table, index));
+            furi_crash("Index map mismatch");
+        }
+    }
+
+    pokemon_data_free(pdata);
+}
+
+/* The formula, rounded down, with anything below 0 at the lowest levels
+ * taken as 0
+ */
+static uint32_t exp_reference(Growth growth, int level) {
+    const int* k = growth_coeff[growth];
+    double n = level;
+    double exp;
+
+    exp = floor((k[0] * n * n * n) / k[1]) + (k[2] * n * n) + (k[3] * n) + k[4];
+    return (exp < 0) ? 0 : exp;
+}
+
+static void exp_test(void) {
+    uint32_t exp;
+    uint32_t ref;
+    Growth growth;
+    int level;
+
+    for(growth = 0; growth < GROWTH_COUNT; growth++) {
+        for(level = LEVEL_MIN; level <= LEVEL_MAX; level++) {
+            ref = exp_reference(growth, level);
+            if(table_exp_get(growth, level) != ref) {
+                FURI_LOG_E(
+                    TAG,
+                    "[test] growth %d level %d: got %u, expected %u",
+                    growth,
+                    level,
+                    table_exp_get(growth, level),
+                    ref);
+                furi_crash("Experience mismatch");
+            }
+        }
+
+        /* Out of range levels are clamped */
+        furi_check(table_exp_get(growth, 0) == exp_reference(growth, LEVEL_MIN));
+        furi_check(table_exp_get(growth, LEVEL_MAX + 1) == exp_reference(growth, LEVEL_MAX));
+        furi_check(table_exp_get(growth, UINT8_MAX) == exp_reference(growth, LEVEL_MAX));
+
+        /* Every amount of experience, walking the level up as it is reached */
+        level = LEVEL_MIN;
+        for(exp = 0; exp <= exp_reference(growth, LEVEL_MAX) + EXP_OVER; exp++) {
+            while(level < LEVEL_MAX && exp_reference(growth, level + 1) <= exp) level++;
+            if(table_level_get(growth, exp) != level) {
+                FURI_LOG_E(
+                    TAG,
+                    "[test] growth %d exp %u: got level %d, expected %d",
+                    growth,
+                    exp,
+                    table_level_get(growth, exp),
+                    level);
+                furi_crash("Level mismatch");
+            }
+        }
+        furi_check(table_level_get(growth, UINT32_MAX) == LEVEL_MAX);
+    }
+}
+
+int main(void) {
+    index_test();
+    exp_test();
+
+    return 0;
+}
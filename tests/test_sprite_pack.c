@@ -0,0 +1,245 @@
+/* Checks the compressed sprite pack against the legacy one, which the
+ * Makefile writes from the same sprites/ with tools/sprite_pack.py --fxbm.
+ *
+ * Every sprite must come out of the sprite cache the same from either pack,
+ * both when read directly and when loaded by the prefetch thread. Truncated
+ * or extended sprite data must be rejected by the decoder.
+ *
+ * Then a benchmark of the decoder over the whole pack, against copying the
+ * same sprites out of the legacy pack. As in test_patch_list.c, the fastest
+ * of BENCH_ROUNDS runs is taken as the cost of each.
+ */
+
+#include <time.h>
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/sprite_cache.h>
+#include <src/include/sprite_pack.h>
+
+#define PACK_PATH APP_ASSETS_PATH("all_sprites.pksp")
+#define LEGACY_PATH "/ext/legacy/all_sprites.fxbm"
+
+#define SPRITE_WIDTH 56
+#define SPRITE_HEIGHT 56
+
+/* Each legacy sprite is a 4 byte length, then its struct fxbm_sprite */
+#define LEGACY_SPRITE_SIZE(data_sz) (sizeof(uint32_t) + sizeof(struct fxbm_sprite) + (data_sz))
+
+#define BENCH_ROUNDS 200
+
+/* How long to wait for the prefetch thread */
+#define PREFETCH_TIMEOUT_MS 5000
+
+struct pack {
+    uint8_t* data;
+    size_t len;
+    const struct sprite_pack_hdr* hdr;
+    const uint32_t* index;
+};
+
+static uint8_t* file_load(Storage* storage, const char* path, size_t* len) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* data;
+
+    furi_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    *len = storage_file_size(file);
+    data = malloc(*len);
+    furi_check(data);
+    furi_check(storage_file_read(file, data, *len) == *len);
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return data;
+}
+
+static void pack_load(Storage* storage, struct pack* pack) {
+    pack->data = file_load(storage, PACK_PATH, &pack->len);
+    furi_check(pack->len > sizeof(struct sprite_pack_hdr));
+    pack->hdr = (const struct sprite_pack_hdr*)pack->data;
+    pack->index = (const uint32_t*)(pack->data + sizeof(struct sprite_pack_hdr));
+
+    furi_check(memcmp(pack->hdr->magic, SPRITE_PACK_MAGIC, sizeof(pack->hdr->magic)) == 0);
+    furi_check(pack->hdr->width == SPRITE_WIDTH && pack->hdr->height == SPRITE_HEIGHT);
+    furi_check(pack->index[pack->hdr->count] == pack->len);
+}
+
+static const uint8_t* pack_sprite(const struct pack* pack, int num, size_t* len) {
+    *len = pack->index[num] - pack->index[num - 1];
+    return pack->data + pack->index[num - 1];
+}
+
+static bool sprite_same(const struct fxbm_sprite* a, const struct fxbm_sprite* b, size_t data_sz) {
+    return a && b && a->width == b->width && a->height == b->height &&
+           memcmp(a->data, b->data, data_sz) == 0;
+}
+
+/* Both packs, through the cache, one sprite at a time */
+static void cache_test(Storage* storage, int count, size_t data_sz) {
+    struct sprite_cache* cache = sprite_cache_alloc(storage, PACK_PATH);
+    struct sprite_cache* legacy = sprite_cache_alloc(storage, LEGACY_PATH);
+    const struct fxbm_sprite* sprite;
+    int num;
+
+    for(num = 1; num <= count; num++) {
+        sprite = sprite_cache_get(cache, num);
+        furi_check(sprite && sprite->width == SPRITE_WIDTH && sprite->height == SPRITE_HEIGHT);
+        if(!sprite_same(sprite, sprite_cache_get(legacy, num), data_sz)) {
+            FURI_LOG_E(TAG, "[test] sprite %d differs from the legacy pack", num);
+            furi_crash("Sprite mismatch");
+        }
+    }
+    furi_check(!sprite_cache_get(cache, count + 1));
+    furi_check(!sprite_cache_get(legacy, count + 1));
+
+    sprite_cache_free(legacy);
+    sprite_cache_free(cache);
+}
+
+static void prefetch_done(void* context) {
+    __atomic_add_fetch((uint32_t*)context, 1, __ATOMIC_RELAXED);
+}
+
+/* The same, with every sprite loaded ahead of time by the prefetch thread.
+ * A sprite already loaded by an earlier request isn't loaded again, and there
+ * is no callback for it, so the cache itself is polled.
+ */
+static void prefetch_test(Storage* storage, int count, size_t data_sz) {
+    struct sprite_cache* cache = sprite_cache_alloc(storage, PACK_PATH);
+    struct sprite_cache* legacy = sprite_cache_alloc(storage, LEGACY_PATH);
+    const struct fxbm_sprite* sprite;
+    uint32_t callbacks = 0;
+    uint32_t waited;
+    int num;
+
+    sprite_cache_callback_set(cache, prefetch_done, &callbacks);
+    for(num = 1; num <= count; num++) {
+        sprite_cache_prefetch(cache, num, 1, 1, count);
+        for(waited = 0; !(sprite = sprite_cache_peek(cache, num)); waited++) {
+            furi_check(waited < PREFETCH_TIMEOUT_MS);
+            furi_delay_ms(1);
+        }
+        furi_check(sprite_same(sprite, sprite_cache_get(legacy, num), data_sz));
+    }
+    sprite_cache_callback_set(cache, NULL, NULL);
+    furi_check(__atomic_load_n(&callbacks, __ATOMIC_RELAXED));
+
+    sprite_cache_free(legacy);
+    sprite_cache_free(cache);
+}
+
+/* A coded sprite with a byte missing or a byte too many must not decode */
+static void decode_reject_test(const struct pack* pack, size_t data_sz) {
+    uint8_t* dest = malloc(data_sz);
+    uint8_t* src = malloc(data_sz + 1);
+    const uint8_t* sprite;
+    size_t len;
+    int num;
+
+    furi_check(dest && src);
+    for(num = 1; num <= pack->hdr->count; num++) {
+        sprite = pack_sprite(pack, num, &len);
+        if(len == data_sz) continue;
+
+        memcpy(src, sprite, len);
+        src[len] = 0xFF;
+        furi_check(!sprite_pack_decode(dest, src, len - 1, SPRITE_WIDTH, SPRITE_HEIGHT));
+        furi_check(!sprite_pack_decode(dest, src, len + 1, SPRITE_WIDTH, SPRITE_HEIGHT));
+        furi_check(sprite_pack_decode(dest, src, len, SPRITE_WIDTH, SPRITE_HEIGHT));
+    }
+
+    free(src);
+    free(dest);
+}
+
+static uint64_t bench_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+static void bench_run(const struct pack* pack, const uint8_t* legacy, size_t data_sz) {
+    uint8_t* dest = malloc(data_sz);
+    volatile uint8_t sink = 0;
+    uint64_t decode_ns = UINT64_MAX;
+    uint64_t copy_ns = UINT64_MAX;
+    uint64_t start;
+    uint64_t ns;
+    const uint8_t* sprite;
+    size_t stored = 0;
+    size_t len;
+    int count = pack->hdr->count;
+    int num;
+    int i;
+
+    furi_check(dest);
+    for(i = 0; i < BENCH_ROUNDS; i++) {
+        start = bench_ns();
+        for(num = 1; num <= count; num++) {
+            sprite = pack_sprite(pack, num, &len);
+            sprite_pack_decode(dest, sprite, len, SPRITE_WIDTH, SPRITE_HEIGHT);
+            sink ^= dest[data_sz / 2];
+        }
+        ns = bench_ns() - start;
+        if(ns < decode_ns) decode_ns = ns;
+
+        start = bench_ns();
+        for(num = 1; num <= count; num++) {
+            memcpy(
+                dest,
+                legacy + ((num - 1) * LEGACY_SPRITE_SIZE(data_sz)) + sizeof(uint32_t) +
+                    sizeof(struct fxbm_sprite),
+                data_sz);
+            sink ^= dest[data_sz / 2];
+        }
+        ns = bench_ns() - start;
+        if(ns < copy_ns) copy_ns = ns;
+    }
+
+    for(num = 1; num <= count; num++) {
+        pack_sprite(pack, num, &len);
+        stored += len;
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "[bench] %d sprites: decode %u ns/sprite, legacy copy %u ns/sprite",
+        count,
+        (uint32_t)(decode_ns / count),
+        (uint32_t)(copy_ns / count));
+    FURI_LOG_I(
+        TAG,
+        "[bench] %zu bytes stored, %zu%% of %zu raw",
+        stored,
+        (stored * 100) / (count * data_sz),
+        count * data_sz);
+
+    free(dest);
+}
+
+int main(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    size_t data_sz = sprite_pack_data_size(SPRITE_WIDTH, SPRITE_HEIGHT);
+    struct pack pack;
+    uint8_t* legacy;
+    size_t legacy_len;
+
+    pack_load(storage, &pack);
+    legacy = file_load(storage, LEGACY_PATH, &legacy_len);
+    furi_check(legacy_len == pack.hdr->count * LEGACY_SPRITE_SIZE(data_sz));
+
+    cache_test(storage, pack.hdr->count, data_sz);
+    prefetch_test(storage, pack.hdr->count, data_sz);
+    decode_reject_test(&pack, data_sz);
+    bench_run(&pack, legacy, data_sz);
+
+    free(legacy);
+    free(pack.data);
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/* Checks the integer stat engine bit for bit against the double math it
+ * replaced,
+ *     floor((((2 * (base + iv)) + floor(sqrt(ev) / 4)) * level) / 100)
+ * plus level + 10 for HP and 5 for everything else.
+ *
+ * pokemon_stat_calc() is checked at every EV for every level, and then for
+ * every base stat of every species at every level and IV. The EV only
+ * matters through floor(sqrt(ev) / 4), so that second pass takes the first
+ * and last EV giving each value of it. Last, pokemon_stats_calc() must agree
+ * for every species and level of both gens.
+ */
+
+#include <math.h>
+
+#include <furi.h>
+
+#include <src/include/pokemon_app.h>
+#include <src/include/pokemon_data.h>
+#include <src/include/pokemon_table.h>
+
+#define IV_MAX 15
+
+/* floor(sqrt(ev) / 4) runs up to this for a 16 bit EV */
+#define EV_TERM_MAX 63
+
+/* IV and EV sets for each species and level in the PokemonData pass */
+#define SPREADS 4
+
+static uint16_t
+    stat_reference(DataStat stat, uint8_t base, uint8_t iv, uint16_t ev, uint8_t level) {
+    uint16_t calc = floor((((2 * (base + iv)) + floor(sqrt(ev) / 4)) * level) / 100);
+
+    calc += (stat == STAT_HP) ? (level + 10) : 5;
+    return calc;
+}
+
+static void stat_check(DataStat stat, uint8_t base, uint8_t iv, uint16_t ev, uint8_t level) {
+    uint16_t val = pokemon_stat_calc(stat, base, iv, ev, level);
+    uint16_t ref = stat_reference(stat, base, iv, ev, level);
+
+    if(val != ref) {
+        FURI_LOG_E(
+            TAG,
+            "[test] stat %d base %d iv %d ev %d level %d: got %d, expected %d",
+            stat,
+            base,
+            iv,
+            ev,
+            level,
+            val,
+            ref);
+        furi_crash("Stat mismatch");
+    }
+}
+
+/* Every EV, at every level */
+static void stat_ev_test(void) {
+    uint32_t ev;
+    int level;
+
+    for(level = LEVEL_MIN; level <= LEVEL_MAX; level++) {
+        for(ev = 0; ev <= UINT16_MAX; ev++) {
+            stat_check(STAT_ATK, 255, IV_MAX, ev, level);
+            stat_check(STAT_HP, 255, IV_MAX, ev, level);
+        }
+    }
+}
+
+/* Every base stat used by any species, at every level and IV, and at both ends
+ * of the range of EVs that give each value of floor(sqrt(ev) / 4).
+ */
+static void stat_species_test(void) {
+    PokemonData* pdata = pokemon_data_alloc(GEN_II);
+    bool used[2][256] = {0};
+    uint16_t evs[(EV_TERM_MAX + 1) * 2];
+    uint32_t ev;
+    DataStat stat;
+    int hp;
+    int base;
+    int num;
+    int level;
+    int iv;
+    size_t i;
+
+    for(num = 0; num <= pdata->dex_max; num++) {
+        for(stat = STAT; stat < STAT_END; stat++)
+            used[stat == STAT_HP][table_stat_base_get(pdata->pokemon_table, num, stat, NONE)] =
+                true;
+    }
+    pokemon_data_free(pdata);
+
+    for(i = 0; i <= EV_TERM_MAX; i++) {
+        ev = 16 * i * i;
+        evs[i * 2] = ev;
+        ev = 16 * (i + 1) * (i + 1) - 1;
+        evs[(i * 2) + 1] = (ev > UINT16_MAX) ? UINT16_MAX : ev;
+    }
+
+    for(hp = 0; hp < 2; hp++) {
+        for(base = 0; base < 256; base++) {
+            if(!used[hp][base]) continue;
+            for(level = LEVEL_MIN; level <= LEVEL_MAX; level++) {
+                for(iv = 0; iv <= IV_MAX; iv++) {
+                    for(i = 0; i < COUNT_OF(evs); i++)
+                        stat_check(hp ? STAT_HP : STAT_ATK, base, iv, evs[i], level);
+                }
+            }
+        }
+    }
+}
+
+/* All stats at once, as recalculation does */
+static void stat_party_test(uint8_t gen) {
+    PokemonData* pdata = pokemon_data_alloc(gen);
+    const PokemonTable* table = pdata->pokemon_table;
+    DataStat stat;
+    uint16_t ev;
+    uint16_t iv;
+    uint16_t ref;
+    int num;
+    int level;
+    int k;
+
+    for(num = 0; num <= pdata->dex_max; num++) {
+        pokemon_stat_set(pdata, 0, STAT_NUM, NONE, num);
+        for(level = LEVEL_MIN; level <= LEVEL_MAX; level++) {
+            pokemon_stat_set(pdata, 0, STAT_LEVEL, NONE, level);
+            for(k = 0; k < SPREADS; k++) {
+                for(stat = STAT_ATK_EV; stat < STAT_EV_END; stat++) {
+                    ev = (k * 21845) + (level * 13) + stat;
+                    pokemon_stat_set(pdata, 0, stat, NONE, ev);
+                }
+                pokemon_stat_set(pdata, 0, STAT_IV, NONE, (k * 0x5A5A) + num);
+                pokemon_stats_calc(pdata, 0);
+
+                for(stat = STAT; stat < STAT_END; stat++) {
+                    if(gen == GEN_I && (stat == STAT_SPC_ATK || stat == STAT_SPC_DEF)) continue;
+                    if(gen == GEN_II && stat == STAT_SPC) continue;
+
+                    ev = pokemon_stat_get(pdata, 0, stat + STAT_EV_OFFS, NONE);
+                    iv = pokemon_stat_get(pdata, 0, stat + STAT_IV_OFFS, NONE);
+                    ref = stat_reference(
+                        stat,
+                        table_stat_base_get(
+                            table, pokemon_stat_get(pdata, 0, STAT_NUM, NONE), stat, NONE),
+                        iv,
+                        ev,
+                        level);
+                    furi_check(pokemon_stat_get(pdata, 0, stat, NONE) == ref);
+                }
+            }
+        }
+    }
+
+    pokemon_data_free(pdata);
+}
+
+int main(void) {
+    stat_ev_test();
+    stat_species_test();
+    stat_party_test(GEN_I);
+    stat_party_test(GEN_II);
+
+    return 0;
+}
@@ -0,0 +1,414 @@
+#!/usr/bin/env python3
+"""Generate the colosseum battle tables in src/battle_table.c.
+
+The moves and types are looked up by name in the items of move_list and
+type_list, src/move_nl.c and src/type_nl.c, so the indices always match what
+the rest of the app shows and sends. The Gen I species types come from
+src/pokemon_table.c. The battle data itself, power, type, and how each move
+deals damage, is kept here as it is not needed anywhere else.
+
+Everything after the GENERATED marker in src/battle_table.c is rewritten.
+
+Run from the root of the repository after changing any of the data below, or
+any of the lists it refers to:
+    python3 tools/battle_table_gen.py
+"""
+
+import re
+import sys
+from pathlib import Path
+
+MARKER = "/* Generated by tools/battle_table_gen.py, do not edit below this line */"
+
+OUT_FILE = "src/battle_table.c"
+
+ITEM_RE = re.compile(r'^\s*\{"((?:[^"\\]|\\.)*)", (0x[0-9A-Fa-f]+), [^}]+\},\s*$', re.M)
+SPECIES_RE = re.compile(
+    r'^    \{"([^"]+)",\n(?:\s+[^{\n]+\n)+\s+\{(0x[0-9A-F]+), (0x[0-9A-F]+)\},', re.M)
+
+# Gen II types, type_list only has those that can be set on a Gen I Pokemon
+EXTRA_TYPES = {"Steel": 0x09, "Dark": 0x1B}
+
+# Number of type indices, the highest is Dark
+TYPE_CNT = 0x1C
+
+# Flags, see src/include/battle_table.h
+LEVEL = "BATTLE_MOVE_LEVEL"
+FIXED = "BATTLE_MOVE_FIXED"
+HALF_HP = "BATTLE_MOVE_HALF_HP"
+
+# Average number of hits of a move that hits 2 to 5 times
+MULTI = 3
+
+# name: (power, type, PP, hits, flags). PP is without any PP Ups. Charging
+# moves only do damage every other turn and count as half a hit. Moves that do
+# no damage, or whose damage can't be worked out from the two Pokemon alone,
+# e.g. Counter, OHKO moves, and Dream Eater, aren't listed. Neither are Selfdestruct and Explosion, the
+# AI is never going to pick a move that faints its own Pokemon.
+MOVES_GEN_II = {
+    "Pound": (40, "Normal", 35),
+    "Karate Chop": (50, "Fighting", 25),
+    "Doubleslap": (15, "Normal", 10, MULTI),
+    "Comet Punch": (18, "Normal", 15, MULTI),
+    "Mega Punch": (80, "Normal", 20),
+    "Pay Day": (40, "Normal", 20),
+    "Fire Punch": (75, "Fire", 15),
+    "Ice Punch": (75, "Ice", 15),
+    "Thunderpunch": (75, "Electric", 15),
+    "Scratch": (40, "Normal", 35),
+    "Vicegrip": (55, "Normal", 30),
+    "Razor Wind": (80, "Normal", 10, 0.5),
+    "Cut": (50, "Normal", 30),
+    "Gust": (40, "Flying", 35),
+    "Wing Attack": (60, "Flying", 35),
+    "Fly": (70, "Flying", 15, 0.5),
+    "Bind": (15, "Normal", 20),
+    "Slam": (80, "Normal", 20),
+    "Vine Whip": (35, "Grass", 10),
+    "Stomp": (65, "Normal", 20),
+    "Double Kick": (30, "Fighting", 30, 2),
+    "Mega Kick": (120, "Normal", 5),
+    "Jump Kick": (70, "Fighting", 25),
+    "Rolling Kick": (60, "Fighting", 15),
+    "Headbutt": (70, "Normal", 15),
+    "Horn Attack": (65, "Normal", 25),
+    "Fury Attack": (15, "Normal", 20, MULTI),
+    "Tackle": (35, "Normal", 35),
+    "Body Slam": (85, "Normal", 15),
+    "Wrap": (15, "Normal", 20),
+    "Take Down": (90, "Normal", 20),
+    "Thrash": (90, "Normal", 20),
+    "Double-Edge": (120, "Normal", 15),
+    "Poison Sting": (15, "Poison", 35),
+    "Twineedle": (25, "Bug", 20, 2),
+    "Pin Missile": (14, "Bug", 20, MULTI),
+    "Bite": (60, "Dark", 25),
+    "Sonicboom": (20, "Normal", 20, 1, FIXED),
+    "Acid": (40, "Poison", 30),
+    "Ember": (40, "Fire", 25),
+    "Flamethrower": (95, "Fire", 15),
+    "Water Gun": (40, "Water", 25),
+    "Hydro Pump": (120, "Water", 5),
+    "Surf": (95, "Water", 15),
+    "Ice Beam": (95, "Ice", 10),
+    "Blizzard": (120, "Ice", 5),
+    "Psybeam": (65, "Psychic", 20),
+    "Bubblebeam": (65, "Water", 20),
+    "Aurora Beam": (65, "Ice", 20),
+    "Hyper Beam": (150, "Normal", 5),
+    "Peck": (35, "Flying", 35),
+    "Drill Peck": (80, "Flying", 20),
+    "Submission": (80, "Fighting", 25),
+    "Low Kick": (50, "Fighting", 20),
+    "Seismic Toss": (0, "Fighting", 20, 1, LEVEL),
+    "Strength": (80, "Normal", 15),
+    "Absorb": (20, "Grass", 20),
+    "Mega Drain": (40, "Grass", 10),
+    "Razor Leaf": (55, "Grass", 25),
+    "Solar Beam": (120, "Grass", 10, 0.5),
+    "Petal Dance": (70, "Grass", 20),
+    "Dragon Rage": (40, "Dragon", 10, 1, FIXED),
+    "Fire Spin": (15, "Fire", 15),
+    "Thundershock": (40, "Electric", 30),
+    "Thunderbolt": (95, "Electric", 15),
+    "Thunder": (120, "Electric", 10),
+    "Rock Throw": (50, "Rock", 15),
+    "Earthquake": (100, "Ground", 10),
+    "Dig": (60, "Ground", 10, 0.5),
+    "Confusion": (50, "Psychic", 25),
+    "Psychic": (90, "Psychic", 10),
+    "Quick Attack": (40, "Normal", 30),
+    "Rage": (20, "Normal", 20),
+    "Night Shade": (0, "Ghost", 15, 1, LEVEL),
+    "Egg Bomb": (100, "Normal", 10),
+    "Lick": (20, "Ghost", 30),
+    "Smog": (20, "Poison", 20),
+    "Sludge": (65, "Poison", 20),
+    "Bone Club": (65, "Ground", 20),
+    "Fire Blast": (120, "Fire", 5),
+    "Waterfall": (80, "Water", 15),
+    "Clamp": (35, "Water", 10),
+    "Swift": (60, "Normal", 20),
+    "Skull Bash": (100, "Normal", 15, 0.5),
+    "Spike Cannon": (20, "Normal", 15, MULTI),
+    "Constrict": (10, "Normal", 35),
+    "Hi Jump Kick": (85, "Fighting", 20),
+    "Barrage": (15, "Normal", 20, MULTI),
+    "Leech Life": (20, "Bug", 15),
+    "Sky Attack": (140, "Flying", 5, 0.5),
+    "Bubble": (20, "Water", 30),
+    "Dizzy Punch": (70, "Normal", 10),
+    "Psywave": (0, "Psychic", 15, 1, LEVEL),
+    "Crabhammer": (90, "Water", 10),
+    "Fury Swipes": (18, "Normal", 15, MULTI),
+    "Boomerang": (50, "Ground", 10, 2),
+    "Rock Slide": (75, "Rock", 10),
+    "Hyper Fang": (80, "Normal", 15),
+    "Tri Attack": (80, "Normal", 10),
+    "Super Fang": (0, "Normal", 10, 1, HALF_HP),
+    "Slash": (70, "Normal", 20),
+    "Struggle": (50, "Normal", 10),
+    "Triple Kick": (20, "Fighting", 10, 3),
+    "Thief": (40, "Dark", 10),
+    "Flame Wheel": (60, "Fire", 25),
+    # Flail and Reversal get stronger the lower the user's HP, this is the
+    # power at about half HP.
+    "Flail": (40, "Normal", 15),
+    "Aeroblast": (100, "Flying", 5),
+    "Reversal": (40, "Fighting", 15),
+    "Powder Snow": (40, "Ice", 25),
+    "Mach Punch": (40, "Fighting", 30),
+    "Feint Attack": (60, "Dark", 20),
+    "Sludge Bomb": (90, "Poison", 10),
+    "Mud-Slap": (20, "Ground", 10),
+    "Octazooka": (65, "Water", 10),
+    "Zap Cannon": (100, "Electric", 5),
+    "Icy Wind": (55, "Ice", 15),
+    "Bone Rush": (25, "Ground", 10, MULTI),
+    "Outrage": (90, "Dragon", 15),
+    "Giga Drain": (60, "Grass", 5),
+    "Rollout": (30, "Rock", 20),
+    "False Swipe": (40, "Normal", 40),
+    "Spark": (65, "Electric", 20),
+    "Fury Cutter": (10, "Bug", 20),
+    "Steel Wing": (70, "Steel", 25),
+    # Return and Frustration at the friendship a Pokemon starts with
+    "Return": (70, "Normal", 20),
+    "Present": (50, "Normal", 15),
+    "Frustration": (70, "Normal", 20),
+    "Sacred Fire": (100, "Fire", 5),
+    "Magnitude": (70, "Ground", 30),
+    "Dynamic Punch": (100, "Fighting", 5),
+    "Megahorn": (120, "Bug", 10),
+    "Dragon Breath": (60, "Dragon", 20),
+    "Pursuit": (40, "Dark", 20),
+    "Rapid Spin": (20, "Normal", 40),
+    "Iron Tail": (100, "Steel", 15),
+    "Metal Claw": (50, "Steel", 35),
+    "Vital Throw": (70, "Fighting", 10),
+    # The real type and power come from the DVs
+    "Hidden Power": (70, "Normal", 15),
+    "Cross Chop": (100, "Fighting", 5),
+    "Twister": (40, "Dragon", 20),
+    "Crunch": (80, "Dark", 15),
+    "Extreme Speed": (80, "Normal", 5),
+    "Ancient Power": (60, "Rock", 5),
+    "Shadow Ball": (80, "Ghost", 15),
+    "Rock Smash": (20, "Fighting", 15),
+    "Whirlpool": (15, "Water", 15),
+    "Beat Up": (10, "Dark", 10),
+}
+
+# Where Gen I differs, only moves Gen I has are taken from MOVES_GEN_II
+MOVES_GEN_I = {
+    "Karate Chop": (50, "Normal", 25),
+    "Gust": (40, "Normal", 35),
+    "Wing Attack": (35, "Flying", 35),
+    "Bite": (60, "Normal", 25),
+    "Double-Edge": (100, "Normal", 15),
+    "Dig": (100, "Ground", 10, 0.5),
+}
+
+# (attacker, defender, multiplier), anything not listed is neutral
+TYPE_CHART_GEN_II = [
+    ("Normal", "Rock", 0.5), ("Normal", "Ghost", 0), ("Normal", "Steel", 0.5),
+    ("Fire", "Fire", 0.5), ("Fire", "Water", 0.5), ("Fire", "Grass", 2), ("Fire", "Ice", 2),
+    ("Fire", "Bug", 2), ("Fire", "Rock", 0.5), ("Fire", "Dragon", 0.5), ("Fire", "Steel", 2),
+    ("Water", "Fire", 2), ("Water", "Water", 0.5), ("Water", "Grass", 0.5),
+    ("Water", "Ground", 2), ("Water", "Rock", 2), ("Water", "Dragon", 0.5),
+    ("Electric", "Water", 2), ("Electric", "Electric", 0.5), ("Electric", "Grass", 0.5),
+    ("Electric", "Ground", 0), ("Electric", "Flying", 2), ("Electric", "Dragon", 0.5),
+    ("Grass", "Fire", 0.5), ("Grass", "Water", 2), ("Grass", "Grass", 0.5),
+    ("Grass", "Poison", 0.5), ("Grass", "Ground", 2), ("Grass", "Flying", 0.5),
+    ("Grass", "Bug", 0.5), ("Grass", "Rock", 2), ("Grass", "Dragon", 0.5),
+    ("Grass", "Steel", 0.5),
+    ("Ice", "Fire", 0.5), ("Ice", "Water", 0.5), ("Ice", "Grass", 2), ("Ice", "Ice", 0.5),
+    ("Ice", "Ground", 2), ("Ice", "Flying", 2), ("Ice", "Dragon", 2), ("Ice", "Steel", 0.5),
+    ("Fighting", "Normal", 2), ("Fighting", "Ice", 2), ("Fighting", "Poison", 0.5),
+    ("Fighting", "Flying", 0.5), ("Fighting", "Psychic", 0.5), ("Fighting", "Bug", 0.5),
+    ("Fighting", "Rock", 2), ("Fighting", "Ghost", 0), ("Fighting", "Dark", 2),
+    ("Fighting", "Steel", 2),
+    ("Poison", "Grass", 2), ("Poison", "Poison", 0.5), ("Poison", "Ground", 0.5),
+    ("Poison", "Rock", 0.5), ("Poison", "Ghost", 0.5), ("Poison", "Steel", 0),
+    ("Ground", "Fire", 2), ("Ground", "Electric", 2), ("Ground", "Grass", 0.5),
+    ("Ground", "Poison", 2), ("Ground", "Flying", 0), ("Ground", "Bug", 0.5),
+    ("Ground", "Rock", 2), ("Ground", "Steel", 2),
+    ("Flying", "Electric", 0.5), ("Flying", "Grass", 2), ("Flying", "Fighting", 2),
+    ("Flying", "Bug", 2), ("Flying", "Rock", 0.5), ("Flying", "Steel", 0.5),
+    ("Psychic", "Fighting", 2), ("Psychic", "Poison", 2), ("Psychic", "Psychic", 0.5),
+    ("Psychic", "Dark", 0), ("Psychic", "Steel", 0.5),
+    ("Bug", "Fire", 0.5), ("Bug", "Grass", 2), ("Bug", "Fighting", 0.5),
+    ("Bug", "Poison", 0.5), ("Bug", "Flying", 0.5), ("Bug", "Psychic", 2),
+    ("Bug", "Ghost", 0.5), ("Bug", "Dark", 2), ("Bug", "Steel", 0.5),
+    ("Rock", "Fire", 2), ("Rock", "Ice", 2), ("Rock", "Fighting", 0.5),
+    ("Rock", "Ground", 0.5), ("Rock", "Flying", 2), ("Rock", "Bug", 2), ("Rock", "Steel", 0.5),
+    ("Ghost", "Normal", 0), ("Ghost", "Psychic", 2), ("Ghost", "Ghost", 2),
+    ("Ghost", "Dark", 0.5), ("Ghost", "Steel", 0.5),
+    ("Dragon", "Dragon", 2), ("Dragon", "Steel", 0.5),
+    ("Dark", "Fighting", 0.5), ("Dark", "Psychic", 2), ("Dark", "Ghost", 2),
+    ("Dark", "Dark", 0.5), ("Dark", "Steel", 0.5),
+    ("Steel", "Fire", 0.5), ("Steel", "Water", 0.5), ("Steel", "Electric", 0.5),
+    ("Steel", "Ice", 2), ("Steel", "Rock", 2), ("Steel", "Steel", 0.5),
+]
+
+# Gen I has no Steel or Dark, and a few well known differences
+TYPE_CHART_GEN_I_DIFF = [
+    ("Bug", "Poison", 2), ("Poison", "Bug", 2), ("Ghost", "Psychic", 0), ("Ice", "Fire", 1),
+]
+
+# Types of the Pokemon Gen I doesn't have, and of the two Gen II gave Steel
+SPECIES_TYPES_GEN_II = {
+    "Magnemite": ("Electric", "Steel"), "Magneton": ("Electric", "Steel"),
+    "Chikorita": ("Grass",), "Bayleef": ("Grass",), "Meganium": ("Grass",),
+    "Cyndaquil": ("Fire",), "Quilava": ("Fire",), "Typhlosion": ("Fire",),
+    "Totodile": ("Water",), "Croconaw": ("Water",), "Feraligatr": ("Water",),
+    "Sentret": ("Normal",), "Furret": ("Normal",),
+    "Hoothoot": ("Normal", "Flying"), "Noctowl": ("Normal", "Flying"),
+    "Ledyba": ("Bug", "Flying"), "Ledian": ("Bug", "Flying"),
+    "Spinarak": ("Bug", "Poison"), "Ariados": ("Bug", "Poison"), "Crobat": ("Poison", "Flying"),
+    "Chinchou": ("Water", "Electric"), "Lanturn": ("Water", "Electric"),
+    "Pichu": ("Electric",), "Cleffa": ("Normal",), "Igglybuff": ("Normal",),
+    "Togepi": ("Normal",), "Togetic": ("Normal", "Flying"),
+    "Natu": ("Psychic", "Flying"), "Xatu": ("Psychic", "Flying"),
+    "Mareep": ("Electric",), "Flaaffy": ("Electric",), "Ampharos": ("Electric",),
+    "Bellossom": ("Grass",), "Marill": ("Water",), "Azumarill": ("Water",),
+    "Sudowoodo": ("Rock",), "Politoed": ("Water",),
+    "Hoppip": ("Grass", "Flying"), "Skiploom": ("Grass", "Flying"),
+    "Jumpluff": ("Grass", "Flying"), "Aipom": ("Normal",),
+    "Sunkern": ("Grass",), "Sunflora": ("Grass",), "Yanma": ("Bug", "Flying"),
+    "Wooper": ("Water", "Ground"), "Quagsire": ("Water", "Ground"),
+    "Espeon": ("Psychic",), "Umbreon": ("Dark",), "Murkrow": ("Dark", "Flying"),
+    "Slowking": ("Water", "Psychic"), "Misdreavus": ("Ghost",), "Unown": ("Psychic",),
+    "Wobbuffet": ("Psychic",), "Girafarig": ("Normal", "Psychic"),
+    "Pineco": ("Bug",), "Forretress": ("Bug", "Steel"), "Dunsparce": ("Normal",),
+    "Gligar": ("Ground", "Flying"), "Steelix": ("Steel", "Ground"),
+    "Snubbull": ("Normal",), "Granbull": ("Normal",), "Qwilfish": ("Water", "Poison"),
+    "Scizor": ("Bug", "Steel"), "Shuckle": ("Bug", "Rock"), "Heracross": ("Bug", "Fighting"),
+    "Sneasel": ("Dark", "Ice"), "Teddiursa": ("Normal",), "Ursaring": ("Normal",),
+    "Slugma": ("Fire",), "Magcargo": ("Fire", "Rock"),
+    "Swinub": ("Ice", "Ground"), "Piloswine": ("Ice", "Ground"),
+    "Corsola": ("Water", "Rock"), "Remoraid": ("Water",), "Octillery": ("Water",),
+    "Delibird": ("Ice", "Flying"), "Mantine": ("Water", "Flying"),
+    "Skarmory": ("Steel", "Flying"), "Houndour": ("Dark", "Fire"),
+    "Houndoom": ("Dark", "Fire"), "Kingdra": ("Water", "Dragon"),
+    "Phanpy": ("Ground",), "Donphan": ("Ground",), "Porygon2": ("Normal",),
+    "Stantler": ("Normal",), "Smeargle": ("Normal",), "Tyrogue": ("Fighting",),
+    "Hitmontop": ("Fighting",), "Smoochum": ("Ice", "Psychic"), "Elekid": ("Electric",),
+    "Magby": ("Fire",), "Miltank": ("Normal",), "Blissey": ("Normal",),
+    "Raikou": ("Electric",), "Entei": ("Fire",), "Suicune": ("Water",),
+    "Larvitar": ("Rock", "Ground"), "Pupitar": ("Rock", "Ground"),
+    "Tyranitar": ("Rock", "Dark"), "Lugia": ("Psychic", "Flying"),
+    "Ho-Oh": ("Fire", "Flying"), "Celebi": ("Psychic", "Grass"),
+}
+
+
+def list_items(path, name):
+    text = path.read_text()
+    match = re.search(r"static const NamedListItem %s_items\[\] = \{(.*?)\n\};" % name, text, re.S)
+    if not match:
+        sys.exit("%s: no %s items" % (path, name))
+    return {n: int(i, 16) for n, i in ITEM_RE.findall(match.group(1))}
+
+
+def move_table(moves, types, data):
+    entries = []
+    for name, move in sorted(data.items(), key=lambda d: moves[d[0]] if d[0] in moves else -1):
+        if name not in moves:
+            sys.exit("unknown move '%s'" % name)
+        power, type_name, pp = move[0], move[1], move[2]
+        hits = move[3] if len(move) > 3 else 1
+        flags = move[4] if len(move) > 4 else "0"
+        power = int(power * hits)
+        if power > 255:
+            sys.exit("'%s' is too strong" % name)
+        entries.append(
+            "    [0x%02X] = {%d, 0x%02X, %d, %s}, // %s"
+            % (moves[name], power, types[type_name], pp, flags, name)
+        )
+    return entries
+
+
+def type_chart(types, chart):
+    eff = [[2] * TYPE_CNT for _ in range(TYPE_CNT)]
+    for atk, dfn, mult in chart:
+        eff[types[atk]][types[dfn]] = int(mult * 2)
+
+    names = {v: n for n, v in types.items()}
+    rows = []
+    for atk in range(TYPE_CNT):
+        rows.append("    /* %s */" % names.get(atk, "Unused"))
+        rows.append("    {%s}," % ", ".join(str(e) for e in eff[atk]))
+    return rows
+
+
+def species_types(root, types):
+    text = (root / "src/pokemon_table.c").read_text()
+    species = SPECIES_RE.findall(text)
+    if len(species) != 251:
+        sys.exit("expected 251 species, found %d" % len(species))
+
+    for name in SPECIES_TYPES_GEN_II:
+        if name not in [s[0] for s in species]:
+            sys.exit("unknown species '%s'" % name)
+
+    rows = []
+    for num, (name, type_0, type_1) in enumerate(species):
+        if name in SPECIES_TYPES_GEN_II:
+            both = SPECIES_TYPES_GEN_II[name]
+            type_0 = types[both[0]]
+            type_1 = types[both[-1]]
+        else:
+            if num >= 151:
+                sys.exit("no types for '%s'" % name)
+            type_0 = int(type_0, 16)
+            type_1 = int(type_1, 16)
+        rows.append("    {0x%02X, 0x%02X}, // %s" % (type_0, type_1, name))
+    return rows
+
+
+def main():
+    root = Path(__file__).resolve().parent.parent
+    moves = list_items(root / "src/move_nl.c", "move_list")
+    types = list_items(root / "src/type_nl.c", "type_list")
+    types.update(EXTRA_TYPES)
+
+    moves_gen_i = {n: m for n, m in MOVES_GEN_II.items() if moves[n] <= moves["Struggle"]}
+    moves_gen_i.update(MOVES_GEN_I)
+
+    path = root / OUT_FILE
+    head = path.read_text().split(MARKER)[0].rstrip("\n")
+    out = [head, "", MARKER, ""]
+
+    out.append("const BattleMove battle_move_gen_i[256] = {")
+    out += move_table(moves, types, moves_gen_i)
+    out.append("};")
+    out.append("")
+    out.append("const BattleMove battle_move_gen_ii[256] = {")
+    out += move_table(moves, types, MOVES_GEN_II)
+    out.append("};")
+    out.append("")
+
+    gen_i_types = {n: v for n, v in types.items() if n not in EXTRA_TYPES}
+    out.append("const uint8_t battle_type_eff_gen_i[BATTLE_TYPE_CNT][BATTLE_TYPE_CNT] = {")
+    out += type_chart(
+        gen_i_types,
+        [e for e in TYPE_CHART_GEN_II if e[0] in gen_i_types and e[1] in gen_i_types]
+        + TYPE_CHART_GEN_I_DIFF,
+    )
+    out.append("};")
+    out.append("")
+    out.append("const uint8_t battle_type_eff_gen_ii[BATTLE_TYPE_CNT][BATTLE_TYPE_CNT] = {")
+    out += type_chart(types, TYPE_CHART_GEN_II)
+    out.append("};")
+    out.append("")
+
+    out.append("const uint8_t battle_species_type_gen_ii[BATTLE_SPECIES_CNT][2] = {")
+    out += species_types(root, types)
+    out.append("};")
+    out.append("")
+
+    path.write_text("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Generate the lookup tables for each NamedList in src/*_nl.c.
+
+Each list's items are defined by hand as a NamedListItem array named
+<list>_items. Everything after the GENERATED marker in the same file is
+rewritten by this script: the index to position table, the per generation
+position arrays, and the NamedList itself.
+
+Run from the root of the repository after changing any list's items:
+    python3 tools/named_list_gen.py
+"""
+
+import re
+import sys
+from pathlib import Path
+
+MARKER = "/* Generated by tools/named_list_gen.py, do not edit below this line */"
+
+NL_FILES = ["src/item_nl.c", "src/move_nl.c", "src/stat_nl.c", "src/type_nl.c"]
+
+# Generation bits, see GEN_I and GEN_II in src/include/pokemon_data.h
+GENS = [("GEN_I", 0x01), ("GEN_II", 0x02)]
+
+ITEMS_RE = re.compile(r"static const NamedListItem (\w+)_items\[\] = \{(.*?)\n\};", re.S)
+ITEM_RE = re.compile(r'^\s*\{"((?:[^"\\]|\\.)*)", ([^,]+), ([^}]+)\},\s*$')
+ENUM_RE = re.compile(r"typedef enum \{(.*?)\}", re.S)
+
+
+def enum_values(root):
+    """Values of every plain enum in the list headers, for symbolic indices"""
+    values = {}
+    for header in sorted((root / "src/include").glob("*_nl.h")):
+        for body in ENUM_RE.findall(header.read_text()):
+            val = 0
+            for name in re.findall(r"^\s*(\w+)\s*(?:=\s*([^,]+))?,", body, re.M):
+                if name[1]:
+                    val = int(name[1], 0)
+                values[name[0]] = val
+                val += 1
+    return values
+
+
+def evaluate(expr, symbols):
+    for name, val in sorted(symbols.items(), key=lambda s: -len(s[0])):
+        expr = re.sub(r"\b%s\b" % name, str(val), expr)
+    if not re.fullmatch(r"[0-9a-fA-FxX()| ]+", expr):
+        sys.exit("cannot evaluate '%s'" % expr)
+    return eval(expr)
+
+
+def c_array(vals, indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(vals), per_line):
+        lines.append(indent + ", ".join(str(v) for v in vals[i : i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def generate(path, symbols):
+    text = path.read_text()
+    head = text.split(MARKER)[0].rstrip("\n")
+    match = ITEMS_RE.search(head)
+    if not match:
+        sys.exit("%s: no NamedListItem array" % path)
+    name = match.group(1)
+
+    items = []
+    for line in match.group(2).splitlines():
+        item = ITEM_RE.match(line)
+        if item:
+            items.append((item.group(1), evaluate(item.group(2), symbols), evaluate(item.group(3), symbols)))
+    if len(items) > 255:
+        sys.exit("%s: too many items for uint8_t positions" % path)
+
+    index_pos = [0] * 256
+    for pos in reversed(range(len(items))):
+        index_pos[items[pos][1]] = pos
+
+    out = [head, "", MARKER, ""]
+    out.append("static const uint8_t %s_index_pos[256] = {" % name)
+    out.append(c_array(index_pos))
+    out.append("};")
+    out.append("")
+
+    gen_pos = []
+    gen_cnt = []
+    for gen_name, gen_bit in GENS:
+        positions = [pos for pos, item in enumerate(items) if item[2] & gen_bit]
+        gen_cnt.append(len(positions))
+        if not positions:
+            gen_pos.append("NULL")
+            continue
+        arr = "%s_%s_pos" % (name, gen_name.lower())
+        gen_pos.append(arr)
+        out.append("static const uint8_t %s[%d] = {" % (arr, len(positions)))
+        out.append(c_array(positions))
+        out.append("};")
+        out.append("")
+
+    out.append("const NamedList %s = {" % name)
+    out.append("    .items = %s_items," % name)
+    out.append("    .cnt = %d," % len(items))
+    out.append("    .index_pos = %s_index_pos," % name)
+    out.append("    .gen_pos = {%s}," % ", ".join(gen_pos))
+    out.append("    .gen_cnt = {%s}," % ", ".join(str(c) for c in gen_cnt))
+    out.append("};")
+    out.append("")
+
+    path.write_text("\n".join(out))
+
+
+def main():
+    root = Path(__file__).resolve().parent.parent
+    symbols = dict(GENS)
+    symbols.update(enum_values(root))
+    for nl in NL_FILES:
+        generate(root / nl, symbols)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Generate the Gen I species index to position table in src/pokemon_table.c.
+
+Each entry of pokemon_table is defined by hand with its name followed by its
+Gen I species index. Everything after the GENERATED marker in the same file is
+rewritten by this script with pokemon_index_pos, the position in pokemon_table
+of the first entry with each index.
+
+Run from the root of the repository after adding, removing, or reordering any
+pokemon_table entry, or changing any entry's index:
+    python3 tools/pokemon_index_gen.py
+"""
+
+import re
+import sys
+from pathlib import Path
+
+MARKER = "/* Generated by tools/pokemon_index_gen.py, do not edit below this line */"
+
+TABLE_FILE = "src/pokemon_table.c"
+
+TABLE_RE = re.compile(r"static const PokemonTable pokemon_table\[\] = \{(.*?)\n\};", re.S)
+ENTRY_RE = re.compile(r'^    \{"([^"]+)",\n\s+(0x[0-9A-Fa-f]+),', re.M)
+
+
+def main():
+    path = Path(__file__).resolve().parent.parent / TABLE_FILE
+    text = path.read_text()
+    head = text.split(MARKER)[0].rstrip("\n")
+
+    match = TABLE_RE.search(head)
+    if not match:
+        sys.exit("%s: no pokemon_table" % path)
+    entries = [(name, int(index, 16)) for name, index in ENTRY_RE.findall(match.group(1))]
+    if not entries or len(entries) > 255:
+        sys.exit("%s: %d entries don't fit uint8_t positions" % (path, len(entries)))
+
+    index_pos = [0] * 256
+    for pos in reversed(range(len(entries))):
+        index_pos[entries[pos][1]] = pos
+
+    out = [head, "", MARKER, ""]
+    out.append("/* Any index that does not match an entry gives the first entry, which could")
+    out.append(" * be surprising at runtime. Note that all Gen II only Pokemon have an index")
+    out.append(" * of 0, so index 0 is the first of those.")
+    out.append(" */")
+    out.append("static const uint8_t pokemon_index_pos[256] = {")
+    for row in range(0, 256, 16):
+        vals = ", ".join(str(v) for v in index_pos[row : row + 16])
+        out.append("    /* 0x%02X */ %s," % (row, vals))
+    out.append("};")
+    out.append("")
+
+    path.write_text("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Build the compressed sprite pack from the sprite PNGs.
+
+Every sprites/NNN.png from 001 up to the last one present is converted to
+XBM and coded as described in src/include/sprite_pack.h. 000 is the built in
+placeholder, src/missingno_i.h, and is not part of the pack.
+
+Only the standard library is used, the PNGs must be 1 bit grayscale and not
+interlaced, which is what is in sprites/.
+
+Run from the root of the repository after changing any sprite:
+    python3 tools/sprite_pack.py
+
+The legacy all_sprites.fxbm, still read by the app if no pack is found, can
+be written instead with --fxbm.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+MAGIC = b"PKSP"
+VERSION = 1
+HDR = struct.Struct("<4sBBHHH")
+
+
+def png_read(path):
+    """Returns width, height, and the unfiltered rows of a 1 bpp gray PNG"""
+    data = path.read_bytes()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        sys.exit(f"{path}: not a PNG")
+
+    pos = 8
+    idat = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos : pos + 8])
+        body = data[pos + 8 : pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+            if depth != 1 or color != 0 or interlace != 0:
+                sys.exit(f"{path}: must be 1 bit grayscale, not interlaced")
+        elif kind == b"IDAT":
+            idat += body
+
+    raw = zlib.decompress(idat)
+    stride = (width + 7) // 8
+    rows = []
+    prev = bytes(stride)
+    for y in range(height):
+        pos = y * (stride + 1)
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1 : pos + 1 + stride])
+        for x in range(stride):
+            a = line[x - 1] if x else 0
+            b = prev[x]
+            c = prev[x - 1] if x else 0
+            if ftype == 1:
+                line[x] = (line[x] + a) & 0xFF
+            elif ftype == 2:
+                line[x] = (line[x] + b) & 0xFF
+            elif ftype == 3:
+                line[x] = (line[x] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else b if pb <= pc else c
+                line[x] = (line[x] + pred) & 0xFF
+        rows.append(bytes(line))
+        prev = rows[-1]
+
+    return width, height, rows
+
+
+def xbm(width, rows):
+    """PNG rows, MSB first with black as 0, to XBM, LSB first with black as 1"""
+    out = bytearray()
+    for row in rows:
+        for x in range(0, width, 8):
+            val = 0
+            for bit in range(min(8, width - x)):
+                if not (row[(x + bit) // 8] >> (7 - (x + bit) % 8)) & 1:
+                    val |= 1 << bit
+            out.append(val)
+    return bytes(out)
+
+
+def encode(data, stride):
+    """Code one sprite, or leave it raw if that would be no smaller"""
+    delta = bytes(data[i] ^ (data[i - stride] if i >= stride else 0) for i in range(len(data)))
+    mask = bytearray((len(data) + 7) // 8)
+    for i, val in enumerate(delta):
+        if val:
+            mask[i // 8] |= 1 << (i % 8)
+    coded = bytes(mask) + bytes(val for val in delta if val)
+
+    return coded if len(coded) < len(data) else data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--sprites", default="sprites", type=Path)
+    parser.add_argument("--out", type=Path)
+    parser.add_argument("--fxbm", action="store_true", help="write the legacy format")
+    args = parser.parse_args()
+
+    if args.out is None:
+        args.out = Path("files/all_sprites.fxbm" if args.fxbm else "files/all_sprites.pksp")
+
+    sprites = []
+    num = 1
+    while (args.sprites / f"{num:03d}.png").exists():
+        sprites.append(png_read(args.sprites / f"{num:03d}.png"))
+        num += 1
+    if not sprites:
+        sys.exit(f"no sprites found in {args.sprites}")
+
+    width, height = sprites[0][:2]
+    for num, (w, h, _) in enumerate(sprites, 1):
+        if (w, h) != (width, height):
+            sys.exit(f"{num:03d}.png is {w}x{h}, expected {width}x{height}")
+
+    stride = (width + 7) // 8
+    raw = [xbm(width, rows) for _, _, rows in sprites]
+
+    if args.fxbm:
+        out = b"".join(
+            struct.pack("<III", len(data) + 8, width, height) + data for data in raw
+        )
+    else:
+        coded = [encode(data, stride) for data in raw]
+        offset = HDR.size + (len(coded) + 1) * 4
+        index = [offset]
+        for data in coded:
+            offset += len(data)
+            index.append(offset)
+        out = (
+            HDR.pack(MAGIC, VERSION, 0, len(coded), width, height)
+            + struct.pack(f"<{len(index)}I", *index)
+            + b"".join(coded)
+        )
+
+    args.out.write_bytes(out)
+    print(
+        f"{args.out}: {len(sprites)} sprites, {len(out)} bytes, "
+        f"{len(out) * 100 // sum(len(data) for data in raw)}% of raw"
+    )
+
+
+if __name__ == "__main__":
+    main()